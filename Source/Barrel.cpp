@@ -23,7 +23,10 @@ namespace GameDev2D
         m_PhysicsBody->SetLinearDamping(Vector2(0.2f, 0.2));
         m_PhysicsBody->SetAngularDamping(1.0f);
         m_PhysicsBody->SetPosition(Math::PixelsToMeters(Postion));
+        m_PhysicsBody->SetUserData(this);
         m_PhysicsBody->SetObject(Body_Barrel);
+        m_PhysicsBody->GetCollider()->SetCategoryBits(COLLISION_CATEGORY_BARREL);
+        m_PhysicsBody->GetCollider()->SetMaskBits(COLLISION_CATEGORY_TANK | COLLISION_CATEGORY_SHELL);
         m_DidCollide = false;
         m_Existance = true;
 
@@ -59,7 +62,8 @@ namespace GameDev2D
 	{
         delete m_Barrel;
         delete m_Explosion;
-        delete m_PhysicsBody;
+        Physics::World::GetInstance()->DestroyBody(m_PhysicsBody);
+        m_PhysicsBody = nullptr;
         UnloadTexture("SpriteAtlas");
 	}
 
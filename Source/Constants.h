@@ -10,3 +10,8 @@ enum BodyTypes
     Body_Blue,
     Body_Green
 };
+
+//Collision categories, shells pass through each other and barrels don't push each other around
+const unsigned short COLLISION_CATEGORY_TANK = 0x0001;
+const unsigned short COLLISION_CATEGORY_BARREL = 0x0002;
+const unsigned short COLLISION_CATEGORY_SHELL = 0x0004;
@@ -56,7 +56,7 @@ namespace GameDev2D
         m_Det = nullptr;
 
 
-        delete m_PhysicsBody;
+        Physics::World::GetInstance()->DestroyBody(m_PhysicsBody);
         m_PhysicsBody = nullptr;
 
     }
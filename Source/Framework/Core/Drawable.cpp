@@ -45,4 +45,36 @@ namespace GameDev2D
     {
         m_Anchor = aAnchor;
     }
+
+    Rect Drawable::GetLocalBounds()
+    {
+        Vector2 size(GetWidth(), GetHeight());
+        return Rect(Vector2(-size.x * m_Anchor.x, -size.y * m_Anchor.y), size);
+    }
+
+    Rect Drawable::GetWorldBounds()
+    {
+        //Transform the local bounds' corners into world space
+        Rect bounds = GetLocalBounds();
+        Vector2 corners[4] =
+        {
+            bounds.origin,
+            bounds.origin + Vector2(bounds.size.x, 0.0f),
+            bounds.origin + bounds.size,
+            bounds.origin + Vector2(0.0f, bounds.size.y)
+        };
+        GetTransformMatrix().Transform(corners, corners, 4);
+
+        //The world bounds enclose all four corners
+        Vector2 lower = corners[0];
+        Vector2 upper = corners[0];
+        for (unsigned int i = 1; i < 4; i++)
+        {
+            lower.x = fminf(lower.x, corners[i].x);
+            lower.y = fminf(lower.y, corners[i].y);
+            upper.x = fmaxf(upper.x, corners[i].x);
+            upper.y = fmaxf(upper.y, corners[i].y);
+        }
+        return Rect(lower, upper - lower);
+    }
 }
\ No newline at end of file
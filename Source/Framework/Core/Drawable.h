@@ -3,6 +3,7 @@
 
 #include "Transformable.h"
 #include "../Graphics/Color.h"
+#include "../Graphics/GraphicTypes.h"
 #include "../Graphics/Shader.h"
 
 
@@ -41,6 +42,14 @@ namespace GameDev2D
         //Sets the anchor point associated with the Drawable object
         void SetAnchor(Vector2 anchor);
 
+        //Returns the bounds of the Drawable relative to its own transform, by default the width and height offset by the
+        //anchor. Override it if the Drawable's vertices can extend past that rect
+        virtual Rect GetLocalBounds();
+
+        //Returns the axis aligned bounds of the Drawable in world space, the Graphics service uses it to skip Drawables
+        //that are outside of the Camera's view
+        Rect GetWorldBounds();
+
     protected:
         //Member variables
         Shader* m_Shader;
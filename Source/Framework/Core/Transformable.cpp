@@ -6,18 +6,76 @@ namespace GameDev2D
 {
     Transformable::Transformable() :
         m_Parent(nullptr),
-        m_Transform(Matrix::Identity()),
+        m_Children(),
+        m_Transform(AffineMatrix::Identity()),
+        m_WorldTransform(AffineMatrix::Identity()),
+        m_Version(0),
         m_Rotation(),
         m_Position(0.0f, 0.0f),
         m_Scale(1.0f, 1.0f),
-        m_IsTransformMatrixDirty(false)
+        m_IsTransformMatrixDirty(false),
+        m_IsWorldTransformDirty(false)
     {
 
     }
 
+    Transformable::Transformable(const Transformable& aTransformable) :
+        m_Parent(nullptr),
+        m_Children(),
+        m_Transform(aTransformable.m_Transform),
+        m_WorldTransform(AffineMatrix::Identity()),
+        m_Version(0),
+        m_Rotation(aTransformable.m_Rotation),
+        m_Position(aTransformable.m_Position),
+        m_Scale(aTransformable.m_Scale),
+        m_IsTransformMatrixDirty(true),
+        m_IsWorldTransformDirty(true)
+    {
+        AttachTo(aTransformable.m_Parent);
+    }
+
+    Transformable::~Transformable()
+    {
+        //Detach from the parent, and detach the children, none of them can be left pointing at a deleted object
+        AttachTo(nullptr);
+        while (m_Children.empty() == false)
+        {
+            m_Children.back()->AttachTo(nullptr);
+        }
+    }
+
+    Transformable& Transformable::operator=(const Transformable& aTransformable)
+    {
+        if (this != &aTransformable)
+        {
+            m_Rotation = aTransformable.m_Rotation;
+            m_Position = aTransformable.m_Position;
+            m_Scale = aTransformable.m_Scale;
+            m_IsTransformMatrixDirty = true;
+            AttachTo(aTransformable.m_Parent);
+            SetWorldTransformDirty();
+        }
+        return *this;
+    }
+
     void Transformable::AttachTo(Transformable* aParent)
     {
-        m_Parent = aParent;
+        if (m_Parent != aParent)
+        {
+            if (m_Parent != nullptr)
+            {
+                m_Parent->RemoveChild(this);
+            }
+
+            m_Parent = aParent;
+
+            if (m_Parent != nullptr)
+            {
+                m_Parent->AddChild(this);
+            }
+        }
+
+        SetWorldTransformDirty();
     }
 
     Transformable* Transformable::GetParent()
@@ -25,24 +83,78 @@ namespace GameDev2D
         return m_Parent;
     }
 
-    Matrix Transformable::GetTransformMatrix()
+    const AffineMatrix& Transformable::GetTransformMatrix()
     {
-        if (m_IsTransformMatrixDirty == true)
+        //The world matrix is marked dirty when this object OR one of its parents changes, so a clean matrix is returned as is
+        if (m_IsWorldTransformDirty == true)
         {
-            Matrix translationMatrix = Matrix::MakeTranslation(m_Position);
-            Matrix rotationMatrix = Matrix::MakeRotation(m_Rotation.GetAngle());
-            Matrix scaleMatrix = Matrix::MakeScale(m_Scale);
+            if (m_Parent != nullptr)
+            {
+                m_WorldTransform = m_Parent->GetTransformMatrix() * GetLocalTransformMatrix();
+            }
+            else
+            {
+                //Without a parent the world matrix is the local matrix
+                m_WorldTransform = GetLocalTransformMatrix();
+            }
+
+            m_IsWorldTransformDirty = false;
+            m_Version++;
+        }
+
+        return m_WorldTransform;
+    }
 
-            m_Transform = translationMatrix * rotationMatrix * scaleMatrix;
+    const AffineMatrix& Transformable::GetLocalTransformMatrix()
+    {
+        if (m_IsTransformMatrixDirty == true)
+        {
+            m_Transform = AffineMatrix::Make(m_Position, m_Rotation.GetAngle(), m_Scale);
             m_IsTransformMatrixDirty = false;
         }
 
-        if (m_Parent != nullptr)
+        return m_Transform;
+    }
+
+    unsigned int Transformable::GetTransformVersion()
+    {
+        //Make sure the version is up to date
+        GetTransformMatrix();
+        return m_Version;
+    }
+
+    void Transformable::SetWorldTransformDirty()
+    {
+        //A dirty world matrix's children are already dirty, they can't be rebuilt before their parent is
+        if (m_IsWorldTransformDirty == true)
+        {
+            return;
+        }
+
+        m_IsWorldTransformDirty = true;
+        for (unsigned int i = 0; i < m_Children.size(); i++)
         {
-            return m_Parent->GetTransformMatrix() * m_Transform;
+            m_Children.at(i)->SetWorldTransformDirty();
         }
+    }
 
-        return m_Transform;
+    void Transformable::AddChild(Transformable* aChild)
+    {
+        m_Children.push_back(aChild);
+    }
+
+    void Transformable::RemoveChild(Transformable* aChild)
+    {
+        for (unsigned int i = 0; i < m_Children.size(); i++)
+        {
+            if (m_Children.at(i) == aChild)
+            {
+                //The order of the children doesn't matter, swap the last child into its place
+                m_Children.at(i) = m_Children.back();
+                m_Children.pop_back();
+                return;
+            }
+        }
     }
 
     Vector2 Transformable::GetPosition()
@@ -54,12 +166,14 @@ namespace GameDev2D
     {
         m_Position = aPosition;
         m_IsTransformMatrixDirty = true;
+        SetWorldTransformDirty();
     }
 
     void Transformable::Translate(Vector2 aOffset)
     {
         m_Position += aOffset;
         m_IsTransformMatrixDirty = true;
+        SetWorldTransformDirty();
     }
 
     float Transformable::GetAngle()
@@ -71,12 +185,14 @@ namespace GameDev2D
     {
         m_Rotation.SetAngle(aAngle);
         m_IsTransformMatrixDirty = true;
+        SetWorldTransformDirty();
     }
 
     void Transformable::Rotate(float aAngle)
     {
         m_Rotation.SetAngle(m_Rotation.GetAngle() + aAngle);
         m_IsTransformMatrixDirty = true;
+        SetWorldTransformDirty();
     }
 
     Vector2 Transformable::GetDirection()
@@ -88,6 +204,7 @@ namespace GameDev2D
     {
         m_Rotation.SetDirection(aDirection);
         m_IsTransformMatrixDirty = true;
+        SetWorldTransformDirty();
     }
 
     Vector2 Transformable::GetScale()
@@ -99,6 +216,7 @@ namespace GameDev2D
     {
         m_Scale = aScale;
         m_IsTransformMatrixDirty = true;
+        SetWorldTransformDirty();
     }
 
     void Transformable::Log()
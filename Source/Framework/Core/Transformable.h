@@ -3,7 +3,8 @@
 
 #include "../Math/Rotation.h"
 #include "../Math/Vector2.h"
-#include "../Math/Matrix.h"
+#include "../Math/AffineMatrix.h"
+#include <vector>
 
 
 namespace GameDev2D
@@ -12,6 +13,11 @@ namespace GameDev2D
     {
     public:
         Transformable();
+        Transformable(const Transformable& transformable);
+        ~Transformable();
+
+        //Copies the position, angle and scale, the copy is attached to the same parent but it has no children
+        Transformable& operator=(const Transformable& transformable);
 
         //Returns the parent object (if there is one) of the Transformable object
         Transformable* GetParent();
@@ -20,8 +26,16 @@ namespace GameDev2D
         //it will then move, rotate and scale with its parent
         void AttachTo(Transformable* parent);
 
-        //Returns the Transformation matrix
-        Matrix GetTransformMatrix();
+        //Returns the world space Transformation matrix, the parent's matrix multiplied by the local matrix. The
+        //matrix is cached, changing this object OR one of its parents marks it (and its children) to be rebuilt
+        const AffineMatrix& GetTransformMatrix();
+
+        //Returns the local Transformation matrix, relative to the parent
+        const AffineMatrix& GetLocalTransformMatrix();
+
+        //Returns the world matrix's version, it's incremented every time the world matrix is rebuilt. Objects that
+        //cache data derived from the world matrix can compare versions to know when it's stale
+        unsigned int GetTransformVersion();
 
         //Returns the Position of the Transformable object
         Vector2 GetPosition();
@@ -57,13 +71,24 @@ namespace GameDev2D
         void Log();
 
     protected:
+        //Marks the world matrix to be rebuilt, along with the world matrices of the children
+        void SetWorldTransformDirty();
+
+        //Adds or removes a child, used by AttachTo() so a parent can mark its children's world matrices dirty
+        void AddChild(Transformable* child);
+        void RemoveChild(Transformable* child);
+
         //Member variables
         Transformable* m_Parent;
-        Matrix m_Transform;
+        std::vector<Transformable*> m_Children;
+        AffineMatrix m_Transform;
+        AffineMatrix m_WorldTransform;
+        unsigned int m_Version;
         Rotation m_Rotation;
         Vector2 m_Position;
         Vector2 m_Scale;
         bool m_IsTransformMatrixDirty;
+        bool m_IsWorldTransformDirty;
     };
 }
 
@@ -3,10 +3,10 @@
 
 namespace GameDev2D
 {
-    void Run(std::function<void()> aInitCallback, std::function<void()> aShutdownCallback, std::function<void(double)> aUpdateCallback, std::function<void()> aDrawCallback)
+    void Run(std::function<void()> aInitCallback, std::function<void()> aShutdownCallback, std::function<void(double)> aUpdateCallback, std::function<void()> aDrawCallback, GraphicsBackend aGraphicsBackend)
     {
         //Create the Window's PlatformLayer and initialize it and set the Root Scene
-        Application application = Application(WINDOW_TITLE, TARGET_FPS, WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_IS_FULLSCREEN);
+        Application application = Application(WINDOW_TITLE, TARGET_FPS, WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_IS_FULLSCREEN, aGraphicsBackend);
 
         //Initialize the application with the callback functions
         application.Init(aInitCallback, aShutdownCallback, aUpdateCallback, aDrawCallback);
@@ -23,6 +23,15 @@ namespace GameDev2D
         } while (application.Loop() == true);
     }
 
+    GraphicsBackend GetGraphicsBackend(const std::string& aCommandLine)
+    {
+        if (aCommandLine.find("-headless") != std::string::npos)
+        {
+            return GraphicsBackend_Headless;
+        }
+        return GRAPHICS_BACKEND;
+    }
+
     unsigned int GetScreenWidth()
     {
         return Services::GetApplication()->GetWindow()->GetWidth();
@@ -35,16 +35,19 @@
 #include "Graphics/GraphicTypes.h"
 #include "Graphics/Label.h"
 #include "Graphics/Polygon.h"
+#include "Graphics/PrimitiveBatch.h"
 #include "Graphics/RenderTarget.h"
 #include "Graphics/Shader.h"
 #include "Graphics/Sprite.h"
 #include "Graphics/SpriteAtlas.h"
 #include "Graphics/SpriteBatch.h"
+#include "Graphics/StaticLayer.h"
 #include "Graphics/Texture.h"
 #include "Graphics/VertexData.h"
 #include "Input/Keyboard.h"
 #include "Input/Mouse.h"
 #include "IO/File.h"
+#include "Math/AffineMatrix.h"
 #include "Math/Math.h"
 #include "Math/Matrix.h"
 #include "Math/Rotation.h"
@@ -76,11 +79,20 @@
 #define WINDOW_HEIGHT 768
 #define WINDOW_IS_FULLSCREEN false
 #define BACKGROUND_CLEAR_COLOR Color::CornflowerBlueColor()
+#define GRAPHICS_BACKEND GraphicsBackend_OpenGL
 #define DEBUG_DRAW_FPS 1
 #define DEBUG_DRAW_DELTA_TIME 0
 #define DEBUG_DRAW_ELAPSED_TIME 0
 #define DEBUG_DRAW_ALLOCATED_TEXTURE_MEMORY 0
+#define DEBUG_DRAW_UNIFORM_UPLOADS 0
+#define DEBUG_DRAW_UPLOADED_BYTES 0
 #define DEBUG_DRAW_SPRITE_RECT 0
+#define DEBUG_DRAW_CULLED_DRAWABLES 0
+#define DEBUG_DRAW_PHYSICS_BODY_COUNT 0
+#define DEBUG_DRAW_PHYSICS_AWAKE_BODY_COUNT 0
+#define DEBUG_DRAW_PHYSICS_PAIR_COUNT 0
+#define DEBUG_DRAW_PHYSICS_CULLED_PAIR_COUNT 0
+#define DEBUG_DRAW_PHYSICS_STEP_TIME 0
 #define THROW_EXCEPTION_ON_ERROR 1
 #define LOG_TO_FILE 0
 
@@ -102,7 +114,14 @@ namespace GameDev2D
     // 4. The fourth function, is an draw function, that has a return type of void and takes zero parameters, the draw 
     //   function is called once a frame, you should perform ALL rendering and ONLY rendering in the draw function.
     //   Drawing anything outside of the draw function will not work.
-    void Run(std::function<void()> initCallback, std::function<void()> shutdownCallback, std::function<void(double)> updateCallback, std::function<void()> drawCallback);
+    //
+    // The last parameter is optional, it's the GraphicsBackend used to render the game, it defaults to GRAPHICS_BACKEND.
+    void Run(std::function<void()> initCallback, std::function<void()> shutdownCallback, std::function<void(double)> updateCallback, std::function<void()> drawCallback, GraphicsBackend graphicsBackend = GRAPHICS_BACKEND);
+
+
+    // Returns the GraphicsBackend requested on the command line, -headless selects the headless backend,
+    // otherwise GRAPHICS_BACKEND is returned
+    GraphicsBackend GetGraphicsBackend(const std::string& commandLine);
 
 
     // Returns the width of the Window
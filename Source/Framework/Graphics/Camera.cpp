@@ -8,6 +8,8 @@ namespace GameDev2D
 {
     Camera::Camera() : Transformable(),
         m_ProjectionMatrix(Matrix::Identity()),
+        m_InverseTransform(AffineMatrix::Identity()),
+        m_InverseTransformVersion(0),
         m_Viewport(0, 0),
         m_ClipNear(-1.0f),
         m_ClipFar(1.0f),
@@ -51,9 +53,17 @@ namespace GameDev2D
         return m_ProjectionMatrix;
     }
     
-    Matrix Camera::GetViewMatrix()
+    AffineMatrix Camera::GetViewMatrix()
     {
-        Matrix viewMatrix = GetTransformMatrix().GetInverse();
+        //Only invert the transform matrix when it has changed, the view matrix is requested for every draw call
+        const AffineMatrix& transform = GetTransformMatrix();
+        if (m_InverseTransformVersion != m_Version)
+        {
+            m_InverseTransform = transform.GetInverse();
+            m_InverseTransformVersion = m_Version;
+        }
+
+        AffineMatrix viewMatrix = m_InverseTransform;
         viewMatrix.SetTranslation(viewMatrix.GetTranslation() + m_ShakeOffset);
         return viewMatrix;
     }
@@ -78,6 +88,34 @@ namespace GameDev2D
         return m_Viewport;
     }
 
+    Rect Camera::GetVisibleBounds()
+    {
+        //The view matrix is the inverse transform plus the shake offset, so the visible corners in world space
+        //are the viewport's corners, minus the shake offset, transformed by the Camera's transform
+        float halfWidth = (float)m_Viewport.width * 0.5f;
+        float halfHeight = (float)m_Viewport.height * 0.5f;
+        Vector2 corners[4] =
+        {
+            Vector2(-halfWidth, -halfHeight) - m_ShakeOffset,
+            Vector2(halfWidth, -halfHeight) - m_ShakeOffset,
+            Vector2(halfWidth, halfHeight) - m_ShakeOffset,
+            Vector2(-halfWidth, halfHeight) - m_ShakeOffset
+        };
+        GetTransformMatrix().Transform(corners, corners, 4);
+
+        //The visible bounds enclose all four corners
+        Vector2 lower = corners[0];
+        Vector2 upper = corners[0];
+        for (unsigned int i = 1; i < 4; i++)
+        {
+            lower.x = fminf(lower.x, corners[i].x);
+            lower.y = fminf(lower.y, corners[i].y);
+            upper.x = fmaxf(upper.x, corners[i].x);
+            upper.y = fmaxf(upper.y, corners[i].y);
+        }
+        return Rect(lower, upper - lower);
+    }
+
     void Camera::SetDepthClip(float aNear, float aFar)
     {
         m_ClipNear = aNear;
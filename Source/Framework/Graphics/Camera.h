@@ -3,6 +3,7 @@
 
 #include "GraphicTypes.h"
 #include "../Core/Transformable.h"
+#include "../Math/AffineMatrix.h"
 #include "../Math/Matrix.h"
 
 
@@ -18,7 +19,7 @@ namespace GameDev2D
 
         //Getter methods for the projection and view matrices
         Matrix GetProjectionMatrix();
-        Matrix GetViewMatrix();
+        AffineMatrix GetViewMatrix();
 
         //Set's the width and height of the camera's view
         void SetViewport(const Viewport& viewport);
@@ -26,6 +27,10 @@ namespace GameDev2D
         //Returns the width and height of the Camera's view
         Viewport GetViewport();
 
+        //Returns the axis aligned world space rect the Camera can see, it accounts for the Camera's
+        //position, rotation, zoom (scale) and shake
+        Rect GetVisibleBounds();
+
         //Sets the Z-clipping values
         void SetDepthClip(float near, float far);
 
@@ -45,6 +50,8 @@ namespace GameDev2D
 
         //Member variables
         Matrix m_ProjectionMatrix;
+        AffineMatrix m_InverseTransform;
+        unsigned int m_InverseTransformVersion;
         Viewport m_Viewport;
         float m_ClipNear;
         float m_ClipFar;
@@ -80,4 +80,9 @@ namespace GameDev2D
     {
         return m_GlyphData[aCharacter].bearingY;
     }
+
+    const GlyphData& Font::GetGlyphData(char aCharacter)
+    {
+        return m_GlyphData[aCharacter];
+    }
 }
\ No newline at end of file
@@ -39,6 +39,9 @@ namespace GameDev2D
         char GetBearingXForCharacter(char character);
         char GetBearingYForCharacter(char character);
 
+        //Returns all the glyph data for a given character with one lookup, used when laying out text
+        const GlyphData& GetGlyphData(char character);
+
     private:
         //Member variables
         Texture* m_Texture;
@@ -0,0 +1,125 @@
+#include "FontLayoutCache.h"
+#include "Font.h"
+#include "VertexFormat.h"
+#include "../Utils/Text/Text.h"
+
+
+namespace GameDev2D
+{
+    FontLayoutCache::FontLayoutCache() :
+        m_Entries(),
+        m_HitCount(0),
+        m_MissCount(0)
+    {
+
+    }
+
+    FontLayoutCache::~FontLayoutCache()
+    {
+        Clear();
+    }
+
+    const std::vector<SpriteVertex>& FontLayoutCache::GetVertices(Font* aFont, const std::string& aText, Vector2 aPosition, Color aColor)
+    {
+        //Find the entry, laying out the text if it's a new one. The color is packed for the key, the same as it is in the vertices
+        unsigned int color = PackColor(aColor);
+        std::map<Key, Entry>::iterator iterator = m_Entries.find(Key(aFont, aText, color));
+        bool isNew = iterator == m_Entries.end();
+        if (isNew == true)
+        {
+            iterator = m_Entries.insert(std::make_pair(Key(aFont, aText, color), Entry())).first;
+            BuildLayout(aFont, aText, aColor, iterator->second.localVertices);
+            iterator->second.vertices = iterator->second.localVertices;
+            m_MissCount++;
+        }
+        else
+        {
+            m_HitCount++;
+        }
+
+        //Translate the quads, only if the text has moved since they were last translated
+        Entry& entry = iterator->second;
+        if (isNew == true || entry.position != aPosition)
+        {
+            for (unsigned int i = 0; i < entry.localVertices.size(); i++)
+            {
+                entry.vertices[i].x = entry.localVertices[i].x + aPosition.x;
+                entry.vertices[i].y = entry.localVertices[i].y + aPosition.y;
+            }
+            entry.position = aPosition;
+        }
+
+        entry.isUsed = true;
+        return entry.vertices;
+    }
+
+    void FontLayoutCache::EndFrame()
+    {
+        for (std::map<Key, Entry>::iterator iterator = m_Entries.begin(); iterator != m_Entries.end();)
+        {
+            if (iterator->second.isUsed == false)
+            {
+                iterator = m_Entries.erase(iterator);
+            }
+            else
+            {
+                iterator->second.isUsed = false;
+                ++iterator;
+            }
+        }
+    }
+
+    void FontLayoutCache::Clear()
+    {
+        m_Entries.clear();
+    }
+
+    unsigned int FontLayoutCache::GetCount()
+    {
+        return (unsigned int)m_Entries.size();
+    }
+
+    unsigned int FontLayoutCache::GetHitCount()
+    {
+        return m_HitCount;
+    }
+
+    unsigned int FontLayoutCache::GetMissCount()
+    {
+        return m_MissCount;
+    }
+
+    void FontLayoutCache::BuildLayout(Font* aFont, const std::string& aText, const Color& aColor, std::vector<SpriteVertex>& aVertices)
+    {
+        //calculate the baseline and origin for the text
+        unsigned int baseline = aFont->GetLineHeight() - aFont->GetBaseLine();
+        unsigned int numberOfLines = Text::NumberOfLines(aText);
+        Vector2 textureSize = Vector2((float)aFont->GetTexture()->GetWidth(), (float)aFont->GetTexture()->GetHeight());
+        Vector2 origin(0.0f, (float)baseline + (aFont->GetLineHeight() * (numberOfLines - 1)));
+
+        //Cycle through the characters in the text
+        for (unsigned int i = 0; i < aText.length(); i++)
+        {
+            //Did we reach a new line?
+            if (aText.at(i) == '\n')
+            {
+                origin.x = 0.0f;
+                origin.y -= aFont->GetLineHeight();
+                continue;
+            }
+
+            //Calculate the character position based on the x and y bearing
+            const GlyphData& glyph = aFont->GetGlyphData(aText.at(i));
+            Vector2 charPosition = origin;
+            charPosition.x += glyph.bearingX;
+            charPosition.y += glyph.bearingY - glyph.frame.size.y;
+
+            //Build the character's quad
+            aVertices.resize(aVertices.size() + SPRITE_BATCH_VERTICES_PER_SPRITE);
+            PackSpriteVertices(&aVertices[aVertices.size() - SPRITE_BATCH_VERTICES_PER_SPRITE], textureSize, AffineMatrix::Make(charPosition, 0.0f), aColor, Vector2(0.0f, 0.0f), glyph.frame);
+
+            //Increment the origin
+            origin.x += glyph.advanceX;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef __GameDev2D__FontLayoutCache__
+#define __GameDev2D__FontLayoutCache__
+
+#include "SpriteBatch.h"
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class Font;
+
+    //Caches the glyph quads for text drawn through Graphics::DrawFont(), so the same string drawn every frame is only
+    //laid out once. Each entry is keyed by the Font, the text and the color, the quads are laid out at the origin and only
+    //re-translated when the position changes. Entries that weren't drawn in a frame are removed in EndFrame()
+    class FontLayoutCache
+    {
+    public:
+        FontLayoutCache();
+        ~FontLayoutCache();
+
+        //Returns the world space vertices for the text, laying it out if it isn't in the cache. The number of
+        //sprites is the number of vertices divided by SPRITE_BATCH_VERTICES_PER_SPRITE
+        const std::vector<SpriteVertex>& GetVertices(Font* font, const std::string& text, Vector2 position, Color color);
+
+        //Removes the entries that weren't used since the last EndFrame() call
+        void EndFrame();
+
+        //Removes all the entries
+        void Clear();
+
+        //Returns the number of entries in the cache
+        unsigned int GetCount();
+
+        //Returns the number of GetVertices() calls that found the text in the cache, and the number that had to lay it out
+        unsigned int GetHitCount();
+        unsigned int GetMissCount();
+
+    private:
+        //Lays out the text's glyph quads at the origin
+        void BuildLayout(Font* font, const std::string& text, const Color& color, std::vector<SpriteVertex>& vertices);
+
+        //The key for a cached layout
+        struct Key
+        {
+            Key(Font* font, const std::string& text, unsigned int color) :
+                font(font),
+                text(text),
+                color(color)
+            {}
+
+            bool operator<(const Key& key) const
+            {
+                if (font != key.font)
+                {
+                    return font < key.font;
+                }
+                if (color != key.color)
+                {
+                    return color < key.color;
+                }
+                return text < key.text;
+            }
+
+            Font* font;
+            std::string text;
+            unsigned int color;
+        };
+
+        //A cached layout
+        struct Entry
+        {
+            Entry() :
+                localVertices(),
+                vertices(),
+                position(0.0f, 0.0f),
+                isUsed(false)
+            {}
+
+            std::vector<SpriteVertex> localVertices;
+            std::vector<SpriteVertex> vertices;
+            Vector2 position;
+            bool isUsed;
+        };
+
+        //Member variables
+        std::map<Key, Entry> m_Entries;
+        unsigned int m_HitCount;
+        unsigned int m_MissCount;
+    };
+}
+
+#endif
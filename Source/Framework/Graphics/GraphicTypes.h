@@ -4,6 +4,7 @@
 #include "../Math/Vector2.h"
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace GameDev2D
@@ -11,6 +12,15 @@ namespace GameDev2D
     //Forward declarations
     class Texture;
 
+    //The backend the Graphics service renders with, it's selected at startup (passed to GameDev2D::Run(), the -headless
+    //command line option selects the headless backend, otherwise GRAPHICS_BACKEND in GameDev2D.h is used). The headless
+    //backend records the graphics commands instead of calling OpenGL, so it runs without a GPU
+    enum GraphicsBackend
+    {
+        GraphicsBackend_OpenGL = 0,
+        GraphicsBackend_Headless
+    };
+
     enum GraphicType
     {
         GraphicType_Byte = 0,
@@ -20,7 +30,8 @@ namespace GameDev2D
         GraphicType_Int,
         GraphicType_UnsignedInt,
         GraphicType_Float,
-        GraphicType_Double
+        GraphicType_Double,
+        GraphicType_HalfFloat      //16-bit float, see PackHalfFloat()
     };
 
     enum RenderMode
@@ -66,6 +77,16 @@ namespace GameDev2D
             this->destination = destination;
         }
 
+        bool operator==(const BlendingMode& blendingMode) const
+        {
+            return source == blendingMode.source && destination == blendingMode.destination;
+        }
+
+        bool operator!=(const BlendingMode& blendingMode) const
+        {
+            return source != blendingMode.source || destination != blendingMode.destination;
+        }
+
         //Member variables
         BlendingFactor source;
         BlendingFactor destination;
@@ -182,6 +203,13 @@ namespace GameDev2D
 
         }
 
+        //Returns true if the two rects overlap (touching edges count as overlapping)
+        bool Overlaps(const Rect& rect) const
+        {
+            return origin.x <= rect.origin.x + rect.size.x && origin.x + size.x >= rect.origin.x &&
+                   origin.y <= rect.origin.y + rect.size.y && origin.y + size.y >= rect.origin.y;
+        }
+
         Vector2 origin;
         Vector2 size;
     };
@@ -264,15 +292,19 @@ namespace GameDev2D
         VertexBufferDescriptor() :
             size(0),
             capacity(0),
-            usage(BufferUsage_DynamicDraw)
+            usage(BufferUsage_DynamicDraw),
+            isRingBuffer(false)
         {
         }
 
         std::vector<int> attributeIndex;
         std::vector<unsigned int> attributeSize;
-        unsigned int size;
+        std::vector<GraphicType> attributeType;         //Optional, every attribute is a float if it's empty. Integer types are normalized
+        std::vector<unsigned int> attributeDivisor;     //Optional, every attribute advances per vertex if it's empty. One advances it per instance
+        unsigned int size;                              //The vertex size, in floats (4 bytes). Compact attribute types pack several components into one float, the last attribute can be padded up to a whole float
         unsigned int capacity;
         BufferUsage usage;
+        bool isRingBuffer;                              //Optional, dynamic buffers only. Streams the uploads through VERTEX_BUFFER_RING_SIZE full buffers, for shared buffers flushed several times a frame
     };
 
     struct IndexBufferDescriptor
@@ -14,20 +14,21 @@ namespace GameDev2D
         m_Justification(JustifyLeft),
         m_Text(""),
         m_Size(Vector2(0.0f, 0.0f)),
-        m_CharacterSpacing(0.0f)
+        m_CharacterSpacing(0.0f),
+        m_Vertices(),
+        m_LocalPositions(),
+        m_Positions(),
+        m_LayoutAnchor(Vector2(0.0f, 0.0f)),
+        m_LayoutTransformVersion(0),
+        m_LayoutVersion(0),
+        m_IsLayoutDirty(true)
     {
-        //Create the SpriteBatch
-        m_SpriteBatch = new SpriteBatch();
+
     }
 
     Label::~Label()
     {
-        //Delete the SpriteBatch
-        if (m_SpriteBatch != nullptr)
-        {
-            delete m_SpriteBatch;
-            m_SpriteBatch = nullptr;
-        }
+
     }
 
     void Label::Draw()
@@ -38,78 +39,54 @@ namespace GameDev2D
             return;
         }
 
-        //calculate the baseline and origin for the label
-        unsigned int baseline = m_Font->GetLineHeight() - m_Font->GetBaseLine();
-        unsigned int numberOfLines = Text::NumberOfLines(m_Text);
-        Vector2 origin = Vector2(0.0f, 0.0f);
-        Vector2 position = Vector2(0.0f, 0.0f);
-        position.y += baseline + (m_Font->GetLineHeight() * (numberOfLines - 1));
-        int lineIndex = 0;
-
-        //What justification are we dealing with
-        if (m_Justification == JustifyLeft)
+        //Is the Label on-screen?
+        if (Services::GetGraphics()->IsVisible(this) == false)
         {
-            position.x = 0.0f;
-        }
-        else if (m_Justification == JustifyCenter)
-        {
-            position.x = (GetWidth() - m_LineWidth.at(lineIndex)) * 0.5f;
+            return;
         }
-        else if (m_Justification == JustifyRight)
+
+        //Rebuild the glyph quads if the layout has changed, the anchor is baked into them as well
+        bool wasRebuilt = false;
+        if (m_IsLayoutDirty == true || m_LayoutAnchor != GetAnchor())
         {
-            position.x = GetWidth() - m_LineWidth.at(lineIndex);
+            BuildLayout();
+            wasRebuilt = true;
         }
 
-        //Begin the SpriteBatch
-        m_SpriteBatch->Begin();
-
-        //Cycle through the characters in the text label
-        for (unsigned int i = 0; i < m_Text.length(); i++)
+        //Move the glyph quads into world space, only if the Label (or one of its parents) has moved since they were last transformed
+        unsigned int transformVersion = GetTransformVersion();
+        if (wasRebuilt == true || m_LayoutTransformVersion != transformVersion)
         {
-            //Did we reach a new line?
-            if (m_Text.at(i) == '\n')
+            //The positions are kept in their own array so AffineMatrix::Transform() can do two at a time with SSE
+            GetTransformMatrix().Transform(m_LocalPositions.data(), m_Positions.data(), (unsigned int)m_LocalPositions.size());
+            for (unsigned int i = 0; i < m_Positions.size(); i++)
             {
-                //Increment the line index
-                lineIndex++;
-
-                //Calculate the line's origin based on the justification
-                if (m_Justification == JustifyLeft)
-                {
-                    position.x = 0.0f;
-                }
-                else if (m_Justification == JustifyCenter)
-                {
-                    position.x = (GetWidth() - m_LineWidth.at(lineIndex)) * 0.5f;
-                }
-                else if (m_Justification == JustifyRight)
-                {
-                    position.x = GetWidth() - m_LineWidth.at(lineIndex);
-                }
-
-                //Set the y line origin based on the line height of the font
-                position.y -= m_Font->GetLineHeight();
-                continue;
+                m_Vertices[i].x = m_Positions[i].x;
+                m_Vertices[i].y = m_Positions[i].y;
             }
-            //Calculate the character position based on the x and y bearing
-            Rect characterRect = m_Font->GetTextureRectForCharacter(m_Text.at(i));
-            Vector2 anchorOffset = Vector2(-GetWidth() * GetAnchor().x, -GetHeight() * GetAnchor().y);
-            Vector2 charPosition = position + anchorOffset;
-            charPosition.x += m_Font->GetBearingXForCharacter(m_Text.at(i));
-            charPosition.y += m_Font->GetBearingYForCharacter(m_Text.at(i)) - characterRect.size.y;
+            m_LayoutTransformVersion = transformVersion;
+        }
 
-            //Calculate the Matrix
-            Matrix parent = GetTransformMatrix();
-            Matrix matrix = Matrix::Make(charPosition, m_CharacterData.at(i).angle, m_CharacterData.at(i).scale);
+        //Add all the characters to the frame's SpriteBatch as one block
+        Services::GetGraphics()->DrawSpriteVertices(m_Font->GetTexture(), m_Vertices.data(), (unsigned int)(m_Vertices.size() / SPRITE_BATCH_VERTICES_PER_SPRITE));
+    }
 
-            //Draw each character
-            m_SpriteBatch->Draw(m_Font->GetTexture(), parent * matrix, m_CharacterData.at(i).color, m_CharacterData.at(i).anchor, characterRect);
+    void Label::SetFont(Font* aFont)
+    {
+        if (m_Font != aFont)
+        {
+            //Set the font
+            m_Font = aFont;
 
-            //Increment the position
-            position.x += m_Font->GetAdvanceXForCharacter(m_Text.at(i)) + GetCharacterSpacing();
+            //Re-calculate the size and rebuild the layout
+            CalculateSize();
+            m_IsLayoutDirty = true;
         }
+    }
 
-        //End the SpriteBatch
-        m_SpriteBatch->End();
+    Font* Label::GetFont()
+    {
+        return m_Font;
     }
 
     float Label::GetWidth()
@@ -139,8 +116,9 @@ namespace GameDev2D
                 m_CharacterData.push_back(CharacterData(GetColor()));
             }
 
-            //Re-calculate the size
+            //Re-calculate the size and rebuild the layout
             CalculateSize();
+            m_IsLayoutDirty = true;
         }
     }
 
@@ -156,8 +134,9 @@ namespace GameDev2D
             //Set the character spacing
             m_CharacterSpacing = aCharacterSpacing;
 
-            //Re-calculate the size
+            //Re-calculate the size and rebuild the layout
             CalculateSize();
+            m_IsLayoutDirty = true;
         }
     }
 
@@ -171,8 +150,9 @@ namespace GameDev2D
         //Safety check that the justification isn't already set
         if (aJustification != m_Justification)
         {
-            //Set the justification
+            //Set the justification and rebuild the layout
             m_Justification = aJustification;
+            m_IsLayoutDirty = true;
         }
     }
 
@@ -228,8 +208,99 @@ namespace GameDev2D
         m_Size = maxSize;
     }
 
+    void Label::BuildLayout()
+    {
+        //Clear the vertices, the capacity is kept so re-layouts don't reallocate
+        m_Vertices.clear();
+
+        //calculate the baseline and origin for the label
+        unsigned int baseline = m_Font->GetLineHeight() - m_Font->GetBaseLine();
+        unsigned int numberOfLines = Text::NumberOfLines(m_Text);
+        Vector2 textureSize = Vector2((float)m_Font->GetTexture()->GetWidth(), (float)m_Font->GetTexture()->GetHeight());
+        Vector2 anchorOffset = Vector2(-GetWidth() * GetAnchor().x, -GetHeight() * GetAnchor().y);
+        Vector2 position = Vector2(0.0f, 0.0f);
+        position.y += baseline + (m_Font->GetLineHeight() * (numberOfLines - 1));
+        int lineIndex = 0;
+
+        //What justification are we dealing with
+        if (m_Justification == JustifyLeft)
+        {
+            position.x = 0.0f;
+        }
+        else if (m_Justification == JustifyCenter)
+        {
+            position.x = (GetWidth() - m_LineWidth.at(lineIndex)) * 0.5f;
+        }
+        else if (m_Justification == JustifyRight)
+        {
+            position.x = GetWidth() - m_LineWidth.at(lineIndex);
+        }
+
+        //Cycle through the characters in the text label
+        for (unsigned int i = 0; i < m_Text.length(); i++)
+        {
+            //Did we reach a new line?
+            if (m_Text.at(i) == '\n')
+            {
+                //Increment the line index
+                lineIndex++;
+
+                //Calculate the line's origin based on the justification
+                if (m_Justification == JustifyLeft)
+                {
+                    position.x = 0.0f;
+                }
+                else if (m_Justification == JustifyCenter)
+                {
+                    position.x = (GetWidth() - m_LineWidth.at(lineIndex)) * 0.5f;
+                }
+                else if (m_Justification == JustifyRight)
+                {
+                    position.x = GetWidth() - m_LineWidth.at(lineIndex);
+                }
+
+                //Set the y line origin based on the line height of the font
+                position.y -= m_Font->GetLineHeight();
+                continue;
+            }
+
+            //Calculate the character position based on the x and y bearing
+            const GlyphData& glyph = m_Font->GetGlyphData(m_Text.at(i));
+            Vector2 charPosition = position + anchorOffset;
+            charPosition.x += glyph.bearingX;
+            charPosition.y += glyph.bearingY - glyph.frame.size.y;
+
+            //Build the character's quad, relative to the Label
+            const CharacterData& characterData = m_CharacterData.at(i);
+            AffineMatrix matrix = AffineMatrix::Make(charPosition, characterData.angle, characterData.scale);
+            m_Vertices.resize(m_Vertices.size() + SPRITE_BATCH_VERTICES_PER_SPRITE);
+            PackSpriteVertices(&m_Vertices[m_Vertices.size() - SPRITE_BATCH_VERTICES_PER_SPRITE], textureSize, matrix, characterData.color, characterData.anchor, glyph.frame);
+
+            //Increment the position
+            position.x += glyph.advanceX + GetCharacterSpacing();
+        }
+
+        //The vertices were packed relative to the Label, keep their positions so Draw() can move them into world space
+        m_LocalPositions.resize(m_Vertices.size());
+        m_Positions.resize(m_Vertices.size());
+        for (unsigned int i = 0; i < m_Vertices.size(); i++)
+        {
+            m_LocalPositions[i] = Vector2(m_Vertices[i].x, m_Vertices[i].y);
+        }
+        m_LayoutAnchor = GetAnchor();
+        m_LayoutVersion++;
+        m_IsLayoutDirty = false;
+    }
+
     std::vector<Label::CharacterData>& Label::GetCharacterData()
     {
+        //The caller can modify the data through the reference, so the layout has to be rebuilt
+        m_IsLayoutDirty = true;
         return m_CharacterData;
     }
+
+    unsigned int Label::GetLayoutVersion()
+    {
+        return m_LayoutVersion;
+    }
 }
\ No newline at end of file
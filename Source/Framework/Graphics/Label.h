@@ -2,6 +2,7 @@
 #define __GameDev2D__Label__
 
 #include "../Core/Drawable.h"
+#include "SpriteBatch.h"
 #include <string>
 #include <vector>
 
@@ -10,9 +11,11 @@ namespace GameDev2D
 {
     //Forward declarations
     class Font;
-    class SpriteBatch;
 
-    //Creates a label from a .ttf or .otf font file. The label can be transform (translated, rotatated, scaled)
+    //Creates a label from a .ttf or .otf font file. The label can be transform (translated, rotatated, scaled). The glyph
+    //quads are laid out once when the text, font, spacing or justification changes and kept as a block of vertices, static
+    //text is drawn with a single copy and moving text only re-transforms the cached quads. The block is added to the
+    //Graphics service's frame SpriteBatch, so labels share draw calls with the sprites around them
     class Label : public Drawable
     {
     public:
@@ -23,6 +26,12 @@ namespace GameDev2D
         //Draws the Label
         void Draw();
 
+        //Sets the Font the Label uses to display its text
+        void SetFont(Font* font);
+
+        //Returns the Font the Label uses
+        Font* GetFont();
+
         //Returns the size of the label
         float GetWidth();
         float GetHeight();
@@ -83,22 +92,35 @@ namespace GameDev2D
             float angle;
         };
 
-        //Returns a reference to the CharacterData so that you can modify each character's data individually
+        //Returns a reference to the CharacterData so that you can modify each character's data individually,
+        //calling this marks the layout as dirty, it will be rebuilt the next time the Label is drawn
         std::vector<CharacterData>& GetCharacterData();
 
+        //Returns the number of times the glyph quads have been laid out, it only changes when Draw() rebuilds the layout
+        unsigned int GetLayoutVersion();
+
     protected:
         //Conveniance method to calculate the size of the Label, based on the text
         void CalculateSize();
-        
+
+        //Builds the glyph quads relative to the Label, called from Draw() when the layout is dirty
+        void BuildLayout();
+
         //Member variables
         Font* m_Font;
-        SpriteBatch* m_SpriteBatch;
         std::string m_Text;
         std::vector<float> m_LineWidth;
         std::vector<CharacterData> m_CharacterData;
         Vector2 m_Size;
         Justification m_Justification;
         float m_CharacterSpacing;
+        std::vector<SpriteVertex> m_Vertices;
+        std::vector<Vector2> m_LocalPositions;
+        std::vector<Vector2> m_Positions;
+        Vector2 m_LayoutAnchor;
+        unsigned int m_LayoutTransformVersion;
+        unsigned int m_LayoutVersion;
+        bool m_IsLayoutDirty;
     };
 }
 
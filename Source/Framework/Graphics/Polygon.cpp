@@ -49,22 +49,29 @@ namespace GameDev2D
 
     Polygon::Polygon() : Drawable(),
         m_VertexData(nullptr),
+        m_AnchorUniform(SHADER_INVALID_UNIFORM),
+        m_SizeUniform(SHADER_INVALID_UNIFORM),
+        m_ModelUniform(SHADER_INVALID_UNIFORM),
+        m_ViewUniform(SHADER_INVALID_UNIFORM),
+        m_ProjectionUniform(SHADER_INVALID_UNIFORM),
         m_RenderMode(RenderMode_LineLoop),
         m_BlendingMode(BlendingMode()),
         m_Size(0.0f, 0.0f),
+        m_Origin(0.0f, 0.0f),
         m_EnableBlending(false)
     {
         //Initialize the Shader
-        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+        SetShader(Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY));
 
         //Initialize the Polygon's VertexBuffer VertexDescriptor, it describes
         //how the individual vertices will be stored in the VertexBuffer
         VertexBufferDescriptor descriptor;
-        descriptor.size = Vertex::vertexSize;
+        descriptor.size = sizeof(Vertex) / sizeof(float);
         descriptor.capacity = POLYGON_MAX_VERTICES;
         descriptor.usage = BufferUsage_DynamicDraw;
         descriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_color") };
         descriptor.attributeSize = { 2, 4 };
+        descriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedByte };
 
         //Create the vertex DataBuffer
         m_VertexData = new VertexData();
@@ -94,15 +101,21 @@ namespace GameDev2D
         //Cache the graphics service
         Graphics* graphics = Services::GetGraphics();
 
+        //Is the Polygon on-screen?
+        if (graphics->IsVisible(this) == false)
+        {
+            return;
+        }
+
         //Bind the vertex array object
         m_VertexData->PrepareForDraw();
 
         //Setup the shader uniforms
-        m_Shader->SetUniformVector2("uniform_anchor", GetAnchor());
-        m_Shader->SetUniformVector2("uniform_size", Vector2(GetWidth(), GetHeight()));
-        m_Shader->SetUniformMatrix("uniform_model", GetTransformMatrix());
-        m_Shader->SetUniformMatrix("uniform_view", graphics->GetViewMatrix());
-        m_Shader->SetUniformMatrix("uniform_projection", graphics->GetProjectionMatrix());
+        m_Shader->SetUniformVector2(m_AnchorUniform, GetAnchor());
+        m_Shader->SetUniformVector2(m_SizeUniform, Vector2(GetWidth(), GetHeight()));
+        m_Shader->SetUniformMatrix(m_ModelUniform, GetTransformMatrix());
+        m_Shader->SetUniformMatrix(m_ViewUniform, graphics->GetViewMatrix());
+        m_Shader->SetUniformMatrix(m_ProjectionUniform, graphics->GetProjectionMatrix());
 
         //Validate the shader, return if it fails
         if (m_Shader->Validate() == false)
@@ -126,6 +139,18 @@ namespace GameDev2D
         }
     }
 
+    void Polygon::SetShader(Shader* aShader)
+    {
+        m_Shader = aShader;
+
+        //Look up the uniform handles once, Draw() sets the uniforms with them
+        m_AnchorUniform = m_Shader->GetUniformHandle("uniform_anchor");
+        m_SizeUniform = m_Shader->GetUniformHandle("uniform_size");
+        m_ModelUniform = m_Shader->GetUniformHandle("uniform_model");
+        m_ViewUniform = m_Shader->GetUniformHandle("uniform_view");
+        m_ProjectionUniform = m_Shader->GetUniformHandle("uniform_projection");
+    }
+
     float Polygon::GetWidth()
     {
         return m_Size.x;
@@ -136,6 +161,12 @@ namespace GameDev2D
         return m_Size.y;
     }
 
+    Rect Polygon::GetLocalBounds()
+    {
+        //The shader offsets the vertices by the size multiplied by the anchor
+        return Rect(m_Origin - Vector2(m_Size.x * GetAnchor().x, m_Size.y * GetAnchor().y), m_Size);
+    }
+
     void Polygon::AddVertex(float aX, float aY)
     {
         AddVertex(Vector2(aX, aY));
@@ -147,8 +178,7 @@ namespace GameDev2D
         m_Vertices.push_back(Vertex(aVertex, GetColor()));
 
         //Add the vertex to the VertexBuffer
-        float* data = m_Vertices.back().data;
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>(data, data + Vertex::vertexSize));
+        *m_VertexData->GetVertexBuffer()->Emit<Vertex>(1) = m_Vertices.back();
 
         //Do we need to enable blending
         if (GetColor().a != 1.0f)
@@ -220,8 +250,9 @@ namespace GameDev2D
             top = fmaxf(top, m_Vertices.at(i).GetPosition().y);
         }
 
-        //Set the width and height
+        //Set the width, height and origin
         m_Size.x = right - left;
         m_Size.y = top - bottom;
+        m_Origin = Vector2(left, bottom);
     }
 }
\ No newline at end of file
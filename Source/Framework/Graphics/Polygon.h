@@ -3,6 +3,7 @@
 
 #include "GraphicTypes.h"
 #include "VertexData.h"
+#include "VertexFormat.h"
 #include "../Core/Drawable.h"
 #include <vector>
 
@@ -29,11 +30,17 @@ namespace GameDev2D
         
         //Draws the polygon
         void Draw();
+
+        //Sets the Shader, the Shader's uniform handles are looked up again
+        void SetShader(Shader* shader);
         
         //Returns the width and height of the polygon
         float GetWidth();
         float GetHeight();
 
+        //Returns the bounds of the vertices, offset by the anchor
+        Rect GetLocalBounds();
+
         //Adds a vertex to the polygon, the vertex will be added and set to the active polygon color
         void AddVertex(float x, float y);
         void AddVertex(Vector2 vertex);
@@ -61,33 +68,35 @@ namespace GameDev2D
         //Used to calculate the size of the Polygon
         void CalculateSize();
 
-        //Struct to hold Vertex data
+        //Struct to hold Vertex data, it matches the in_vertices and in_color shader attributes. The color
+        //is four normalized bytes, so a vertex is 12 bytes
         struct Vertex
         {
         public:
-            Vertex(Vector2 position, Color color)
+            Vertex(Vector2 position, Color color) :
+                x(position.x), y(position.y),
+                color(PackColor(color))
             {
-                data[0] = position.x;
-                data[1] = position.y;
-                data[2] = color.r;
-                data[3] = color.g;
-                data[4] = color.b;
-                data[5] = color.a;
             }
 
-            Vector2 GetPosition() { return Vector2(data[0], data[1]); }
-            Color GetColor() { return Color(data[2], data[3], data[4], data[5]); }
+            Vector2 GetPosition() { return Vector2(x, y); }
 
-            const static unsigned int vertexSize = 6; //2 position, 4 color
-            float data[vertexSize];
+            float x, y;
+            unsigned int color;
         };
 
         //Member variables
         VertexData* m_VertexData;
+        UniformHandle m_AnchorUniform;
+        UniformHandle m_SizeUniform;
+        UniformHandle m_ModelUniform;
+        UniformHandle m_ViewUniform;
+        UniformHandle m_ProjectionUniform;
         std::vector<Vertex> m_Vertices;
         RenderMode m_RenderMode;
         BlendingMode m_BlendingMode;
         Vector2 m_Size;
+        Vector2 m_Origin;  //The lower left of the vertices
         bool m_EnableBlending;
     };
 }
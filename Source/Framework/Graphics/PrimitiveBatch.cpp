@@ -0,0 +1,273 @@
+#include "PrimitiveBatch.h"
+#include "../Services/Services.h"
+#include <assert.h>
+#include <math.h>
+
+
+namespace GameDev2D
+{
+    PrimitiveBatch::PrimitiveBatch() :
+        m_Shader(nullptr),
+        m_AnchorUniform(SHADER_INVALID_UNIFORM),
+        m_SizeUniform(SHADER_INVALID_UNIFORM),
+        m_ModelUniform(SHADER_INVALID_UNIFORM),
+        m_ViewUniform(SHADER_INVALID_UNIFORM),
+        m_ProjectionUniform(SHADER_INVALID_UNIFORM),
+        m_VertexData(nullptr),
+        m_ShapeCount(0),
+        m_DrawCallCount(0),
+        m_HasTranslucentColor(false),
+        m_Lock(false)
+    {
+        //Initialize the Shader
+        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+
+        //Look up the uniform handles once, Flush() sets the uniforms with them
+        m_AnchorUniform = m_Shader->GetUniformHandle("uniform_anchor");
+        m_SizeUniform = m_Shader->GetUniformHandle("uniform_size");
+        m_ModelUniform = m_Shader->GetUniformHandle("uniform_model");
+        m_ViewUniform = m_Shader->GetUniformHandle("uniform_view");
+        m_ProjectionUniform = m_Shader->GetUniformHandle("uniform_projection");
+
+        //Initialize the PrimitiveBatch's vertex DataBufferDescriptor, it describes
+        //how the individual 'elements' will be stored in the DataBuffer
+        VertexBufferDescriptor descriptor;
+        descriptor.size = sizeof(PrimitiveVertex) / sizeof(float);
+        descriptor.capacity = PRIMITIVE_BATCH_VERTEX_COUNT;
+        descriptor.usage = BufferUsage_DynamicDraw;
+        descriptor.isRingBuffer = true;
+        descriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_color") };
+        descriptor.attributeSize = { 2, 4 };
+        descriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedByte };
+
+        //Create the VertexData object, the filled shapes and the outlines share it
+        m_VertexData = new VertexData();
+        m_VertexData->CreateBuffer(descriptor);
+
+        //Build the unit circle table once, every circle is the table scaled by its radius
+        for (unsigned int i = 0; i < PRIMITIVE_BATCH_CIRCLE_SEGMENTS; i++)
+        {
+            float radians = (float)M_PI * 2.0f * (float)i / (float)PRIMITIVE_BATCH_CIRCLE_SEGMENTS;
+            m_UnitCircle[i] = Vector2(cosf(radians), sinf(radians));
+        }
+    }
+
+    PrimitiveBatch::~PrimitiveBatch()
+    {
+        if (m_VertexData != nullptr)
+        {
+            delete m_VertexData;
+            m_VertexData = nullptr;
+        }
+    }
+
+    void PrimitiveBatch::Begin()
+    {
+        //If this assert is hit, you are trying to draw to a PrimitiveBatch that has already had Begin() called BUT not End()
+        assert(m_Lock == false);
+
+        //Lock the PrimitiveBatch
+        m_Lock = true;
+
+        //Reset the stats
+        m_ShapeCount = 0;
+        m_DrawCallCount = 0;
+    }
+
+    void PrimitiveBatch::End()
+    {
+        //Flush the vertex data (draw to the screen)
+        Flush();
+
+        //Unlock the PrimitiveBatch
+        m_Lock = false;
+    }
+
+    void PrimitiveBatch::DrawRectangle(Vector2 aPosition, Vector2 aSize, float aAngle, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    {
+        DrawRectangle(AffineMatrix::Make(aPosition, aAngle), aSize, aAnchor, aColor, aIsFilled);
+    }
+
+    void PrimitiveBatch::DrawRectangle(const AffineMatrix& aTransformation, Vector2 aSize, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    {
+        //Transform the corners into world space in one batch, the rectangle is rotated around its anchor
+        Vector2 offset = aSize * aAnchor;
+        Vector2 corners[4] =
+        {
+            Vector2(0.0f, 0.0f) - offset,
+            Vector2(aSize.x, 0.0f) - offset,
+            Vector2(aSize.x, aSize.y) - offset,
+            Vector2(0.0f, aSize.y) - offset
+        };
+        aTransformation.Transform(corners, corners, 4);
+
+        //Pack the color once, it's shared by the vertices
+        unsigned int color = PackColor(aColor);
+
+        if (aIsFilled == true)
+        {
+            PrimitiveVertex* vertices = Emit(6, aColor);
+            vertices[0] = PrimitiveVertex(corners[0], color);
+            vertices[1] = PrimitiveVertex(corners[1], color);
+            vertices[2] = PrimitiveVertex(corners[2], color);
+            vertices[3] = PrimitiveVertex(corners[0], color);
+            vertices[4] = PrimitiveVertex(corners[2], color);
+            vertices[5] = PrimitiveVertex(corners[3], color);
+        }
+        else
+        {
+            PrimitiveVertex* vertices = Emit(4 * PRIMITIVE_BATCH_LINE_VERTICES, aColor);
+            for (unsigned int i = 0; i < 4; i++)
+            {
+                EmitLine(&vertices[i * PRIMITIVE_BATCH_LINE_VERTICES], corners[i], corners[(i + 1) % 4], color);
+            }
+        }
+
+        m_ShapeCount++;
+    }
+
+    void PrimitiveBatch::DrawCircle(Vector2 aPosition, float aRadius, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    {
+        //The circle fits in a square twice the radius in size, its bottom left corner is offset by the anchor
+        Vector2 center = aPosition + Vector2(aRadius, aRadius) - Vector2(aRadius * 2.0f, aRadius * 2.0f) * aAnchor;
+
+        //Scale the unit circle table, the points go clockwise starting from the left edge
+        Vector2 points[PRIMITIVE_BATCH_CIRCLE_SEGMENTS];
+        for (unsigned int i = 0; i < PRIMITIVE_BATCH_CIRCLE_SEGMENTS; i++)
+        {
+            points[i] = center - m_UnitCircle[i] * aRadius;
+        }
+
+        //Pack the color once, it's shared by the vertices
+        unsigned int color = PackColor(aColor);
+
+        if (aIsFilled == true)
+        {
+            //Fan the triangles out from the first point
+            const unsigned int triangles = PRIMITIVE_BATCH_CIRCLE_SEGMENTS - 2;
+            PrimitiveVertex* vertices = Emit(triangles * 3, aColor);
+            for (unsigned int i = 0; i < triangles; i++)
+            {
+                vertices[i * 3] = PrimitiveVertex(points[0], color);
+                vertices[i * 3 + 1] = PrimitiveVertex(points[i + 1], color);
+                vertices[i * 3 + 2] = PrimitiveVertex(points[i + 2], color);
+            }
+        }
+        else
+        {
+            PrimitiveVertex* vertices = Emit(PRIMITIVE_BATCH_CIRCLE_SEGMENTS * PRIMITIVE_BATCH_LINE_VERTICES, aColor);
+            for (unsigned int i = 0; i < PRIMITIVE_BATCH_CIRCLE_SEGMENTS; i++)
+            {
+                EmitLine(&vertices[i * PRIMITIVE_BATCH_LINE_VERTICES], points[i], points[(i + 1) % PRIMITIVE_BATCH_CIRCLE_SEGMENTS], color);
+            }
+        }
+
+        m_ShapeCount++;
+    }
+
+    void PrimitiveBatch::DrawLine(Vector2 aStartPoint, Vector2 aEndPoint, Color aColor)
+    {
+        unsigned int color = PackColor(aColor);
+        PrimitiveVertex* vertices = Emit(PRIMITIVE_BATCH_LINE_VERTICES, aColor);
+        EmitLine(vertices, aStartPoint, aEndPoint, color);
+        m_ShapeCount++;
+    }
+
+    unsigned int PrimitiveBatch::GetShapeCount()
+    {
+        return m_ShapeCount;
+    }
+
+    unsigned int PrimitiveBatch::GetDrawCallCount()
+    {
+        return m_DrawCallCount;
+    }
+
+    PrimitiveVertex* PrimitiveBatch::Emit(unsigned int aVertexCount, const Color& aColor)
+    {
+        //If this assert is hit, you are trying to draw to a PrimitiveBatch that hasn't had Begin() called
+        assert(m_Lock == true);
+
+        //Flush the batch if there isn't enough room left for the vertices
+        VertexBuffer* vertexBuffer = m_VertexData->GetVertexBuffer();
+        if (vertexBuffer->GetCount() + aVertexCount > vertexBuffer->GetCapacity())
+        {
+            Flush();
+        }
+
+        //Blending is needed if the color isn't opaque
+        if (aColor.a != 1.0f)
+        {
+            m_HasTranslucentColor = true;
+        }
+
+        return vertexBuffer->Emit<PrimitiveVertex>(aVertexCount);
+    }
+
+    void PrimitiveBatch::EmitLine(PrimitiveVertex* aVertices, Vector2 aStartPoint, Vector2 aEndPoint, unsigned int aColor)
+    {
+        //Offset the endpoints by half the line width on either side of the line
+        Vector2 direction = aEndPoint - aStartPoint;
+        float length = direction.Length();
+        Vector2 offset = Vector2(0.0f, 0.0f);
+        if (length > 0.0f)
+        {
+            offset = Vector2(-direction.y, direction.x) * (PRIMITIVE_BATCH_LINE_WIDTH * 0.5f / length);
+        }
+
+        aVertices[0] = PrimitiveVertex(aStartPoint + offset, aColor);
+        aVertices[1] = PrimitiveVertex(aStartPoint - offset, aColor);
+        aVertices[2] = PrimitiveVertex(aEndPoint - offset, aColor);
+        aVertices[3] = PrimitiveVertex(aStartPoint + offset, aColor);
+        aVertices[4] = PrimitiveVertex(aEndPoint - offset, aColor);
+        aVertices[5] = PrimitiveVertex(aEndPoint + offset, aColor);
+    }
+
+    void PrimitiveBatch::Flush()
+    {
+        //We can't draw anything if there isn't any vertices
+        unsigned int count = m_VertexData->GetVertexBuffer()->GetCount();
+        if (count == 0)
+        {
+            return;
+        }
+
+        //Cache the Graphics service
+        Graphics* graphics = Services::GetGraphics();
+
+        //Bind the vertex array object
+        m_VertexData->PrepareForDraw();
+
+        //Setup the shader uniforms, the vertices are already in world space
+        m_Shader->SetUniformVector2(m_AnchorUniform, Vector2(0.0f, 0.0f));
+        m_Shader->SetUniformVector2(m_SizeUniform, Vector2(0.0f, 0.0f));
+        m_Shader->SetUniformMatrix(m_ModelUniform, AffineMatrix::Identity());
+        m_Shader->SetUniformMatrix(m_ViewUniform, graphics->GetViewMatrix());
+        m_Shader->SetUniformMatrix(m_ProjectionUniform, graphics->GetProjectionMatrix());
+
+        //Validate the shader, only draw if it passes
+        if (m_Shader->Validate() == true)
+        {
+            //Enable blending if any of the shapes are translucent
+            if (m_HasTranslucentColor == true)
+            {
+                graphics->EnableBlending(BlendingMode());
+            }
+
+            //Draw the vertices
+            graphics->DrawArrays(RenderMode_Triangles, 0, count);
+            m_DrawCallCount++;
+
+            //Disable blending, if we did in fact have it enabled
+            if (m_HasTranslucentColor == true)
+            {
+                graphics->DisableBlending();
+            }
+        }
+
+        //This unbind's the vertex array, so its not accidently modified
+        m_VertexData->EndDraw();
+        m_VertexData->GetVertexBuffer()->ClearVertices();
+        m_HasTranslucentColor = false;
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef __GameDev2D__PrimitiveBatch__
+#define __GameDev2D__PrimitiveBatch__
+
+#include "GraphicTypes.h"
+#include "Color.h"
+#include "Shader.h"
+#include "VertexData.h"
+#include "VertexFormat.h"
+#include "../Math/AffineMatrix.h"
+#include "../Math/Vector2.h"
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int PRIMITIVE_BATCH_VERTEX_COUNT = 6144;     //Number of vertices per draw call, a multiple of 3 (triangles)
+    const unsigned int PRIMITIVE_BATCH_CIRCLE_SEGMENTS = 36;    //Number of points around a circle, one every 10 degrees
+    const unsigned int PRIMITIVE_BATCH_LINE_VERTICES = 6;       //Number of vertices per line, two triangles
+    const float PRIMITIVE_BATCH_LINE_WIDTH = 1.0f;              //The width of lines and outlines, in world units
+
+    //Vertex layout used by the PrimitiveBatch, it matches the in_vertices and in_color shader attributes. The color is
+    //four normalized bytes, so a vertex is 12 bytes
+    struct PrimitiveVertex
+    {
+        PrimitiveVertex() :
+            x(0.0f), y(0.0f),
+            color(0)
+        {
+        }
+
+        PrimitiveVertex(Vector2 position, unsigned int color) :
+            x(position.x), y(position.y),
+            color(color)
+        {
+        }
+
+        float x, y;
+        unsigned int color;
+    };
+
+    //PrimitiveBatch collects rectangles, circles and lines into a single triangle stream, the vertices are transformed
+    //into world space as they are added. Lines and outlines are added as thin quads, so filled shapes and outlines share
+    //the stream and are drawn in the order they were added, with one draw call until the stream is full
+    class PrimitiveBatch
+    {
+    public:
+        PrimitiveBatch();
+        ~PrimitiveBatch();
+
+        //Called when the PrimitiveBatch should begin it's rendering
+        void Begin();
+
+        //Called when the PrimitiveBatch is done rendering, will flush the contents of the Batch
+        void End();
+
+        //Adds a Rectangle at the supplied position and size, rotated around the anchor
+        void DrawRectangle(Vector2 position, Vector2 size, float angle, Vector2 anchor, Color color, bool isFilled);
+
+        //Adds a Rectangle of the supplied size, transformed by the AffineMatrix around the anchor
+        void DrawRectangle(const AffineMatrix& transformation, Vector2 size, Vector2 anchor, Color color, bool isFilled);
+
+        //Adds a Circle at the supplied position and radius
+        void DrawCircle(Vector2 position, float radius, Vector2 anchor, Color color, bool isFilled);
+
+        //Adds a Line between the supplied endpoints
+        void DrawLine(Vector2 startPoint, Vector2 endPoint, Color color);
+
+        //Returns the number of shapes drawn between the last Begin() and End() calls
+        unsigned int GetShapeCount();
+
+        //Returns the number of draw calls made between the last Begin() and End() calls
+        unsigned int GetDrawCallCount();
+
+    private:
+        //Returns where the vertices can be written, the batch is flushed first if there isn't enough room
+        PrimitiveVertex* Emit(unsigned int vertexCount, const Color& color);
+
+        //Writes a line as a quad (two triangles) into the vertices, PRIMITIVE_BATCH_LINE_VERTICES are written
+        void EmitLine(PrimitiveVertex* vertices, Vector2 startPoint, Vector2 endPoint, unsigned int color);
+
+        //Draws the contents of the PrimitiveBatch and clears them
+        void Flush();
+
+        //Member variables
+        Shader* m_Shader;
+        UniformHandle m_AnchorUniform;
+        UniformHandle m_SizeUniform;
+        UniformHandle m_ModelUniform;
+        UniformHandle m_ViewUniform;
+        UniformHandle m_ProjectionUniform;
+        VertexData* m_VertexData;
+        Vector2 m_UnitCircle[PRIMITIVE_BATCH_CIRCLE_SEGMENTS];
+        unsigned int m_ShapeCount;
+        unsigned int m_DrawCallCount;
+        bool m_HasTranslucentColor;
+        bool m_Lock;
+    };
+}
+
+#endif
@@ -14,7 +14,9 @@ namespace GameDev2D
         m_ClearColor(Color::ClearColor()),
         m_PreviousClearColor(Color::WhiteColor()),
         m_PreviousViewport(0, 0),
-        m_FrameBuffer(0)
+        m_PreviousCameraPosition(0.0f, 0.0f),
+        m_FrameBuffer(0),
+        m_IsClipping(false)
     {
         //Set the texture frame
         m_Texture = aTexture;
@@ -34,37 +36,48 @@ namespace GameDev2D
 
     void RenderTarget::Begin()
     {
-        //Ensure there isn't already a bound framebuffer
-        assert(Services::GetGraphics()->GetBoundFrameBufferId() == 0);
-
-        //Bind the framebuffer
-        Services::GetGraphics()->BindFrameBuffer(m_FrameBuffer);
-
-        //The Graphics Camera can NOT be null
-        assert(Services::GetGraphics()->GetCamera() != nullptr);
-
-        //Push the viewport
-        m_PreviousViewport = Services::GetGraphics()->GetCamera()->GetViewport();
-        Services::GetGraphics()->GetCamera()->SetViewport(Viewport(GetWidth(), GetHeight()));
-
-        //Push the clear color
-        m_PreviousClearColor = Services::GetGraphics()->GetClearColor();
-        Services::GetGraphics()->SetClearColor(GetClearColor());
+        //Bind the framebuffer and push the Camera and clear color
+        Bind();
 
         //Lastly, clear the buffer
         Services::GetGraphics()->Clear();
     }
 
+    void RenderTarget::Begin(const Rect& aRegion)
+    {
+        //Bind the framebuffer and push the Camera and clear color
+        Bind();
+
+        //Clip to the region, rounded out to whole pixels, the clear and anything drawn are limited to it
+        float left = floorf(aRegion.origin.x);
+        float bottom = floorf(aRegion.origin.y);
+        float right = ceilf(aRegion.origin.x + aRegion.size.x);
+        float top = ceilf(aRegion.origin.y + aRegion.size.y);
+        Services::GetGraphics()->PushScissorClip(left, bottom, right - left, top - bottom);
+        m_IsClipping = true;
+
+        //Lastly, clear the region
+        Services::GetGraphics()->Clear();
+    }
+
     void RenderTarget::End()
     {
+        //Pop the region's clip, before the framebuffer is unbound so anything waiting to be drawn is still clipped
+        if (m_IsClipping == true)
+        {
+            Services::GetGraphics()->PopScissorClip();
+            m_IsClipping = false;
+        }
+
         //Unbind the framebuffer
         Services::GetGraphics()->BindFrameBuffer(0);
 
         //The Graphics Camera can NOT be null
         assert(Services::GetGraphics()->GetCamera() != nullptr);
 
-        //Pop the viewport size
+        //Pop the viewport size and the Camera's position
         Services::GetGraphics()->GetCamera()->SetViewport(m_PreviousViewport);
+        Services::GetGraphics()->GetCamera()->SetPosition(m_PreviousCameraPosition);
 
         //Pop the clear color
         Services::GetGraphics()->SetClearColor(m_PreviousClearColor);
@@ -140,4 +153,25 @@ namespace GameDev2D
             flippedBuffer = nullptr;
         }
     }
+
+    void RenderTarget::Bind()
+    {
+        //Ensure there isn't already a bound framebuffer
+        assert(Services::GetGraphics()->GetBoundFrameBufferId() == 0);
+
+        //Bind the framebuffer
+        Services::GetGraphics()->BindFrameBuffer(m_FrameBuffer);
+
+        //The Graphics Camera can NOT be null
+        assert(Services::GetGraphics()->GetCamera() != nullptr);
+
+        //Push the viewport, setting the viewport centers the Camera on it so push the Camera's position too
+        m_PreviousViewport = Services::GetGraphics()->GetCamera()->GetViewport();
+        m_PreviousCameraPosition = Services::GetGraphics()->GetCamera()->GetPosition();
+        Services::GetGraphics()->GetCamera()->SetViewport(Viewport(GetWidth(), GetHeight()));
+
+        //Push the clear color
+        m_PreviousClearColor = Services::GetGraphics()->GetClearColor();
+        Services::GetGraphics()->SetClearColor(GetClearColor());
+    }
 }
\ No newline at end of file
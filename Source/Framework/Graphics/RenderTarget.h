@@ -22,6 +22,10 @@ namespace GameDev2D
         //Call Begin() before you want to render
         void Begin();
 
+        //Call Begin() with a region (in pixels) to only clear and render to that part of the RenderTarget, the rest of
+        //its contents are kept. Used to redraw the parts of a cached RenderTarget that have changed
+        void Begin(const Rect& region);
+
         //Call End() when you are done rendering
         void End();
 
@@ -39,12 +43,17 @@ namespace GameDev2D
         void SaveFrameBufferToFile(const std::string& aPath);
 
     private:
+        //Binds the framebuffer and pushes the Camera's viewport and position and the clear color, used by both Begin() methods
+        void Bind();
+
         //Member variables
         Texture* m_Texture;
         Color m_ClearColor;
         Color m_PreviousClearColor;
         Viewport m_PreviousViewport;
+        Vector2 m_PreviousCameraPosition;
         unsigned int m_FrameBuffer;
+        bool m_IsClipping;
     };
 }
 
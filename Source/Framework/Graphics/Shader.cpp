@@ -2,6 +2,7 @@
 #include "../Debug/Log.h"
 #include "../Services/Services.h"
 #include <assert.h>
+#include <string.h>
 
 
 namespace GameDev2D
@@ -119,80 +120,224 @@ namespace GameDev2D
         return index;
     }
 
-    void Shader::AddUniform(const string& aUniform)
+    UniformHandle Shader::AddUniform(const string& aUniform)
     {
+        //Is the uniform already added?
+        UniformHandle handle = GetUniformHandle(aUniform);
+        if (handle != SHADER_INVALID_UNIFORM)
+        {
+            return handle;
+        }
+
+        //Add the uniform, its handle is its index
         int location = Services::GetGraphics()->GetUniformLocation(m_Program, aUniform);
-        m_UniformLocations[string(aUniform)] = location;
+        handle = (UniformHandle)m_Uniforms.size();
+        m_Uniforms.push_back(ShaderUniform(location));
+        m_UniformHandles[string(aUniform)] = handle;
+        return handle;
+    }
+
+    UniformHandle Shader::GetUniformHandle(const string& aUniform)
+    {
+        std::map<std::string, UniformHandle>::iterator iterator = m_UniformHandles.find(aUniform);
+        if (iterator != m_UniformHandles.end())
+        {
+            return iterator->second;
+        }
+        return SHADER_INVALID_UNIFORM;
     }
 
     int Shader::GetUniformLocation(const string& aUniform)
     {
-        int index = m_UniformLocations[string(aUniform)];
-        return index;
+        UniformHandle handle = GetUniformHandle(aUniform);
+        if (handle != SHADER_INVALID_UNIFORM)
+        {
+            return m_Uniforms.at(handle).location;
+        }
+        return -1;
     }
 
     void Shader::SetUniformFloat(const string& aUniform, float aValue)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformFloat(m_Program, location, aValue);
+        SetUniformFloat(GetUniformHandle(aUniform), aValue);
     }
 
     void Shader::SetUniformFloat(const string& aUniform, float aValue1, float aValue2)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformFloat(m_Program, location, aValue1, aValue2);
+        SetUniformFloat(GetUniformHandle(aUniform), aValue1, aValue2);
     }
 
     void Shader::SetUniformFloat(const string& aUniform, float aValue1, float aValue2, float aValue3)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformFloat(m_Program, location, aValue1, aValue2, aValue3);
+        SetUniformFloat(GetUniformHandle(aUniform), aValue1, aValue2, aValue3);
     }
 
     void Shader::SetUniformFloat(const string& aUniform, float aValue1, float aValue2, float aValue3, float aValue4)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformFloat(m_Program, location, aValue1, aValue2, aValue3, aValue4);
+        SetUniformFloat(GetUniformHandle(aUniform), aValue1, aValue2, aValue3, aValue4);
     }
 
     void Shader::SetUniformInt(const string& aUniform, int aValue)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformInt(m_Program, location, aValue);
+        SetUniformInt(GetUniformHandle(aUniform), aValue);
     }
 
     void Shader::SetUniformInt(const string& aUniform, int aValue1, int aValue2)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformInt(m_Program, location, aValue1, aValue2);
+        SetUniformInt(GetUniformHandle(aUniform), aValue1, aValue2);
     }
 
     void Shader::SetUniformInt(const string& aUniform, int aValue1, int aValue2, int aValue3)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformInt(m_Program, location, aValue1, aValue2, aValue3);
+        SetUniformInt(GetUniformHandle(aUniform), aValue1, aValue2, aValue3);
     }
 
     void Shader::SetUniformInt(const string& aUniform, int aValue1, int aValue2, int aValue3, int aValue4)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformInt(m_Program, location, aValue1, aValue2, aValue3, aValue4);
+        SetUniformInt(GetUniformHandle(aUniform), aValue1, aValue2, aValue3, aValue4);
     }
 
     void Shader::SetUniformVector2(const string& aUniform, const Vector2& aValue)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformVector2(m_Program, location, aValue);
+        SetUniformVector2(GetUniformHandle(aUniform), aValue);
     }
 
     void Shader::SetUniformMatrix(const string& aUniform, const Matrix& aValue)
     {
-        int location = GetUniformLocation(aUniform);
-        Services::GetGraphics()->SetUniformMatrix(m_Program, location, aValue);
+        SetUniformMatrix(GetUniformHandle(aUniform), aValue);
+    }
+
+    void Shader::SetUniformMatrix(const string& aUniform, const AffineMatrix& aValue)
+    {
+        SetUniformMatrix(GetUniformHandle(aUniform), aValue);
+    }
+
+    void Shader::SetUniformFloat(UniformHandle aHandle, float aValue)
+    {
+        float values[] = { aValue };
+        if (UpdateUniform(aHandle, values, 1) == true)
+        {
+            Services::GetGraphics()->SetUniformFloat(m_Program, m_Uniforms.at(aHandle).location, aValue);
+        }
+    }
+
+    void Shader::SetUniformFloat(UniformHandle aHandle, float aValue1, float aValue2)
+    {
+        float values[] = { aValue1, aValue2 };
+        if (UpdateUniform(aHandle, values, 2) == true)
+        {
+            Services::GetGraphics()->SetUniformFloat(m_Program, m_Uniforms.at(aHandle).location, aValue1, aValue2);
+        }
+    }
+
+    void Shader::SetUniformFloat(UniformHandle aHandle, float aValue1, float aValue2, float aValue3)
+    {
+        float values[] = { aValue1, aValue2, aValue3 };
+        if (UpdateUniform(aHandle, values, 3) == true)
+        {
+            Services::GetGraphics()->SetUniformFloat(m_Program, m_Uniforms.at(aHandle).location, aValue1, aValue2, aValue3);
+        }
+    }
+
+    void Shader::SetUniformFloat(UniformHandle aHandle, float aValue1, float aValue2, float aValue3, float aValue4)
+    {
+        float values[] = { aValue1, aValue2, aValue3, aValue4 };
+        if (UpdateUniform(aHandle, values, 4) == true)
+        {
+            Services::GetGraphics()->SetUniformFloat(m_Program, m_Uniforms.at(aHandle).location, aValue1, aValue2, aValue3, aValue4);
+        }
+    }
+
+    void Shader::SetUniformInt(UniformHandle aHandle, int aValue)
+    {
+        int values[] = { aValue };
+        if (UpdateUniform(aHandle, values, 1) == true)
+        {
+            Services::GetGraphics()->SetUniformInt(m_Program, m_Uniforms.at(aHandle).location, aValue);
+        }
+    }
+
+    void Shader::SetUniformInt(UniformHandle aHandle, int aValue1, int aValue2)
+    {
+        int values[] = { aValue1, aValue2 };
+        if (UpdateUniform(aHandle, values, 2) == true)
+        {
+            Services::GetGraphics()->SetUniformInt(m_Program, m_Uniforms.at(aHandle).location, aValue1, aValue2);
+        }
+    }
+
+    void Shader::SetUniformInt(UniformHandle aHandle, int aValue1, int aValue2, int aValue3)
+    {
+        int values[] = { aValue1, aValue2, aValue3 };
+        if (UpdateUniform(aHandle, values, 3) == true)
+        {
+            Services::GetGraphics()->SetUniformInt(m_Program, m_Uniforms.at(aHandle).location, aValue1, aValue2, aValue3);
+        }
+    }
+
+    void Shader::SetUniformInt(UniformHandle aHandle, int aValue1, int aValue2, int aValue3, int aValue4)
+    {
+        int values[] = { aValue1, aValue2, aValue3, aValue4 };
+        if (UpdateUniform(aHandle, values, 4) == true)
+        {
+            Services::GetGraphics()->SetUniformInt(m_Program, m_Uniforms.at(aHandle).location, aValue1, aValue2, aValue3, aValue4);
+        }
+    }
+
+    void Shader::SetUniformVector2(UniformHandle aHandle, const Vector2& aValue)
+    {
+        if (UpdateUniform(aHandle, &aValue.data[0], 2) == true)
+        {
+            Services::GetGraphics()->SetUniformVector2(m_Program, m_Uniforms.at(aHandle).location, aValue);
+        }
+    }
+
+    void Shader::SetUniformMatrix(UniformHandle aHandle, const Matrix& aValue)
+    {
+        if (UpdateUniform(aHandle, &aValue.m[0][0], 16) == true)
+        {
+            Services::GetGraphics()->SetUniformMatrix(m_Program, m_Uniforms.at(aHandle).location, aValue);
+        }
+    }
+
+    void Shader::SetUniformMatrix(UniformHandle aHandle, const AffineMatrix& aValue)
+    {
+        SetUniformMatrix(aHandle, aValue.ToMatrix());
+    }
+
+    bool Shader::UpdateUniform(UniformHandle aHandle, const void* aValues, unsigned int aCount)
+    {
+        //If the uniform wasn't added, there's nowhere to upload the value to
+        if (aHandle == SHADER_INVALID_UNIFORM)
+        {
+            return false;
+        }
+
+        //If this assert is hit, the handle doesn't belong to this Shader
+        assert(aHandle >= 0 && aHandle < (UniformHandle)m_Uniforms.size());
+
+        //If this assert is hit, the uniform has more values than the cache can hold
+        assert(aCount <= SHADER_UNIFORM_MAX_VALUES);
+
+        //Skip the upload if the uniform already has the values, they're compared bit for bit so ints and floats are treated the same
+        ShaderUniform& uniform = m_Uniforms.at(aHandle);
+        if (uniform.count == aCount && memcmp(uniform.values, aValues, aCount * sizeof(float)) == 0)
+        {
+            Services::GetGraphics()->AddSkippedUniformUpload();
+            return false;
+        }
+
+        //Cache the new values
+        memcpy(uniform.values, aValues, aCount * sizeof(float));
+        uniform.count = aCount;
+        return true;
     }
 
     bool Shader::Validate()
     {
+        //Use the program, SetUniform doesn't bind it when the upload is skipped
+        Services::GetGraphics()->UseShaderProgram(m_Program);
+
         return Services::GetGraphics()->ValidateShaderProgram(m_Program);
     }
 
@@ -205,4 +350,9 @@ namespace GameDev2D
     {
         return m_Key;
     }
+
+    unsigned int Shader::GetId()
+    {
+        return m_Program;
+    }
 }
@@ -2,6 +2,7 @@
 #define __GameDev2D__Shader__
 
 #include "../Math/Vector2.h"
+#include "../Math/AffineMatrix.h"
 #include "../Math/Matrix.h"
 #include <map>
 #include <string>
@@ -10,6 +11,14 @@
 
 namespace GameDev2D
 {
+    //Local constants
+    const int SHADER_INVALID_UNIFORM = -1;
+    const unsigned int SHADER_UNIFORM_MAX_VALUES = 16;  //A 4x4 matrix
+
+    //Handle to a Shader's uniform, returned by AddUniform() and GetUniformHandle(). Resolve it once
+    //and set the uniform with it, instead of looking the uniform up by name every time it's set
+    typedef int UniformHandle;
+
     //Struct to manager the shader sources, attributes and uniforms
     struct ShaderInfo
     {
@@ -62,6 +71,21 @@ namespace GameDev2D
     };
 
 
+    //A Shader's uniform location and the last value uploaded to it, setting a uniform to the value
+    //it already has is skipped, since the program keeps its uniform values between draws
+    struct ShaderUniform
+    {
+        ShaderUniform(int location) :
+            location(location),
+            count(0)
+        {
+        }
+
+        int location;
+        unsigned int count;     //Number of values cached, zero until the uniform has been set
+        float values[SHADER_UNIFORM_MAX_VALUES];
+    };
+
     //A Shader is part of the customizable rendering pipeline
     class Shader
     {
@@ -72,8 +96,11 @@ namespace GameDev2D
         //Returns an attribute index for a attribute key
         int GetAttributeLocation(const std::string& attribute);
 
-        //Adds an attribute
-        void AddUniform(const std::string& uniform);
+        //Adds a uniform and returns its handle
+        UniformHandle AddUniform(const std::string& uniform);
+
+        //Returns the handle for a uniform key, or SHADER_INVALID_UNIFORM if the uniform wasn't added
+        UniformHandle GetUniformHandle(const std::string& uniform);
 
         //Returns an attribute index for a uniform key
         int GetUniformLocation(const std::string& uniform);
@@ -95,6 +122,26 @@ namespace GameDev2D
 
         //Sets a Matrix for the uniform key
         void SetUniformMatrix(const std::string& uniform, const Matrix& value);
+        void SetUniformMatrix(const std::string& uniform, const AffineMatrix& value);
+
+        //Sets float value(s) for the uniform handle
+        void SetUniformFloat(UniformHandle handle, float value);
+        void SetUniformFloat(UniformHandle handle, float value1, float value2);
+        void SetUniformFloat(UniformHandle handle, float value1, float value2, float value3);
+        void SetUniformFloat(UniformHandle handle, float value1, float value2, float value3, float value4);
+
+        //Sets int value(s) for the uniform handle
+        void SetUniformInt(UniformHandle handle, int value);
+        void SetUniformInt(UniformHandle handle, int value1, int value2);
+        void SetUniformInt(UniformHandle handle, int value1, int value2, int value3);
+        void SetUniformInt(UniformHandle handle, int value1, int value2, int value3, int value4);
+
+        //Sets a Vector2 for the uniform handle
+        void SetUniformVector2(UniformHandle handle, const Vector2& value);
+
+        //Sets a Matrix for the uniform handle, an AffineMatrix is expanded to the shader's 4x4 matrix
+        void SetUniformMatrix(UniformHandle handle, const Matrix& value);
+        void SetUniformMatrix(UniformHandle handle, const AffineMatrix& value);
 
         //Validate the Shader, returns true is the validation was successful
         bool Validate();
@@ -105,6 +152,9 @@ namespace GameDev2D
         //Returns the key for the shader
         std::string GetKey();
 
+        //Returns the shader's program id
+        unsigned int GetId();
+
     protected:
         //Created from the ResourceManager with the supplied ShaderSourcce
         Shader(const ShaderSource& shaderSource);
@@ -114,8 +164,13 @@ namespace GameDev2D
         friend class ResourceManager;
 
     private:
+        //Compares the values to the uniform's cached values, returns true if they're different and need to
+        //be uploaded (the cache is updated), or false if the upload can be skipped
+        bool UpdateUniform(UniformHandle handle, const void* values, unsigned int count);
+
         //Member variables
-        std::map<std::string, int> m_UniformLocations;
+        std::vector<ShaderUniform> m_Uniforms;
+        std::map<std::string, UniformHandle> m_UniformHandles;
         std::map<std::string, int> m_AttributeLocations;
         unsigned int m_Program;
         unsigned int m_VertexShader;
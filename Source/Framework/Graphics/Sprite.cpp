@@ -13,25 +13,19 @@ namespace GameDev2D
     Sprite::Sprite(Texture* aTexture) : Drawable(),
         m_Texture(aTexture),
         m_VertexData(nullptr),
+        m_AnchorUniform(SHADER_INVALID_UNIFORM),
+        m_SizeUniform(SHADER_INVALID_UNIFORM),
+        m_ColorUniform(SHADER_INVALID_UNIFORM),
+        m_TextureUniform(SHADER_INVALID_UNIFORM),
+        m_ModelUniform(SHADER_INVALID_UNIFORM),
+        m_ViewUniform(SHADER_INVALID_UNIFORM),
+        m_ProjectionUniform(SHADER_INVALID_UNIFORM),
         m_Frame(Rect()),
         m_BlendingMode(BlendingMode()),
         m_Wrap(Wrap())
     {
-        //Initialize the Shader
-        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
-
-        //Initialize the Sprite's vertex DataBufferDescriptor, it describes
-        //how the individual 'elements' will be stored in the DataBuffer
-        VertexBufferDescriptor descriptor;
-        descriptor.size = SPRITE_VERTEX_SIZE;
-        descriptor.capacity = SPRITE_VERTEX_COUNT;
-        descriptor.usage = BufferUsage_DynamicDraw;
-        descriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_uv") };
-        descriptor.attributeSize = { 2, 2 };
-
-        //Create the vertex DataBuffer
-        m_VertexData = new VertexData();
-        m_VertexData->CreateBuffer(descriptor);
+        //Initialize the Shader, the SpriteBatch draws the Sprite with it
+        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
 
         //Set the Texture's frame
         SetFrame(Rect(Vector2(0.0f, 0.0f), Vector2((float)m_Texture->GetWidth(), (float)m_Texture->GetHeight())));
@@ -59,45 +53,62 @@ namespace GameDev2D
             //Cache the Graphics pointer
             Graphics* graphics = Services::GetGraphics();
 
-            //Bind the vertex array object
-            m_VertexData->PrepareForDraw();
- 
-            //Setup the shader uniforms
-            m_Shader->SetUniformVector2("uniform_anchor", GetAnchor());
-            m_Shader->SetUniformVector2("uniform_size", Vector2(GetWidth(), GetHeight()));
-            m_Shader->SetUniformFloat("uniform_color", m_Color.r, m_Color.g, m_Color.b, m_Color.a);
-            m_Shader->SetUniformInt("uniform_texture", 0);
-            m_Shader->SetUniformMatrix("uniform_model", GetTransformMatrix());
-            m_Shader->SetUniformMatrix("uniform_view", graphics->GetViewMatrix());
-            m_Shader->SetUniformMatrix("uniform_projection", graphics->GetProjectionMatrix());
-
-            //Validate the shader, return if it fails
-            if (m_Shader->Validate() == false)
+            //Does the Sprite have a custom Shader? Then it's drawn on its own
+            if (m_VertexData != nullptr)
             {
-                return;
-            }
+                //Is the Sprite on-screen?
+                if (graphics->IsVisible(this) == false)
+                {
+                    return;
+                }
 
-            //Bind the texture
-            graphics->BindTexture(m_Texture);
+                //Bind the vertex array object, this draws any sprites waiting in the frame's batches first
+                m_VertexData->PrepareForDraw();
 
-            //Enable blending if the texture has an alpha channel
-            if (m_Texture->GetPixelFormat().layout == PixelFormat::RGBA || m_Color.a != 1.0f)
-            {
-                graphics->EnableBlending(GetBlendingMode());
-            }
+                //Setup the shader uniforms
+                m_Shader->SetUniformVector2(m_AnchorUniform, GetAnchor());
+                m_Shader->SetUniformVector2(m_SizeUniform, Vector2(GetWidth(), GetHeight()));
+                m_Shader->SetUniformFloat(m_ColorUniform, m_Color.r, m_Color.g, m_Color.b, m_Color.a);
+                m_Shader->SetUniformInt(m_TextureUniform, 0);
+                m_Shader->SetUniformMatrix(m_ModelUniform, GetTransformMatrix());
+                m_Shader->SetUniformMatrix(m_ViewUniform, graphics->GetViewMatrix());
+                m_Shader->SetUniformMatrix(m_ProjectionUniform, graphics->GetProjectionMatrix());
+
+                //Validate the shader, return if it fails
+                if (m_Shader->Validate() == false)
+                {
+                    return;
+                }
+
+                //Bind the texture
+                graphics->BindTexture(m_Texture);
 
-            //Draw the texture
-            graphics->DrawArrays(RenderMode_TriangleStrip, 0, m_VertexData->GetVertexBuffer()->GetCount());
+                //Enable blending if the texture has an alpha channel
+                bool isBlending = m_Texture->GetPixelFormat().layout == PixelFormat::RGBA || m_Color.a != 1.0f;
+                if (isBlending == true)
+                {
+                    graphics->EnableBlending(GetBlendingMode());
+                }
 
-            //Disable blending, if we did in fact have it enabled
-            if (m_Texture->GetPixelFormat().layout == PixelFormat::RGBA || m_Color.a != 1.0f)
+                //Draw the texture
+                graphics->DrawArrays(RenderMode_TriangleStrip, 0, m_VertexData->GetVertexBuffer()->GetCount());
+
+                //Disable blending, if we did in fact have it enabled
+                if (isBlending == true)
+                {
+                    graphics->DisableBlending();
+                }
+
+                //This unbind's the vertex array, so its not accidently modified
+                m_VertexData->EndDraw();
+            }
+            else
             {
-                graphics->DisableBlending();
+                //Add the Sprite to the frame's SpriteBatch, it gets drawn along with the
+                //other sprites that share its texture
+                graphics->DrawSprite(this);
             }
 
-            //This unbind's the vertex array, so its not accidently modified
-            m_VertexData->EndDraw();
-
 #if DEBUG && DEBUG_DRAW_SPRITE_RECT
             //Draw the Debug Rectangle
             Vector2 size = Vector2(GetWidth(), GetHeight());
@@ -113,6 +124,47 @@ namespace GameDev2D
         }
     }
 
+    void Sprite::SetShader(Shader* aShader)
+    {
+        m_Shader = aShader;
+
+        //The vertex attributes are bound to the Shader's attribute locations, delete the old vertex data
+        if (m_VertexData != nullptr)
+        {
+            delete m_VertexData;
+            m_VertexData = nullptr;
+        }
+
+        //The SpriteBatch's Shader doesn't need any vertex data, the Sprite is drawn by the frame's SpriteBatch
+        if (m_Shader == Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY))
+        {
+            return;
+        }
+
+        //Look up the uniform handles once, Draw() sets the uniforms with them
+        m_AnchorUniform = m_Shader->GetUniformHandle("uniform_anchor");
+        m_SizeUniform = m_Shader->GetUniformHandle("uniform_size");
+        m_ColorUniform = m_Shader->GetUniformHandle("uniform_color");
+        m_TextureUniform = m_Shader->GetUniformHandle("uniform_texture");
+        m_ModelUniform = m_Shader->GetUniformHandle("uniform_model");
+        m_ViewUniform = m_Shader->GetUniformHandle("uniform_view");
+        m_ProjectionUniform = m_Shader->GetUniformHandle("uniform_projection");
+
+        //Initialize the Sprite's VertexBufferDescriptor, it describes
+        //how the individual vertices will be stored in the VertexBuffer
+        VertexBufferDescriptor descriptor;
+        descriptor.size = 4;
+        descriptor.capacity = 4;
+        descriptor.usage = BufferUsage_DynamicDraw;
+        descriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_uv") };
+        descriptor.attributeSize = { 2, 2 };
+
+        //Create the vertex DataBuffer and build the vertices
+        m_VertexData = new VertexData();
+        m_VertexData->CreateBuffer(descriptor);
+        UpdateVertices();
+    }
+
     float Sprite::GetWidth()
     {
         return m_Frame.size.x;
@@ -173,31 +225,11 @@ namespace GameDev2D
 
     void Sprite::SetFrame(Rect aFrame)
     {
-        //Ensure the Sprite's frame is different
-        if (m_Frame != aFrame)
-        {
-            //Set the source frame
-            m_Frame.origin = aFrame.origin;
-            m_Frame.size = aFrame.size;
+        //Set the source frame, the SpriteBatch builds the UV coordinates from it when the Sprite is drawn
+        m_Frame = aFrame;
 
-            if (m_Texture != nullptr)
-            {
-                //Build the UV Coordinates
-                float u1 = (float)m_Frame.origin.x / (float)m_Texture->GetWidth();
-                float u2 = (float)(m_Frame.origin.x + m_Frame.size.x) / (float)m_Texture->GetWidth();
-                float v1 = 1.0f - (((float)m_Frame.origin.y + m_Frame.size.y) / (float)m_Texture->GetHeight());
-                float v2 = 1.0f - (m_Frame.origin.y / (float)m_Texture->GetHeight());
-
-                //Clear the vertices from the VertexBuffer 
-                m_VertexData->GetVertexBuffer()->ClearVertices();
-
-                //Add the new vertices to the VertexBuffer
-                m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 0.0f, 0.0f, u1, v1 });
-                m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 1.0f, 0.0f, u2, v1 });
-                m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 0.0f, 1.0f, u1, v2 });
-                m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 1.0f, 1.0f, u2, v2 });
-            }
-        }
+        //Rebuild the vertices, if the Sprite is drawn with a custom Shader
+        UpdateVertices();
     }
 
     Rect Sprite::GetFrame()
@@ -208,10 +240,37 @@ namespace GameDev2D
     void Sprite::SetTexture(Texture* aTexture)
     {
         m_Texture = aTexture;
+
+        //The UV coordinates depend on the Texture's size
+        UpdateVertices();
     }
         
     Texture* Sprite::GetTexture() const
     {
         return m_Texture;
     }
+
+    void Sprite::UpdateVertices()
+    {
+        //Only a Sprite with a custom Shader has vertices
+        if (m_VertexData == nullptr || m_Texture == nullptr)
+        {
+            return;
+        }
+
+        //Build the UV Coordinates
+        float u1 = (float)m_Frame.origin.x / (float)m_Texture->GetWidth();
+        float u2 = (float)(m_Frame.origin.x + m_Frame.size.x) / (float)m_Texture->GetWidth();
+        float v1 = 1.0f - (((float)m_Frame.origin.y + m_Frame.size.y) / (float)m_Texture->GetHeight());
+        float v2 = 1.0f - (m_Frame.origin.y / (float)m_Texture->GetHeight());
+
+        //Clear the vertices from the VertexBuffer 
+        m_VertexData->GetVertexBuffer()->ClearVertices();
+
+        //Add the new vertices to the VertexBuffer
+        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 0.0f, 0.0f, u1, v1 });
+        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 1.0f, 0.0f, u2, v1 });
+        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 0.0f, 1.0f, u1, v2 });
+        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 1.0f, 1.0f, u2, v2 });
+    }
 }
\ No newline at end of file
@@ -9,14 +9,14 @@
 
 namespace GameDev2D
 {
-    //Sprite constant
-    const unsigned int SPRITE_VERTEX_SIZE = 4;  //2 position, 2 uv
-    const unsigned int SPRITE_VERTEX_COUNT = 4;
-
     //The Sprite class is used for Draw a Texture to the screen, it has it's own 
     //Draw() method which must be called inside a Draw function. It inherits for Drawable, 
     //which inherits from Transformable, meaning in can have its position, rotation, scale, 
-    //anchor point, color and Shader modified
+    //anchor point, color and Shader modified. Sprites don't own any vertex data, Draw() adds
+    //the Sprite to the Graphics service's frame SpriteBatch, which draws consecutive sprites
+    //that share a texture (a SpriteAtlas for example) with a single draw call. A Sprite with
+    //a custom Shader is drawn on its own with its own vertex data, the Shader gets the same
+    //attributes and uniforms as the texture passthrough Shader
     class Sprite : public Drawable
     {
     public:
@@ -29,6 +29,10 @@ namespace GameDev2D
 
         //Draws the Sprite
         virtual void Draw();
+
+        //Sets the Shader used to draw the Sprite, any Shader other than the SpriteBatch's
+        //passthrough Shader draws the Sprite on its own, outside of the frame's SpriteBatch
+        virtual void SetShader(Shader* shader);
         
         //Returns the width and height of the Sprite
         virtual float GetWidth();
@@ -64,9 +68,19 @@ namespace GameDev2D
         Texture* GetTexture() const;
         
     protected:
+        //Builds the vertices used to draw the Sprite with a custom Shader
+        void UpdateVertices();
+
         //Member variables
         Texture* m_Texture;
         VertexData* m_VertexData;
+        UniformHandle m_AnchorUniform;
+        UniformHandle m_SizeUniform;
+        UniformHandle m_ColorUniform;
+        UniformHandle m_TextureUniform;
+        UniformHandle m_ModelUniform;
+        UniformHandle m_ViewUniform;
+        UniformHandle m_ProjectionUniform;
         Rect m_Frame;
         BlendingMode m_BlendingMode;
         Wrap m_Wrap;
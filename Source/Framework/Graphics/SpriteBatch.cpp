@@ -5,29 +5,168 @@
 #include "../Math/Math.h"
 #include "../Services/Services.h"
 #include <assert.h>
+#include <string.h>
 
 
 namespace GameDev2D
 {
-    SpriteBatch::SpriteBatch() : 
+    //Stable least significant digit radix sort of the items by key, the scratch vector is used as the second buffer. Passes
+    //where every key has the same digit are skipped, most frames only use a handful of layers, textures and blending modes
+    static void RadixSort(std::vector<SpriteBatchSortItem>& aItems, std::vector<SpriteBatchSortItem>& aScratch)
+    {
+        const unsigned int radix = 1 << SPRITE_BATCH_SORT_RADIX_BITS;
+        const unsigned int passes = (sizeof(unsigned long long) * 8) / SPRITE_BATCH_SORT_RADIX_BITS;
+        const unsigned int count = (unsigned int)aItems.size();
+
+        aScratch.resize(count);
+        SpriteBatchSortItem* source = aItems.data();
+        SpriteBatchSortItem* destination = aScratch.data();
+
+        for (unsigned int pass = 0; pass < passes; pass++)
+        {
+            unsigned int shift = pass * SPRITE_BATCH_SORT_RADIX_BITS;
+
+            //Count how many keys have each digit
+            unsigned int offsets[radix] = {};
+            for (unsigned int i = 0; i < count; i++)
+            {
+                offsets[(source[i].key >> shift) & (radix - 1)]++;
+            }
+
+            //If every key has the same digit, this pass wouldn't change the order
+            if (offsets[(source[0].key >> shift) & (radix - 1)] == count)
+            {
+                continue;
+            }
+
+            //Turn the counts into the starting offset for each digit
+            unsigned int offset = 0;
+            for (unsigned int i = 0; i < radix; i++)
+            {
+                unsigned int digitCount = offsets[i];
+                offsets[i] = offset;
+                offset += digitCount;
+            }
+
+            //Scatter the items, in order, to their digit's slots
+            for (unsigned int i = 0; i < count; i++)
+            {
+                destination[offsets[(source[i].key >> shift) & (radix - 1)]++] = source[i];
+            }
+
+            SpriteBatchSortItem* temp = source;
+            source = destination;
+            destination = temp;
+        }
+
+        //If the sorted items ended up in the scratch buffer, copy them back
+        if (source != aItems.data())
+        {
+            memcpy(aItems.data(), source, count * sizeof(SpriteBatchSortItem));
+        }
+    }
+
+    void PackSpriteVertices(SpriteVertex* aVertices, Vector2 aTextureSize, const AffineMatrix& aTransformation, const Color& aColor, Vector2 aAnchor, const Rect& aSourceFrame, unsigned char aTextureSlot)
+    {
+        //Get the source size
+        Vector2 sourceSize = aSourceFrame.size;
+
+        //Build the UV Coordinates
+        float u1 = 0.0f;
+        float u2 = 1.0f;
+        float v1 = 0.0f;
+        float v2 = 1.0f;
+
+        //Recalculate the UVs if the texture size and source size differ
+        if (aTextureSize != sourceSize)
+        {
+            u1 = (float)aSourceFrame.origin.x / (float)aTextureSize.x;
+            u2 = (float)(aSourceFrame.origin.x + aSourceFrame.size.x) / (float)aTextureSize.x;
+            v1 = 1.0f - (((float)aSourceFrame.origin.y + aSourceFrame.size.y) / (float)aTextureSize.y);
+            v2 = 1.0f - (aSourceFrame.origin.y / (float)aTextureSize.y);
+        }
+
+        //Calculate the corners, offset by the anchor
+        Vector2 anchorOffset = Vector2(aAnchor.x * sourceSize.x, aAnchor.y * sourceSize.y);
+        Vector2 corners[SPRITE_BATCH_VERTICES_PER_SPRITE] =
+        {
+            Vector2(0.0f, sourceSize.y) - anchorOffset,
+            Vector2(sourceSize.x, sourceSize.y) - anchorOffset,
+            Vector2(sourceSize.x, 0.0f) - anchorOffset,
+            Vector2(0.0f, 0.0f) - anchorOffset
+        };
+
+        //Apply the matrix transformation to all four corners at once
+        aTransformation.Transform(corners, corners, SPRITE_BATCH_VERTICES_PER_SPRITE);
+
+        //Pack the uvs and color once, they are shared by the vertices
+        unsigned short packedU1 = PackUnsignedNormalized(u1);
+        unsigned short packedU2 = PackUnsignedNormalized(u2);
+        unsigned short packedV1 = PackUnsignedNormalized(v1);
+        unsigned short packedV2 = PackUnsignedNormalized(v2);
+        unsigned int packedColor = PackColor(aColor);
+
+        //Set the vertices
+        aVertices[0] = SpriteVertex(corners[0], packedU1, packedV2, packedColor, aTextureSlot);  //x,y+h,u1,v2
+        aVertices[1] = SpriteVertex(corners[1], packedU2, packedV2, packedColor, aTextureSlot);  //x+w,y+h,u2,v2
+        aVertices[2] = SpriteVertex(corners[2], packedU2, packedV1, packedColor, aTextureSlot);  //x+w,y,u2,v1
+        aVertices[3] = SpriteVertex(corners[3], packedU1, packedV1, packedColor, aTextureSlot);  //x,y,u1,v1
+    }
+
+    SpriteBatch::SpriteBatch(bool aIsRingBuffered) : 
+        m_TextureUniforms(),
+        m_ModelUniform(SHADER_INVALID_UNIFORM),
+        m_ViewUniform(SHADER_INVALID_UNIFORM),
+        m_ProjectionUniform(SHADER_INVALID_UNIFORM),
         m_VertexData(nullptr),
-        m_CurrentTexture(nullptr),
+        m_InstanceShader(nullptr),
+        m_InstanceTextureUniforms(),
+        m_InstanceViewUniform(SHADER_INVALID_UNIFORM),
+        m_InstanceProjectionUniform(SHADER_INVALID_UNIFORM),
+        m_InstanceData(nullptr),
+        m_Textures(),
+        m_TextureCount(0),
+        m_CurrentBlendingMode(BlendingMode()),
+        m_HasTranslucentColor(false),
+        m_BlendingMode(BlendingMode()),
+        m_Mode(SpriteBatchMode_Immediate),
+        m_Layer(0),
+        m_Records(),
+        m_RecordVertices(),
+        m_SortItems(),
+        m_SortScratch(),
+        m_BeginTime(),
+        m_SpriteCount(0),
+        m_DrawCallCount(0),
+        m_DrawTime(0.0),
+        m_IsRingBuffered(aIsRingBuffered),
         m_Lock(false)
     {
         //Initialize the Shader
         m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
 
+        //Look up the uniform handles once, Flush() sets the uniforms with them
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            m_TextureUniforms[i] = m_Shader->GetUniformHandle("uniform_textures[" + std::to_string(i) + "]");
+        }
+        m_ModelUniform = m_Shader->GetUniformHandle("uniform_model");
+        m_ViewUniform = m_Shader->GetUniformHandle("uniform_view");
+        m_ProjectionUniform = m_Shader->GetUniformHandle("uniform_projection");
+
         //Create the VertexData object
         m_VertexData = new VertexData();
 
         //Initialize the SpriteBatch's vertex DataBufferDescriptor, it describes
         //how the individual 'elements' will be stored in the DataBuffer
         VertexBufferDescriptor vertexDescriptor;
-        vertexDescriptor.size = 8;
-        vertexDescriptor.capacity = SPRITE_BATCH_COUNT;
+        vertexDescriptor.size = sizeof(SpriteVertex) / sizeof(float);
+        vertexDescriptor.capacity = SPRITE_BATCH_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE;
         vertexDescriptor.usage = BufferUsage_DynamicDraw;
-        vertexDescriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_uv"), m_Shader->GetAttributeLocation("in_color") };
-        vertexDescriptor.attributeSize = { 2, 2, 4 };
+        vertexDescriptor.isRingBuffer = m_IsRingBuffered;
+        vertexDescriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_uv"), m_Shader->GetAttributeLocation("in_color"), m_Shader->GetAttributeLocation("in_textureSlot") };
+        vertexDescriptor.attributeSize = { 2, 2, 4, 1 };
+        vertexDescriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedShort, GraphicType_UnsignedByte, GraphicType_UnsignedByte };
 
         //Create the vertex buffer
         m_VertexData->CreateBuffer(vertexDescriptor);
@@ -62,24 +201,67 @@ namespace GameDev2D
             delete m_VertexData;
             m_VertexData = nullptr;
         }
+
+        if (m_InstanceData != nullptr)
+        {
+            delete m_InstanceData;
+            m_InstanceData = nullptr;
+        }
     }
 
-    void SpriteBatch::Begin()
+    void SpriteBatch::Begin(SpriteBatchMode aMode)
     {
         //If this assert is hit, you are trying to draw to a SpriteBatch that has already had Begin() called BUT not End()
         assert(m_Lock == false);
 
         //Lock the SpriteBatch
         m_Lock = true;
+
+        //Instanced mode needs OpenGL 3.3 (or the instancing extensions), fall back to immediate mode without it
+        if (aMode == SpriteBatchMode_Instanced && Services::GetGraphics()->IsInstancingSupported() == false)
+        {
+            Log::Message(this, "SpriteBatch", Log::Verbosity_Graphics, "Instancing isn't supported, falling back to immediate mode");
+            aMode = SpriteBatchMode_Immediate;
+        }
+
+        //Create the instance data the first time it's needed
+        if (aMode == SpriteBatchMode_Instanced && m_InstanceData == nullptr)
+        {
+            CreateInstanceData();
+        }
+
+        //Set the mode and reset the draw state
+        m_Mode = aMode;
+        m_Layer = 0;
+        m_BlendingMode = BlendingMode();
+
+        //Clear the recorded sprites, the vectors keep their capacity so recording doesn't allocate once it has warmed up
+        m_Records.clear();
+        m_RecordVertices.clear();
+
+        //Reset the stats
+        m_SpriteCount = 0;
+        m_DrawCallCount = 0;
+        m_BeginTime = std::chrono::high_resolution_clock::now();
     }
 
     void SpriteBatch::End()
     {
+        //Sort and draw the recorded sprites
+        if (m_Mode == SpriteBatchMode_Deferred)
+        {
+            DrawRecords();
+        }
+
         //Flush the vertex data (draw to the screen)
         Flush();
 
         //Unlock the SpriteBatch
         m_Lock = false;
+
+        //Calculate the draw time
+        std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - m_BeginTime;
+        m_DrawTime = duration.count();
     }
 
     void SpriteBatch::Draw(Texture* aTexture, Vector2 aPosition, float aAngle, Vector2 aScale)
@@ -100,101 +282,384 @@ namespace GameDev2D
     void SpriteBatch::Draw(Texture* aTexture, Vector2 aPosition, float aAngle, Vector2 aScale, Color aColor, Vector2 aAnchor, Rect aSourceFrame)
     {
         //Draw the texture
-        Draw(aTexture, Matrix::Make(aPosition, aAngle, aScale), aColor, aAnchor, aSourceFrame);
+        Draw(aTexture, AffineMatrix::Make(aPosition, aAngle, aScale), aColor, aAnchor, aSourceFrame);
     }
 
-    void SpriteBatch::Draw(Texture* aTexture, const Matrix& aTransformation)
+    void SpriteBatch::Draw(Texture* aTexture, const AffineMatrix& aTransformation)
     {
         Draw(aTexture, aTransformation, Color::WhiteColor(), Vector2(0.0f, 0.0f));
     }
 
-    void SpriteBatch::Draw(Texture* aTexture, const Matrix& aTransformation, Color aColor)
+    void SpriteBatch::Draw(Texture* aTexture, const AffineMatrix& aTransformation, Color aColor)
     {
         Draw(aTexture, aTransformation, aColor, Vector2(0.0f, 0.0f));
     }
 
-    void SpriteBatch::Draw(Texture* aTexture, const Matrix& aTransformation, Color aColor, Vector2 aAnchor)
+    void SpriteBatch::Draw(Texture* aTexture, const AffineMatrix& aTransformation, Color aColor, Vector2 aAnchor)
     {
         Draw(aTexture, aTransformation, aColor, aAnchor, Rect(Vector2(0.0f, 0.0f), Vector2((float)aTexture->GetWidth(), (float)aTexture->GetHeight())));
     }
 
-    void SpriteBatch::Draw(Texture* aTexture, const Matrix& aTransformation, Color aColor, Vector2 aAnchor, Rect aSourceFrame)
+    void SpriteBatch::Draw(Texture* aTexture, const AffineMatrix& aTransformation, Color aColor, Vector2 aAnchor, Rect aSourceFrame)
+    {
+        AddSprite(aTexture, aTransformation, aColor, aAnchor, aSourceFrame, m_BlendingMode);
+    }
+
+    void SpriteBatch::Draw(Sprite* aSprite)
     {
-        //If the SpriteBatch has reacher the maximum vertices, flush the data
-        if (m_VertexData->GetVertexBuffer()->GetCount() == SPRITE_BATCH_COUNT)
+        if (aSprite != nullptr)
+        {
+            AddSprite(aSprite->GetTexture(), aSprite->GetTransformMatrix(), aSprite->GetColor(), aSprite->GetAnchor(), aSprite->GetFrame(), aSprite->GetBlendingMode());
+        }
+    }
+
+    void SpriteBatch::Draw(Texture* aTexture, const SpriteVertex* aVertices, unsigned int aSpriteCount)
+    {
+        //If this assert is hit, the texture is null
+        assert(aTexture != nullptr);
+
+        //If this assert is hit, vertex blocks can't be drawn in instanced mode, the instances are built from a transformation
+        assert(m_Mode != SpriteBatchMode_Instanced);
+
+        if (aSpriteCount == 0)
+        {
+            return;
+        }
+
+        //In deferred mode the block is recorded one sprite at a time so the sprites can still be sorted, but their
+        //vertices are copied with a single memcpy
+        if (m_Mode == SpriteBatchMode_Deferred)
+        {
+            unsigned long long key = MakeSortKey(aTexture, m_BlendingMode);
+            for (unsigned int i = 0; i < aSpriteCount; i++)
+            {
+                m_Records.push_back(SpriteBatchRecord(key, aTexture, m_BlendingMode));
+            }
+
+            size_t offset = m_RecordVertices.size();
+            m_RecordVertices.resize(offset + aSpriteCount * SPRITE_BATCH_VERTICES_PER_SPRITE);
+            memcpy(&m_RecordVertices[offset], aVertices, aSpriteCount * SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex));
+            m_SpriteCount += aSpriteCount;
+            return;
+        }
+
+        //If the blending mode is different, flush the data
+        if (m_CurrentBlendingMode != m_BlendingMode)
         {
             Flush();
         }
+        m_CurrentBlendingMode = m_BlendingMode;
+
+        //Blending is needed if any of the colors aren't opaque, the alpha is the packed color's most significant byte
+        bool isTranslucent = false;
+        for (unsigned int i = 0; i < aSpriteCount && isTranslucent == false; i++)
+        {
+            isTranslucent = (aVertices[i * SPRITE_BATCH_VERTICES_PER_SPRITE].color >> 24) != 255;
+        }
 
-        //Safety check the texture
-        if (aTexture != nullptr)
+        //Copy the block into the vertex buffer, as many sprites as will fit at a time
+        VertexBuffer* vertexBuffer = m_VertexData->GetVertexBuffer();
+        unsigned int spritesCopied = 0;
+        while (spritesCopied < aSpriteCount)
         {
-            //If the Texture is different, Flush the vertex data
-            if (m_CurrentTexture != aTexture)
+            //Flush if the buffer is full
+            unsigned int capacity = (vertexBuffer->GetCapacity() - vertexBuffer->GetCount()) / SPRITE_BATCH_VERTICES_PER_SPRITE;
+            if (capacity == 0)
             {
                 Flush();
+                capacity = vertexBuffer->GetCapacity() / SPRITE_BATCH_VERTICES_PER_SPRITE;
             }
 
-            //Set the current Texture
-            m_CurrentTexture = aTexture;
+            //If the Texture doesn't fit in the remaining texture slots, flush the data
+            unsigned int slot = GetTextureSlot(aTexture);
+            if (slot == SPRITE_BATCH_TEXTURE_SLOTS)
+            {
+                Flush();
+                slot = GetTextureSlot(aTexture);
+                capacity = vertexBuffer->GetCapacity() / SPRITE_BATCH_VERTICES_PER_SPRITE;
+            }
+
+            if (isTranslucent == true)
+            {
+                m_HasTranslucentColor = true;
+            }
+
+            //Copy the vertices, the texture slot only needs to be rewritten if it differs from the one the block was built with
+            unsigned int sprites = std::min<unsigned int>(capacity, aSpriteCount - spritesCopied);
+            unsigned int vertexCount = sprites * SPRITE_BATCH_VERTICES_PER_SPRITE;
+            const SpriteVertex* source = &aVertices[spritesCopied * SPRITE_BATCH_VERTICES_PER_SPRITE];
+            SpriteVertex* vertices = vertexBuffer->Emit<SpriteVertex>(vertexCount);
+            memcpy(vertices, source, vertexCount * sizeof(SpriteVertex));
+            if (source[0].GetTextureSlot() != slot)
+            {
+                for (unsigned int i = 0; i < vertexCount; i++)
+                {
+                    vertices[i].SetTextureSlot((unsigned char)slot);
+                }
+            }
+
+            spritesCopied += sprites;
         }
 
-        //Get the texture and source sizes
+        m_SpriteCount += aSpriteCount;
+    }
+
+    void SpriteBatch::SetLayer(unsigned short aLayer)
+    {
+        m_Layer = aLayer;
+    }
+
+    unsigned short SpriteBatch::GetLayer()
+    {
+        return m_Layer;
+    }
+
+    void SpriteBatch::SetBlendingMode(BlendingMode aBlendingMode)
+    {
+        m_BlendingMode = aBlendingMode;
+    }
+
+    BlendingMode SpriteBatch::GetBlendingMode()
+    {
+        return m_BlendingMode;
+    }
+
+    void SpriteBatch::AddSprite(Texture* aTexture, const AffineMatrix& aTransformation, Color aColor, Vector2 aAnchor, Rect aSourceFrame, BlendingMode aBlendingMode)
+    {
+        //If this assert is hit, the texture is null
+        assert(aTexture != nullptr);
+
+        //In instanced mode the whole sprite is packed into one instance, the vertex shader builds the quad
+        if (m_Mode == SpriteBatchMode_Instanced)
+        {
+            //If the blending mode is different OR the SpriteBatch has reached the maximum instances, flush the data
+            VertexBuffer* instanceBuffer = m_InstanceData->GetInstanceBuffer();
+            if (m_CurrentBlendingMode != aBlendingMode || instanceBuffer->GetCount() + 1 > instanceBuffer->GetCapacity())
+            {
+                Flush();
+            }
+
+            //If the Texture doesn't fit in the remaining texture slots, flush the data
+            unsigned int slot = GetTextureSlot(aTexture);
+            if (slot == SPRITE_BATCH_TEXTURE_SLOTS)
+            {
+                Flush();
+                slot = GetTextureSlot(aTexture);
+            }
+
+            //Set the current blending mode
+            m_CurrentBlendingMode = aBlendingMode;
+
+            //Blending is needed if the color isn't opaque
+            if (aColor.a != 1.0f)
+            {
+                m_HasTranslucentColor = true;
+            }
+
+            //Pack the instance straight into the instance buffer
+            Vector2 textureSize = Vector2((float)aTexture->GetWidth(), (float)aTexture->GetHeight());
+            PackSpriteInstance(instanceBuffer->Emit<SpriteInstance>(1), textureSize, aTransformation, aColor, aAnchor, aSourceFrame, (unsigned char)slot);
+            m_SpriteCount++;
+            return;
+        }
+
+        //Get where the sprite's vertices will be written, and the texture slot they sample from
+        SpriteVertex* vertices = nullptr;
+        unsigned int slot = 0;
+        if (m_Mode == SpriteBatchMode_Immediate)
+        {
+            //If the blending mode is different OR the SpriteBatch has reached the maximum vertices, flush the data
+            VertexBuffer* vertexBuffer = m_VertexData->GetVertexBuffer();
+            if (m_CurrentBlendingMode != aBlendingMode || vertexBuffer->GetCount() + SPRITE_BATCH_VERTICES_PER_SPRITE > vertexBuffer->GetCapacity())
+            {
+                Flush();
+            }
+
+            //If the Texture doesn't fit in the remaining texture slots, flush the data
+            slot = GetTextureSlot(aTexture);
+            if (slot == SPRITE_BATCH_TEXTURE_SLOTS)
+            {
+                Flush();
+                slot = GetTextureSlot(aTexture);
+            }
+
+            //Set the current blending mode
+            m_CurrentBlendingMode = aBlendingMode;
+
+            //Blending is needed if the color isn't opaque
+            if (aColor.a != 1.0f)
+            {
+                m_HasTranslucentColor = true;
+            }
+
+            //Write the vertices straight into the vertex buffer
+            vertices = vertexBuffer->Emit<SpriteVertex>(SPRITE_BATCH_VERTICES_PER_SPRITE);
+        }
+        else
+        {
+            //Record the sprite, it will be sorted and drawn when End() is called
+            m_Records.push_back(SpriteBatchRecord(MakeSortKey(aTexture, aBlendingMode), aTexture, aBlendingMode));
+            m_RecordVertices.resize(m_RecordVertices.size() + SPRITE_BATCH_VERTICES_PER_SPRITE);
+            vertices = &m_RecordVertices[m_RecordVertices.size() - SPRITE_BATCH_VERTICES_PER_SPRITE];
+        }
+
+        //Build the vertices, in deferred mode the texture slot is set when the records are drawn
         Vector2 textureSize = Vector2((float)aTexture->GetWidth(), (float)aTexture->GetHeight());
-        Vector2 sourceSize = aSourceFrame.size;
+        PackSpriteVertices(vertices, textureSize, aTransformation, aColor, aAnchor, aSourceFrame, (unsigned char)slot);
+        m_SpriteCount++;
+    }
 
-        //Build the UV Coordinates
-        float u1 = 0.0f;
-        float u2 = 1.0f;
-        float v1 = 0.0f;
-        float v2 = 1.0f;
+    unsigned long long SpriteBatch::MakeSortKey(Texture* aTexture, BlendingMode aBlendingMode)
+    {
+        //The ids are masked to fit their bits, two ids sharing a key only means they might not be grouped together,
+        //DrawRecords() compares the actual Texture and blending mode. Sprites with a custom Shader are drawn on their
+        //own (see Sprite::SetShader()), every record in the SpriteBatch is drawn with the SpriteBatch's Shader
+        unsigned long long layer = m_Layer;
+        unsigned long long shader = m_Shader->GetId() & 0xff;
+        unsigned long long texture = aTexture->GetId() & 0xffffff;
+        unsigned long long blendingMode = ((aBlendingMode.source & 0xff) << 8) | (aBlendingMode.destination & 0xff);
+        return (layer << SPRITE_BATCH_LAYER_SHIFT) | (shader << SPRITE_BATCH_SHADER_SHIFT) | (texture << SPRITE_BATCH_TEXTURE_SHIFT) | blendingMode;
+    }
 
-        //Recalculate the UVs if the texture size and source size differ
-        if (textureSize != sourceSize)
+    void SpriteBatch::DrawRecords()
+    {
+        if (m_Records.size() == 0)
         {
-            u1 = (float)aSourceFrame.origin.x / (float)textureSize.x;
-            u2 = (float)(aSourceFrame.origin.x + aSourceFrame.size.x) / (float)textureSize.x;
-            v1 = 1.0f - (((float)aSourceFrame.origin.y + aSourceFrame.size.y) / (float)textureSize.y);
-            v2 = 1.0f - (aSourceFrame.origin.y / (float)textureSize.y);
+            return;
+        }
+
+        //Build the sort items and sort them by key, equal keys stay in submission order
+        m_SortItems.resize(m_Records.size());
+        for (unsigned int i = 0; i < m_Records.size(); i++)
+        {
+            m_SortItems[i].key = m_Records[i].key;
+            m_SortItems[i].index = i;
         }
+        RadixSort(m_SortItems, m_SortScratch);
 
-        //Calculate the vertices
-        Vector2 offsetA = Vector2(0.0f, sourceSize.y) - Vector2(aAnchor.x * sourceSize.x, aAnchor.y * sourceSize.y);
-        Vector2 offsetB = Vector2(sourceSize.x, sourceSize.y) - Vector2(aAnchor.x * sourceSize.x, aAnchor.y * sourceSize.y);
-        Vector2 offsetC = Vector2(sourceSize.x, 0.0f) - Vector2(aAnchor.x * sourceSize.x, aAnchor.y * sourceSize.y);
-        Vector2 offsetD = Vector2(0.0f, 0.0f) - Vector2(aAnchor.x * sourceSize.x, aAnchor.y * sourceSize.y);
+        //Add the sprites to the vertex buffer in sorted order, only flushing when the blending mode changes, the
+        //buffer is full or the texture slots run out
+        VertexBuffer* vertexBuffer = m_VertexData->GetVertexBuffer();
+        for (unsigned int i = 0; i < m_SortItems.size(); i++)
+        {
+            const SpriteBatchRecord& record = m_Records[m_SortItems[i].index];
+            if (m_CurrentBlendingMode != record.blendingMode || vertexBuffer->GetCount() + SPRITE_BATCH_VERTICES_PER_SPRITE > vertexBuffer->GetCapacity())
+            {
+                Flush();
+            }
 
-        //Apply a matrix transformation to each vertices
-        Vector2 vertexA = aTransformation * offsetA;
-        Vector2 vertexB = aTransformation * offsetB;
-        Vector2 vertexC = aTransformation * offsetC;
-        Vector2 vertexD = aTransformation * offsetD;
+            //Get the Texture's slot, flushing if it doesn't fit in the remaining texture slots
+            unsigned int slot = GetTextureSlot(record.texture);
+            if (slot == SPRITE_BATCH_TEXTURE_SLOTS)
+            {
+                Flush();
+                slot = GetTextureSlot(record.texture);
+            }
+
+            //Set the current blending mode
+            m_CurrentBlendingMode = record.blendingMode;
+
+            //Blending is needed if the color isn't opaque, the alpha is the packed color's most significant byte
+            const SpriteVertex* recordVertices = &m_RecordVertices[m_SortItems[i].index * SPRITE_BATCH_VERTICES_PER_SPRITE];
+            if ((recordVertices[0].color >> 24) != 255)
+            {
+                m_HasTranslucentColor = true;
+            }
 
-        //Add the vertices to the vertex buffer
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexA.x, vertexA.y, u1, v2, aColor.r, aColor.g, aColor.b, aColor.a });  //x,y+h,u1,v2
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexB.x, vertexB.y, u2, v2, aColor.r, aColor.g, aColor.b, aColor.a });  //x+w,y+h,u2,v2
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexC.x, vertexC.y, u2, v1, aColor.r, aColor.g, aColor.b, aColor.a });  //x+w,y,u2,v1
-        m_VertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { vertexD.x, vertexD.y, u1, v1, aColor.r, aColor.g, aColor.b, aColor.a });  //x,y,u1,v1
+            //Copy the vertices into the vertex buffer, then set their texture slot
+            SpriteVertex* vertices = vertexBuffer->Emit<SpriteVertex>(SPRITE_BATCH_VERTICES_PER_SPRITE);
+            memcpy(vertices, recordVertices, SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex));
+            for (unsigned int j = 0; j < SPRITE_BATCH_VERTICES_PER_SPRITE; j++)
+            {
+                vertices[j].SetTextureSlot((unsigned char)slot);
+            }
+        }
     }
 
-    void SpriteBatch::Draw(Sprite* aSprite)
+    unsigned int SpriteBatch::GetTextureSlot(Texture* aTexture)
     {
-        if (aSprite != nullptr)
+        //Is the Texture already in a slot? There's only a handful of slots, a linear search is the fastest
+        for (unsigned int i = 0; i < m_TextureCount; i++)
+        {
+            if (m_Textures[i] == aTexture)
+            {
+                return i;
+            }
+        }
+
+        //Are all the slots taken?
+        if (m_TextureCount == SPRITE_BATCH_TEXTURE_SLOTS)
+        {
+            return SPRITE_BATCH_TEXTURE_SLOTS;
+        }
+
+        //Give the Texture the next free slot
+        m_Textures[m_TextureCount] = aTexture;
+        return m_TextureCount++;
+    }
+
+    void SpriteBatch::CreateInstanceData()
+    {
+        //Initialize the instanced Shader and look up the uniform handles once
+        m_InstanceShader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEINSTANCED_SHADER_KEY);
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
         {
-            Draw(aSprite->GetTexture(), aSprite->GetTransformMatrix(), aSprite->GetColor(), aSprite->GetAnchor(), aSprite->GetFrame());
+            m_InstanceTextureUniforms[i] = m_InstanceShader->GetUniformHandle("uniform_textures[" + std::to_string(i) + "]");
         }
+        m_InstanceViewUniform = m_InstanceShader->GetUniformHandle("uniform_view");
+        m_InstanceProjectionUniform = m_InstanceShader->GetUniformHandle("uniform_projection");
+
+        //Create the VertexData object
+        m_InstanceData = new VertexData();
+
+        //The unit quad's corners, in the same order as the vertices of the non-instanced modes
+        std::vector<float> corners = { 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+
+        //Create the static unit quad vertex buffer, it never changes so it's uploaded once
+        VertexBufferDescriptor vertexDescriptor;
+        vertexDescriptor.size = 2;
+        vertexDescriptor.capacity = SPRITE_BATCH_VERTICES_PER_SPRITE;
+        vertexDescriptor.usage = BufferUsage_StaticDraw;
+        vertexDescriptor.attributeIndex = { m_InstanceShader->GetAttributeLocation("in_corner") };
+        vertexDescriptor.attributeSize = { 2 };
+        m_InstanceData->CreateBuffer(vertexDescriptor, &corners);
+
+        //Create the instance buffer, every attribute advances once per instance. The uvs are normalized unsigned shorts,
+        //the color is four normalized bytes and the texture slot is one byte
+        VertexBufferDescriptor instanceDescriptor;
+        instanceDescriptor.size = sizeof(SpriteInstance) / sizeof(float);
+        instanceDescriptor.capacity = SPRITE_BATCH_INSTANCE_COUNT;
+        instanceDescriptor.usage = BufferUsage_DynamicDraw;
+        instanceDescriptor.isRingBuffer = m_IsRingBuffered;
+        instanceDescriptor.attributeIndex = { m_InstanceShader->GetAttributeLocation("in_transformX"), m_InstanceShader->GetAttributeLocation("in_transformY"), m_InstanceShader->GetAttributeLocation("in_uvRect"), m_InstanceShader->GetAttributeLocation("in_anchor"), m_InstanceShader->GetAttributeLocation("in_color"), m_InstanceShader->GetAttributeLocation("in_textureSlot") };
+        instanceDescriptor.attributeSize = { 3, 3, 4, 2, 4, 1 };
+        instanceDescriptor.attributeType = { GraphicType_Float, GraphicType_Float, GraphicType_UnsignedShort, GraphicType_Float, GraphicType_UnsignedByte, GraphicType_UnsignedByte };
+        instanceDescriptor.attributeDivisor = { 1, 1, 1, 1, 1, 1 };
+        m_InstanceData->CreateInstanceBuffer(instanceDescriptor);
+
+        //Create the unit quad's index buffer
+        IndexBufferDescriptor indexDescriptor;
+        indexDescriptor.size = 6;
+        indexDescriptor.capacity = 1;
+        indexDescriptor.usage = BufferUsage_StaticDraw;
+        std::vector<unsigned short> indices = { 1, 2, 0, 0, 2, 3 };
+        m_InstanceData->CreateBuffer(indexDescriptor, &indices);
     }
 
     void SpriteBatch::Flush()
     {
-        //We can't draw anything if there isn't any vertices OR a texture set
-        if (m_VertexData->GetVertexBuffer()->GetCount() == 0 || m_CurrentTexture == nullptr)
+        //Instanced mode draws from its own vertex data
+        if (m_Mode == SpriteBatchMode_Instanced)
         {
+            FlushInstances();
             return;
         }
 
-        //Bind the texture
-        Services::GetGraphics()->BindTexture(m_CurrentTexture);
+        //We can't draw anything if there isn't any vertices OR a texture set
+        if (m_VertexData->GetVertexBuffer()->GetCount() == 0 || m_TextureCount == 0)
+        {
+            return;
+        }
 
         //Cache the Graphics service
         Graphics* graphics = Services::GetGraphics();
@@ -202,11 +667,14 @@ namespace GameDev2D
         //Bind the vertex array object
         m_VertexData->PrepareForDraw();
 
-        //Setup the shader uniforms
-        m_Shader->SetUniformInt("uniform_texture", 0);
-        m_Shader->SetUniformMatrix("uniform_model", Matrix::Identity());
-        m_Shader->SetUniformMatrix("uniform_view", graphics->GetViewMatrix());
-        m_Shader->SetUniformMatrix("uniform_projection", graphics->GetProjectionMatrix());
+        //Setup the shader uniforms, each texture slot samples from the texture unit of the same index
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            m_Shader->SetUniformInt(m_TextureUniforms[i], i);
+        }
+        m_Shader->SetUniformMatrix(m_ModelUniform, AffineMatrix::Identity());
+        m_Shader->SetUniformMatrix(m_ViewUniform, graphics->GetViewMatrix());
+        m_Shader->SetUniformMatrix(m_ProjectionUniform, graphics->GetProjectionMatrix());
 
         //Validate the shader, return if it fails
         if (m_Shader->Validate() == false)
@@ -214,22 +682,23 @@ namespace GameDev2D
             return;
         }
 
-        //Bind the texture
-        graphics->BindTexture(m_CurrentTexture);
+        //Bind the textures to their texture units, blending is needed if any of the textures has an alpha channel
+        bool isBlending = BindTextures() == true || m_HasTranslucentColor == true;
 
-        //Enable blending if the texture has an alpha channel
-        if (m_CurrentTexture->GetPixelFormat().layout == PixelFormat::RGBA /*|| m_Color.a != 1.0f*/)
+        //Enable blending if any of the textures has an alpha channel OR any of the sprites are translucent
+        if (isBlending == true)
         {
-            graphics->EnableBlending(BlendingMode());
+            graphics->EnableBlending(m_CurrentBlendingMode);
         }
 
         //Draw the indices
-        unsigned int sprites = m_VertexData->GetVertexBuffer()->GetCount() / 4;
+        unsigned int sprites = m_VertexData->GetVertexBuffer()->GetCount() / SPRITE_BATCH_VERTICES_PER_SPRITE;
         unsigned int count = sprites * m_VertexData->GetIndexBuffer()->GetSize();
         graphics->DrawElements(RenderMode_Triangles, count, GraphicType_UnsignedShort, 0);
+        m_DrawCallCount++;
 
         //Disable blending, if we did in fact have it enabled
-        if (m_CurrentTexture->GetPixelFormat().layout == PixelFormat::RGBA /*|| m_Color.a != 1.0f*/)
+        if (isBlending == true)
         {
             graphics->DisableBlending();
         }
@@ -237,5 +706,90 @@ namespace GameDev2D
         //This unbind's the vertex array, so its not accidently modified
         m_VertexData->EndDraw();
         m_VertexData->GetVertexBuffer()->ClearVertices();
+        m_HasTranslucentColor = false;
+        m_TextureCount = 0;
+    }
+
+    void SpriteBatch::FlushInstances()
+    {
+        //We can't draw anything if there isn't any instances OR a texture set
+        VertexBuffer* instanceBuffer = m_InstanceData->GetInstanceBuffer();
+        if (instanceBuffer->GetCount() == 0 || m_TextureCount == 0)
+        {
+            return;
+        }
+
+        //Cache the Graphics service
+        Graphics* graphics = Services::GetGraphics();
+
+        //Bind the vertex array object and upload the instances
+        m_InstanceData->PrepareForDraw();
+
+        //Setup the shader uniforms, the instances are already in world space so there's no model matrix
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            m_InstanceShader->SetUniformInt(m_InstanceTextureUniforms[i], i);
+        }
+        m_InstanceShader->SetUniformMatrix(m_InstanceViewUniform, graphics->GetViewMatrix());
+        m_InstanceShader->SetUniformMatrix(m_InstanceProjectionUniform, graphics->GetProjectionMatrix());
+
+        //Validate the shader, return if it fails
+        if (m_InstanceShader->Validate() == false)
+        {
+            return;
+        }
+
+        //Bind the textures to their texture units, blending is needed if any of the textures has an alpha channel
+        bool isBlending = BindTextures() == true || m_HasTranslucentColor == true;
+        if (isBlending == true)
+        {
+            graphics->EnableBlending(m_CurrentBlendingMode);
+        }
+
+        //Draw the unit quad once for each instance
+        unsigned int count = m_InstanceData->GetIndexBuffer()->GetSize();
+        graphics->DrawElementsInstanced(RenderMode_Triangles, count, GraphicType_UnsignedShort, 0, instanceBuffer->GetCount());
+        m_DrawCallCount++;
+
+        //Disable blending, if we did in fact have it enabled
+        if (isBlending == true)
+        {
+            graphics->DisableBlending();
+        }
+
+        //This unbind's the vertex array, so its not accidently modified
+        m_InstanceData->EndDraw();
+        instanceBuffer->ClearVertices();
+        m_HasTranslucentColor = false;
+        m_TextureCount = 0;
+    }
+
+    bool SpriteBatch::BindTextures()
+    {
+        bool hasAlpha = false;
+        for (unsigned int i = 0; i < m_TextureCount; i++)
+        {
+            Services::GetGraphics()->BindTexture(m_Textures[i], i);
+            if (m_Textures[i]->GetPixelFormat().layout == PixelFormat::RGBA)
+            {
+                hasAlpha = true;
+            }
+        }
+        return hasAlpha;
+    }
+
+    unsigned int SpriteBatch::GetSpriteCount()
+    {
+        return m_SpriteCount;
+    }
+
+    unsigned int SpriteBatch::GetDrawCallCount()
+    {
+        return m_DrawCallCount;
+    }
+
+    double SpriteBatch::GetDrawTime()
+    {
+        return m_DrawTime;
     }
 }
\ No newline at end of file
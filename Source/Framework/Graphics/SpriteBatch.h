@@ -3,19 +3,114 @@
 
 #include "GraphicTypes.h"
 #include "Color.h"
+#include "Shader.h"
+#include "SpriteInstance.h"
 #include "VertexData.h"
+#include "VertexFormat.h"
 #include "../Math/Vector2.h"
-#include "../Math/Matrix.h"
+#include "../Math/AffineMatrix.h"
+#include <chrono>
+#include <vector>
 
 
 namespace GameDev2D
 {
     //Local constants
-    const unsigned int SPRITE_BATCH_COUNT = 300;
+    const unsigned int SPRITE_BATCH_COUNT = 300;            //Number of sprites per draw call
+    const unsigned int SPRITE_BATCH_VERTICES_PER_SPRITE = 4;
+    const unsigned int SPRITE_BATCH_INSTANCE_COUNT = 2048;  //Number of sprites per draw call in instanced mode
+    const unsigned int SPRITE_BATCH_TEXTURE_SLOTS = 8;      //Number of textures per draw call, can't exceed GRAPHICS_TEXTURE_UNIT_COUNT or the shader's uniform_textures array
+    const unsigned int SPRITE_BATCH_LAYER_SHIFT = 48;       //Sort key layout, from the most to least significant bits:
+    const unsigned int SPRITE_BATCH_SHADER_SHIFT = 40;      //layer (16 bits), shader (8 bits), texture (24 bits)
+    const unsigned int SPRITE_BATCH_TEXTURE_SHIFT = 16;     //and blending mode (16 bits)
+    const unsigned int SPRITE_BATCH_SORT_RADIX_BITS = 8;
+
+    //Immediate mode draws the sprites in the order they were submitted, each texture is bound to its own texture unit so
+    //the batch only flushes when the blending mode changes or it runs out of texture slots. Deferred mode records the sprites and sorts them by layer, shader, texture and blending mode when End() is
+    //called, sprites on the same layer are drawn grouped by texture and blending mode, but otherwise in submission order.
+    //Instanced mode draws in submission order like immediate mode, but each sprite is packed into one SpriteInstance
+    //and the vertex shader expands a static unit quad, it uses the same texture slots as immediate mode. If the OpenGL
+    //context can't instance it falls back to immediate mode
+    enum SpriteBatchMode
+    {
+        SpriteBatchMode_Immediate = 0,
+        SpriteBatchMode_Deferred,
+        SpriteBatchMode_Instanced
+    };
+
+    //Vertex layout used by the SpriteBatch, it matches the in_vertices, in_uv, in_color and in_textureSlot shader attributes.
+    //The uvs are full 16 bit normalized unsigned shorts, the color is four normalized bytes and the texture slot is a byte
+    //of its own, padded so a vertex is 20 bytes and the floats stay aligned
+    struct SpriteVertex
+    {
+        SpriteVertex() :
+            x(0.0f), y(0.0f),
+            u(0), v(0),
+            color(0),
+            slot(0),
+            padding()
+        {
+        }
+
+        SpriteVertex(Vector2 position, unsigned short u, unsigned short v, unsigned int color, unsigned char slot) :
+            x(position.x), y(position.y),
+            u(u), v(v),
+            color(color),
+            slot(slot),
+            padding()
+        {
+        }
+
+        //Sets the texture slot
+        void SetTextureSlot(unsigned char textureSlot)
+        {
+            slot = textureSlot;
+        }
+
+        //Returns the texture slot
+        unsigned char GetTextureSlot() const
+        {
+            return slot;
+        }
+
+        float x, y;
+        unsigned short u, v;
+        unsigned int color;
+        unsigned char slot;
+        unsigned char padding[3];
+    };
+
+    static_assert(sizeof(SpriteVertex) == 20, "SpriteVertex must stay 20 bytes");
+    static_assert(SPRITE_BATCH_TEXTURE_SLOTS <= 256, "The texture slots don't fit in the SpriteVertex's slot byte");
+
+    //Fills in the four vertices for a sprite, transformed into world space, this is pure CPU work and doesn't touch the
+    //Graphics service. Used to build vertex blocks ahead of time, that are then drawn with SpriteBatch::Draw(texture, vertices, count)
+    void PackSpriteVertices(SpriteVertex* vertices, Vector2 textureSize, const AffineMatrix& transformation, const Color& color, Vector2 anchor, const Rect& sourceFrame, unsigned char textureSlot = 0);
+
+    //A sprite recorded in deferred mode, its vertices are stored separately so the records stay small to sort
+    struct SpriteBatchRecord
+    {
+        SpriteBatchRecord(unsigned long long key, Texture* texture, BlendingMode blendingMode) :
+            key(key),
+            texture(texture),
+            blendingMode(blendingMode)
+        {
+        }
+
+        unsigned long long key;
+        Texture* texture;
+        BlendingMode blendingMode;
+    };
+
+    //The sort key and record index of a deferred sprite, this is what actually gets radix sorted
+    struct SpriteBatchSortItem
+    {
+        unsigned long long key;
+        unsigned int index;
+    };
 
     //Forward declarations
     class Font;
-    class Shader;
     class Sprite;
     class Texture;
 
@@ -23,15 +118,32 @@ namespace GameDev2D
     class SpriteBatch
     {
     public:
-        SpriteBatch();
+        //A SpriteBatch that is shared and flushed several times a frame (such as the Graphics service's) should stream its
+        //vertices through a ring buffer, it costs VERTEX_BUFFER_RING_SIZE times the buffer memory on the GPU
+        SpriteBatch(bool isRingBuffered = false);
         ~SpriteBatch();
 
-        //Called when the SpriteBatch should begin it's rendering
-        void Begin();
+        //Called when the SpriteBatch should begin it's rendering, immediate mode is the default
+        void Begin(SpriteBatchMode mode = SpriteBatchMode_Immediate);
 
-        //Called when the SpriteBatch is done rendering, will flush the contents of the Batch
+        //Called when the SpriteBatch is done rendering, will flush the contents of the Batch. In
+        //deferred mode the recorded sprites are sorted and drawn
         void End();
 
+        //Sets the layer for the sprites drawn after this call, lower layers are drawn first in deferred mode.
+        //Immediate mode always draws in submission order and ignores the layer. Begin() resets the layer to zero
+        void SetLayer(unsigned short layer);
+
+        //Returns the layer for the sprites being drawn
+        unsigned short GetLayer();
+
+        //Sets the blending mode for the textures drawn after this call, Begin() resets the blending mode to the
+        //default. A Sprite is always drawn with its own blending mode
+        void SetBlendingMode(BlendingMode blendingMode);
+
+        //Returns the blending mode for the textures being drawn
+        BlendingMode GetBlendingMode();
+
         //Texture drawing methods
         void Draw(Texture* texture, Vector2 position, float angle, Vector2 scale = Vector2(1.0f, 1.0f));
         void Draw(Texture* texture, Vector2 position, float angle, Vector2 scale, Color color);
@@ -39,22 +151,84 @@ namespace GameDev2D
         void Draw(Texture* texture, Vector2 position, float angle, Vector2 scale, Color color, Vector2 anchor, Rect sourceFrame);
 
         //Texture drawing methods
-        void Draw(Texture* texture, const Matrix& transformation);
-        void Draw(Texture* texture, const Matrix& transformation, Color color);
-        void Draw(Texture* texture, const Matrix& transformation, Color color, Vector2 anchor);
-        void Draw(Texture* texture, const Matrix& transformation, Color color, Vector2 anchor, Rect sourceFrame);
+        void Draw(Texture* texture, const AffineMatrix& transformation);
+        void Draw(Texture* texture, const AffineMatrix& transformation, Color color);
+        void Draw(Texture* texture, const AffineMatrix& transformation, Color color, Vector2 anchor);
+        void Draw(Texture* texture, const AffineMatrix& transformation, Color color, Vector2 anchor, Rect sourceFrame);
 
         //Draws a Sprite
         void Draw(Sprite* sprite);
 
+        //Draws a block of sprites whose vertices were built ahead of time (see PackSpriteVertices), all sampling from the
+        //same Texture. The vertices are copied as is, their texture slot is only rewritten if the Texture ends up in a
+        //different slot than the vertices were built with. Not supported in instanced mode
+        void Draw(Texture* texture, const SpriteVertex* vertices, unsigned int spriteCount);
+
+        //Returns the number of sprites drawn between the last Begin() and End() calls
+        unsigned int GetSpriteCount();
+
+        //Returns the number of draw calls made between the last Begin() and End() calls
+        unsigned int GetDrawCallCount();
+
+        //Returns how long it took from the last Begin() call to the last End() call (in milliseconds), the
+        //sprite count divided by the draw time gives the number of sprites per millisecond
+        double GetDrawTime();
+
     private:
+        //Adds a sprite to the vertex buffer in immediate mode, or records it in deferred mode
+        void AddSprite(Texture* texture, const AffineMatrix& transformation, Color color, Vector2 anchor, Rect sourceFrame, BlendingMode blendingMode);
+
+        //Returns the deferred mode sort key for a sprite
+        unsigned long long MakeSortKey(Texture* texture, BlendingMode blendingMode);
+
+        //Sorts the recorded sprites and adds them to the vertex buffer, flushing whenever the blending mode changes or
+        //the texture slots run out
+        void DrawRecords();
+
+        //Returns the texture slot the Texture is bound to for the next draw call, the Texture is given the next free slot
+        //if it doesn't have one. Returns SPRITE_BATCH_TEXTURE_SLOTS if all the slots are taken
+        unsigned int GetTextureSlot(Texture* texture);
+
+        //Creates the instanced shader's static unit quad and instance buffer, the first time instanced mode is used
+        void CreateInstanceData();
+
+        //Binds the textures to the texture units of their slots, returns true if any of the textures has an alpha channel
+        bool BindTextures();
+
         //Draws the contents of the SpriteBatch
         void Flush();
 
+        //Draws the contents of the instance buffer, in instanced mode
+        void FlushInstances();
+
         //Member variables
         Shader* m_Shader;
+        UniformHandle m_TextureUniforms[SPRITE_BATCH_TEXTURE_SLOTS];
+        UniformHandle m_ModelUniform;
+        UniformHandle m_ViewUniform;
+        UniformHandle m_ProjectionUniform;
         VertexData* m_VertexData;
-        Texture* m_CurrentTexture;
+        Shader* m_InstanceShader;
+        UniformHandle m_InstanceTextureUniforms[SPRITE_BATCH_TEXTURE_SLOTS];
+        UniformHandle m_InstanceViewUniform;
+        UniformHandle m_InstanceProjectionUniform;
+        VertexData* m_InstanceData;
+        Texture* m_Textures[SPRITE_BATCH_TEXTURE_SLOTS];
+        unsigned int m_TextureCount;
+        BlendingMode m_CurrentBlendingMode;
+        bool m_HasTranslucentColor;
+        BlendingMode m_BlendingMode;
+        SpriteBatchMode m_Mode;
+        unsigned short m_Layer;
+        std::vector<SpriteBatchRecord> m_Records;
+        std::vector<SpriteVertex> m_RecordVertices;
+        std::vector<SpriteBatchSortItem> m_SortItems;
+        std::vector<SpriteBatchSortItem> m_SortScratch;
+        std::chrono::high_resolution_clock::time_point m_BeginTime;
+        unsigned int m_SpriteCount;
+        unsigned int m_DrawCallCount;
+        double m_DrawTime;
+        bool m_IsRingBuffered;
         bool m_Lock;
     };
 }
@@ -0,0 +1,48 @@
+#include "SpriteInstance.h"
+
+
+namespace GameDev2D
+{
+    void PackSpriteInstance(SpriteInstance* aInstance, Vector2 aTextureSize, const AffineMatrix& aTransformation, const Color& aColor, Vector2 aAnchor, const Rect& aSourceFrame, unsigned char aTextureSlot)
+    {
+        Vector2 sourceSize = aSourceFrame.size;
+
+        //Fold the source frame's size into the 2x3 transform, the shader's unit quad then only has to be offset by the anchor
+        aInstance->transformX[0] = aTransformation.m[0][0] * sourceSize.x;
+        aInstance->transformX[1] = aTransformation.m[1][0] * sourceSize.y;
+        aInstance->transformX[2] = aTransformation.m[2][0];
+        aInstance->transformY[0] = aTransformation.m[0][1] * sourceSize.x;
+        aInstance->transformY[1] = aTransformation.m[1][1] * sourceSize.y;
+        aInstance->transformY[2] = aTransformation.m[2][1];
+
+        //Build the UV Coordinates, they are only recalculated if the texture size and source size differ
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+        float u2 = 1.0f;
+        float v2 = 1.0f;
+
+        if (aTextureSize != sourceSize)
+        {
+            u1 = aSourceFrame.origin.x / aTextureSize.x;
+            v1 = 1.0f - ((aSourceFrame.origin.y + sourceSize.y) / aTextureSize.y);
+            u2 = (aSourceFrame.origin.x + sourceSize.x) / aTextureSize.x;
+            v2 = 1.0f - (aSourceFrame.origin.y / aTextureSize.y);
+        }
+
+        aInstance->uvRect[0] = PackUnsignedNormalized(u1);
+        aInstance->uvRect[1] = PackUnsignedNormalized(v1);
+        aInstance->uvRect[2] = PackUnsignedNormalized(u2);
+        aInstance->uvRect[3] = PackUnsignedNormalized(v2);
+
+        //Set the anchor and color
+        aInstance->anchor[0] = aAnchor.x;
+        aInstance->anchor[1] = aAnchor.y;
+        aInstance->color = PackColor(aColor);
+
+        //Set the texture slot, the padding is zeroed so the uploaded bytes are deterministic
+        aInstance->textureSlot = aTextureSlot;
+        aInstance->padding[0] = 0;
+        aInstance->padding[1] = 0;
+        aInstance->padding[2] = 0;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef __GameDev2D__SpriteInstance__
+#define __GameDev2D__SpriteInstance__
+
+#include "GraphicTypes.h"
+#include "Color.h"
+#include "VertexFormat.h"
+#include "../Math/Vector2.h"
+#include "../Math/AffineMatrix.h"
+
+
+namespace GameDev2D
+{
+    //Per-sprite record used by the SpriteBatch's instanced mode, it matches the instanced shader's attributes. The vertex
+    //shader expands a static unit quad with it, each corner is: transform * (corner - anchor), so the transform already
+    //has the source frame's size folded into it. One instance is 48 bytes, compared to 80 bytes for four SpriteVertex
+    struct SpriteInstance
+    {
+        float transformX[3];            //First row of the 2x3 transform: m00, m01, translation x
+        float transformY[3];            //Second row of the 2x3 transform: m10, m11, translation y
+        unsigned short uvRect[4];       //u1, v1, u2, v2, normalized unsigned shorts
+        float anchor[2];                //Kept as floats, the anchor is scaled by the source frame's size
+        unsigned int color;             //RGBA, one byte per component in memory order
+        unsigned char textureSlot;      //The SpriteBatch texture slot the sprite samples from
+        unsigned char padding[3];
+    };
+
+    //Fills in an instance record for a sprite, this is pure CPU work and doesn't touch the Graphics service, the
+    //quad it describes is identical to the four vertices the SpriteBatch builds for the same sprite
+    void PackSpriteInstance(SpriteInstance* instance, Vector2 textureSize, const AffineMatrix& transformation, const Color& color, Vector2 anchor, const Rect& sourceFrame, unsigned char textureSlot = 0);
+}
+
+#endif
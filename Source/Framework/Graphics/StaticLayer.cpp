@@ -0,0 +1,557 @@
+#include "StaticLayer.h"
+#include "RenderTarget.h"
+#include "Sprite.h"
+#include "Texture.h"
+#include "VertexData.h"
+#include "../Services/Services.h"
+#include "../Services/Graphics/Graphics.h"
+#include "../Debug/Log.h"
+#include <algorithm>
+#include <assert.h>
+
+
+namespace GameDev2D
+{
+    StaticLayer::StaticLayer(unsigned int aCapacity) :
+        m_Mode(StaticLayerMode_VertexBuffer),
+        m_Shader(nullptr),
+        m_TextureUniforms(),
+        m_ModelUniform(SHADER_INVALID_UNIFORM),
+        m_ViewUniform(SHADER_INVALID_UNIFORM),
+        m_ProjectionUniform(SHADER_INVALID_UNIFORM),
+        m_VertexData(nullptr),
+        m_Sprites(),
+        m_Bounds(),
+        m_IsTranslucent(),
+        m_SpriteSlots(),
+        m_Textures(),
+        m_TextureReferences(),
+        m_TextureCount(0),
+        m_BlendingMode(BlendingMode()),
+        m_DirtyBegin(0),
+        m_DirtyEnd(0),
+        m_TranslucentCount(0),
+        m_RenderBounds(),
+        m_RenderTexture(nullptr),
+        m_RenderTarget(nullptr),
+        m_RenderSprite(nullptr),
+        m_DirtyRegion(),
+        m_IsRegionDirty(false)
+    {
+        Initialize(aCapacity);
+    }
+
+    StaticLayer::StaticLayer(const Rect& aBounds, unsigned int aCapacity) :
+        m_Mode(StaticLayerMode_RenderTarget),
+        m_Shader(nullptr),
+        m_TextureUniforms(),
+        m_ModelUniform(SHADER_INVALID_UNIFORM),
+        m_ViewUniform(SHADER_INVALID_UNIFORM),
+        m_ProjectionUniform(SHADER_INVALID_UNIFORM),
+        m_VertexData(nullptr),
+        m_Sprites(),
+        m_Bounds(),
+        m_IsTranslucent(),
+        m_SpriteSlots(),
+        m_Textures(),
+        m_TextureReferences(),
+        m_TextureCount(0),
+        m_BlendingMode(BlendingMode()),
+        m_DirtyBegin(0),
+        m_DirtyEnd(0),
+        m_TranslucentCount(0),
+        m_RenderBounds(aBounds),
+        m_RenderTexture(nullptr),
+        m_RenderTarget(nullptr),
+        m_RenderSprite(nullptr),
+        m_DirtyRegion(),
+        m_IsRegionDirty(false)
+    {
+        //If this assert is hit, the bounds are empty
+        assert(aBounds.size.x >= 1.0f && aBounds.size.y >= 1.0f);
+
+        Initialize(aCapacity);
+
+        //Create the Texture and RenderTarget the Sprites are rendered into, one texel per pixel
+        PixelFormat format = PixelFormat(PixelFormat::RGBA, PixelFormat::UnsignedByte);
+        m_RenderTexture = new Texture(ImageData(format, (unsigned int)ceilf(aBounds.size.x), (unsigned int)ceilf(aBounds.size.y)));
+        m_RenderTarget = new RenderTarget(m_RenderTexture);
+
+        //The RenderTarget's texture is drawn as a Sprite, its bottom left corner at the bounds' origin
+        m_RenderSprite = new Sprite(m_RenderTexture);
+        m_RenderSprite->SetPosition(aBounds.origin);
+
+        //The RenderTarget starts out empty, clear all of it the first time the layer is drawn
+        AddDirtyRegion(aBounds);
+    }
+
+    StaticLayer::~StaticLayer()
+    {
+        if (m_RenderSprite != nullptr)
+        {
+            delete m_RenderSprite;
+            m_RenderSprite = nullptr;
+        }
+
+        if (m_RenderTarget != nullptr)
+        {
+            delete m_RenderTarget;
+            m_RenderTarget = nullptr;
+        }
+
+        if (m_RenderTexture != nullptr)
+        {
+            delete m_RenderTexture;
+            m_RenderTexture = nullptr;
+        }
+
+        if (m_VertexData != nullptr)
+        {
+            delete m_VertexData;
+            m_VertexData = nullptr;
+        }
+    }
+
+    bool StaticLayer::Add(Sprite* aSprite)
+    {
+        //If this assert is hit, the Sprite or its Texture is null
+        assert(aSprite != nullptr && aSprite->GetTexture() != nullptr);
+
+        //Is the layer full? Create it with a larger capacity
+        if (m_Sprites.size() == m_VertexData->GetIndexBuffer()->GetCapacity())
+        {
+            Log::Error(this, "StaticLayer", false, Log::Verbosity_Graphics, "Add() failed, the layer is full");
+            return false;
+        }
+
+        //Are all the texture slots taken by other Textures? The Sprite has to be drawn in another layer
+        unsigned int slot = AcquireTextureSlot(aSprite->GetTexture());
+        if (slot == SPRITE_BATCH_TEXTURE_SLOTS)
+        {
+            Log::Error(this, "StaticLayer", false, Log::Verbosity_Graphics, "Add() failed, the layer already has %u different textures", SPRITE_BATCH_TEXTURE_SLOTS);
+            return false;
+        }
+
+        //Reserve the Sprite's vertices at the end of the vertex buffer, they are packed when the layer is drawn
+        m_Sprites.push_back(aSprite);
+        m_Bounds.push_back(aSprite->GetWorldBounds());
+        m_IsTranslucent.push_back(false);
+        m_SpriteSlots.push_back(slot);
+        m_VertexData->GetVertexBuffer()->Emit<SpriteVertex>(SPRITE_BATCH_VERTICES_PER_SPRITE);
+        AddDirtySprites((unsigned int)m_Sprites.size() - 1, (unsigned int)m_Sprites.size());
+        return true;
+    }
+
+    void StaticLayer::Remove(Sprite* aSprite)
+    {
+        std::vector<Sprite*>::iterator iterator = std::find(m_Sprites.begin(), m_Sprites.end(), aSprite);
+        if (iterator == m_Sprites.end())
+        {
+            return;
+        }
+
+        //The region the Sprite covered has to be redrawn
+        unsigned int index = (unsigned int)(iterator - m_Sprites.begin());
+        AddDirtyRegion(m_Bounds.at(index));
+
+        //The layer only blends while it has translucent Sprites
+        if (m_IsTranslucent.at(index) == true)
+        {
+            m_TranslucentCount--;
+        }
+
+        //Release the Sprite's texture slot, it's freed if no other Sprite uses its Texture
+        ReleaseTextureSlot(m_SpriteSlots.at(index));
+
+        //The Sprites after it move down to fill the gap, so the draw order is kept, and they have to be rebuilt
+        m_Sprites.erase(iterator);
+        m_Bounds.erase(m_Bounds.begin() + index);
+        m_IsTranslucent.erase(m_IsTranslucent.begin() + index);
+        m_SpriteSlots.erase(m_SpriteSlots.begin() + index);
+        m_VertexData->GetVertexBuffer()->RemoveVertices(SPRITE_BATCH_VERTICES_PER_SPRITE);
+        AddDirtySprites(index, (unsigned int)m_Sprites.size());
+    }
+
+    void StaticLayer::Clear()
+    {
+        //The region the Sprites covered has to be redrawn
+        for (unsigned int i = 0; i < m_Bounds.size(); i++)
+        {
+            AddDirtyRegion(m_Bounds.at(i));
+        }
+
+        //Reset the baked contents, there's nothing left to rebuild
+        m_Sprites.clear();
+        m_Bounds.clear();
+        m_IsTranslucent.clear();
+        m_SpriteSlots.clear();
+        m_TranslucentCount = 0;
+        m_DirtyBegin = 0;
+        m_DirtyEnd = 0;
+        m_VertexData->GetVertexBuffer()->ClearVertices();
+
+        //Free the texture slots
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            m_Textures[i] = nullptr;
+            m_TextureReferences[i] = 0;
+        }
+        m_TextureCount = 0;
+    }
+
+    void StaticLayer::MarkDirty(Sprite* aSprite)
+    {
+        std::vector<Sprite*>::iterator iterator = std::find(m_Sprites.begin(), m_Sprites.end(), aSprite);
+
+        //If this assert is hit, the Sprite hasn't been added to the layer
+        assert(iterator != m_Sprites.end());
+
+        unsigned int index = (unsigned int)(iterator - m_Sprites.begin());
+        AddDirtySprites(index, index + 1);
+    }
+
+    void StaticLayer::MarkDirty()
+    {
+        AddDirtySprites(0, (unsigned int)m_Sprites.size());
+    }
+
+    void StaticLayer::Draw()
+    {
+        //Pack the Sprites that changed, nothing is packed if the layer hasn't changed
+        Rebuild();
+
+        //Cache the Graphics service
+        Graphics* graphics = Services::GetGraphics();
+
+        if (m_Mode == StaticLayerMode_VertexBuffer)
+        {
+            if (m_Sprites.size() > 0)
+            {
+                DrawVertices(graphics->GetViewMatrix(), graphics->GetProjectionMatrix());
+            }
+            return;
+        }
+
+        //Redraw the part of the RenderTarget that changed, the view maps the bounds onto the RenderTarget
+        if (m_IsRegionDirty == true)
+        {
+            Rect region(m_DirtyRegion.origin - m_RenderBounds.origin, m_DirtyRegion.size);
+            m_RenderTarget->Begin(region);
+
+            if (m_Sprites.size() > 0)
+            {
+                Vector2 center = m_RenderBounds.origin + m_RenderBounds.size * 0.5f;
+                DrawVertices(AffineMatrix::Make(-center, 0.0f), graphics->GetProjectionMatrix());
+            }
+
+            m_RenderTarget->End();
+            m_IsRegionDirty = false;
+        }
+
+        //Draw the RenderTarget's texture
+        m_RenderSprite->Draw();
+    }
+
+    void StaticLayer::SetBlendingMode(BlendingMode aBlendingMode)
+    {
+        m_BlendingMode = aBlendingMode;
+
+        //The RenderTarget was drawn with the old blending mode
+        if (m_Mode == StaticLayerMode_RenderTarget)
+        {
+            AddDirtyRegion(m_RenderBounds);
+        }
+    }
+
+    BlendingMode StaticLayer::GetBlendingMode()
+    {
+        return m_BlendingMode;
+    }
+
+    StaticLayerMode StaticLayer::GetMode()
+    {
+        return m_Mode;
+    }
+
+    unsigned int StaticLayer::GetCount()
+    {
+        return (unsigned int)m_Sprites.size();
+    }
+
+    unsigned int StaticLayer::GetTextureCount()
+    {
+        return m_TextureCount;
+    }
+
+    void StaticLayer::Initialize(unsigned int aCapacity)
+    {
+        //If this assert is hit, the capacity is zero OR the sprites' vertices can't be indexed with unsigned shorts
+        assert(aCapacity > 0 && aCapacity <= STATIC_LAYER_MAX_CAPACITY);
+
+        //The layer is drawn with the SpriteBatch's shader, the vertices are the same
+        m_Shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
+
+        //Look up the uniform handles once, DrawVertices() sets the uniforms with them
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            m_TextureUniforms[i] = m_Shader->GetUniformHandle("uniform_textures[" + std::to_string(i) + "]");
+        }
+        m_ModelUniform = m_Shader->GetUniformHandle("uniform_model");
+        m_ViewUniform = m_Shader->GetUniformHandle("uniform_view");
+        m_ProjectionUniform = m_Shader->GetUniformHandle("uniform_projection");
+
+        //Create the VertexData object
+        m_VertexData = new VertexData();
+
+        //The vertex buffer is static, it isn't a ring buffer, so it keeps its vertices between frames and only
+        //uploads the ones that were packed since the last time it was drawn
+        VertexBufferDescriptor vertexDescriptor;
+        vertexDescriptor.size = sizeof(SpriteVertex) / sizeof(float);
+        vertexDescriptor.capacity = aCapacity * SPRITE_BATCH_VERTICES_PER_SPRITE;
+        vertexDescriptor.usage = BufferUsage_StaticDraw;
+        vertexDescriptor.attributeIndex = { m_Shader->GetAttributeLocation("in_vertices"), m_Shader->GetAttributeLocation("in_uv"), m_Shader->GetAttributeLocation("in_color"), m_Shader->GetAttributeLocation("in_textureSlot") };
+        vertexDescriptor.attributeSize = { 2, 2, 4, 1 };
+        vertexDescriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedShort, GraphicType_UnsignedByte, GraphicType_UnsignedByte };
+        m_VertexData->CreateBuffer(vertexDescriptor);
+
+        //Initialize the indices, two triangles per sprite, the same as the SpriteBatch
+        IndexBufferDescriptor indexDescriptor;
+        indexDescriptor.size = 6;
+        indexDescriptor.capacity = aCapacity;
+        indexDescriptor.usage = BufferUsage_StaticDraw;
+
+        std::vector<unsigned short> indices;
+        for (unsigned int i = 0; i < aCapacity; i++)
+        {
+            indices.push_back(i * 4 + 1);
+            indices.push_back(i * 4 + 2);
+            indices.push_back(i * 4 + 0);
+            indices.push_back(i * 4 + 0);
+            indices.push_back(i * 4 + 2);
+            indices.push_back(i * 4 + 3);
+        }
+        m_VertexData->CreateBuffer(indexDescriptor, &indices);
+    }
+
+    unsigned int StaticLayer::AcquireTextureSlot(Texture* aTexture)
+    {
+        //Is the Texture already in a slot? Keep track of the first free slot while looking, freed slots leave gaps
+        unsigned int freeSlot = SPRITE_BATCH_TEXTURE_SLOTS;
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            if (m_Textures[i] == aTexture)
+            {
+                m_TextureReferences[i]++;
+                return i;
+            }
+            else if (m_Textures[i] == nullptr && freeSlot == SPRITE_BATCH_TEXTURE_SLOTS)
+            {
+                freeSlot = i;
+            }
+        }
+
+        //Are all the slots taken?
+        if (freeSlot == SPRITE_BATCH_TEXTURE_SLOTS)
+        {
+            return SPRITE_BATCH_TEXTURE_SLOTS;
+        }
+
+        //Give the Texture the free slot
+        m_Textures[freeSlot] = aTexture;
+        m_TextureReferences[freeSlot] = 1;
+        m_TextureCount++;
+        return freeSlot;
+    }
+
+    void StaticLayer::ReleaseTextureSlot(unsigned int aSlot)
+    {
+        //A Sprite whose Texture didn't fit doesn't hold a slot
+        if (aSlot == SPRITE_BATCH_TEXTURE_SLOTS)
+        {
+            return;
+        }
+
+        //If this assert is hit, the slot has already been freed
+        assert(m_TextureReferences[aSlot] > 0);
+
+        //Free the slot once the last Sprite using its Texture releases it
+        m_TextureReferences[aSlot]--;
+        if (m_TextureReferences[aSlot] == 0)
+        {
+            m_Textures[aSlot] = nullptr;
+            m_TextureCount--;
+        }
+    }
+
+    void StaticLayer::AddDirtySprites(unsigned int aFirst, unsigned int aLast)
+    {
+        if (aFirst >= aLast)
+        {
+            return;
+        }
+
+        //Grow the dirty range to include the Sprites
+        if (m_DirtyBegin >= m_DirtyEnd)
+        {
+            m_DirtyBegin = aFirst;
+            m_DirtyEnd = aLast;
+        }
+        else
+        {
+            m_DirtyBegin = std::min<unsigned int>(m_DirtyBegin, aFirst);
+            m_DirtyEnd = std::max<unsigned int>(m_DirtyEnd, aLast);
+        }
+    }
+
+    void StaticLayer::AddDirtyRegion(const Rect& aBounds)
+    {
+        if (m_Mode != StaticLayerMode_RenderTarget)
+        {
+            return;
+        }
+
+        //Grow the dirty region to include the bounds
+        Vector2 lower = aBounds.origin;
+        Vector2 upper = aBounds.origin + aBounds.size;
+        if (m_IsRegionDirty == true)
+        {
+            lower = Vector2(std::min<float>(lower.x, m_DirtyRegion.origin.x), std::min<float>(lower.y, m_DirtyRegion.origin.y));
+            upper = Vector2(std::max<float>(upper.x, m_DirtyRegion.origin.x + m_DirtyRegion.size.x), std::max<float>(upper.y, m_DirtyRegion.origin.y + m_DirtyRegion.size.y));
+        }
+
+        //Clamp the region to the RenderTarget's bounds, there's nothing to redraw outside of them
+        Vector2 renderLower = m_RenderBounds.origin;
+        Vector2 renderUpper = m_RenderBounds.origin + m_RenderBounds.size;
+        lower = Vector2(std::max<float>(lower.x, renderLower.x), std::max<float>(lower.y, renderLower.y));
+        upper = Vector2(std::min<float>(upper.x, renderUpper.x), std::min<float>(upper.y, renderUpper.y));
+        if (lower.x >= upper.x || lower.y >= upper.y)
+        {
+            return;
+        }
+
+        m_DirtyRegion = Rect(lower, upper - lower);
+        m_IsRegionDirty = true;
+    }
+
+    void StaticLayer::Rebuild()
+    {
+        if (m_DirtyBegin >= m_DirtyEnd)
+        {
+            return;
+        }
+
+        //Pack the dirty Sprites straight into the vertex buffer, only the packed vertices are uploaded
+        unsigned int last = std::min<unsigned int>(m_DirtyEnd, (unsigned int)m_Sprites.size());
+        for (unsigned int i = m_DirtyBegin; i < last; i++)
+        {
+            Sprite* sprite = m_Sprites.at(i);
+            Texture* texture = sprite->GetTexture();
+            SpriteVertex* vertices = m_VertexData->GetVertexBuffer()->Modify<SpriteVertex>(i * SPRITE_BATCH_VERTICES_PER_SPRITE, SPRITE_BATCH_VERTICES_PER_SPRITE);
+
+            //The Sprite's Texture may have changed since it was last built, its old slot is released first so it can be
+            //reused. If there's no slot left for it the Sprite's vertices are collapsed so it isn't drawn with another slot's Texture
+            unsigned int slot = m_SpriteSlots.at(i);
+            if (slot == SPRITE_BATCH_TEXTURE_SLOTS || m_Textures[slot] != texture)
+            {
+                ReleaseTextureSlot(slot);
+                slot = AcquireTextureSlot(texture);
+                m_SpriteSlots.at(i) = slot;
+            }
+
+            bool isTranslucent = false;
+            if (slot == SPRITE_BATCH_TEXTURE_SLOTS)
+            {
+                Log::Error(this, "StaticLayer", false, Log::Verbosity_Graphics, "Rebuild() failed to pack a Sprite, the layer already has %u different textures", SPRITE_BATCH_TEXTURE_SLOTS);
+                memset(vertices, 0, sizeof(SpriteVertex) * SPRITE_BATCH_VERTICES_PER_SPRITE);
+            }
+            else
+            {
+                Vector2 textureSize = Vector2((float)texture->GetWidth(), (float)texture->GetHeight());
+                PackSpriteVertices(vertices, textureSize, sprite->GetTransformMatrix(), sprite->GetColor(), sprite->GetAnchor(), sprite->GetFrame(), (unsigned char)slot);
+                isTranslucent = sprite->GetColor().a != 1.0f;
+            }
+
+            //Blending is needed while any of the Sprites is built with a color that isn't opaque
+            if (m_IsTranslucent.at(i) != isTranslucent)
+            {
+                m_IsTranslucent.at(i) = isTranslucent;
+                if (isTranslucent == true)
+                {
+                    m_TranslucentCount++;
+                }
+                else
+                {
+                    m_TranslucentCount--;
+                }
+            }
+
+            //The region the Sprite covered before and covers now has to be redrawn
+            Rect bounds = sprite->GetWorldBounds();
+            AddDirtyRegion(m_Bounds.at(i));
+            AddDirtyRegion(bounds);
+            m_Bounds.at(i) = bounds;
+        }
+
+        m_DirtyBegin = 0;
+        m_DirtyEnd = 0;
+    }
+
+    void StaticLayer::DrawVertices(const AffineMatrix& aView, const Matrix& aProjection)
+    {
+        //Cache the Graphics service
+        Graphics* graphics = Services::GetGraphics();
+
+        //Bind the vertex array object, the vertex buffer uploads any vertices that were packed
+        m_VertexData->PrepareForDraw();
+
+        //Setup the shader uniforms, each texture slot samples from the texture unit of the same index
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            m_Shader->SetUniformInt(m_TextureUniforms[i], i);
+        }
+        m_Shader->SetUniformMatrix(m_ModelUniform, AffineMatrix::Identity());
+        m_Shader->SetUniformMatrix(m_ViewUniform, aView);
+        m_Shader->SetUniformMatrix(m_ProjectionUniform, aProjection);
+
+        //Validate the shader, return if it fails
+        if (m_Shader->Validate() == false)
+        {
+            m_VertexData->EndDraw();
+            return;
+        }
+
+        //Bind the textures to their texture units, blending is needed if any of the textures has an alpha channel. The
+        //free slots aren't sampled by any of the Sprites
+        bool isBlending = m_TranslucentCount > 0;
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            if (m_Textures[i] != nullptr)
+            {
+                graphics->BindTexture(m_Textures[i], i);
+                if (m_Textures[i]->GetPixelFormat().layout == PixelFormat::RGBA)
+                {
+                    isBlending = true;
+                }
+            }
+        }
+
+        //Enable blending if any of the textures has an alpha channel OR any of the sprites are translucent
+        if (isBlending == true)
+        {
+            graphics->EnableBlending(m_BlendingMode);
+        }
+
+        //Draw the whole layer with one draw call
+        unsigned int count = (unsigned int)m_Sprites.size() * m_VertexData->GetIndexBuffer()->GetSize();
+        graphics->DrawElements(RenderMode_Triangles, count, GraphicType_UnsignedShort, 0);
+
+        //Disable blending, if we did in fact have it enabled
+        if (isBlending == true)
+        {
+            graphics->DisableBlending();
+        }
+
+        //This unbind's the vertex array, so its not accidently modified
+        m_VertexData->EndDraw();
+    }
+}
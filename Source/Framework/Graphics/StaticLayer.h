@@ -0,0 +1,136 @@
+#ifndef __GameDev2D__StaticLayer__
+#define __GameDev2D__StaticLayer__
+
+#include "GraphicTypes.h"
+#include "Shader.h"
+#include "SpriteBatch.h"
+#include "../Math/AffineMatrix.h"
+#include "../Math/Matrix.h"
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int STATIC_LAYER_DEFAULT_CAPACITY = 1024;    //Number of sprites a StaticLayer can hold
+    const unsigned int STATIC_LAYER_MAX_CAPACITY = 16384;       //The indices are unsigned shorts, each sprite has four vertices
+
+    //Forward declarations
+    class RenderTarget;
+    class Sprite;
+    class Texture;
+    class VertexData;
+
+    //Enum to help manage how a StaticLayer is drawn
+    enum StaticLayerMode
+    {
+        StaticLayerMode_VertexBuffer = 0,   //The Sprites are baked into a persistent vertex buffer, drawn with one draw call
+        StaticLayerMode_RenderTarget        //The vertex buffer is also rendered into a cached RenderTarget, only its texture is drawn
+    };
+
+    //A StaticLayer is for Sprites that hardly ever change, such as a background or a level's props. The Sprites are
+    //registered once and baked into a vertex buffer that stays on the GPU, drawing the layer doesn't touch the Sprites'
+    //vertices, it's one draw call. When a Sprite changes (position, frame, color etc) call MarkDirty(), only the dirty
+    //Sprites are packed and uploaded again, and in RenderTarget mode only the region they cover is redrawn.
+    //The layer can hold up to SPRITE_BATCH_TEXTURE_SLOTS different textures at a time, a Texture's slot is freed once the
+    //last Sprite using it is removed. The Sprites are drawn in the order they were added with the layer's blending mode.
+    //The StaticLayer doesn't own the Sprites, remove them before deleting them
+    class StaticLayer
+    {
+    public:
+        //Creates a StaticLayer that bakes its Sprites into a persistent vertex buffer
+        StaticLayer(unsigned int capacity = STATIC_LAYER_DEFAULT_CAPACITY);
+
+        //Creates a StaticLayer that renders its Sprites into a cached RenderTarget covering the world space bounds, each
+        //frame only the RenderTarget's texture is drawn. The parts of the Sprites outside of the bounds aren't drawn
+        StaticLayer(const Rect& bounds, unsigned int capacity = STATIC_LAYER_DEFAULT_CAPACITY);
+        ~StaticLayer();
+
+        //Adds a Sprite to the layer, it's drawn after the Sprites that were added before it. Returns false if the
+        //layer is full OR the Sprite's Texture would be the layer's (SPRITE_BATCH_TEXTURE_SLOTS + 1)th Texture
+        bool Add(Sprite* sprite);
+
+        //Removes a Sprite from the layer, the Sprites that were added after it have to be rebuilt
+        void Remove(Sprite* sprite);
+
+        //Removes all the Sprites from the layer and frees its texture slots
+        void Clear();
+
+        //Call after a Sprite in the layer has changed, it will be rebuilt the next time the layer is drawn
+        void MarkDirty(Sprite* sprite);
+
+        //Rebuilds all the Sprites in the layer the next time it's drawn
+        void MarkDirty();
+
+        //Rebuilds the dirty Sprites, then draws the layer
+        void Draw();
+
+        //Sets the blending mode the layer is drawn with
+        void SetBlendingMode(BlendingMode blendingMode);
+
+        //Returns the blending mode the layer is drawn with
+        BlendingMode GetBlendingMode();
+
+        //Returns how the layer is drawn
+        StaticLayerMode GetMode();
+
+        //Returns the number of Sprites in the layer
+        unsigned int GetCount();
+
+        //Returns the number of different Textures in the layer, each one takes a texture slot
+        unsigned int GetTextureCount();
+
+    private:
+        //Creates the shader uniforms and the VertexData, called by both constructors
+        void Initialize(unsigned int capacity);
+
+        //Adds a reference to the Texture's slot and returns the slot, a Texture that isn't in a slot yet is given the
+        //first free slot. Returns SPRITE_BATCH_TEXTURE_SLOTS if all the slots are taken
+        unsigned int AcquireTextureSlot(Texture* texture);
+
+        //Removes a reference to the slot, the slot is freed when its last Sprite releases it
+        void ReleaseTextureSlot(unsigned int slot);
+
+        //Marks a range of Sprites as dirty
+        void AddDirtySprites(unsigned int first, unsigned int last);
+
+        //Adds a world space rect to the region of the RenderTarget that has to be redrawn
+        void AddDirtyRegion(const Rect& bounds);
+
+        //Packs the dirty Sprites' vertices, the VertexBuffer only uploads the vertices that were packed
+        void Rebuild();
+
+        //Draws the vertex buffer with a single draw call
+        void DrawVertices(const AffineMatrix& view, const Matrix& projection);
+
+        //Member variables
+        StaticLayerMode m_Mode;
+        Shader* m_Shader;
+        UniformHandle m_TextureUniforms[SPRITE_BATCH_TEXTURE_SLOTS];
+        UniformHandle m_ModelUniform;
+        UniformHandle m_ViewUniform;
+        UniformHandle m_ProjectionUniform;
+        VertexData* m_VertexData;
+        std::vector<Sprite*> m_Sprites;
+        std::vector<Rect> m_Bounds;             //The world bounds each Sprite was last built with
+        std::vector<bool> m_IsTranslucent;      //Whether each Sprite was last built with a translucent color
+        std::vector<unsigned int> m_SpriteSlots;    //The texture slot each Sprite holds a reference to
+        Texture* m_Textures[SPRITE_BATCH_TEXTURE_SLOTS];
+        unsigned int m_TextureReferences[SPRITE_BATCH_TEXTURE_SLOTS];
+        unsigned int m_TextureCount;
+        BlendingMode m_BlendingMode;
+        unsigned int m_DirtyBegin;
+        unsigned int m_DirtyEnd;
+        unsigned int m_TranslucentCount;
+
+        //RenderTarget mode members
+        Rect m_RenderBounds;
+        Texture* m_RenderTexture;
+        RenderTarget* m_RenderTarget;
+        Sprite* m_RenderSprite;
+        Rect m_DirtyRegion;
+        bool m_IsRegionDirty;
+    };
+}
+
+#endif
@@ -1,14 +1,23 @@
 #include "VertexData.h"
 #include "../Services/Services.h"
+#include <string.h>
 
 
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
 namespace GameDev2D
 {
+    //Returns the size (in bytes) of one component of the graphic type
+    static unsigned int GetGraphicTypeSize(GraphicType aType)
+    {
+        unsigned int sizes[] = { sizeof(char), sizeof(unsigned char), sizeof(short), sizeof(unsigned short), sizeof(int), sizeof(unsigned int), sizeof(float), sizeof(double), sizeof(unsigned short) };
+        return sizes[aType];
+    }
+
     VertexData::VertexData() :
         m_VertexArray(0),
         m_VertexBuffer(nullptr),
+        m_InstanceBuffer(nullptr),
         m_IndexBuffer(nullptr)
     {
         Services::GetGraphics()->GenerateVertexArray(&m_VertexArray);
@@ -22,6 +31,12 @@ namespace GameDev2D
             m_VertexBuffer = nullptr;
         }
 
+        if (m_InstanceBuffer != nullptr)
+        {
+            delete m_InstanceBuffer;
+            m_InstanceBuffer = nullptr;
+        }
+
         if (m_IndexBuffer != nullptr)
         {
             delete m_IndexBuffer;
@@ -48,6 +63,23 @@ namespace GameDev2D
         return m_VertexBuffer;
     }
 
+    VertexBuffer* VertexData::CreateInstanceBuffer(const VertexBufferDescriptor& aDescriptor)
+    {
+        //If this assert is hit, it means you are trying to create an instance VertexBuffer that has already been created
+        assert(m_InstanceBuffer == nullptr);
+
+        //Bind the vertex array
+        Services::GetGraphics()->BindVertexArray(m_VertexArray);
+
+        //Create and return the instance VertexBuffer
+        m_InstanceBuffer = new VertexBuffer(aDescriptor, nullptr);
+
+        //Unbind the vertex array
+        Services::GetGraphics()->BindVertexArray(0);
+
+        return m_InstanceBuffer;
+    }
+
     IndexBuffer* VertexData::CreateBuffer(const IndexBufferDescriptor& aDescriptor, std::vector<unsigned short>* aData)
     {
         //If this assert is hit, it means you are trying to create a VertexBuffer that has already been created
@@ -70,6 +102,11 @@ namespace GameDev2D
         return m_VertexBuffer;
     }
 
+    VertexBuffer* VertexData::GetInstanceBuffer()
+    {
+        return m_InstanceBuffer;
+    }
+
     IndexBuffer* VertexData::GetIndexBuffer()
     {
         return m_IndexBuffer;
@@ -77,6 +114,9 @@ namespace GameDev2D
 
     void VertexData::PrepareForDraw()
     {
+        //Draw any sprites and shapes waiting in the frame's batches first, so they end up behind what's drawn next
+        Services::GetGraphics()->FlushBatches();
+
         //Bind the vertex array
         Services::GetGraphics()->BindVertexArray(m_VertexArray);
 
@@ -86,6 +126,12 @@ namespace GameDev2D
             m_VertexBuffer->UpdateBuffer();
         }
 
+        //Update the instance buffer (if one exists)
+        if (m_InstanceBuffer != nullptr)
+        {
+            m_InstanceBuffer->UpdateBuffer();
+        }
+
         //Update the index buffer (if one exists)
         if (m_IndexBuffer != nullptr)
         {
@@ -148,12 +194,29 @@ namespace GameDev2D
     VertexBuffer::VertexBuffer(const VertexBufferDescriptor& aDescriptor, std::vector<float>* aData) : Buffer(BufferType_Vertex, aDescriptor.usage, aDescriptor.size, aDescriptor.capacity),
         m_Buffer(nullptr),
         m_AttributeIndex(aDescriptor.attributeIndex),
-        m_AttributeSize(aDescriptor.attributeSize)
+        m_AttributeSize(aDescriptor.attributeSize),
+        m_AttributeType(aDescriptor.attributeType),
+        m_AttributeDivisor(aDescriptor.attributeDivisor),
+        m_IsRingBuffer(aDescriptor.isRingBuffer),
+        m_RingCapacity(0),
+        m_RingOffset(0),
+        m_BaseVertex(0),
+        m_DirtyBegin(0),
+        m_DirtyEnd(0)
     {
         //Create the buffer
         const unsigned int size = GetSize() * GetCapacity();
         m_Buffer = new float[size];
 
+        //If this assert is hit, only a dynamic buffer can be a ring buffer
+        assert(m_IsRingBuffer == false || GetUsage() == BufferUsage_DynamicDraw);
+
+        //A ring buffer holds several full buffers, the uploads are streamed into it
+        if (IsRingBuffer() == true)
+        {
+            m_RingCapacity = GetCapacity() * VERTEX_BUFFER_RING_SIZE;
+        }
+
         //Is there data to initialize the buffer with
         if (aData != nullptr)
         {
@@ -168,14 +231,30 @@ namespace GameDev2D
 
             //Calculate the number of vertices (count) that were in the buffer
             m_Count = aData->size() / GetSize();
+            m_DirtyEnd = m_Count;
 
-            //Lastly, update the vertex attributes
-            UpdateAttributes();
+            //A ring buffer uploads the data the first time it's drawn, otherwise update the vertex attributes
+            if (IsRingBuffer() == true)
+            {
+                m_IsDirty = true;
+            }
+            else
+            {
+                UpdateAttributes();
+            }
         }
 
-        //Initialize the buffer array
-        const unsigned int numBytes = size * sizeof(float);
-        Services::GetGraphics()->InitializeDataBuffer(m_BufferId, GetType(), numBytes, m_Buffer, GetUsage());
+        //Initialize the buffer array, a ring buffer's storage is allocated empty
+        if (IsRingBuffer() == true)
+        {
+            const unsigned int numBytes = m_RingCapacity * GetSize() * sizeof(float);
+            Services::GetGraphics()->InitializeDataBuffer(m_BufferId, GetType(), numBytes, nullptr, GetUsage());
+        }
+        else
+        {
+            const unsigned int numBytes = size * sizeof(float);
+            Services::GetGraphics()->InitializeDataBuffer(m_BufferId, GetType(), numBytes, m_Buffer, GetUsage());
+        }
     }
 
     VertexBuffer::~VertexBuffer()
@@ -199,26 +278,72 @@ namespace GameDev2D
         //Is the VertexBuffer dirty, do we need to update the buffer
         if (m_IsDirty == true)
         {
-            //Set the buffer data
-            const unsigned int numBytes = GetSize() * GetCount() * sizeof(float);
-            Services::GetGraphics()->UpdateDataBuffer(m_BufferId, GetType(), 0, numBytes, m_Buffer);
+            const unsigned int vertexBytes = GetSize() * sizeof(float);
+            unsigned int numBytes = GetCount() * vertexBytes;
+            unsigned int first = 0;
+
+            if (IsRingBuffer() == true)
+            {
+                //If the vertices don't fit in the rest of the ring, orphan it and start again from the beginning. The driver
+                //hands back fresh storage, so the draws still using the old storage don't stall the upload
+                if (m_RingOffset + GetCount() > m_RingCapacity)
+                {
+                    Services::GetGraphics()->InitializeDataBuffer(m_BufferId, GetType(), m_RingCapacity * vertexBytes, nullptr, GetUsage());
+                    Services::GetGraphics()->AddBufferWrap();
+                    m_RingOffset = 0;
+                }
+
+                //Upload the vertices after the ones already in the ring, they are drawn from the base vertex
+                m_BaseVertex = m_RingOffset;
+                m_RingOffset += GetCount();
+            }
+            else
+            {
+                //Only upload the vertices that were modified or emitted since the last upload, vertices past the count aren't drawn
+                unsigned int last = std::min<unsigned int>(m_DirtyEnd, GetCount());
+                first = std::min<unsigned int>(m_DirtyBegin, last);
+                numBytes = (last - first) * vertexBytes;
+            }
+
+            //Set the buffer data, nothing reads from the ring past the last upload so it doesn't have to wait for the GPU
+            if (numBytes > 0)
+            {
+                Services::GetGraphics()->UpdateDataBuffer(m_BufferId, GetType(), (m_BaseVertex + first) * vertexBytes, numBytes, m_Buffer + first * GetSize(), IsRingBuffer());
+            }
 
             //Update the vertex attributes
             UpdateAttributes();
 
-            //Reset the is dirty flag
+            //Reset the is dirty flag and range
             m_IsDirty = false;
+            m_DirtyBegin = 0;
+            m_DirtyEnd = 0;
         }
     }
 
+    unsigned int VertexBuffer::GetBaseVertex()
+    {
+        return m_BaseVertex;
+    }
+
+    bool VertexBuffer::IsRingBuffer()
+    {
+        return m_IsRingBuffer;
+    }
+
     void VertexBuffer::UpdateAttributes()
     {
-        //Ensure the attribute index and attribute size vectors have the same number of elements
+        //Ensure the attribute index and attribute size vectors have the same number of elements, the optional
+        //type and divisor vectors must either be empty or have an element for each attribute too
         assert(m_AttributeIndex.size() == m_AttributeSize.size());
+        assert(m_AttributeType.size() == 0 || m_AttributeType.size() == m_AttributeIndex.size());
+        assert(m_AttributeDivisor.size() == 0 || m_AttributeDivisor.size() == m_AttributeIndex.size());
 
-        //Locals
+        //Locals, the attributes point at the base vertex. That way the draw calls don't need to know where in a
+        //ring buffer the vertices were uploaded to, and it works for instance buffers as well
         const int stride = GetSize() * sizeof(float);
-        unsigned int offset = 0;
+        const unsigned int baseOffset = m_BaseVertex * stride;
+        unsigned int offset = baseOffset;
 
         //Cycle through the attributes and set their data
         for (unsigned int i = 0; i < m_AttributeIndex.size(); i++)
@@ -230,12 +355,20 @@ namespace GameDev2D
             //Get the attribute size
             unsigned int attributeSize = m_AttributeSize.at(i);
 
+            //Get the attribute type and divisor
+            GraphicType attributeType = m_AttributeType.size() > 0 ? m_AttributeType.at(i) : GraphicType_Float;
+            unsigned int attributeDivisor = m_AttributeDivisor.size() > 0 ? m_AttributeDivisor.at(i) : 0;
+
             //Set the attribute data
-            Services::GetGraphics()->SetVertexAttributePointer(m_BufferId, attributeIndex, attributeSize, stride, BUFFER_OFFSET(offset));
+            Services::GetGraphics()->SetVertexAttributePointer(m_BufferId, attributeIndex, attributeSize, stride, BUFFER_OFFSET(offset), attributeType, attributeDivisor);
 
             //Increase the offset
-            offset += attributeSize * sizeof(float);
+            offset += attributeSize * GetGraphicTypeSize(attributeType);
         }
+
+        //If this assert is hit, the attributes don't add up to the vertex size, the vertex size is in floats (4 bytes) so
+        //the last attribute can be followed by up to 3 bytes of padding
+        assert(offset - baseOffset <= (unsigned int)stride && (unsigned int)stride - (offset - baseOffset) < sizeof(float));
     }
 
     void VertexBuffer::AddVertex(const std::vector<float>& aVertex)
@@ -247,29 +380,44 @@ namespace GameDev2D
         assert(m_Count < GetCapacity());
 
         //Add the vertex to the buffer
-        for (unsigned int i = 0; i < aVertex.size(); i++)
-        {
-            unsigned int index = GetCount() * GetSize() + i;
-            m_Buffer[index] = aVertex.at(i);
-        }
+        memcpy(&m_Buffer[GetCount() * GetSize()], aVertex.data(), GetSize() * sizeof(float));
 
-        //Increment the count variable
+        //Enable the dirty flag and increment the count variable
+        AddDirtyRange(m_Count, 1);
         m_Count++;
+    }
 
-        //Enable the dirty flag
-        m_IsDirty = true;
+    void VertexBuffer::RemoveVertices(unsigned int aVertexCount)
+    {
+        //If this assert is hit, there aren't that many vertices in the buffer
+        assert(aVertexCount <= m_Count);
+
+        //The removed vertices aren't drawn, they don't need to be uploaded
+        m_Count -= aVertexCount;
     }
 
     void VertexBuffer::ClearVertices()
     {
-        //Set the buffer elements to zero
-        unsigned int numBytes = GetCapacity() * GetSize() * sizeof(float);
-        memset(m_Buffer, 0, numBytes);
-
-        //Reset the count to zero
+        //Reset the count to zero, only the first count vertices are ever uploaded so there's no need to zero the buffer
         m_Count = 0;
     }
 
+    void VertexBuffer::AddDirtyRange(unsigned int aFirst, unsigned int aVertexCount)
+    {
+        //Grow the dirty range to include the vertices
+        if (m_IsDirty == false)
+        {
+            m_DirtyBegin = aFirst;
+            m_DirtyEnd = aFirst + aVertexCount;
+        }
+        else
+        {
+            m_DirtyBegin = std::min<unsigned int>(m_DirtyBegin, aFirst);
+            m_DirtyEnd = std::max<unsigned int>(m_DirtyEnd, aFirst + aVertexCount);
+        }
+        m_IsDirty = true;
+    }
+
     IndexBuffer::IndexBuffer(const IndexBufferDescriptor& aDescriptor, std::vector<unsigned short>* aData) : Buffer(BufferType_Index, aDescriptor.usage, aDescriptor.size, aDescriptor.capacity),
         m_Buffer(nullptr)
     {
@@ -320,7 +468,7 @@ namespace GameDev2D
         if (m_IsDirty == true)
         {
             //Set the buffer data
-            const unsigned int numBytes = GetSize() * GetCount() * sizeof(float);
+            const unsigned int numBytes = GetSize() * GetCount() * sizeof(unsigned short);
             Services::GetGraphics()->UpdateDataBuffer(m_BufferId, GetType(), 0, numBytes, m_Buffer);
 
             //Reset the is dirty flag
@@ -352,11 +500,7 @@ namespace GameDev2D
 
     void IndexBuffer::ClearIndices()
     {
-        //Set the buffer elements to zero
-        unsigned int numBytes = GetCapacity() * GetSize() * sizeof(unsigned short);
-        memset(m_Buffer, 0, numBytes);
-
-        //Reset the count to zero
+        //Reset the count to zero, only the first count indices are ever uploaded so there's no need to zero the buffer
         m_Count = 0;
     }
 }
\ No newline at end of file
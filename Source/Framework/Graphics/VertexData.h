@@ -11,6 +11,9 @@
 
 namespace GameDev2D
 {
+    //Local constants
+    const unsigned int VERTEX_BUFFER_RING_SIZE = 8;     //Number of full buffers a dynamic VertexBuffer's ring buffer holds
+
     //Forward declarations
     class VertexBuffer;
     class IndexBuffer;
@@ -28,9 +31,16 @@ namespace GameDev2D
         //Create a IndexBuffer for the given descriptor, data can be provided or it can be set or modified later
         IndexBuffer* CreateBuffer(const IndexBufferDescriptor& descriptor, std::vector<unsigned short>* data = nullptr);
 
+        //Create a second VertexBuffer for per-instance data, the descriptor's attribute divisors should be set so
+        //the attributes advance once per instance. Used for instanced drawing, see Graphics::DrawElementsInstanced()
+        VertexBuffer* CreateInstanceBuffer(const VertexBufferDescriptor& descriptor);
+
         //Returns the VertexBuffer, can be null if one wasn't created
         VertexBuffer* GetVertexBuffer();
 
+        //Returns the instance VertexBuffer, can be null if one wasn't created
+        VertexBuffer* GetInstanceBuffer();
+
         //Return the IndexBuffer, can be null if one wasn't created
         IndexBuffer* GetIndexBuffer();
 
@@ -44,6 +54,7 @@ namespace GameDev2D
         //Member variables
         unsigned int m_VertexArray;
         VertexBuffer* m_VertexBuffer;
+        VertexBuffer* m_InstanceBuffer;
         IndexBuffer* m_IndexBuffer;
     };
 
@@ -82,15 +93,49 @@ namespace GameDev2D
 
         void UpdateBuffer();
 
+        //Reserves room for vertices at the end of the buffer and returns a pointer to the first one, so they can be
+        //written directly into the buffer. The vertex type must be the same size as the descriptor's vertex size
+        template<typename T>
+        T* Emit(unsigned int vertexCount);
+
+        //Returns a pointer to vertices already in the buffer, starting at the first vertex, so they can be modified in
+        //place. A buffer that isn't a ring buffer only uploads the range of vertices that were modified or emitted
+        template<typename T>
+        T* Modify(unsigned int first, unsigned int vertexCount);
+
         void AddVertex(const std::vector<float>& vertex);
+
+        //Removes vertices from the end of the buffer
+        void RemoveVertices(unsigned int vertexCount);
+
+        //Resets the number of vertices, the old vertices are overwritten as new ones are added
         void ClearVertices();
 
+        //Returns the index, in the OpenGL buffer, of the first vertex uploaded by the last UpdateBuffer() call. The
+        //vertex attributes already point at it, so draw calls still start at vertex zero
+        unsigned int GetBaseVertex();
+
+        //Returns true if the VertexBuffer streams its vertices into a ring buffer, see VertexBufferDescriptor::isRingBuffer. Each
+        //upload goes after the last one, when the ring is full its storage is orphaned and the uploads start from the beginning
+        bool IsRingBuffer();
+
     private:
         void UpdateAttributes();
 
+        //Adds a range of vertices to the range that needs to be uploaded
+        void AddDirtyRange(unsigned int first, unsigned int vertexCount);
+
         float* m_Buffer;
         std::vector<int> m_AttributeIndex;
         std::vector<unsigned int> m_AttributeSize;
+        std::vector<GraphicType> m_AttributeType;
+        std::vector<unsigned int> m_AttributeDivisor;
+        bool m_IsRingBuffer;
+        unsigned int m_RingCapacity;
+        unsigned int m_RingOffset;
+        unsigned int m_BaseVertex;
+        unsigned int m_DirtyBegin;
+        unsigned int m_DirtyEnd;
     };
 
     //Index Buffer
@@ -103,11 +148,46 @@ namespace GameDev2D
         void UpdateBuffer();
 
         void AddIndex(const std::vector<unsigned short>& index);
+
+        //Resets the number of indices, the old indices are overwritten as new ones are added
         void ClearIndices();
 
     private:
         unsigned short* m_Buffer;
     };
+
+    template<typename T>
+    T* VertexBuffer::Emit(unsigned int aVertexCount)
+    {
+        //If this assert is hit, the vertex type isn't the same size as the vertices in the buffer
+        assert(sizeof(T) == GetSize() * sizeof(float));
+
+        //If this assert is hit, there isn't enough room left in the buffer, check the count against the capacity first
+        assert(m_Count + aVertexCount <= GetCapacity());
+
+        T* vertices = (T*)(m_Buffer + m_Count * GetSize());
+
+        //Increment the count variable and enable the dirty flag
+        AddDirtyRange(m_Count, aVertexCount);
+        m_Count += aVertexCount;
+
+        return vertices;
+    }
+
+    template<typename T>
+    T* VertexBuffer::Modify(unsigned int aFirst, unsigned int aVertexCount)
+    {
+        //If this assert is hit, the vertex type isn't the same size as the vertices in the buffer
+        assert(sizeof(T) == GetSize() * sizeof(float));
+
+        //If this assert is hit, the vertices being modified haven't been added to the buffer
+        assert(aFirst + aVertexCount <= m_Count);
+
+        //Enable the dirty flag, only the modified range will be uploaded
+        AddDirtyRange(aFirst, aVertexCount);
+
+        return (T*)(m_Buffer + aFirst * GetSize());
+    }
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "VertexFormat.h"
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    //Converts a 0.0f - 1.0f color component to a byte, rounding to the nearest value
+    static unsigned int PackColorComponent(float aComponent)
+    {
+        if (aComponent <= 0.0f)
+        {
+            return 0;
+        }
+        if (aComponent >= 1.0f)
+        {
+            return 255;
+        }
+        return (unsigned int)(aComponent * 255.0f + 0.5f);
+    }
+
+    unsigned int PackColor(const Color& aColor)
+    {
+        //The bytes are read by the shader as a normalized unsigned byte vec4, on a little endian machine
+        //the red component is the least significant byte
+        return PackColorComponent(aColor.r) | (PackColorComponent(aColor.g) << 8) | (PackColorComponent(aColor.b) << 16) | (PackColorComponent(aColor.a) << 24);
+    }
+
+    unsigned short PackUnsignedNormalized(float aValue)
+    {
+        if (aValue <= 0.0f)
+        {
+            return 0;
+        }
+        if (aValue >= 1.0f)
+        {
+            return 65535;
+        }
+        return (unsigned short)(aValue * 65535.0f + 0.5f);
+    }
+
+    unsigned short PackHalfFloat(float aValue)
+    {
+        //Get the float's bits
+        unsigned int bits = 0;
+        memcpy(&bits, &aValue, sizeof(bits));
+
+        unsigned int sign = (bits >> 16) & 0x8000;
+        int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+        unsigned int mantissa = bits & 0x7fffff;
+
+        //Infinity and NaN keep their meaning
+        if ((bits & 0x7fffffff) >= 0x7f800000)
+        {
+            return (unsigned short)(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+        }
+
+        //Too large for a half float, it becomes infinity
+        if (exponent >= 31)
+        {
+            return (unsigned short)(sign | 0x7c00);
+        }
+
+        //Too small for a normal half float, it becomes a subnormal half float or zero
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return (unsigned short)sign;
+            }
+
+            mantissa |= 0x800000;
+            unsigned int shift = (unsigned int)(14 - exponent);
+            unsigned int half = mantissa >> shift;
+
+            //Round to the nearest value
+            if (((mantissa >> (shift - 1)) & 1) != 0)
+            {
+                half++;
+            }
+            return (unsigned short)(sign | half);
+        }
+
+        //Round to the nearest value, a carry out of the mantissa correctly increments the exponent
+        unsigned int half = sign | ((unsigned int)exponent << 10) | (mantissa >> 13);
+        if ((mantissa & 0x1000) != 0)
+        {
+            half++;
+        }
+        return (unsigned short)half;
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef __GameDev2D__VertexFormat__
+#define __GameDev2D__VertexFormat__
+
+#include "Color.h"
+
+
+namespace GameDev2D
+{
+    //Helper functions used to pack vertex attributes into compact formats, see VertexBufferDescriptor::attributeType.
+    //Integer attributes are normalized by OpenGL, so the shaders still read them as 0.0f - 1.0f floats
+
+    //Packs a Color into four bytes, in R, G, B, A memory order. Components are clamped to the 0.0f - 1.0f range.
+    //Use it with a GraphicType_UnsignedByte attribute of size 4
+    unsigned int PackColor(const Color& color);
+
+    //Packs a 0.0f - 1.0f value (such as a uv coordinate) into an unsigned short, the value is clamped to that range.
+    //Use it with a GraphicType_UnsignedShort attribute
+    unsigned short PackUnsignedNormalized(float value);
+
+    //Packs a float into a 16-bit half float, values too large for a half float become infinity.
+    //Use it with a GraphicType_HalfFloat attribute
+    unsigned short PackHalfFloat(float value);
+}
+
+#endif
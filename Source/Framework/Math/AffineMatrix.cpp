@@ -0,0 +1,125 @@
+#include "AffineMatrix.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+#define AFFINE_MATRIX_SSE 1
+#include <xmmintrin.h>
+#endif
+
+
+namespace GameDev2D
+{
+    //The batch transform loads two Vector2s as one 4 float register
+    static_assert(sizeof(Vector2) == sizeof(float) * 2, "Vector2 must be two tightly packed floats");
+
+    AffineMatrix AffineMatrix::Identity()
+    {
+        return AffineMatrix();
+    }
+
+    AffineMatrix AffineMatrix::Make(Vector2 aTranslation, float aAngle, Vector2 aScale)
+    {
+        return Make(aTranslation, Rotation(aAngle), aScale);
+    }
+
+    AffineMatrix AffineMatrix::Make(Vector2 aTranslation, Rotation aRotation, Vector2 aScale)
+    {
+        //The rotation's direction is its cosine and sine, the scale stretches the axes
+        Vector2 direction = aRotation.GetDirection();
+        return AffineMatrix(direction * aScale.x, Vector2(-direction.y, direction.x) * aScale.y, aTranslation);
+    }
+
+    AffineMatrix::AffineMatrix()
+    {
+        m[0][0] = 1.0f;  m[1][0] = 0.0f;  m[2][0] = 0.0f;
+        m[0][1] = 0.0f;  m[1][1] = 1.0f;  m[2][1] = 0.0f;
+    }
+
+    AffineMatrix::AffineMatrix(Vector2 aXAxis, Vector2 aYAxis, Vector2 aTranslation)
+    {
+        m[0][0] = aXAxis.x;  m[1][0] = aYAxis.x;  m[2][0] = aTranslation.x;
+        m[0][1] = aXAxis.y;  m[1][1] = aYAxis.y;  m[2][1] = aTranslation.y;
+    }
+
+    Vector2 AffineMatrix::GetTranslation() const
+    {
+        return Vector2(m[2][0], m[2][1]);
+    }
+
+    void AffineMatrix::SetTranslation(Vector2 aTranslation)
+    {
+        m[2][0] = aTranslation.x;
+        m[2][1] = aTranslation.y;
+    }
+
+    AffineMatrix AffineMatrix::GetInverse() const
+    {
+        float determinant = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+
+        if (determinant == 0.0f)
+        {
+            return AffineMatrix(Vector2(0.0f, 0.0f), Vector2(0.0f, 0.0f), Vector2(0.0f, 0.0f));
+        }
+
+        //Invert the 2x2 rotation and scale, then move the translation back through it
+        determinant = 1.0f / determinant;
+        Vector2 xAxis(m[1][1] * determinant, -m[0][1] * determinant);
+        Vector2 yAxis(-m[1][0] * determinant, m[0][0] * determinant);
+        Vector2 translation(-(xAxis.x * m[2][0] + yAxis.x * m[2][1]), -(xAxis.y * m[2][0] + yAxis.y * m[2][1]));
+        return AffineMatrix(xAxis, yAxis, translation);
+    }
+
+    Matrix AffineMatrix::ToMatrix() const
+    {
+        Matrix matrix = Matrix::Identity();
+        matrix.m[0][0] = m[0][0];  matrix.m[1][0] = m[1][0];  matrix.m[3][0] = m[2][0];
+        matrix.m[0][1] = m[0][1];  matrix.m[1][1] = m[1][1];  matrix.m[3][1] = m[2][1];
+        return matrix;
+    }
+
+    void AffineMatrix::Transform(const Vector2* aSource, Vector2* aDestination, unsigned int aCount) const
+    {
+        unsigned int i = 0;
+
+#ifdef AFFINE_MATRIX_SSE
+        //Each register holds two interleaved vectors (x0, y0, x1, y1), the x values are broadcast across
+        //(x0, x0, x1, x1) and multiplied by the x axis, the same for y, then the translation is added
+        __m128 xAxis = _mm_setr_ps(m[0][0], m[0][1], m[0][0], m[0][1]);
+        __m128 yAxis = _mm_setr_ps(m[1][0], m[1][1], m[1][0], m[1][1]);
+        __m128 translation = _mm_setr_ps(m[2][0], m[2][1], m[2][0], m[2][1]);
+
+        for (; i + 2 <= aCount; i += 2)
+        {
+            __m128 vectors = _mm_loadu_ps(&aSource[i].data[0]);
+            __m128 x = _mm_shuffle_ps(vectors, vectors, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 y = _mm_shuffle_ps(vectors, vectors, _MM_SHUFFLE(3, 3, 1, 1));
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, xAxis), _mm_mul_ps(y, yAxis)), translation);
+            _mm_storeu_ps(&aDestination[i].data[0], result);
+        }
+#endif
+
+        //Transform the rest one at a time, it's all of them without SSE
+        for (; i < aCount; i++)
+        {
+            aDestination[i] = *this * aSource[i];
+        }
+    }
+
+    Vector2 AffineMatrix::operator *(const Vector2& aVector2) const
+    {
+        return Vector2(m[0][0] * aVector2.x + m[1][0] * aVector2.y + m[2][0], m[0][1] * aVector2.x + m[1][1] * aVector2.y + m[2][1]);
+    }
+
+    AffineMatrix AffineMatrix::operator *(const AffineMatrix& aAffineMatrix) const
+    {
+        AffineMatrix affineMatrix;
+
+        affineMatrix.m[0][0] = m[0][0] * aAffineMatrix.m[0][0] + m[1][0] * aAffineMatrix.m[0][1];
+        affineMatrix.m[0][1] = m[0][1] * aAffineMatrix.m[0][0] + m[1][1] * aAffineMatrix.m[0][1];
+        affineMatrix.m[1][0] = m[0][0] * aAffineMatrix.m[1][0] + m[1][0] * aAffineMatrix.m[1][1];
+        affineMatrix.m[1][1] = m[0][1] * aAffineMatrix.m[1][0] + m[1][1] * aAffineMatrix.m[1][1];
+        affineMatrix.m[2][0] = m[0][0] * aAffineMatrix.m[2][0] + m[1][0] * aAffineMatrix.m[2][1] + m[2][0];
+        affineMatrix.m[2][1] = m[0][1] * aAffineMatrix.m[2][0] + m[1][1] * aAffineMatrix.m[2][1] + m[2][1];
+
+        return affineMatrix;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef __GameDev2D_AffineMatrix_h__
+#define __GameDev2D_AffineMatrix_h__
+
+#include "Matrix.h"
+#include "Rotation.h"
+#include "Vector2.h"
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int AFFINE_MATRIX_NUM_ROWS = 2;
+    const unsigned int AFFINE_MATRIX_NUM_COLUMNS = 3;
+
+    //A 2x3 affine transformation, the columns are the x axis, the y axis and the translation. It holds everything a 2D
+    //translation, rotation and scale can produce in 6 floats, the 4x4 Matrix is only needed for the projection
+    struct AffineMatrix
+    {
+        //Returns an Identity AffineMatrix
+        static AffineMatrix Identity();
+
+        //Returns an AffineMatrix based on the translation, angle (in degrees) and scale, built directly
+        //instead of multiplying a translation, rotation and scale matrix together
+        static AffineMatrix Make(Vector2 translation, float angle, Vector2 scale = Vector2(1.0f, 1.0f));
+        static AffineMatrix Make(Vector2 translation, Rotation rotation, Vector2 scale = Vector2(1.0f, 1.0f));
+
+        //Creates an Identity AffineMatrix
+        AffineMatrix();
+
+        //Creates an AffineMatrix from its x axis, y axis and translation columns
+        AffineMatrix(Vector2 xAxis, Vector2 yAxis, Vector2 translation);
+
+        //Returns the translation Vector2 value
+        Vector2 GetTranslation() const;
+
+        //Sets the translation
+        void SetTranslation(Vector2 translation);
+
+        //Returns an inversed AffineMatrix based on this AffineMatrix
+        AffineMatrix GetInverse() const;
+
+        //Returns the 4x4 Matrix equivalent, for uploading to a shader's mat4 uniform
+        Matrix ToMatrix() const;
+
+        //Transforms the vectors in the source array and writes them to the destination array, the arrays can be
+        //the same. Two vectors are transformed at a time with SSE, four sprite corners only take two iterations
+        void Transform(const Vector2* source, Vector2* destination, unsigned int count) const;
+
+        //Multiplication operator override
+        Vector2 operator *(const Vector2& vector2) const;
+
+        //Multiplication operator override
+        AffineMatrix operator *(const AffineMatrix& affineMatrix) const;
+
+        //Member variable
+        float m[AFFINE_MATRIX_NUM_COLUMNS][AFFINE_MATRIX_NUM_ROWS];
+    };
+}
+
+#endif
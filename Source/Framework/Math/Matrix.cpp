@@ -180,7 +180,7 @@ namespace GameDev2D
         return matrix;
     }
 
-    Matrix Matrix::GetInverse()
+    Matrix Matrix::GetInverse() const
     {
         Matrix inverse;
 
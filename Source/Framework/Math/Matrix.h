@@ -69,7 +69,7 @@ namespace GameDev2D
         Matrix GetTransposed();
 
         //Returns an inversed Matrix based on this Matrix
-        Matrix GetInverse();
+        Matrix GetInverse() const;
 
         //Multiplication operator override
         Vector2 operator *(const Vector2 vector2) const;
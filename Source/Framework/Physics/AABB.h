@@ -0,0 +1,65 @@
+#ifndef __GameDev2D__AABB__
+#define __GameDev2D__AABB__
+
+#include "../Math/Vector2.h"
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Axis aligned bounding box, used by the broadphase to quickly reject pairs of bodies that can't be touching
+		struct AABB
+		{
+			AABB() :
+				lowerBound(0.0f, 0.0f),
+				upperBound(0.0f, 0.0f)
+			{
+			}
+
+			AABB(Vector2 lowerBound, Vector2 upperBound) :
+				lowerBound(lowerBound),
+				upperBound(upperBound)
+			{
+			}
+
+			//Returns a bounding box that encloses both bounding boxes
+			static AABB Combine(const AABB& a, const AABB& b)
+			{
+				return AABB(Vector2(a.lowerBound.x < b.lowerBound.x ? a.lowerBound.x : b.lowerBound.x, a.lowerBound.y < b.lowerBound.y ? a.lowerBound.y : b.lowerBound.y),
+							Vector2(a.upperBound.x > b.upperBound.x ? a.upperBound.x : b.upperBound.x, a.upperBound.y > b.upperBound.y ? a.upperBound.y : b.upperBound.y));
+			}
+
+			//Returns true if the two bounding boxes overlap (touching edges count as overlapping)
+			bool Overlaps(const AABB& aabb) const
+			{
+				return lowerBound.x <= aabb.upperBound.x && upperBound.x >= aabb.lowerBound.x &&
+					   lowerBound.y <= aabb.upperBound.y && upperBound.y >= aabb.lowerBound.y;
+			}
+
+			//Returns true if the supplied bounding box is entirely inside this bounding box
+			bool Contains(const AABB& aabb) const
+			{
+				return lowerBound.x <= aabb.lowerBound.x && lowerBound.y <= aabb.lowerBound.y &&
+					   upperBound.x >= aabb.upperBound.x && upperBound.y >= aabb.upperBound.y;
+			}
+
+			//Returns true if the point is inside the bounding box
+			bool Contains(Vector2 point) const
+			{
+				return point.x >= lowerBound.x && point.x <= upperBound.x && point.y >= lowerBound.y && point.y <= upperBound.y;
+			}
+
+			//Returns the perimeter of the bounding box, used as the cost metric for the DynamicTree
+			float GetPerimeter() const
+			{
+				return 2.0f * ((upperBound.x - lowerBound.x) + (upperBound.y - lowerBound.y));
+			}
+
+			//Member variables
+			Vector2 lowerBound;	//In meters
+			Vector2 upperBound;	//In meters
+		};
+	}
+}
+
+#endif
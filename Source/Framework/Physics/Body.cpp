@@ -1,27 +1,22 @@
 #include "Body.h"
 #include "Collider.h"
+#include "BodyData.h"
+#include "World.h"
 #include "../Core/Transformable.h"
 
 namespace GameDev2D
 {
 	namespace Physics
 	{
-		Body::Body(Collider* aCollider, float aDensity) :
-			m_Position(0.0f, 0.0f),
-			m_Angle(0.0f),
-			m_LinearVelocity(0.0f, 0.0f),
-			m_AngularVelocity(0.0f),
-			m_Force(0.0f, 0.0f),
-			m_Torque(0.0f),
-			m_LinearDamping(0.0f, 0.0f),
-			m_AngularDamping(0.0f),
-			m_Mass(0.0f),
-			m_InverseMass(0.0f),
-			m_Inertia(0.0f),
-			m_InverseInertia(0.0f),
-
-			m_Collider(aCollider)
-  
+		Body::Body(World* aWorld, BodyData* aData, Collider* aCollider, float aDensity) :
+			m_World(aWorld),
+			m_Data(aData),
+			m_Index(aData->AddBody(this)),
+			m_NextInIsland(nullptr),
+			m_IsDestroyPending(false),
+			m_Collider(aCollider),
+			m_ProxyId(-1),
+			m_UserData(nullptr)
 		{
 			SetMass(m_Collider->ComputeMass(aDensity));
 			SetInertia(m_Collider->ComputeInertia(GetMass()));
@@ -40,154 +35,198 @@ namespace GameDev2D
 
 		void Body::SetPosition(Vector2 aPosition)
 		{
-			m_Position = aPosition;
+			m_Data->positionX[m_Index] = aPosition.x;
+			m_Data->positionY[m_Index] = aPosition.y;
+			SetIsAwake(true);
 		}
 
 		Vector2 Body::GetPosition()
 		{
-			return m_Position;
+			return Vector2(m_Data->positionX[m_Index], m_Data->positionY[m_Index]);
 		}
 
 		void Body::SetAngle(float aAngle)
 		{
-			m_Angle = aAngle;
-			m_Collider->SetAngle(m_Angle);
+			m_Data->angle[m_Index] = aAngle;
+			m_Collider->SetAngle(aAngle);
+			SetIsAwake(true);
 		}
 
 		float Body::GetAngle()
 		{
-			return m_Angle;
+			return m_Data->angle[m_Index];
 		}
 
 		void Body::SetLinearVelocity(Vector2 aLinearVelocity)
 		{
-			m_LinearVelocity = aLinearVelocity;
+			if (aLinearVelocity.x != 0.0f || aLinearVelocity.y != 0.0f)
+			{
+				SetIsAwake(true);
+			}
+
+			m_Data->linearVelocityX[m_Index] = aLinearVelocity.x;
+			m_Data->linearVelocityY[m_Index] = aLinearVelocity.y;
 		}
 
 		Vector2 Body::GetLinearVelocity()
 		{
-			return m_LinearVelocity;
+			return Vector2(m_Data->linearVelocityX[m_Index], m_Data->linearVelocityY[m_Index]);
 		}
 
 		void Body::SetAngularVelocity(float aAngularVelocity)
 		{
-			m_AngularVelocity = aAngularVelocity;
+			if (aAngularVelocity != 0.0f)
+			{
+				SetIsAwake(true);
+			}
+
+			m_Data->angularVelocity[m_Index] = aAngularVelocity;
 		}
 
 		float Body::GetAngularVelocity()
 		{
-			return m_AngularVelocity;
+			return m_Data->angularVelocity[m_Index];
 		}
 
 		void Body::SetLinearDamping(Vector2 aLinearDamping)
 		{
-			m_LinearDamping = aLinearDamping;
+			m_Data->linearDampingX[m_Index] = aLinearDamping.x;
+			m_Data->linearDampingY[m_Index] = aLinearDamping.y;
 		}
 
 		Vector2 Body::GetLinearDamping()
 		{
-			return m_LinearDamping;
+			return Vector2(m_Data->linearDampingX[m_Index], m_Data->linearDampingY[m_Index]);
 		}
 
 		void Body::SetAngularDamping(float aAngularDamping)
 		{
-			m_AngularDamping = aAngularDamping;
+			m_Data->angularDamping[m_Index] = aAngularDamping;
 		}
 
 		float Body::GetAngularDamping()
 		{
-			return m_AngularDamping;
+			return m_Data->angularDamping[m_Index];
 		}
 
 		void Body::SetMass(float aMass)
 		{
-			m_Mass = aMass;
-			m_InverseMass = (m_Mass == 0.0f ? 0.0f : 1.0f / m_Mass);
+			m_Data->mass[m_Index] = aMass;
+			m_Data->inverseMass[m_Index] = (aMass == 0.0f ? 0.0f : 1.0f / aMass);
 		}
 
 		float Body::GetMass()
 		{
-			return m_Mass;
+			return m_Data->mass[m_Index];
 		}
 
 		float Body::GetInverseMass()
 		{
-			return m_InverseMass;
+			return m_Data->inverseMass[m_Index];
 		}
 
 		void Body::SetInertia(float aInertia)
 		{
-			m_Inertia = aInertia;
-			m_InverseInertia = (m_Inertia == 0.0f ? 0.0f : 1.0f / m_Inertia);
+			m_Data->inertia[m_Index] = aInertia;
+			m_Data->inverseInertia[m_Index] = (aInertia == 0.0f ? 0.0f : 1.0f / aInertia);
 		}
 
 		float Body::GetInertia()
 		{
-			return m_Inertia;
+			return m_Data->inertia[m_Index];
 		}
 
 		float Body::GetInverseInertia()
 		{
-			return m_InverseInertia;
+			return m_Data->inverseInertia[m_Index];
 		}
 
 		void Body::ApplyForces(Vector2 aForce)
 		{
-			m_Force += aForce;
+			if (aForce.x == 0.0f && aForce.y == 0.0f)
+			{
+				return;
+			}
+
+			SetIsAwake(true);
+			m_Data->forceX[m_Index] += aForce.x;
+			m_Data->forceY[m_Index] += aForce.y;
 		}
 
 		void Body::ApplyTorque(float aTorque)
 		{
-			m_Torque += aTorque;
+			if (aTorque == 0.0f)
+			{
+				return;
+			}
+
+			SetIsAwake(true);
+			m_Data->torque[m_Index] += aTorque;
 		}
 
 		void Body::ApplyLinearImpulse(Vector2 aLinearImpulse)
 		{
-			m_LinearVelocity += aLinearImpulse * m_InverseMass;
+			if (aLinearImpulse.x == 0.0f && aLinearImpulse.y == 0.0f)
+			{
+				return;
+			}
+
+			SetIsAwake(true);
+			m_Data->linearVelocityX[m_Index] += aLinearImpulse.x * m_Data->inverseMass[m_Index];
+			m_Data->linearVelocityY[m_Index] += aLinearImpulse.y * m_Data->inverseMass[m_Index];
 		}
 
 		void Body::ApplyAngularImpulse(float aAngularImpulse)
 		{
-			m_AngularVelocity += aAngularImpulse * m_InverseInertia;
+			if (aAngularImpulse == 0.0f)
+			{
+				return;
+			}
+
+			SetIsAwake(true);
+			m_Data->angularVelocity[m_Index] += aAngularImpulse * m_Data->inverseInertia[m_Index];
 		}
 
 		void Body::ClearForces()
 		{
-			m_Force = Vector2(0.0f, 0.0f);
-			m_Torque = 0.0f;
+			m_Data->ClearForces(m_Index);
 		}
 
 		void Body::SyncForces(double aTimeStep, Vector2 aGravity)
 		{
-			if (GetInverseMass() == 0.0f)
-			{
-				return;
-			}
+			m_Data->IntegrateForces(m_Index, (float)aTimeStep, aGravity);
+		}
 
-			//Calculate the acceleration based on the mass and force
-			Vector2 acceleration = m_Force * GetInverseMass();
-			m_LinearVelocity.x += acceleration.x * aTimeStep;
-			m_LinearVelocity.y += acceleration.y * aTimeStep;
+		void Body::SyncVelocities(double aTimeStep)
+		{
+			m_Data->IntegrateVelocities(m_Index, (float)aTimeStep);
+		}
 
-			//Next apply the effects of gravity
-			m_LinearVelocity.x += aGravity.x * aTimeStep;
-			m_LinearVelocity.y += aGravity.y * aTimeStep;
+		void Body::SetIsAwake(bool aIsAwake)
+		{
+			m_World->SetBodyIsAwake(this, aIsAwake);
+		}
 
-			//Calculate the angular acceleration
-			m_AngularVelocity += (m_Torque * GetInverseInertia()) * aTimeStep;
+		bool Body::GetIsAwake()
+		{
+			return m_Index < m_Data->awakeCount;
+		}
 
-			//Lastly apply damping
-			m_LinearVelocity.x *= 1.0f / (1.0f + m_LinearDamping.x * aTimeStep);
-			m_LinearVelocity.y *= 1.0f / (1.0f + m_LinearDamping.y * aTimeStep);
-			m_AngularVelocity *= 1.0f / (1.0f + m_AngularDamping * aTimeStep);
+		BodyHandle Body::GetHandle()
+		{
+			return m_Handle;
 		}
 
-		void Body::SyncVelocities(double aTimeStep)
+		void Body::SetUserData(void* aUserData)
 		{
-			m_Position.x += m_LinearVelocity.x * aTimeStep;
-			m_Position.y += m_LinearVelocity.y * aTimeStep;
-			m_Angle += m_AngularVelocity * aTimeStep;
+			m_UserData = aUserData;
 		}
+
+		void* Body::GetUserData()
+		{
+			return m_UserData;
+		}
+
         BodyTypes Body::GetObject1()
         {
             return m_Object;
@@ -9,12 +9,41 @@ namespace GameDev2D
 	{
 		//Forward declaration
 		class Collider;
+		class World;
+		struct BodyData;
 
+		//Local constants
+		const unsigned int BODY_HANDLE_NULL_INDEX = 0xffffffff;
+
+		//Generation checked reference to a body, the World returns nullptr for a handle once its body has been
+		//destroyed, even if the body's memory has been reused for a new body
+		struct BodyHandle
+		{
+			BodyHandle() :
+				index(BODY_HANDLE_NULL_INDEX),
+				generation(0)
+			{
+			}
+
+			BodyHandle(unsigned int index, unsigned int generation) :
+				index(index),
+				generation(generation)
+			{
+			}
+
+			bool operator==(const BodyHandle& handle) const
+			{
+				return index == handle.index && generation == handle.generation;
+			}
+
+			unsigned int index;
+			unsigned int generation;
+		};
+
+		//A body is a thin handle to the body's state, which is stored in the World's BodyData
 		class Body
 		{
 		public:
-			Body(Collider* collider, float density);
-			~Body();
 
 			void SetPosition(Vector2 position);
 			Vector2 GetPosition();
@@ -53,31 +82,43 @@ namespace GameDev2D
 			void SyncForces(double timeStep, Vector2 gravity);
 			void SyncVelocities(double timeStep);
 
+			//Sleeping bodies aren't simulated until something wakes them, setting the position or velocity,
+			//applying a force or impulse, or a contact with an awake body will all wake the body
+			void SetIsAwake(bool isAwake);
+			bool GetIsAwake();
+
+			//Returns a generation checked handle to the body, use World::GetBody() to get the body back
+			BodyHandle GetHandle();
+
+			//Opaque pointer to the game object that owns the body, the World never touches it. Use it to get
+			//back to the game object from the bodies passed to the WorldListener
+			void SetUserData(void* userData);
+			void* GetUserData();
+
 			Collider* GetCollider();
             BodyTypes GetObject1();
             void SetObject(BodyTypes object);
 
 		private:
-			//Member variables go here
-			Vector2 m_Position;		//In meters
-			float	m_Angle;		//In radians
-
-			Vector2 m_LinearVelocity;	//In m/s
-			float m_AngularVelocity;	//In radians/second
+			//The World needs to access the broadphase proxy id, the body's index and its island
+			friend class World;
 
-			Vector2 m_Force;	//In Newtons
-			float m_Torque;
-
-			Vector2 m_LinearDamping;
-			float m_AngularDamping;
+			//Bodies are created and destroyed by the World, use World::CreateBody() and World::DestroyBody()
+			Body(World* world, BodyData* data, Collider* collider, float density);
+			~Body();
 
-			float m_Mass;		//In kg
-			float m_InverseMass;
-			float m_Inertia;	//In kg-square meters
-			float m_InverseInertia;
+			//Member variables go here
+			World* m_World;
+			BodyData* m_Data;
+			unsigned int m_Index;
+			Body* m_NextInIsland;	//The sleeping bodies in an island are linked in a ring, so they wake together
+			BodyHandle m_Handle;
+			bool m_IsDestroyPending;
 
 			Collider* m_Collider;
             BodyTypes m_Object;
+			int m_ProxyId;
+			void* m_UserData;
 		};
 	}
 }
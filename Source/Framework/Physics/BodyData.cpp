@@ -0,0 +1,219 @@
+#include "BodyData.h"
+#include <algorithm>
+#include <xmmintrin.h>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		BodyData::BodyData() :
+			awakeCount(0)
+		{
+
+		}
+
+		BodyData::~BodyData()
+		{
+
+		}
+
+		unsigned int BodyData::AddBody(Body* aBody)
+		{
+			unsigned int index = GetCount();
+
+			positionX.push_back(0.0f);
+			positionY.push_back(0.0f);
+			angle.push_back(0.0f);
+			linearVelocityX.push_back(0.0f);
+			linearVelocityY.push_back(0.0f);
+			angularVelocity.push_back(0.0f);
+			forceX.push_back(0.0f);
+			forceY.push_back(0.0f);
+			torque.push_back(0.0f);
+			linearDampingX.push_back(0.0f);
+			linearDampingY.push_back(0.0f);
+			angularDamping.push_back(0.0f);
+			mass.push_back(0.0f);
+			inverseMass.push_back(0.0f);
+			inertia.push_back(0.0f);
+			inverseInertia.push_back(0.0f);
+			sleepTime.push_back(0.0f);
+			body.push_back(aBody);
+
+			return index;
+		}
+
+		void BodyData::RemoveLast()
+		{
+			positionX.pop_back();
+			positionY.pop_back();
+			angle.pop_back();
+			linearVelocityX.pop_back();
+			linearVelocityY.pop_back();
+			angularVelocity.pop_back();
+			forceX.pop_back();
+			forceY.pop_back();
+			torque.pop_back();
+			linearDampingX.pop_back();
+			linearDampingY.pop_back();
+			angularDamping.pop_back();
+			mass.pop_back();
+			inverseMass.pop_back();
+			inertia.pop_back();
+			inverseInertia.pop_back();
+			sleepTime.pop_back();
+			body.pop_back();
+
+			if (awakeCount > GetCount())
+			{
+				awakeCount = GetCount();
+			}
+		}
+
+		void BodyData::Swap(unsigned int aIndexA, unsigned int aIndexB)
+		{
+			std::swap(positionX[aIndexA], positionX[aIndexB]);
+			std::swap(positionY[aIndexA], positionY[aIndexB]);
+			std::swap(angle[aIndexA], angle[aIndexB]);
+			std::swap(linearVelocityX[aIndexA], linearVelocityX[aIndexB]);
+			std::swap(linearVelocityY[aIndexA], linearVelocityY[aIndexB]);
+			std::swap(angularVelocity[aIndexA], angularVelocity[aIndexB]);
+			std::swap(forceX[aIndexA], forceX[aIndexB]);
+			std::swap(forceY[aIndexA], forceY[aIndexB]);
+			std::swap(torque[aIndexA], torque[aIndexB]);
+			std::swap(linearDampingX[aIndexA], linearDampingX[aIndexB]);
+			std::swap(linearDampingY[aIndexA], linearDampingY[aIndexB]);
+			std::swap(angularDamping[aIndexA], angularDamping[aIndexB]);
+			std::swap(mass[aIndexA], mass[aIndexB]);
+			std::swap(inverseMass[aIndexA], inverseMass[aIndexB]);
+			std::swap(inertia[aIndexA], inertia[aIndexB]);
+			std::swap(inverseInertia[aIndexA], inverseInertia[aIndexB]);
+			std::swap(sleepTime[aIndexA], sleepTime[aIndexB]);
+			std::swap(body[aIndexA], body[aIndexB]);
+		}
+
+		unsigned int BodyData::GetCount()
+		{
+			return (unsigned int)positionX.size();
+		}
+
+		void BodyData::Integrate(float aTimeStep, Vector2 aGravity)
+		{
+			unsigned int count = awakeCount;
+			unsigned int simdCount = count & ~3u;
+
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 timeStep = _mm_set1_ps(aTimeStep);
+			const __m128 gravityX = _mm_set1_ps(aGravity.x);
+			const __m128 gravityY = _mm_set1_ps(aGravity.y);
+			const __m128 linearTolerance = _mm_set1_ps(BODY_SLEEP_LINEAR_TOLERANCE * BODY_SLEEP_LINEAR_TOLERANCE);
+			const __m128 angularTolerance = _mm_set1_ps(BODY_SLEEP_ANGULAR_TOLERANCE * BODY_SLEEP_ANGULAR_TOLERANCE);
+
+			for (unsigned int i = 0; i < simdCount; i += 4)
+			{
+				//Bodies with no inverse mass don't react to forces, but they still move with their velocity
+				__m128 invMass = _mm_loadu_ps(&inverseMass[i]);
+				__m128 isDynamic = _mm_cmpneq_ps(invMass, zero);
+
+				__m128 velocityX = _mm_loadu_ps(&linearVelocityX[i]);
+				__m128 velocityY = _mm_loadu_ps(&linearVelocityY[i]);
+				__m128 velocityA = _mm_loadu_ps(&angularVelocity[i]);
+
+				//Acceleration from the force and gravity, then the angular acceleration
+				__m128 newVelocityX = _mm_add_ps(velocityX, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&forceX[i]), invMass), gravityX), timeStep));
+				__m128 newVelocityY = _mm_add_ps(velocityY, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&forceY[i]), invMass), gravityY), timeStep));
+				__m128 newVelocityA = _mm_add_ps(velocityA, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&torque[i]), _mm_loadu_ps(&inverseInertia[i])), timeStep));
+
+				//Damping
+				newVelocityX = _mm_div_ps(newVelocityX, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&linearDampingX[i]), timeStep)));
+				newVelocityY = _mm_div_ps(newVelocityY, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&linearDampingY[i]), timeStep)));
+				newVelocityA = _mm_div_ps(newVelocityA, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&angularDamping[i]), timeStep)));
+
+				//Only keep the new velocities for the dynamic bodies
+				velocityX = _mm_or_ps(_mm_and_ps(isDynamic, newVelocityX), _mm_andnot_ps(isDynamic, velocityX));
+				velocityY = _mm_or_ps(_mm_and_ps(isDynamic, newVelocityY), _mm_andnot_ps(isDynamic, velocityY));
+				velocityA = _mm_or_ps(_mm_and_ps(isDynamic, newVelocityA), _mm_andnot_ps(isDynamic, velocityA));
+
+				_mm_storeu_ps(&linearVelocityX[i], velocityX);
+				_mm_storeu_ps(&linearVelocityY[i], velocityY);
+				_mm_storeu_ps(&angularVelocity[i], velocityA);
+
+				//Integrate the velocities
+				_mm_storeu_ps(&positionX[i], _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(velocityX, timeStep)));
+				_mm_storeu_ps(&positionY[i], _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(velocityY, timeStep)));
+				_mm_storeu_ps(&angle[i], _mm_add_ps(_mm_loadu_ps(&angle[i]), _mm_mul_ps(velocityA, timeStep)));
+
+				//Clear the forces
+				_mm_storeu_ps(&forceX[i], zero);
+				_mm_storeu_ps(&forceY[i], zero);
+				_mm_storeu_ps(&torque[i], zero);
+
+				//Bodies that are moving slowly enough accumulate sleep time, the rest have it reset
+				__m128 linearSpeedSquared = _mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY));
+				__m128 angularSpeedSquared = _mm_mul_ps(velocityA, velocityA);
+				__m128 isResting = _mm_and_ps(_mm_cmple_ps(linearSpeedSquared, linearTolerance), _mm_cmple_ps(angularSpeedSquared, angularTolerance));
+				_mm_storeu_ps(&sleepTime[i], _mm_and_ps(isResting, _mm_add_ps(_mm_loadu_ps(&sleepTime[i]), timeStep)));
+			}
+
+			//Handle the remaining bodies one at a time
+			for (unsigned int i = simdCount; i < count; i++)
+			{
+				IntegrateForces(i, aTimeStep, aGravity);
+				IntegrateVelocities(i, aTimeStep);
+				ClearForces(i);
+				UpdateSleepTime(i, aTimeStep);
+			}
+		}
+
+		void BodyData::IntegrateForces(unsigned int aIndex, float aTimeStep, Vector2 aGravity)
+		{
+			if (inverseMass[aIndex] == 0.0f)
+			{
+				return;
+			}
+
+			//Calculate the acceleration based on the mass and force, then apply the effects of gravity
+			linearVelocityX[aIndex] += (forceX[aIndex] * inverseMass[aIndex] + aGravity.x) * aTimeStep;
+			linearVelocityY[aIndex] += (forceY[aIndex] * inverseMass[aIndex] + aGravity.y) * aTimeStep;
+
+			//Calculate the angular acceleration
+			angularVelocity[aIndex] += (torque[aIndex] * inverseInertia[aIndex]) * aTimeStep;
+
+			//Lastly apply damping
+			linearVelocityX[aIndex] /= 1.0f + linearDampingX[aIndex] * aTimeStep;
+			linearVelocityY[aIndex] /= 1.0f + linearDampingY[aIndex] * aTimeStep;
+			angularVelocity[aIndex] /= 1.0f + angularDamping[aIndex] * aTimeStep;
+		}
+
+		void BodyData::IntegrateVelocities(unsigned int aIndex, float aTimeStep)
+		{
+			positionX[aIndex] += linearVelocityX[aIndex] * aTimeStep;
+			positionY[aIndex] += linearVelocityY[aIndex] * aTimeStep;
+			angle[aIndex] += angularVelocity[aIndex] * aTimeStep;
+		}
+
+		void BodyData::ClearForces(unsigned int aIndex)
+		{
+			forceX[aIndex] = 0.0f;
+			forceY[aIndex] = 0.0f;
+			torque[aIndex] = 0.0f;
+		}
+
+		void BodyData::UpdateSleepTime(unsigned int aIndex, float aTimeStep)
+		{
+			float linearSpeedSquared = linearVelocityX[aIndex] * linearVelocityX[aIndex] + linearVelocityY[aIndex] * linearVelocityY[aIndex];
+			float angularSpeedSquared = angularVelocity[aIndex] * angularVelocity[aIndex];
+
+			if (linearSpeedSquared <= BODY_SLEEP_LINEAR_TOLERANCE * BODY_SLEEP_LINEAR_TOLERANCE &&
+				angularSpeedSquared <= BODY_SLEEP_ANGULAR_TOLERANCE * BODY_SLEEP_ANGULAR_TOLERANCE)
+			{
+				sleepTime[aIndex] += aTimeStep;
+			}
+			else
+			{
+				sleepTime[aIndex] = 0.0f;
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#ifndef __GameDev2D__BodyData__
+#define __GameDev2D__BodyData__
+
+#include "../Math/Vector2.h"
+#include <vector>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const float BODY_SLEEP_LINEAR_TOLERANCE = 0.01f;	//In m/s
+		const float BODY_SLEEP_ANGULAR_TOLERANCE = 0.035f;	//In radians/second
+		const float BODY_TIME_TO_SLEEP = 0.5f;				//In seconds
+
+		//Forward declaration
+		class Body;
+
+		//Structure of arrays storage for the simulation state of every body, owned by the World. A body's state
+		//lives at the same index in every array, so the integration loop can process four bodies at a time.
+		//The awake bodies are kept at the front of the arrays, so the sleeping bodies are never touched
+		struct BodyData
+		{
+			BodyData();
+			~BodyData();
+
+			//Adds a body with zeroed state and returns its index, the body is added to the sleeping bodies
+			unsigned int AddBody(Body* body);
+
+			//Removes the last body, use Swap() first to remove any other body in constant time
+			void RemoveLast();
+
+			//Swaps the state of two bodies, the bodies' handles have to be updated afterwards
+			void Swap(unsigned int indexA, unsigned int indexB);
+
+			//Returns the number of bodies stored
+			unsigned int GetCount();
+
+			//Integrates the forces and velocities of the awake bodies, clears their forces and updates how
+			//long they've been resting for, in a single pass
+			void Integrate(float timeStep, Vector2 gravity);
+
+			//Scalar versions of the integration steps, for a single body
+			void IntegrateForces(unsigned int index, float timeStep, Vector2 gravity);
+			void IntegrateVelocities(unsigned int index, float timeStep);
+			void ClearForces(unsigned int index);
+			void UpdateSleepTime(unsigned int index, float timeStep);
+
+			//Member variables
+			std::vector<float> positionX;			//In meters
+			std::vector<float> positionY;			//In meters
+			std::vector<float> angle;				//In radians
+			std::vector<float> linearVelocityX;		//In m/s
+			std::vector<float> linearVelocityY;		//In m/s
+			std::vector<float> angularVelocity;		//In radians/second
+			std::vector<float> forceX;				//In Newtons
+			std::vector<float> forceY;				//In Newtons
+			std::vector<float> torque;
+			std::vector<float> linearDampingX;
+			std::vector<float> linearDampingY;
+			std::vector<float> angularDamping;
+			std::vector<float> mass;				//In kg
+			std::vector<float> inverseMass;
+			std::vector<float> inertia;				//In kg-square meters
+			std::vector<float> inverseInertia;
+			std::vector<float> sleepTime;			//In seconds
+			std::vector<Body*> body;
+			unsigned int awakeCount;
+		};
+	}
+}
+
+#endif
@@ -1,10 +1,33 @@
 #include "BoxCollider.h"
+#include "ObjectPool.h"
+#include <assert.h>
+#include <float.h>
+#include <math.h>
 
 namespace GameDev2D
 {
 	namespace Physics
 	{
-		BoxCollider::BoxCollider(float aWidth, float aHeight) :
+		//The pool is never destroyed, colliders can outlive any object that could own it
+		static ObjectPool* GetBoxColliderPool()
+		{
+			static ObjectPool* s_Pool = new ObjectPool(sizeof(BoxCollider));
+			return s_Pool;
+		}
+
+		void* BoxCollider::operator new(size_t aSize)
+		{
+			//If this assert is hit, a class derived from BoxCollider needs its own pool
+			assert(aSize == sizeof(BoxCollider));
+			return GetBoxColliderPool()->Allocate();
+		}
+
+		void BoxCollider::operator delete(void* aPointer)
+		{
+			GetBoxColliderPool()->Free(aPointer);
+		}
+
+		BoxCollider::BoxCollider(float aWidth, float aHeight) : Collider(ColliderType_Box),
 			m_Width(aWidth),
 			m_Height(aHeight)
 		{
@@ -25,11 +48,6 @@ namespace GameDev2D
 			m_Normals[3] = Vector2(-1.0f, 0.0f);
 		}
 
-		ColliderType BoxCollider::GetType()
-		{
-			return ColliderType_Box;
-		}
-
 		float BoxCollider::ComputeMass(float aDensity)
 		{
 			return aDensity * m_Width * m_Height * 0.5f;
@@ -40,6 +58,44 @@ namespace GameDev2D
 			return aMass * (m_Width * m_Width + m_Height * m_Height) / 12.0f;
 		}
 
+		AABB BoxCollider::ComputeAABB(Vector2 aPosition)
+		{
+			//Project the rotated half extents onto the world axes
+			float c = fabsf(cosf(GetAngle()));
+			float s = fabsf(sinf(GetAngle()));
+			float halfWidth = m_Width / 2.0f;
+			float halfHeight = m_Height / 2.0f;
+			Vector2 extents(halfWidth * c + halfHeight * s, halfWidth * s + halfHeight * c);
+
+			return AABB(aPosition - extents, aPosition + extents);
+		}
+
+		void BoxCollider::UpdateTransform(Vector2 aPosition, float aAngleInRadians)
+		{
+			Collider::UpdateTransform(aPosition, aAngleInRadians);
+
+			//Transform the vertices and normals into world space, the bounding box encloses the world space vertices
+			m_AABB = AABB(Vector2(FLT_MAX, FLT_MAX), Vector2(-FLT_MAX, -FLT_MAX));
+			for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+			{
+				m_WorldVertices[i] = m_Transform.Rotate(m_Vertices[i]) + aPosition;
+				m_WorldNormals[i] = m_Transform.Rotate(m_Normals[i]);
+				m_AABB = AABB::Combine(m_AABB, AABB(m_WorldVertices[i], m_WorldVertices[i]));
+			}
+		}
+
+		bool BoxCollider::TestPoint(Vector2 aPosition, Vector2 aPoint)
+		{
+			//Rotate the point into the box's local space
+			float c = cosf(GetAngle());
+			float s = sinf(GetAngle());
+			Vector2 delta = aPoint - aPosition;
+			float localX = c * delta.x + s * delta.y;
+			float localY = -s * delta.x + c * delta.y;
+
+			return fabsf(localX) <= m_Width / 2.0f && fabsf(localY) <= m_Height / 2.0f;
+		}
+
 		float BoxCollider::GetWidth()
 		{
 			return m_Width;
@@ -67,5 +123,25 @@ namespace GameDev2D
 			}
 			return Vector2(0.0f, 0.0f);
 		}
+
+		const Vector2* BoxCollider::GetVertices()
+		{
+			return m_Vertices;
+		}
+
+		const Vector2* BoxCollider::GetNormals()
+		{
+			return m_Normals;
+		}
+
+		const Vector2* BoxCollider::GetWorldVertices()
+		{
+			return m_WorldVertices;
+		}
+
+		const Vector2* BoxCollider::GetWorldNormals()
+		{
+			return m_WorldNormals;
+		}
 	}
 }
\ No newline at end of file
@@ -13,11 +13,17 @@ namespace GameDev2D
 		class BoxCollider : public Collider
 		{
 		public:
+			//Box colliders are allocated from a pool, so creating and destroying them doesn't churn the heap
+			static void* operator new(size_t size);
+			static void operator delete(void* pointer);
+
 			BoxCollider(float width, float height);
 
-			ColliderType GetType();
 			float ComputeMass(float density);
 			float ComputeInertia(float mass);
+			AABB ComputeAABB(Vector2 position);
+			void UpdateTransform(Vector2 position, float angleInRadians);
+			bool TestPoint(Vector2 position, Vector2 point);
 
 			float GetWidth();
 			float GetHeight();
@@ -25,12 +31,22 @@ namespace GameDev2D
 			Vector2 GetVerticesAtIndex(unsigned int index);
 			Vector2 GetNormalsAtIndex(unsigned int index);
 
+			//Returns the local space vertices and normals, there are BOX_COLLIDER_VERTEX_COUNT of each
+			const Vector2* GetVertices();
+			const Vector2* GetNormals();
+
+			//Returns the world space vertices and normals from the last UpdateTransform() call
+			const Vector2* GetWorldVertices();
+			const Vector2* GetWorldNormals();
+
 		private:
 			//Member variables
 			float m_Width;
 			float m_Height;
 			Vector2 m_Vertices[BOX_COLLIDER_VERTEX_COUNT];
 			Vector2 m_Normals[BOX_COLLIDER_VERTEX_COUNT];
+			Vector2 m_WorldVertices[BOX_COLLIDER_VERTEX_COUNT];
+			Vector2 m_WorldNormals[BOX_COLLIDER_VERTEX_COUNT];
 		};
 	}
 }
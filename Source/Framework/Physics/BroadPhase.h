@@ -0,0 +1,78 @@
+#ifndef __GameDev2D__BroadPhase__
+#define __GameDev2D__BroadPhase__
+
+#include "AABB.h"
+#include "CollisionFilter.h"
+#include <vector>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const int NULL_PROXY = -1;
+
+		//Enum to help manage the type of broadphase the World uses
+		enum BroadPhaseType
+		{
+			BroadPhaseType_SpatialHash,
+			BroadPhaseType_DynamicTree
+		};
+
+		//A pair of proxies whose bounding boxes overlap, proxyA is always less than proxyB
+		struct ProxyPair
+		{
+			ProxyPair(int proxyA, int proxyB) :
+				proxyA(proxyA),
+				proxyB(proxyB)
+			{
+			}
+
+			bool operator<(const ProxyPair& pair) const
+			{
+				return proxyA < pair.proxyA || (proxyA == pair.proxyA && proxyB < pair.proxyB);
+			}
+
+			int proxyA;
+			int proxyB;
+		};
+
+		//Interface for the broadphase backends the World can use to find the pairs of bodies that might be touching
+		class BroadPhase
+		{
+		public:
+			virtual ~BroadPhase() {}
+
+			//Adds a bounding box to the broadphase and returns its proxy id, the user data is returned with the pairs
+			virtual int CreateProxy(const AABB& aabb, void* userData) = 0;
+
+			//Removes a proxy from the broadphase, the proxy id can be reused by the next CreateProxy() call
+			virtual void DestroyProxy(int proxyId) = 0;
+
+			//Updates the bounding box of a proxy, the displacement is how far the proxy is expected to move during the next step
+			virtual void MoveProxy(int proxyId, const AABB& aabb, Vector2 displacement) = 0;
+
+			//Sets the collision filter for a proxy, pairs the filters reject are never reported by ComputePairs()
+			virtual void SetFilter(int proxyId, const CollisionFilter& filter) = 0;
+
+			//Returns the user data and bounding box for a proxy, the bounding box may be larger than the one that was supplied
+			virtual void* GetUserData(int proxyId) = 0;
+			virtual const AABB& GetAABB(int proxyId) = 0;
+
+			//Fills the pairs vector with every unique pair of overlapping proxies that has at least one proxy from
+			//the proxies vector, sorted by proxy id. Pairs where neither proxy is in the vector cost nothing
+			virtual void ComputePairs(const std::vector<int>& proxies, std::vector<ProxyPair>* pairs) = 0;
+
+			//Returns the number of overlapping pairs the collision filters rejected during the last ComputePairs() call
+			virtual unsigned int GetCulledPairCount() = 0;
+
+			//Fills the proxies vector with every proxy whose bounding box overlaps the supplied bounding box
+			virtual void Query(const AABB& aabb, std::vector<int>* proxies) = 0;
+
+			//Returns the number of proxies in the broadphase
+			virtual unsigned int GetProxyCount() = 0;
+		};
+	}
+}
+
+#endif
@@ -1,19 +1,35 @@
 #include "CircleCollider.h"
+#include "ObjectPool.h"
+#include <assert.h>
 
 
 namespace GameDev2D
 {
 	namespace Physics
 	{
-		CircleCollider::CircleCollider(float aRadius) : Collider(),
-			m_Radius(aRadius)
+		//The pool is never destroyed, colliders can outlive any object that could own it
+		static ObjectPool* GetCircleColliderPool()
 		{
+			static ObjectPool* s_Pool = new ObjectPool(sizeof(CircleCollider));
+			return s_Pool;
+		}
 
+		void* CircleCollider::operator new(size_t aSize)
+		{
+			//If this assert is hit, a class derived from CircleCollider needs its own pool
+			assert(aSize == sizeof(CircleCollider));
+			return GetCircleColliderPool()->Allocate();
 		}
 
-		ColliderType CircleCollider::GetType()
+		void CircleCollider::operator delete(void* aPointer)
 		{
-			return ColliderType_Circle;
+			GetCircleColliderPool()->Free(aPointer);
+		}
+
+		CircleCollider::CircleCollider(float aRadius) : Collider(ColliderType_Circle),
+			m_Radius(aRadius)
+		{
+
 		}
 
 		float CircleCollider::ComputeMass(float aDensity)
@@ -26,6 +42,24 @@ namespace GameDev2D
 			return aMass * m_Radius * m_Radius;
 		}
 
+		AABB CircleCollider::ComputeAABB(Vector2 aPosition)
+		{
+			Vector2 extents(m_Radius, m_Radius);
+			return AABB(aPosition - extents, aPosition + extents);
+		}
+
+		void CircleCollider::UpdateTransform(Vector2 aPosition, float aAngleInRadians)
+		{
+			Collider::UpdateTransform(aPosition, aAngleInRadians);
+			m_AABB = ComputeAABB(aPosition);
+		}
+
+		bool CircleCollider::TestPoint(Vector2 aPosition, Vector2 aPoint)
+		{
+			Vector2 delta = aPoint - aPosition;
+			return delta.x * delta.x + delta.y * delta.y <= m_Radius * m_Radius;
+		}
+
 		float CircleCollider::GetRadius()
 		{
 			return m_Radius;
@@ -10,11 +10,17 @@ namespace GameDev2D
 		class CircleCollider :	public Collider
 		{
 		public:
+			//Circle colliders are allocated from a pool, so creating and destroying them doesn't churn the heap
+			static void* operator new(size_t size);
+			static void operator delete(void* pointer);
+
 			CircleCollider(float radius);
 
-			ColliderType GetType();
 			float ComputeMass(float density);
 			float ComputeInertia(float mass);
+			AABB ComputeAABB(Vector2 position);
+			void UpdateTransform(Vector2 position, float angleInRadians);
+			bool TestPoint(Vector2 position, Vector2 point);
 
 			float GetRadius();
 
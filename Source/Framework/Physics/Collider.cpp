@@ -1,13 +1,20 @@
 #include "Collider.h"
+#include "Body.h"
+#include <math.h>
 
 namespace GameDev2D
 {
 	namespace Physics
 	{
-		Collider::Collider() :
+		Collider::Collider(ColliderType aType) :
+			m_Transform(),
+			m_AABB(),
 			m_Body(nullptr),
+			m_Type(aType),
 			m_Angle(0.0f),
-			m_IsEnabled(true)
+			m_Filter(),
+			m_IsEnabled(true),
+			m_IsSensor(false)
 		{
 
 		}
@@ -17,6 +24,29 @@ namespace GameDev2D
 			m_Body = nullptr;
 		}
 
+		ColliderType Collider::GetType()
+		{
+			return m_Type;
+		}
+
+		void Collider::UpdateTransform(Vector2 aPosition, float aAngleInRadians)
+		{
+			m_Angle = aAngleInRadians;
+			m_Transform.position = aPosition;
+			m_Transform.cosAngle = cosf(aAngleInRadians);
+			m_Transform.sinAngle = sinf(aAngleInRadians);
+		}
+
+		const ColliderTransform& Collider::GetTransform()
+		{
+			return m_Transform;
+		}
+
+		const AABB& Collider::GetAABB()
+		{
+			return m_AABB;
+		}
+
 		void Collider::SetBody(Body* aBody)
 		{
 			m_Body = aBody;
@@ -44,7 +74,60 @@ namespace GameDev2D
 
 		void Collider::SetIsEnabled(bool isEnabled)
 		{
+			//Wake the body, so the World updates its broadphase proxy
+			if (m_IsEnabled != isEnabled && m_Body != nullptr)
+			{
+				m_Body->SetIsAwake(true);
+			}
+
 			m_IsEnabled = isEnabled;
 		}
+
+		void Collider::SetCategoryBits(unsigned short aCategoryBits)
+		{
+			//Wake the body, so the World updates its broadphase proxy's filter
+			if (m_Filter.categoryBits != aCategoryBits && m_Body != nullptr)
+			{
+				m_Body->SetIsAwake(true);
+			}
+
+			m_Filter.categoryBits = aCategoryBits;
+		}
+
+		unsigned short Collider::GetCategoryBits()
+		{
+			return m_Filter.categoryBits;
+		}
+
+		void Collider::SetMaskBits(unsigned short aMaskBits)
+		{
+			//Wake the body, so the World updates its broadphase proxy's filter
+			if (m_Filter.maskBits != aMaskBits && m_Body != nullptr)
+			{
+				m_Body->SetIsAwake(true);
+			}
+
+			m_Filter.maskBits = aMaskBits;
+		}
+
+		unsigned short Collider::GetMaskBits()
+		{
+			return m_Filter.maskBits;
+		}
+
+		const CollisionFilter& Collider::GetFilter()
+		{
+			return m_Filter;
+		}
+
+		void Collider::SetIsSensor(bool aIsSensor)
+		{
+			m_IsSensor = aIsSensor;
+		}
+
+		bool Collider::GetIsSensor()
+		{
+			return m_IsSensor;
+		}
 	}
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #ifndef __COLLIDER_H__
 #define __COLLIDER_H__
 
+#include "AABB.h"
+#include "CollisionFilter.h"
+
 namespace GameDev2D
 {
 	namespace Physics
@@ -8,23 +11,68 @@ namespace GameDev2D
 		//Forward declarations
 		class Body;
 
-		//Enum to help manage the type of colliders
+		//Enum to help manage the type of colliders, a new type also needs its kernels added to the table in CollisionKernels.cpp
 		enum ColliderType
 		{
 			ColliderType_Circle,
-			ColliderType_Box
+			ColliderType_Box,
+			ColliderType_Count	//Must be last
+		};
+
+		//World space position and rotation of a collider, cached once per step so the narrowphase kernels
+		//don't have to compute the sine and cosine of the angle for every pair
+		struct ColliderTransform
+		{
+			ColliderTransform() :
+				position(0.0f, 0.0f),
+				cosAngle(1.0f),
+				sinAngle(0.0f)
+			{
+			}
+
+			//Rotates a vector from the collider's local space into world space
+			Vector2 Rotate(Vector2 vector) const
+			{
+				return Vector2(cosAngle * vector.x - sinAngle * vector.y, sinAngle * vector.x + cosAngle * vector.y);
+			}
+
+			//Rotates a vector from world space into the collider's local space
+			Vector2 InverseRotate(Vector2 vector) const
+			{
+				return Vector2(cosAngle * vector.x + sinAngle * vector.y, -sinAngle * vector.x + cosAngle * vector.y);
+			}
+
+			//Member variables
+			Vector2 position;	//In meters
+			float cosAngle;
+			float sinAngle;
 		};
 
 		class Collider
 		{
 		public:
-			Collider();
+			Collider(ColliderType type);
 			virtual ~Collider();
 
-			virtual ColliderType GetType() = 0;
+			//The type isn't virtual, the narrowphase looks it up for every pair
+			ColliderType GetType();
 			virtual float ComputeMass(float density) = 0;
 			virtual float ComputeInertia(float mass) = 0;
 
+			//Returns the world space bounding box of the collider, for a body at the supplied position
+			virtual AABB ComputeAABB(Vector2 position) = 0;
+
+			//Returns true if the point is inside the collider, for a body at the supplied position
+			virtual bool TestPoint(Vector2 position, Vector2 point) = 0;
+
+			//Caches the collider's world space transform and bounding box for a body at the supplied position and angle,
+			//the World calls this once per step for every awake body before the narrowphase runs
+			virtual void UpdateTransform(Vector2 position, float angleInRadians);
+
+			//Returns the transform and bounding box from the last UpdateTransform() call
+			const ColliderTransform& GetTransform();
+			const AABB& GetAABB();
+
 			void SetBody(Body* body);
 			Body* GetBody();
 
@@ -34,10 +82,32 @@ namespace GameDev2D
 			bool GetIsEnabled();
 			void SetIsEnabled(bool isEnabled);
 
+			//The category bits are the categories this collider belongs to, the mask bits are the categories it
+			//collides with. Pairs that the filters reject are culled by the broadphase, the listener never sees them
+			void SetCategoryBits(unsigned short categoryBits);
+			unsigned short GetCategoryBits();
+
+			void SetMaskBits(unsigned short maskBits);
+			unsigned short GetMaskBits();
+
+			const CollisionFilter& GetFilter();
+
+			//Sensors report contacts to the listener, but they don't push the bodies apart
+			void SetIsSensor(bool isSensor);
+			bool GetIsSensor();
+
+		protected:
+			//Member variables
+			ColliderTransform m_Transform;
+			AABB m_AABB;
+
 		private:
 			Body* m_Body;
+			ColliderType m_Type;
 			float m_Angle;
+			CollisionFilter m_Filter;
 			bool m_IsEnabled;
+			bool m_IsSensor;
 		};
 	}
 }
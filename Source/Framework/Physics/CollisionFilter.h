@@ -0,0 +1,41 @@
+#ifndef __GameDev2D__CollisionFilter__
+#define __GameDev2D__CollisionFilter__
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const unsigned short COLLISION_FILTER_DEFAULT_CATEGORY = 0x0001;
+		const unsigned short COLLISION_FILTER_DEFAULT_MASK = 0xffff;
+
+		//Category and mask bits used by the broadphase to reject pairs that can't interact before the narrowphase runs,
+		//two colliders only collide if each one's category is in the other one's mask
+		struct CollisionFilter
+		{
+			CollisionFilter() :
+				categoryBits(COLLISION_FILTER_DEFAULT_CATEGORY),
+				maskBits(COLLISION_FILTER_DEFAULT_MASK)
+			{
+			}
+
+			CollisionFilter(unsigned short categoryBits, unsigned short maskBits) :
+				categoryBits(categoryBits),
+				maskBits(maskBits)
+			{
+			}
+
+			//Returns true if the two filters allow the colliders to collide
+			static bool ShouldCollide(const CollisionFilter& a, const CollisionFilter& b)
+			{
+				return (a.maskBits & b.categoryBits) != 0 && (b.maskBits & a.categoryBits) != 0;
+			}
+
+			//Member variables
+			unsigned short categoryBits;	//The categories the collider belongs to
+			unsigned short maskBits;		//The categories the collider collides with
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include "CollisionKernels.h"
+#include "Body.h"
+#include "Manifold.h"
+#include "CircleCollider.h"
+#include "BoxCollider.h"
+#include "../Math/Math.h"
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Returns the largest separation between box B's vertices and one of box A's faces, a positive separation
+		//means the face is a separating axis. The face index is returned in the face pointer
+		static float FindMaxSeparation(const Vector2* aVerticesA, const Vector2* aNormalsA, const Vector2* aVerticesB, unsigned int* aFace)
+		{
+			float maxSeparation = -FLT_MAX;
+			*aFace = 0;
+
+			for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+			{
+				//The deepest vertex of box B along the face's normal
+				float separation = FLT_MAX;
+				for (unsigned int j = 0; j < BOX_COLLIDER_VERTEX_COUNT; j++)
+				{
+					float distance = Math::Dot(aNormalsA[i], aVerticesB[j] - aVerticesA[i]);
+					if (distance < separation)
+					{
+						separation = distance;
+					}
+				}
+
+				if (separation > maxSeparation)
+				{
+					maxSeparation = separation;
+					*aFace = i;
+				}
+			}
+
+			return maxSeparation;
+		}
+
+		template<>
+		bool Collide<ColliderType_Circle, ColliderType_Circle>(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		{
+			//Get the circle colliders
+			CircleCollider* circleColliderA = (CircleCollider*)aBodyA->GetCollider();
+			CircleCollider* circleColliderB = (CircleCollider*)aBodyB->GetCollider();
+
+			//Check the distance against the radii for collision
+			Vector2 positionA = circleColliderA->GetTransform().position;
+			Vector2 positionB = circleColliderB->GetTransform().position;
+			float distanceSquared = Math::CalculateDistanceSquared(positionA, positionB);
+			float combinedRadii = circleColliderA->GetRadius() + circleColliderB->GetRadius();
+			float radiiSquared = combinedRadii * combinedRadii;
+
+			if (distanceSquared > radiiSquared)
+			{
+				return false;
+			}
+
+			float distance = sqrtf(distanceSquared);
+			float overlap = combinedRadii - distance;
+
+			//If the circles are exactly on top of each other there's no direction to push them apart, pick one so the
+			//positions don't end up NaN (which would also corrupt the broadphase)
+			Vector2 normal(1.0f, 0.0f);
+			if (distance > 0.0f)
+			{
+				normal = (positionB - positionA) / distance;
+			}
+			aManifold->SetContact(overlap, normal);
+
+			return true;
+		}
+
+		template<>
+		bool Collide<ColliderType_Circle, ColliderType_Box>(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		{
+			CircleCollider* circleCollider = (CircleCollider*)aBodyA->GetCollider();
+			BoxCollider* boxCollider = (BoxCollider*)aBodyB->GetCollider();
+
+			float radius = circleCollider->GetRadius();
+			float radiusSquared = radius * radius;
+			const ColliderTransform& boxTransform = boxCollider->GetTransform();
+			const Vector2* vertices = boxCollider->GetVertices();
+			const Vector2* normals = boxCollider->GetNormals();
+
+			//Rotate the circle's center into the box's local space
+			Vector2 circleCenter = boxTransform.InverseRotate(circleCollider->GetTransform().position - boxTransform.position);
+
+			float maxSeperation = -FLT_MAX;
+			unsigned int faceNormal = 0;
+
+			for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+			{
+				float seperation = Math::Dot(normals[i], circleCenter - vertices[i]);
+
+				if (seperation > radius)
+				{
+					return false;
+				}
+				if (seperation > maxSeperation)
+				{
+					maxSeperation = seperation;
+					faceNormal = i;
+				}
+			}
+			if (maxSeperation < EPSILON)
+			{
+				float overlap = circleCollider->GetRadius();
+				Vector2 normal = boxCollider->GetWorldNormals()[faceNormal] * -1.0f;
+				aManifold->SetContact(overlap, normal);
+
+				return true;
+			}
+			//The circle's center is outside the box, clamp it to the box to get the closest point, this handles the corners too
+			Vector2 lowerBound = vertices[0];
+			Vector2 upperBound = vertices[2];
+			Vector2 closestPoint(Math::Clamp(circleCenter.x, lowerBound.x, upperBound.x), Math::Clamp(circleCenter.y, lowerBound.y, upperBound.y));
+
+			float distance = Math::CalculateDistanceSquared(closestPoint, circleCenter);
+
+			if (distance <= radiusSquared)
+			{
+				//Rotate the normal back into world space
+				float overlap = radius - sqrtf(distance);
+				Vector2 normal = boxTransform.Rotate(circleCenter - closestPoint) * -1.0f;
+				normal = Math::Normalize(normal);
+				aManifold->SetContact(overlap, normal);
+
+				return true;
+			}
+			return false;
+		}
+
+		template<>
+		bool Collide<ColliderType_Box, ColliderType_Circle>(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		{
+			//Run the circle to box test with the bodies swapped, then flip the normal so it points from A to B
+			if (Collide<ColliderType_Circle, ColliderType_Box>(aBodyB, aBodyA, aManifold) == true)
+			{
+				aManifold->FlipNormal();
+				return true;
+			}
+			return false;
+		}
+
+		template<>
+		bool Collide<ColliderType_Box, ColliderType_Box>(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		{
+			BoxCollider* boxColliderA = (BoxCollider*)aBodyA->GetCollider();
+			BoxCollider* boxColliderB = (BoxCollider*)aBodyB->GetCollider();
+
+			const Vector2* verticesA = boxColliderA->GetWorldVertices();
+			const Vector2* normalsA = boxColliderA->GetWorldNormals();
+			const Vector2* verticesB = boxColliderB->GetWorldVertices();
+			const Vector2* normalsB = boxColliderB->GetWorldNormals();
+
+			//Separating axis test, the only axes two boxes can be separated on are their face normals
+			unsigned int faceA = 0;
+			float separationA = FindMaxSeparation(verticesA, normalsA, verticesB, &faceA);
+			if (separationA > 0.0f)
+			{
+				return false;
+			}
+
+			unsigned int faceB = 0;
+			float separationB = FindMaxSeparation(verticesB, normalsB, verticesA, &faceB);
+			if (separationB > 0.0f)
+			{
+				return false;
+			}
+
+			//Push the boxes apart along the axis of least penetration, box A's face is preferred unless box B's
+			//is clearly better, so the normal doesn't flip back and forth between steps when they're about equal
+			if (separationB > separationA * BOX_COLLISION_RELATIVE_TOLERANCE + BOX_COLLISION_ABSOLUTE_TOLERANCE)
+			{
+				aManifold->SetContact(-separationB, -normalsB[faceB]);
+			}
+			else
+			{
+				aManifold->SetContact(-separationA, normalsA[faceA]);
+			}
+
+			return true;
+		}
+
+		//Dispatch table indexed by [typeA][typeB], a new collider type needs a row and a column of kernels
+		static const CollisionKernel s_CollisionKernels[ColliderType_Count][ColliderType_Count] =
+		{
+			//ColliderType_Circle								//ColliderType_Box
+			{ &Collide<ColliderType_Circle, ColliderType_Circle>,	&Collide<ColliderType_Circle, ColliderType_Box> },	//ColliderType_Circle
+			{ &Collide<ColliderType_Box, ColliderType_Circle>,		&Collide<ColliderType_Box, ColliderType_Box> }		//ColliderType_Box
+		};
+
+		CollisionKernel GetCollisionKernel(ColliderType aTypeA, ColliderType aTypeB)
+		{
+			//If this assert is hit, the collider type is invalid
+			assert(aTypeA < ColliderType_Count && aTypeB < ColliderType_Count);
+
+			return s_CollisionKernels[aTypeA][aTypeB];
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#ifndef __GameDev2D__CollisionKernels__
+#define __GameDev2D__CollisionKernels__
+
+#include "Collider.h"
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const float BOX_COLLISION_RELATIVE_TOLERANCE = 0.98f;
+		const float BOX_COLLISION_ABSOLUTE_TOLERANCE = 0.001f;	//In meters
+
+		//Forward declarations
+		class Body;
+		class Manifold;
+
+		//Narrowphase test for a pair of bodies, returns true and sets the manifold's contact if the colliders
+		//are touching. The manifold's normal always points from body A to body B. Kernels only read the colliders'
+		//cached transforms, Collider::UpdateTransform() must have been called since the bodies last moved
+		typedef bool (*CollisionKernel)(Body* bodyA, Body* bodyB, Manifold* manifold);
+
+		//Narrowphase test for a pair of collider types, each supported pair has a specialization in CollisionKernels.cpp
+		template<ColliderType TypeA, ColliderType TypeB>
+		bool Collide(Body* bodyA, Body* bodyB, Manifold* manifold);
+
+		//Returns the kernel for a pair of collider types from the dispatch table, or nullptr if the types can't collide
+		CollisionKernel GetCollisionKernel(ColliderType typeA, ColliderType typeB);
+	}
+}
+
+#endif
@@ -0,0 +1,616 @@
+#include "DynamicTree.h"
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		DynamicTree::DynamicTree(float aMargin) :
+			m_Root(DYNAMIC_TREE_NULL_NODE),
+			m_FreeList(DYNAMIC_TREE_NULL_NODE),
+			m_Margin(aMargin),
+			m_ProxyCount(0),
+			m_CulledPairCount(0)
+		{
+			//If this assert is hit, the margin can't be negative
+			assert(aMargin >= 0.0f);
+		}
+
+		DynamicTree::~DynamicTree()
+		{
+			m_Nodes.clear();
+			m_Stack.clear();
+			m_NodePairs.clear();
+			m_IsQueried.clear();
+		}
+
+		int DynamicTree::CreateProxy(const AABB& aAABB, void* aUserData)
+		{
+			//If this assert is hit, the bounding box is invalid, check the body's position for NaNs
+			assert(aAABB.lowerBound.x <= aAABB.upperBound.x && aAABB.lowerBound.y <= aAABB.upperBound.y);
+
+			int proxyId = AllocateNode();
+
+			//Fatten the bounding box so small movements don't require the proxy to be re-inserted
+			Node& node = m_Nodes.at(proxyId);
+			Vector2 margin(m_Margin, m_Margin);
+			node.aabb = AABB(aAABB.lowerBound - margin, aAABB.upperBound + margin);
+			node.userData = aUserData;
+			node.filter = CollisionFilter();
+			node.height = 0;
+
+			InsertLeaf(proxyId);
+			m_ProxyCount++;
+
+			return proxyId;
+		}
+
+		void DynamicTree::DestroyProxy(int aProxyId)
+		{
+			//If this assert is hit, the proxy id is invalid
+			assert(aProxyId >= 0 && aProxyId < (int)m_Nodes.size() && m_Nodes.at(aProxyId).IsLeaf() == true && m_Nodes.at(aProxyId).height == 0);
+
+			RemoveLeaf(aProxyId);
+			FreeNode(aProxyId);
+			m_ProxyCount--;
+		}
+
+		void DynamicTree::MoveProxy(int aProxyId, const AABB& aAABB, Vector2 aDisplacement)
+		{
+			//If this assert is hit, the proxy id is invalid
+			assert(aProxyId >= 0 && aProxyId < (int)m_Nodes.size() && m_Nodes.at(aProxyId).IsLeaf() == true && m_Nodes.at(aProxyId).height == 0);
+
+			//If this assert is hit, the bounding box is invalid, check the body's position for NaNs
+			assert(aAABB.lowerBound.x <= aAABB.upperBound.x && aAABB.lowerBound.y <= aAABB.upperBound.y);
+
+			//Nothing to do if the bounding box is still inside the fat bounding box
+			if (m_Nodes.at(aProxyId).aabb.Contains(aAABB) == true)
+			{
+				return;
+			}
+
+			RemoveLeaf(aProxyId);
+
+			//Fatten the bounding box and extend it in the direction the proxy is moving
+			Vector2 margin(m_Margin, m_Margin);
+			AABB fatAABB(aAABB.lowerBound - margin, aAABB.upperBound + margin);
+			Vector2 displacement = aDisplacement * DYNAMIC_TREE_DISPLACEMENT_MULTIPLIER;
+
+			if (displacement.x < 0.0f)
+			{
+				fatAABB.lowerBound.x += displacement.x;
+			}
+			else
+			{
+				fatAABB.upperBound.x += displacement.x;
+			}
+
+			if (displacement.y < 0.0f)
+			{
+				fatAABB.lowerBound.y += displacement.y;
+			}
+			else
+			{
+				fatAABB.upperBound.y += displacement.y;
+			}
+
+			m_Nodes.at(aProxyId).aabb = fatAABB;
+
+			InsertLeaf(aProxyId);
+		}
+
+		void DynamicTree::SetFilter(int aProxyId, const CollisionFilter& aFilter)
+		{
+			//If this assert is hit, the proxy id is invalid
+			assert(aProxyId >= 0 && aProxyId < (int)m_Nodes.size() && m_Nodes.at(aProxyId).IsLeaf() == true && m_Nodes.at(aProxyId).height == 0);
+
+			m_Nodes.at(aProxyId).filter = aFilter;
+		}
+
+		void* DynamicTree::GetUserData(int aProxyId)
+		{
+			return m_Nodes.at(aProxyId).userData;
+		}
+
+		const AABB& DynamicTree::GetAABB(int aProxyId)
+		{
+			return m_Nodes.at(aProxyId).aabb;
+		}
+
+		void DynamicTree::ComputePairs(const std::vector<int>& aProxies, std::vector<ProxyPair>* aPairs)
+		{
+			m_CulledPairCount = 0;
+
+			if (aProxies.size() == m_ProxyCount)
+			{
+				ComputeAllPairs(aPairs);
+				return;
+			}
+
+			aPairs->clear();
+
+			//Flag the proxies being queried, a pair of two queried proxies is only reported by the lower proxy id
+			m_IsQueried.resize(m_Nodes.size(), false);
+			for (unsigned int i = 0; i < aProxies.size(); i++)
+			{
+				m_IsQueried[aProxies.at(i)] = true;
+			}
+
+			for (unsigned int i = 0; i < aProxies.size(); i++)
+			{
+				int proxyId = aProxies.at(i);
+				const AABB& aabb = m_Nodes.at(proxyId).aabb;
+				const CollisionFilter& filter = m_Nodes.at(proxyId).filter;
+
+				m_Stack.clear();
+				m_Stack.push_back(m_Root);
+
+				while (m_Stack.size() > 0)
+				{
+					int nodeId = m_Stack.back();
+					m_Stack.pop_back();
+
+					const Node& node = m_Nodes.at(nodeId);
+					if (node.aabb.Overlaps(aabb) == false)
+					{
+						continue;
+					}
+
+					if (node.IsLeaf() == true)
+					{
+						if (nodeId != proxyId && (m_IsQueried[nodeId] == false || nodeId > proxyId))
+						{
+							if (CollisionFilter::ShouldCollide(filter, node.filter) == false)
+							{
+								m_CulledPairCount++;
+							}
+							else
+							{
+								aPairs->push_back(ProxyPair(std::min<int>(proxyId, nodeId), std::max<int>(proxyId, nodeId)));
+							}
+						}
+					}
+					else
+					{
+						m_Stack.push_back(node.child1);
+						m_Stack.push_back(node.child2);
+					}
+				}
+			}
+
+			for (unsigned int i = 0; i < aProxies.size(); i++)
+			{
+				m_IsQueried[aProxies.at(i)] = false;
+			}
+
+			//The traversal order depends on the shape of the tree, sort the pairs so the results don't
+			std::sort(aPairs->begin(), aPairs->end());
+		}
+
+		void DynamicTree::ComputeAllPairs(std::vector<ProxyPair>* aPairs)
+		{
+			aPairs->clear();
+
+			if (m_Root == DYNAMIC_TREE_NULL_NODE)
+			{
+				return;
+			}
+
+			//Collide the tree against itself, each entry on the stack is a pair of nodes whose sub-trees need to be
+			//tested against each other. When both nodes are the same, the node's children are tested against each other
+			m_NodePairs.clear();
+			m_NodePairs.push_back(ProxyPair(m_Root, m_Root));
+
+			while (m_NodePairs.size() > 0)
+			{
+				ProxyPair nodePair = m_NodePairs.back();
+				m_NodePairs.pop_back();
+
+				const Node& nodeA = m_Nodes.at(nodePair.proxyA);
+				const Node& nodeB = m_Nodes.at(nodePair.proxyB);
+
+				if (nodePair.proxyA == nodePair.proxyB)
+				{
+					if (nodeA.IsLeaf() == false)
+					{
+						m_NodePairs.push_back(ProxyPair(nodeA.child1, nodeA.child1));
+						m_NodePairs.push_back(ProxyPair(nodeA.child2, nodeA.child2));
+						m_NodePairs.push_back(ProxyPair(nodeA.child1, nodeA.child2));
+					}
+					continue;
+				}
+
+				if (nodeA.aabb.Overlaps(nodeB.aabb) == false)
+				{
+					continue;
+				}
+
+				if (nodeA.IsLeaf() == true && nodeB.IsLeaf() == true)
+				{
+					if (CollisionFilter::ShouldCollide(nodeA.filter, nodeB.filter) == false)
+					{
+						m_CulledPairCount++;
+						continue;
+					}
+
+					int a = std::min<int>(nodePair.proxyA, nodePair.proxyB);
+					int b = std::max<int>(nodePair.proxyA, nodePair.proxyB);
+					aPairs->push_back(ProxyPair(a, b));
+				}
+				else if (nodeB.IsLeaf() == true || (nodeA.IsLeaf() == false && nodeA.height >= nodeB.height))
+				{
+					//Descend into the taller node
+					m_NodePairs.push_back(ProxyPair(nodeA.child1, nodePair.proxyB));
+					m_NodePairs.push_back(ProxyPair(nodeA.child2, nodePair.proxyB));
+				}
+				else
+				{
+					m_NodePairs.push_back(ProxyPair(nodePair.proxyA, nodeB.child1));
+					m_NodePairs.push_back(ProxyPair(nodePair.proxyA, nodeB.child2));
+				}
+			}
+
+			//The traversal order depends on the shape of the tree, sort the pairs so the results don't
+			std::sort(aPairs->begin(), aPairs->end());
+		}
+
+		void DynamicTree::Query(const AABB& aAABB, std::vector<int>* aProxies)
+		{
+			aProxies->clear();
+
+			if (m_Root == DYNAMIC_TREE_NULL_NODE)
+			{
+				return;
+			}
+
+			m_Stack.clear();
+			m_Stack.push_back(m_Root);
+
+			while (m_Stack.size() > 0)
+			{
+				int nodeId = m_Stack.back();
+				m_Stack.pop_back();
+
+				const Node& node = m_Nodes.at(nodeId);
+				if (node.aabb.Overlaps(aAABB) == false)
+				{
+					continue;
+				}
+
+				if (node.IsLeaf() == true)
+				{
+					aProxies->push_back(nodeId);
+				}
+				else
+				{
+					m_Stack.push_back(node.child1);
+					m_Stack.push_back(node.child2);
+				}
+			}
+		}
+
+		unsigned int DynamicTree::GetProxyCount()
+		{
+			return m_ProxyCount;
+		}
+
+		unsigned int DynamicTree::GetCulledPairCount()
+		{
+			return m_CulledPairCount;
+		}
+
+		int DynamicTree::GetHeight()
+		{
+			if (m_Root == DYNAMIC_TREE_NULL_NODE)
+			{
+				return 0;
+			}
+			return m_Nodes.at(m_Root).height;
+		}
+
+		int DynamicTree::AllocateNode()
+		{
+			//Reuse a free node if there is one, otherwise add a new one
+			int nodeId = DYNAMIC_TREE_NULL_NODE;
+			if (m_FreeList != DYNAMIC_TREE_NULL_NODE)
+			{
+				nodeId = m_FreeList;
+				m_FreeList = m_Nodes.at(nodeId).parent;
+			}
+			else
+			{
+				nodeId = (int)m_Nodes.size();
+				m_Nodes.push_back(Node());
+			}
+
+			Node& node = m_Nodes.at(nodeId);
+			node.userData = nullptr;
+			node.parent = DYNAMIC_TREE_NULL_NODE;
+			node.child1 = DYNAMIC_TREE_NULL_NODE;
+			node.child2 = DYNAMIC_TREE_NULL_NODE;
+			node.height = 0;
+
+			return nodeId;
+		}
+
+		void DynamicTree::FreeNode(int aNodeId)
+		{
+			Node& node = m_Nodes.at(aNodeId);
+			node.userData = nullptr;
+			node.parent = m_FreeList;
+			node.child1 = DYNAMIC_TREE_NULL_NODE;
+			node.child2 = DYNAMIC_TREE_NULL_NODE;
+			node.height = -1;
+			m_FreeList = aNodeId;
+		}
+
+		void DynamicTree::InsertLeaf(int aLeafId)
+		{
+			if (m_Root == DYNAMIC_TREE_NULL_NODE)
+			{
+				m_Root = aLeafId;
+				m_Nodes.at(m_Root).parent = DYNAMIC_TREE_NULL_NODE;
+				return;
+			}
+
+			//Walk down the tree looking for the sibling that adds the least perimeter to the tree
+			AABB leafAABB = m_Nodes.at(aLeafId).aabb;
+			int index = m_Root;
+			while (m_Nodes.at(index).IsLeaf() == false)
+			{
+				const Node& node = m_Nodes.at(index);
+				float perimeter = node.aabb.GetPerimeter();
+				float combinedPerimeter = AABB::Combine(node.aabb, leafAABB).GetPerimeter();
+
+				//Cost of creating a new parent for this node and the new leaf
+				float cost = 2.0f * combinedPerimeter;
+
+				//Minimum cost of pushing the leaf further down the tree
+				float inheritanceCost = 2.0f * (combinedPerimeter - perimeter);
+
+				float childCost[2];
+				int children[2] = { node.child1, node.child2 };
+				for (int i = 0; i < 2; i++)
+				{
+					const Node& child = m_Nodes.at(children[i]);
+					float newPerimeter = AABB::Combine(child.aabb, leafAABB).GetPerimeter();
+					if (child.IsLeaf() == true)
+					{
+						childCost[i] = newPerimeter + inheritanceCost;
+					}
+					else
+					{
+						childCost[i] = (newPerimeter - child.aabb.GetPerimeter()) + inheritanceCost;
+					}
+				}
+
+				//Stop descending if creating a parent here is the cheapest option
+				if (cost < childCost[0] && cost < childCost[1])
+				{
+					break;
+				}
+
+				index = childCost[0] < childCost[1] ? children[0] : children[1];
+			}
+
+			//Create a new parent for the sibling and the leaf
+			int sibling = index;
+			int oldParent = m_Nodes.at(sibling).parent;
+			int newParent = AllocateNode();
+			m_Nodes.at(newParent).parent = oldParent;
+			m_Nodes.at(newParent).aabb = AABB::Combine(leafAABB, m_Nodes.at(sibling).aabb);
+			m_Nodes.at(newParent).height = m_Nodes.at(sibling).height + 1;
+			m_Nodes.at(newParent).child1 = sibling;
+			m_Nodes.at(newParent).child2 = aLeafId;
+			m_Nodes.at(sibling).parent = newParent;
+			m_Nodes.at(aLeafId).parent = newParent;
+
+			if (oldParent != DYNAMIC_TREE_NULL_NODE)
+			{
+				if (m_Nodes.at(oldParent).child1 == sibling)
+				{
+					m_Nodes.at(oldParent).child1 = newParent;
+				}
+				else
+				{
+					m_Nodes.at(oldParent).child2 = newParent;
+				}
+			}
+			else
+			{
+				m_Root = newParent;
+			}
+
+			//Walk back up the tree fixing the heights and bounding boxes
+			FixUpwards(m_Nodes.at(aLeafId).parent);
+		}
+
+		void DynamicTree::RemoveLeaf(int aLeafId)
+		{
+			if (aLeafId == m_Root)
+			{
+				m_Root = DYNAMIC_TREE_NULL_NODE;
+				return;
+			}
+
+			int parent = m_Nodes.at(aLeafId).parent;
+			int grandParent = m_Nodes.at(parent).parent;
+			int sibling = m_Nodes.at(parent).child1 == aLeafId ? m_Nodes.at(parent).child2 : m_Nodes.at(parent).child1;
+
+			//The sibling takes the parent's place in the tree
+			if (grandParent != DYNAMIC_TREE_NULL_NODE)
+			{
+				if (m_Nodes.at(grandParent).child1 == parent)
+				{
+					m_Nodes.at(grandParent).child1 = sibling;
+				}
+				else
+				{
+					m_Nodes.at(grandParent).child2 = sibling;
+				}
+				m_Nodes.at(sibling).parent = grandParent;
+				FreeNode(parent);
+
+				FixUpwards(grandParent);
+			}
+			else
+			{
+				m_Root = sibling;
+				m_Nodes.at(sibling).parent = DYNAMIC_TREE_NULL_NODE;
+				FreeNode(parent);
+			}
+
+			m_Nodes.at(aLeafId).parent = DYNAMIC_TREE_NULL_NODE;
+		}
+
+		void DynamicTree::FixUpwards(int aNodeId)
+		{
+			int index = aNodeId;
+			while (index != DYNAMIC_TREE_NULL_NODE)
+			{
+				index = Balance(index);
+
+				Node& node = m_Nodes.at(index);
+				const Node& child1 = m_Nodes.at(node.child1);
+				const Node& child2 = m_Nodes.at(node.child2);
+				node.height = 1 + std::max<int>(child1.height, child2.height);
+				node.aabb = AABB::Combine(child1.aabb, child2.aabb);
+
+				index = node.parent;
+			}
+		}
+
+		int DynamicTree::Balance(int aNodeId)
+		{
+			//Performs a left or right rotation if node A is imbalanced, returns the new root of the sub-tree.
+			//A's children are B and C, B's children are D and E, C's children are F and G
+			Node& a = m_Nodes.at(aNodeId);
+			if (a.IsLeaf() == true || a.height < 2)
+			{
+				return aNodeId;
+			}
+
+			int iB = a.child1;
+			int iC = a.child2;
+			int balance = m_Nodes.at(iC).height - m_Nodes.at(iB).height;
+
+			//Rotate C up
+			if (balance > 1)
+			{
+				Node& b = m_Nodes.at(iB);
+				Node& c = m_Nodes.at(iC);
+				int iF = c.child1;
+				int iG = c.child2;
+				Node& f = m_Nodes.at(iF);
+				Node& g = m_Nodes.at(iG);
+
+				//Swap A and C
+				c.child1 = aNodeId;
+				c.parent = a.parent;
+				a.parent = iC;
+
+				//A's old parent should point to C
+				if (c.parent != DYNAMIC_TREE_NULL_NODE)
+				{
+					if (m_Nodes.at(c.parent).child1 == aNodeId)
+					{
+						m_Nodes.at(c.parent).child1 = iC;
+					}
+					else
+					{
+						m_Nodes.at(c.parent).child2 = iC;
+					}
+				}
+				else
+				{
+					m_Root = iC;
+				}
+
+				//Keep the taller of F and G under C
+				if (f.height > g.height)
+				{
+					c.child2 = iF;
+					a.child2 = iG;
+					g.parent = aNodeId;
+					a.aabb = AABB::Combine(b.aabb, g.aabb);
+					c.aabb = AABB::Combine(a.aabb, f.aabb);
+					a.height = 1 + std::max<int>(b.height, g.height);
+					c.height = 1 + std::max<int>(a.height, f.height);
+				}
+				else
+				{
+					c.child2 = iG;
+					a.child2 = iF;
+					f.parent = aNodeId;
+					a.aabb = AABB::Combine(b.aabb, f.aabb);
+					c.aabb = AABB::Combine(a.aabb, g.aabb);
+					a.height = 1 + std::max<int>(b.height, f.height);
+					c.height = 1 + std::max<int>(a.height, g.height);
+				}
+
+				return iC;
+			}
+
+			//Rotate B up
+			if (balance < -1)
+			{
+				Node& b = m_Nodes.at(iB);
+				Node& c = m_Nodes.at(iC);
+				int iD = b.child1;
+				int iE = b.child2;
+				Node& d = m_Nodes.at(iD);
+				Node& e = m_Nodes.at(iE);
+
+				//Swap A and B
+				b.child1 = aNodeId;
+				b.parent = a.parent;
+				a.parent = iB;
+
+				//A's old parent should point to B
+				if (b.parent != DYNAMIC_TREE_NULL_NODE)
+				{
+					if (m_Nodes.at(b.parent).child1 == aNodeId)
+					{
+						m_Nodes.at(b.parent).child1 = iB;
+					}
+					else
+					{
+						m_Nodes.at(b.parent).child2 = iB;
+					}
+				}
+				else
+				{
+					m_Root = iB;
+				}
+
+				//Keep the taller of D and E under B
+				if (d.height > e.height)
+				{
+					b.child2 = iD;
+					a.child1 = iE;
+					e.parent = aNodeId;
+					a.aabb = AABB::Combine(c.aabb, e.aabb);
+					b.aabb = AABB::Combine(a.aabb, d.aabb);
+					a.height = 1 + std::max<int>(c.height, e.height);
+					b.height = 1 + std::max<int>(a.height, d.height);
+				}
+				else
+				{
+					b.child2 = iE;
+					a.child1 = iD;
+					d.parent = aNodeId;
+					a.aabb = AABB::Combine(c.aabb, d.aabb);
+					b.aabb = AABB::Combine(a.aabb, e.aabb);
+					a.height = 1 + std::max<int>(c.height, d.height);
+					b.height = 1 + std::max<int>(a.height, e.height);
+				}
+
+				return iB;
+			}
+
+			return aNodeId;
+		}
+	}
+}
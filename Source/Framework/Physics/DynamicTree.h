@@ -0,0 +1,99 @@
+#ifndef __GameDev2D__DynamicTree__
+#define __GameDev2D__DynamicTree__
+
+#include "BroadPhase.h"
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const float DYNAMIC_TREE_AABB_MARGIN = 0.1f;		//In meters
+		const float DYNAMIC_TREE_DISPLACEMENT_MULTIPLIER = 2.0f;
+		const int DYNAMIC_TREE_NULL_NODE = -1;
+
+		//Dynamic bounding volume hierarchy broadphase. Each proxy is a leaf in a binary tree and stores a
+		//fat bounding box, a proxy is only re-inserted when its bounding box leaves the fat bounding box,
+		//so small movements don't touch the tree. The tree is kept balanced using rotations
+		class DynamicTree : public BroadPhase
+		{
+		public:
+			DynamicTree(float margin = DYNAMIC_TREE_AABB_MARGIN);
+			~DynamicTree();
+
+			//Adds a bounding box to the tree and returns its proxy id, the user data is returned with the pairs
+			int CreateProxy(const AABB& aabb, void* userData);
+
+			//Removes a proxy from the tree, the proxy id can be reused by the next CreateProxy() call
+			void DestroyProxy(int proxyId);
+
+			//Updates the bounding box of a proxy, the proxy is only re-inserted if the bounding box left
+			//the fat bounding box. The fat bounding box is extended in the direction of the displacement
+			void MoveProxy(int proxyId, const AABB& aabb, Vector2 displacement);
+
+			//Sets the collision filter for a proxy, pairs the filters reject are culled by ComputePairs()
+			void SetFilter(int proxyId, const CollisionFilter& filter);
+
+			//Returns the user data and fat bounding box for a proxy
+			void* GetUserData(int proxyId);
+			const AABB& GetAABB(int proxyId);
+
+			//Fills the pairs vector with every unique pair of proxies whose fat bounding boxes overlap and that has
+			//at least one proxy from the proxies vector, sorted by proxy id
+			void ComputePairs(const std::vector<int>& proxies, std::vector<ProxyPair>* pairs);
+
+			//Returns the number of overlapping pairs the collision filters rejected during the last ComputePairs() call
+			unsigned int GetCulledPairCount();
+
+			//Fills the proxies vector with every proxy whose fat bounding box overlaps the supplied bounding box
+			void Query(const AABB& aabb, std::vector<int>* proxies);
+
+			//Returns the number of proxies in the tree
+			unsigned int GetProxyCount();
+
+			//Returns the height of the tree, a leaf has a height of zero
+			int GetHeight();
+
+		private:
+			struct Node
+			{
+				bool IsLeaf() const
+				{
+					return child1 == DYNAMIC_TREE_NULL_NODE;
+				}
+
+				AABB aabb;
+				void* userData;
+				CollisionFilter filter;
+				int parent;		//Also used as the next index in the free list
+				int child1;
+				int child2;
+				int height;		//Leaves are 0, free nodes are -1
+			};
+
+			//Collides the whole tree against itself, faster than querying every proxy when they're all in the proxies vector
+			void ComputeAllPairs(std::vector<ProxyPair>* pairs);
+
+			//Conveniance methods to manage the nodes
+			int AllocateNode();
+			void FreeNode(int nodeId);
+			void InsertLeaf(int leafId);
+			void RemoveLeaf(int leafId);
+			int Balance(int nodeId);
+			void FixUpwards(int nodeId);
+
+			//Member variables
+			std::vector<Node> m_Nodes;
+			std::vector<int> m_Stack;
+			std::vector<ProxyPair> m_NodePairs;
+			std::vector<bool> m_IsQueried;
+			int m_Root;
+			int m_FreeList;
+			float m_Margin;
+			unsigned int m_ProxyCount;
+			unsigned int m_CulledPairCount;
+		};
+	}
+}
+
+#endif
@@ -27,6 +27,26 @@ namespace GameDev2D
             m_BodyB->SetPosition(m_BodyB->GetPosition() + correction * m_BodyB->GetInverseMass());
         }
 
+        Body* Manifold::GetBodyA()
+        {
+            return m_BodyA;
+        }
+
+        Body* Manifold::GetBodyB()
+        {
+            return m_BodyB;
+        }
+
+        float Manifold::GetOverlap()
+        {
+            return m_Overlap;
+        }
+
+        Vector2 Manifold::GetNormal()
+        {
+            return m_Normal;
+        }
+
         void Manifold::FlipNormal()
         {
             m_Normal = -m_Normal;
@@ -23,6 +23,13 @@ namespace GameDev2D
 
             void CorrectOverlap();
 
+            Body* GetBodyA();
+            Body* GetBodyB();
+
+            //Returns the contact's overlap (in meters) and its normal, which points from body A to body B
+            float GetOverlap();
+            Vector2 GetNormal();
+
         private:
             //Member variables
             Body* m_BodyA;
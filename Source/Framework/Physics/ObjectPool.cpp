@@ -0,0 +1,88 @@
+#include "ObjectPool.h"
+#include <assert.h>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		ObjectPool::ObjectPool(size_t aObjectSize, unsigned int aObjectsPerBlock) :
+			m_ObjectSize(aObjectSize),
+			m_ObjectsPerBlock(aObjectsPerBlock),
+			m_FreeList(nullptr),
+			m_AllocatedCount(0)
+		{
+			//If this assert is hit, the pool needs at least one object per block
+			assert(aObjectsPerBlock > 0);
+
+			//Freed objects store the free list, and every object has to stay aligned within a block
+			const size_t alignment = sizeof(double) > sizeof(void*) ? sizeof(double) : sizeof(void*);
+			if (m_ObjectSize < sizeof(FreeNode))
+			{
+				m_ObjectSize = sizeof(FreeNode);
+			}
+			m_ObjectSize = (m_ObjectSize + alignment - 1) / alignment * alignment;
+		}
+
+		ObjectPool::~ObjectPool()
+		{
+			//If this assert is hit, objects are still using the pool's memory
+			assert(m_AllocatedCount == 0);
+
+			for (unsigned int i = 0; i < m_Blocks.size(); i++)
+			{
+				delete[] m_Blocks.at(i);
+			}
+			m_Blocks.clear();
+			m_FreeList = nullptr;
+		}
+
+		void* ObjectPool::Allocate()
+		{
+			if (m_FreeList == nullptr)
+			{
+				//Allocate a new block and add all of its objects to the free list, in order
+				unsigned char* block = new unsigned char[m_ObjectSize * m_ObjectsPerBlock];
+				m_Blocks.push_back(block);
+
+				for (unsigned int i = m_ObjectsPerBlock; i > 0; i--)
+				{
+					FreeNode* node = (FreeNode*)(block + m_ObjectSize * (i - 1));
+					node->next = m_FreeList;
+					m_FreeList = node;
+				}
+			}
+
+			FreeNode* node = m_FreeList;
+			m_FreeList = node->next;
+			m_AllocatedCount++;
+
+			return node;
+		}
+
+		void ObjectPool::Free(void* aObject)
+		{
+			if (aObject == nullptr)
+			{
+				return;
+			}
+
+			//If this assert is hit, more objects have been freed than were allocated
+			assert(m_AllocatedCount > 0);
+
+			FreeNode* node = (FreeNode*)aObject;
+			node->next = m_FreeList;
+			m_FreeList = node;
+			m_AllocatedCount--;
+		}
+
+		unsigned int ObjectPool::GetAllocatedCount()
+		{
+			return m_AllocatedCount;
+		}
+
+		unsigned int ObjectPool::GetBlockCount()
+		{
+			return (unsigned int)m_Blocks.size();
+		}
+	}
+}
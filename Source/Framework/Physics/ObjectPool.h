@@ -0,0 +1,51 @@
+#ifndef __GameDev2D__ObjectPool__
+#define __GameDev2D__ObjectPool__
+
+#include <stddef.h>
+#include <vector>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const unsigned int OBJECT_POOL_DEFAULT_BLOCK_SIZE = 64;
+
+		//Fixed size memory slab, the memory is allocated in blocks and freed objects are kept in a free list
+		//to be reused, so creating and destroying objects doesn't touch the heap once the pool has warmed up.
+		//The pool only manages memory, the objects have to be constructed and destructed by the caller
+		class ObjectPool
+		{
+		public:
+			ObjectPool(size_t objectSize, unsigned int objectsPerBlock = OBJECT_POOL_DEFAULT_BLOCK_SIZE);
+			~ObjectPool();
+
+			//Returns memory for one object, a new block is only allocated if the free list is empty
+			void* Allocate();
+
+			//Returns the memory for an object to the free list
+			void Free(void* object);
+
+			//Returns the number of objects that are currently allocated
+			unsigned int GetAllocatedCount();
+
+			//Returns the number of blocks the pool has allocated
+			unsigned int GetBlockCount();
+
+		private:
+			struct FreeNode
+			{
+				FreeNode* next;
+			};
+
+			//Member variables
+			size_t m_ObjectSize;
+			unsigned int m_ObjectsPerBlock;
+			std::vector<unsigned char*> m_Blocks;
+			FreeNode* m_FreeList;
+			unsigned int m_AllocatedCount;
+		};
+	}
+}
+
+#endif
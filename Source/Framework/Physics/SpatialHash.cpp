@@ -0,0 +1,292 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <assert.h>
+#include <math.h>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		SpatialHash::SpatialHash(float aCellSize) :
+			m_CellSize(aCellSize),
+			m_InverseCellSize(1.0f / aCellSize),
+			m_ProxyCount(0),
+			m_CulledPairCount(0)
+		{
+			//If this assert is hit, the cell size must be greater than zero
+			assert(aCellSize > 0.0f);
+		}
+
+		SpatialHash::~SpatialHash()
+		{
+			m_Proxies.clear();
+			m_FreeProxies.clear();
+			m_IsQueried.clear();
+			m_Cells.clear();
+		}
+
+		int SpatialHash::CreateProxy(const AABB& aAABB, void* aUserData)
+		{
+			//Reuse a free proxy if there is one, otherwise add a new one
+			int proxyId = NULL_PROXY;
+			if (m_FreeProxies.size() > 0)
+			{
+				proxyId = m_FreeProxies.back();
+				m_FreeProxies.pop_back();
+			}
+			else
+			{
+				proxyId = (int)m_Proxies.size();
+				m_Proxies.push_back(Proxy());
+			}
+
+			//Initialize the proxy
+			Proxy& proxy = m_Proxies.at(proxyId);
+			proxy.aabb = aAABB;
+			proxy.userData = aUserData;
+			proxy.filter = CollisionFilter();
+			proxy.isActive = true;
+			ComputeCellRange(aAABB, &proxy.minX, &proxy.minY, &proxy.maxX, &proxy.maxY);
+
+			//Add the proxy to the cells it overlaps
+			AddToCells(proxyId);
+			m_ProxyCount++;
+
+			return proxyId;
+		}
+
+		void SpatialHash::DestroyProxy(int aProxyId)
+		{
+			//If this assert is hit, the proxy id is invalid
+			assert(aProxyId >= 0 && aProxyId < (int)m_Proxies.size() && m_Proxies.at(aProxyId).isActive == true);
+
+			RemoveFromCells(aProxyId);
+
+			Proxy& proxy = m_Proxies.at(aProxyId);
+			proxy.userData = nullptr;
+			proxy.isActive = false;
+
+			m_FreeProxies.push_back(aProxyId);
+			m_ProxyCount--;
+		}
+
+		void SpatialHash::MoveProxy(int aProxyId, const AABB& aAABB, Vector2 /*aDisplacement*/)
+		{
+			//If this assert is hit, the proxy id is invalid
+			assert(aProxyId >= 0 && aProxyId < (int)m_Proxies.size() && m_Proxies.at(aProxyId).isActive == true);
+
+			Proxy& proxy = m_Proxies.at(aProxyId);
+			proxy.aabb = aAABB;
+
+			//Only re-bucket the proxy if the range of cells it touches has changed
+			int minX, minY, maxX, maxY;
+			ComputeCellRange(aAABB, &minX, &minY, &maxX, &maxY);
+			if (minX != proxy.minX || minY != proxy.minY || maxX != proxy.maxX || maxY != proxy.maxY)
+			{
+				RemoveFromCells(aProxyId);
+				proxy.minX = minX;
+				proxy.minY = minY;
+				proxy.maxX = maxX;
+				proxy.maxY = maxY;
+				AddToCells(aProxyId);
+			}
+		}
+
+		void SpatialHash::SetFilter(int aProxyId, const CollisionFilter& aFilter)
+		{
+			//If this assert is hit, the proxy id is invalid
+			assert(aProxyId >= 0 && aProxyId < (int)m_Proxies.size() && m_Proxies.at(aProxyId).isActive == true);
+
+			m_Proxies.at(aProxyId).filter = aFilter;
+		}
+
+		void* SpatialHash::GetUserData(int aProxyId)
+		{
+			return m_Proxies.at(aProxyId).userData;
+		}
+
+		const AABB& SpatialHash::GetAABB(int aProxyId)
+		{
+			return m_Proxies.at(aProxyId).aabb;
+		}
+
+		void SpatialHash::ComputePairs(const std::vector<int>& aProxies, std::vector<ProxyPair>* aPairs)
+		{
+			aPairs->clear();
+			m_CulledPairCount = 0;
+
+			//Flag the proxies being queried, a pair of two queried proxies is only reported by the lower proxy id
+			m_IsQueried.resize(m_Proxies.size(), false);
+			for (unsigned int i = 0; i < aProxies.size(); i++)
+			{
+				m_IsQueried[aProxies.at(i)] = true;
+			}
+
+			for (unsigned int i = 0; i < aProxies.size(); i++)
+			{
+				int proxyIdA = aProxies.at(i);
+				const Proxy& proxyA = m_Proxies.at(proxyIdA);
+
+				for (int x = proxyA.minX; x <= proxyA.maxX; x++)
+				{
+					for (int y = proxyA.minY; y <= proxyA.maxY; y++)
+					{
+						std::unordered_map<long long, std::vector<int>>::iterator it = m_Cells.find(GetCellKey(x, y));
+						if (it == m_Cells.end())
+						{
+							continue;
+						}
+
+						const std::vector<int>& cell = it->second;
+						for (unsigned int j = 0; j < cell.size(); j++)
+						{
+							int proxyIdB = cell.at(j);
+							if (proxyIdB == proxyIdA || (m_IsQueried[proxyIdB] == true && proxyIdB < proxyIdA))
+							{
+								continue;
+							}
+
+							//Two proxies can share several cells, only report the pair from the first cell
+							//they share (the lowest corner of the overlapping cell range), so it's unique
+							const Proxy& proxyB = m_Proxies.at(proxyIdB);
+							if (x != std::max<int>(proxyA.minX, proxyB.minX) || y != std::max<int>(proxyA.minY, proxyB.minY))
+							{
+								continue;
+							}
+
+							if (proxyA.aabb.Overlaps(proxyB.aabb) == true)
+							{
+								if (CollisionFilter::ShouldCollide(proxyA.filter, proxyB.filter) == false)
+								{
+									m_CulledPairCount++;
+								}
+								else
+								{
+									aPairs->push_back(ProxyPair(std::min<int>(proxyIdA, proxyIdB), std::max<int>(proxyIdA, proxyIdB)));
+								}
+							}
+						}
+					}
+				}
+			}
+
+			for (unsigned int i = 0; i < aProxies.size(); i++)
+			{
+				m_IsQueried[aProxies.at(i)] = false;
+			}
+
+			//Sort the pairs so the results don't depend on the order of the proxies or the cells
+			std::sort(aPairs->begin(), aPairs->end());
+		}
+
+		void SpatialHash::Query(const AABB& aAABB, std::vector<int>* aProxies)
+		{
+			aProxies->clear();
+
+			int minX, minY, maxX, maxY;
+			ComputeCellRange(aAABB, &minX, &minY, &maxX, &maxY);
+
+			for (int x = minX; x <= maxX; x++)
+			{
+				for (int y = minY; y <= maxY; y++)
+				{
+					std::unordered_map<long long, std::vector<int>>::iterator it = m_Cells.find(GetCellKey(x, y));
+					if (it == m_Cells.end())
+					{
+						continue;
+					}
+
+					const std::vector<int>& cell = it->second;
+					for (unsigned int i = 0; i < cell.size(); i++)
+					{
+						const Proxy& proxy = m_Proxies.at(cell.at(i));
+
+						//Same rule as ComputePairs(), only report the proxy from the first cell it shares with the query
+						if (x != std::max<int>(minX, proxy.minX) || y != std::max<int>(minY, proxy.minY))
+						{
+							continue;
+						}
+
+						if (proxy.aabb.Overlaps(aAABB) == true)
+						{
+							aProxies->push_back(cell.at(i));
+						}
+					}
+				}
+			}
+		}
+
+		unsigned int SpatialHash::GetProxyCount()
+		{
+			return m_ProxyCount;
+		}
+
+		unsigned int SpatialHash::GetCulledPairCount()
+		{
+			return m_CulledPairCount;
+		}
+
+		unsigned int SpatialHash::GetCellCount()
+		{
+			return (unsigned int)m_Cells.size();
+		}
+
+		void SpatialHash::ComputeCellRange(const AABB& aAABB, int* aMinX, int* aMinY, int* aMaxX, int* aMaxY)
+		{
+			*aMinX = (int)floorf(aAABB.lowerBound.x * m_InverseCellSize);
+			*aMinY = (int)floorf(aAABB.lowerBound.y * m_InverseCellSize);
+			*aMaxX = (int)floorf(aAABB.upperBound.x * m_InverseCellSize);
+			*aMaxY = (int)floorf(aAABB.upperBound.y * m_InverseCellSize);
+		}
+
+		void SpatialHash::AddToCells(int aProxyId)
+		{
+			const Proxy& proxy = m_Proxies.at(aProxyId);
+			for (int x = proxy.minX; x <= proxy.maxX; x++)
+			{
+				for (int y = proxy.minY; y <= proxy.maxY; y++)
+				{
+					m_Cells[GetCellKey(x, y)].push_back(aProxyId);
+				}
+			}
+		}
+
+		void SpatialHash::RemoveFromCells(int aProxyId)
+		{
+			const Proxy& proxy = m_Proxies.at(aProxyId);
+			for (int x = proxy.minX; x <= proxy.maxX; x++)
+			{
+				for (int y = proxy.minY; y <= proxy.maxY; y++)
+				{
+					std::unordered_map<long long, std::vector<int>>::iterator it = m_Cells.find(GetCellKey(x, y));
+					if (it == m_Cells.end())
+					{
+						continue;
+					}
+
+					std::vector<int>& cell = it->second;
+					for (unsigned int i = 0; i < cell.size(); i++)
+					{
+						if (cell.at(i) == aProxyId)
+						{
+							cell.at(i) = cell.back();
+							cell.pop_back();
+							break;
+						}
+					}
+
+					//Erase the cell once it's empty, otherwise the map grows with every cell a body has ever passed through
+					if (cell.empty() == true)
+					{
+						m_Cells.erase(it);
+					}
+				}
+			}
+		}
+
+		long long SpatialHash::GetCellKey(int aX, int aY)
+		{
+			return (long long)(((unsigned long long)(unsigned int)aX << 32) | (unsigned long long)(unsigned int)aY);
+		}
+	}
+}
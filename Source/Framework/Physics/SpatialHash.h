@@ -0,0 +1,89 @@
+#ifndef __GameDev2D__SpatialHash__
+#define __GameDev2D__SpatialHash__
+
+#include "BroadPhase.h"
+#include <unordered_map>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//Local constants
+		const float SPATIAL_HASH_DEFAULT_CELL_SIZE = 2.0f; //In meters
+
+		//Uniform grid broadphase, each proxy is stored in every cell its bounding box touches. Proxies
+		//are only re-bucketed when their cell range changes, so resting bodies cost nothing to update.
+		//Cells are erased when their last proxy leaves them, so the grid only holds the occupied cells
+		class SpatialHash : public BroadPhase
+		{
+		public:
+			SpatialHash(float cellSize = SPATIAL_HASH_DEFAULT_CELL_SIZE);
+			~SpatialHash();
+
+			//Adds a bounding box to the grid and returns its proxy id, the user data is returned with the pairs
+			int CreateProxy(const AABB& aabb, void* userData);
+
+			//Removes a proxy from the grid, the proxy id can be reused by the next CreateProxy() call
+			void DestroyProxy(int proxyId);
+
+			//Updates the bounding box of a proxy, the proxy is only moved between cells if it has to be. The
+			//displacement isn't used, the grid stores the exact bounding box. Extending the cell range in the
+			//direction of the displacement was tried, the extra cells made ComputePairs() more than twice as slow
+			void MoveProxy(int proxyId, const AABB& aabb, Vector2 displacement);
+
+			//Sets the collision filter for a proxy, pairs the filters reject are culled by ComputePairs()
+			void SetFilter(int proxyId, const CollisionFilter& filter);
+
+			//Returns the user data and bounding box for a proxy
+			void* GetUserData(int proxyId);
+			const AABB& GetAABB(int proxyId);
+
+			//Fills the pairs vector with every unique pair of overlapping proxies that has at least one proxy from
+			//the proxies vector, sorted by proxy id
+			void ComputePairs(const std::vector<int>& proxies, std::vector<ProxyPair>* pairs);
+
+			//Returns the number of overlapping pairs the collision filters rejected during the last ComputePairs() call
+			unsigned int GetCulledPairCount();
+
+			//Fills the proxies vector with every proxy whose bounding box overlaps the supplied bounding box
+			void Query(const AABB& aabb, std::vector<int>* proxies);
+
+			//Returns the number of proxies in the grid
+			unsigned int GetProxyCount();
+
+			//Returns the number of cells that hold at least one proxy
+			unsigned int GetCellCount();
+
+		private:
+			struct Proxy
+			{
+				AABB aabb;
+				void* userData;
+				CollisionFilter filter;
+				int minX;
+				int minY;
+				int maxX;
+				int maxY;
+				bool isActive;
+			};
+
+			//Conveniance methods to manage the cells
+			void ComputeCellRange(const AABB& aabb, int* minX, int* minY, int* maxX, int* maxY);
+			void AddToCells(int proxyId);
+			void RemoveFromCells(int proxyId);
+			long long GetCellKey(int x, int y);
+
+			//Member variables
+			float m_CellSize;
+			float m_InverseCellSize;
+			std::vector<Proxy> m_Proxies;
+			std::vector<int> m_FreeProxies;
+			std::vector<bool> m_IsQueried;
+			std::unordered_map<long long, std::vector<int>> m_Cells;
+			unsigned int m_ProxyCount;
+			unsigned int m_CulledPairCount;
+		};
+	}
+}
+
+#endif
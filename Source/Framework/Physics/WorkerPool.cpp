@@ -0,0 +1,114 @@
+#include "WorkerPool.h"
+#include <assert.h>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		WorkerPool::WorkerPool(unsigned int aWorkerCount) :
+			m_Job(nullptr),
+			m_JobId(0),
+			m_PendingCount(0),
+			m_IsShuttingDown(false)
+		{
+			//If this assert is hit, the pool needs at least one worker (the calling thread)
+			assert(aWorkerCount > 0);
+
+			for (unsigned int i = 1; i < aWorkerCount; i++)
+			{
+				m_Threads.push_back(std::thread(&WorkerPool::WorkerLoop, this, i));
+			}
+		}
+
+		WorkerPool::~WorkerPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_IsShuttingDown = true;
+			}
+			m_JobReady.notify_all();
+
+			for (unsigned int i = 0; i < m_Threads.size(); i++)
+			{
+				m_Threads.at(i).join();
+			}
+			m_Threads.clear();
+		}
+
+		void WorkerPool::Run(const std::function<void(unsigned int)>& aJob)
+		{
+			if (m_Threads.size() == 0)
+			{
+				aJob(0);
+				return;
+			}
+
+			//Hand the job to the worker threads
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Job = &aJob;
+				m_PendingCount = (unsigned int)m_Threads.size();
+				m_JobId++;
+			}
+			m_JobReady.notify_all();
+
+			//The calling thread is worker zero
+			aJob(0);
+
+			//Wait for the worker threads to finish, the job can't outlive this call
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			while (m_PendingCount > 0)
+			{
+				m_JobDone.wait(lock);
+			}
+			m_Job = nullptr;
+		}
+
+		unsigned int WorkerPool::GetWorkerCount()
+		{
+			return (unsigned int)m_Threads.size() + 1;
+		}
+
+		void WorkerPool::WorkerLoop(unsigned int aWorkerIndex)
+		{
+			unsigned int lastJobId = 0;
+
+			while (true)
+			{
+				const std::function<void(unsigned int)>* job = nullptr;
+
+				//Wait until there is a new job or the pool is shutting down
+				{
+					std::unique_lock<std::mutex> lock(m_Mutex);
+					while (m_IsShuttingDown == false && m_JobId == lastJobId)
+					{
+						m_JobReady.wait(lock);
+					}
+
+					if (m_IsShuttingDown == true)
+					{
+						return;
+					}
+
+					lastJobId = m_JobId;
+					job = m_Job;
+				}
+
+				(*job)(aWorkerIndex);
+
+				//Let the calling thread know this worker is done
+				bool isLast = false;
+				{
+					std::lock_guard<std::mutex> lock(m_Mutex);
+					m_PendingCount--;
+					isLast = m_PendingCount == 0;
+				}
+
+				if (isLast == true)
+				{
+					m_JobDone.notify_one();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#ifndef __GameDev2D__WorkerPool__
+#define __GameDev2D__WorkerPool__
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GameDev2D
+{
+	namespace Physics
+	{
+		//A fixed set of worker threads that run the same job in parallel. The calling thread takes part
+		//as worker zero, so a pool with a worker count of one never creates a thread
+		class WorkerPool
+		{
+		public:
+			WorkerPool(unsigned int workerCount);
+			~WorkerPool();
+
+			//Runs the job once on every worker, passing in the worker's index. Returns once every worker is done
+			void Run(const std::function<void(unsigned int)>& job);
+
+			//Returns the number of workers, including the calling thread
+			unsigned int GetWorkerCount();
+
+		private:
+			//The loop each worker thread runs, waits for a job and runs it
+			void WorkerLoop(unsigned int workerIndex);
+
+			//Member variables
+			std::vector<std::thread> m_Threads;
+			std::mutex m_Mutex;
+			std::condition_variable m_JobReady;
+			std::condition_variable m_JobDone;
+			const std::function<void(unsigned int)>* m_Job;
+			unsigned int m_JobId;
+			unsigned int m_PendingCount;
+			bool m_IsShuttingDown;
+		};
+	}
+}
+
+#endif
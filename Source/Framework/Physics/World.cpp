@@ -2,8 +2,18 @@
 #include "Body.h"
 #include "CircleCollider.h"
 #include "BoxCollider.h"
+#include "CollisionKernels.h"
+#include "SpatialHash.h"
+#include "DynamicTree.h"
+#include "WorkerPool.h"
 #include "../Math/Math.h"
 #include "../GameDev2D.h"
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <thread>
 
 namespace GameDev2D
 {
@@ -15,94 +25,455 @@ namespace GameDev2D
 		{
 			if (s_Instance == nullptr)
 			{
-				s_Instance = new World();
+				s_Instance = new World(WORLD_DEFAULT_BROAD_PHASE);
 			}
 			return s_Instance;
 		}
 
-		World::World():
+		World* World::CreateInstance(BroadPhaseType aBroadPhaseType)
+		{
+			//If this assert is hit, the World has already been created, the broadphase can't be changed once there are bodies in it
+			assert(s_Instance == nullptr);
+
+			s_Instance = new World(aBroadPhaseType);
+			return s_Instance;
+		}
+
+		World::World(BroadPhaseType aBroadPhaseType):
 			m_Gravity(0.0f, 0.0f),
-			m_Listener(nullptr)
+			m_BodyPool(sizeof(Body)),
+			m_IsLocked(false),
+			m_StepCount(0),
+			m_BroadPhaseType(aBroadPhaseType),
+			m_BroadPhase(nullptr),
+			m_IsBroadPhaseStale(false),
+			m_WorkerPool(nullptr),
+			m_ActiveWorkerCount(1),
+			m_Listener(nullptr),
+			m_StepTime(0.0)
 		{
+			//One worker per hardware thread, the main thread is one of them
+			unsigned int workerCount = std::max<unsigned int>(std::thread::hardware_concurrency(), 1);
+			m_WorkerPool = new WorkerPool(workerCount);
+			m_WorkerContacts.resize(workerCount);
 
+			if (m_BroadPhaseType == BroadPhaseType_DynamicTree)
+			{
+				m_BroadPhase = new DynamicTree(DYNAMIC_TREE_AABB_MARGIN);
+			}
+			else
+			{
+				m_BroadPhase = new SpatialHash(SPATIAL_HASH_DEFAULT_CELL_SIZE);
+			}
 		}
 
 		World::~World()
 		{
-			for (unsigned int i = 0; i < m_Bodies.size(); i++)
+			//The world is shutting down, the listener isn't told about the contacts of the bodies removed here
+			m_ContactPairs.clear();
+
+			while (m_BodyData.GetCount() > 0)
+			{
+				RemoveBody(m_BodyData.body.back());
+			}
+
+			if (m_BroadPhase != nullptr)
 			{
-				delete m_Bodies.at(i);
+				delete m_BroadPhase;
+				m_BroadPhase = nullptr;
+			}
+
+			if (m_WorkerPool != nullptr)
+			{
+				delete m_WorkerPool;
+				m_WorkerPool = nullptr;
 			}
-			m_Bodies.clear();
 		}
 
 		void World::Step(double aTimeStep)
 		{
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
 			m_Contacts.clear();
+			m_StepCount++;
 
+			//Bodies destroyed during the step (from the listener) are destroyed once the step is done
+			m_IsLocked = true;
 
+			//Update the broadphase and get the unique pairs of bodies whose bounding boxes overlap
+			UpdateBroadPhase(aTimeStep);
+			m_BroadPhase->ComputePairs(m_AwakeProxies, &m_Pairs);
 
-			//Check Collision
-			for (unsigned int i = 0; i < m_Bodies.size(); i++)
+			//Check Collision, small steps aren't worth waking the worker threads for
+			unsigned int maxWorkerCount = (unsigned int)m_Pairs.size() / WORLD_MIN_PAIRS_PER_WORKER;
+			m_ActiveWorkerCount = std::max<unsigned int>(std::min<unsigned int>(maxWorkerCount, m_WorkerPool->GetWorkerCount()), 1);
+
+			if (m_ActiveWorkerCount == 1)
+			{
+				NarrowPhase(0);
+			}
+			else
+			{
+				m_WorkerPool->Run(std::bind(&World::NarrowPhase, this, std::placeholders::_1));
+			}
+
+			//Merge the worker's contacts in worker order, each worker has a contiguous range of the sorted pairs
+			//so the contacts end up in pair order no matter how many workers there were
+			for (unsigned int i = 0; i < m_ActiveWorkerCount; i++)
 			{
-				for (unsigned int j = 0; j < m_Bodies.size(); j++)
+				std::vector<Manifold>& contacts = m_WorkerContacts.at(i);
+				for (unsigned int j = 0; j < contacts.size(); j++)
 				{
-					Body* a = m_Bodies.at(i);
-					Body* b = m_Bodies.at(j);
+					Manifold& manifold = contacts.at(j);
+
+					//An awake body touching a sleeping body wakes it (and its island) up
+					manifold.GetBodyA()->SetIsAwake(true);
+					manifold.GetBodyB()->SetIsAwake(true);
+
+					//There was a collision, let the listener know if it's a new contact
+					UpdateContactPair(manifold.GetBodyA(), manifold.GetBodyB());
 
-					if (a->GetInverseMass() == 0.0f || b->GetInverseMass() == 0.0f)
+					//Give the listener a chance to let the bodies overlap
+					bool isSolid = true;
+					if (m_Listener != nullptr)
 					{
-						continue;
+						isSolid = m_Listener->CollisionCallBack(manifold.GetBodyA(), manifold.GetBodyB());
 					}
 
-					Manifold manifold(a, b);
+					//Sensors only report the contact, they don't push the bodies apart
+					if (manifold.GetBodyA()->GetCollider()->GetIsSensor() == true || manifold.GetBodyB()->GetCollider()->GetIsSensor() == true)
+					{
+						isSolid = false;
+					}
 
-					//Check the collision
-					if (CheckCollision(a, b, &manifold) == true)
+					if (isSolid == true)
 					{
-						//There was a collision, notify the listener
-						if (m_Listener != nullptr)
-						{
-							if (m_Listener->CollisionCallBack(a, b) == true)
-							{
-								m_Contacts.push_back(manifold);
-							}
-						}
-						else
-						{
-							m_Contacts.push_back(manifold);
-						}
+						m_Contacts.push_back(manifold);
 					}
 				}
 			}
 
-			for (unsigned int i = 0; i < m_Bodies.size(); i++)
+			//Let the listener know about the pairs that stopped touching
+			EndContactPairs();
+
+			for (unsigned int i = 0; i < m_Contacts.size(); i++)
+			{
+				m_Contacts.at(i).CorrectOverlap();
+			}
+
+			//Integrate the forces and velocities and clear the forces, for every awake body in one pass
+			m_BodyData.Integrate((float)aTimeStep, m_Gravity);
+
+			//Put the islands that have been resting long enough to sleep
+			UpdateSleep();
+
+			//Destroy the bodies that were destroyed during the step
+			m_IsLocked = false;
+			for (unsigned int i = 0; i < m_PendingDestroys.size(); i++)
+			{
+				RemoveBody(m_PendingDestroys.at(i));
+			}
+			m_PendingDestroys.clear();
+
+			//The bodies have moved since the broadphase was updated, queries made before the next step will update it first
+			m_IsBroadPhaseStale = true;
+
+			std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+			m_StepTime = duration.count();
+		}
+
+		void World::NarrowPhase(unsigned int aWorkerIndex)
+		{
+			std::vector<Manifold>& contacts = m_WorkerContacts.at(aWorkerIndex);
+			contacts.clear();
+
+			//The pool can have more workers than were needed this step
+			if (aWorkerIndex >= m_ActiveWorkerCount)
+			{
+				return;
+			}
+
+			unsigned int pairCount = (unsigned int)m_Pairs.size();
+			unsigned int begin = (unsigned int)((unsigned long long)pairCount * aWorkerIndex / m_ActiveWorkerCount);
+			unsigned int end = (unsigned int)((unsigned long long)pairCount * (aWorkerIndex + 1) / m_ActiveWorkerCount);
+
+			for (unsigned int i = begin; i < end; i++)
+			{
+				Body* a = (Body*)m_BroadPhase->GetUserData(m_Pairs.at(i).proxyA);
+				Body* b = (Body*)m_BroadPhase->GetUserData(m_Pairs.at(i).proxyB);
+
+				if (a->GetInverseMass() == 0.0f || b->GetInverseMass() == 0.0f)
+				{
+					continue;
+				}
+
+				Manifold manifold(a, b);
+
+				//Check the collision
+				if (CheckCollision(a, b, &manifold) == true)
+				{
+					contacts.push_back(manifold);
+				}
+			}
+		}
+
+		void World::UpdateContactPair(Body* aBodyA, Body* aBodyB)
+		{
+			unsigned long long key = GetContactPairKey(aBodyA, aBodyB);
+
+			//The handles are stored in the same order as the key
+			BodyHandle handleA = aBodyA->m_Handle;
+			BodyHandle handleB = aBodyB->m_Handle;
+			if (handleB.index < handleA.index)
+			{
+				std::swap(handleA, handleB);
+			}
+
+			//A body's slot can be reused once it's destroyed, so the handles have to match for it to be the same pair
+			ContactPair& pair = m_ContactPairs[key];
+			bool isNewContact = pair.stepCount == 0 || (pair.handleA == handleA && pair.handleB == handleB) == false;
+			pair.handleA = handleA;
+			pair.handleB = handleB;
+			pair.stepCount = m_StepCount;
+
+			if (m_Listener != nullptr)
+			{
+				if (isNewContact == true)
+				{
+					m_Listener->BeginContact(aBodyA, aBodyB);
+				}
+				else
+				{
+					m_Listener->PersistContact(aBodyA, aBodyB);
+				}
+			}
+		}
+
+		void World::EndContactPairs()
+		{
+			m_EndedContactPairs.clear();
+
+			std::unordered_map<unsigned long long, ContactPair>::iterator it = m_ContactPairs.begin();
+			while (it != m_ContactPairs.end())
+			{
+				const ContactPair& pair = it->second;
+				if (pair.stepCount == m_StepCount)
+				{
+					++it;
+					continue;
+				}
+
+				//Both bodies are still alive, a destroyed body's pairs are ended by RemoveBody()
+				Body* bodyA = GetBody(pair.handleA);
+				Body* bodyB = GetBody(pair.handleB);
+
+				//Two sleeping bodies aren't checked against each other, but they're still touching
+				if (bodyA->GetIsAwake() == false && bodyB->GetIsAwake() == false)
+				{
+					++it;
+					continue;
+				}
+
+				m_EndedContactPairs.push_back(it->first);
+				++it;
+			}
+
+			//The order of the map depends on its history, sort the keys so the EndContact() calls are deterministic
+			std::sort(m_EndedContactPairs.begin(), m_EndedContactPairs.end());
+
+			for (unsigned int i = 0; i < m_EndedContactPairs.size(); i++)
+			{
+				std::unordered_map<unsigned long long, ContactPair>::iterator ended = m_ContactPairs.find(m_EndedContactPairs.at(i));
+				Body* bodyA = GetBody(ended->second.handleA);
+				Body* bodyB = GetBody(ended->second.handleB);
+				m_ContactPairs.erase(ended);
+
+				if (m_Listener != nullptr)
+				{
+					m_Listener->EndContact(bodyA, bodyB);
+				}
+			}
+		}
+
+		unsigned long long World::GetContactPairKey(Body* aBodyA, Body* aBodyB)
+		{
+			unsigned int indexA = std::min<unsigned int>(aBodyA->m_Handle.index, aBodyB->m_Handle.index);
+			unsigned int indexB = std::max<unsigned int>(aBodyA->m_Handle.index, aBodyB->m_Handle.index);
+			return ((unsigned long long)indexA << 32) | (unsigned long long)indexB;
+		}
+
+		void World::UpdateBroadPhase(double aTimeStep)
+		{
+			m_IsBroadPhaseStale = false;
+			m_AwakeProxies.clear();
+
+			//Sleeping bodies don't move, so only the awake bodies need their proxies updated
+			for (unsigned int i = 0; i < m_BodyData.awakeCount; i++)
+			{
+				Body* body = m_BodyData.body[i];
+				Collider* collider = body->GetCollider();
+
+				//Disabled colliders can't collide, take them out of the broadphase entirely
+				if (collider->GetIsEnabled() == false)
+				{
+					if (body->m_ProxyId != NULL_PROXY)
+					{
+						m_BroadPhase->DestroyProxy(body->m_ProxyId);
+						body->m_ProxyId = NULL_PROXY;
+					}
+					continue;
+				}
+
+				//Cache the collider's transform for the narrowphase kernels, this is the only place it's computed during the step
+				collider->UpdateTransform(body->GetPosition(), body->GetAngle());
+				const AABB& aabb = collider->GetAABB();
+				if (body->m_ProxyId == NULL_PROXY)
+				{
+					body->m_ProxyId = m_BroadPhase->CreateProxy(aabb, body);
+				}
+				else
+				{
+					Vector2 displacement = body->GetLinearVelocity() * (float)aTimeStep;
+					m_BroadPhase->MoveProxy(body->m_ProxyId, aabb, displacement);
+				}
+
+				//The filter is cheap to copy, and changing it wakes the body, so it's always up to date for awake bodies
+				m_BroadPhase->SetFilter(body->m_ProxyId, collider->GetFilter());
+				m_AwakeProxies.push_back(body->m_ProxyId);
+			}
+		}
+
+		void World::SetBodyIsAwake(Body* aBody, bool aIsAwake)
+		{
+			if (aIsAwake == true)
+			{
+				//Wake every body in the island, sleeping islands are linked in a ring
+				Body* body = aBody;
+				while (body != nullptr && body->GetIsAwake() == false)
+				{
+					SwapBodies(body->m_Index, m_BodyData.awakeCount);
+					m_BodyData.awakeCount++;
+					m_BodyData.sleepTime[body->m_Index] = 0.0f;
+
+					Body* next = body->m_NextInIsland;
+					body->m_NextInIsland = nullptr;
+					body = next;
+				}
+			}
+			else if (aBody->GetIsAwake() == true)
+			{
+				//Sleeping bodies don't move, clear their velocities and forces
+				unsigned int index = aBody->m_Index;
+				m_BodyData.linearVelocityX[index] = 0.0f;
+				m_BodyData.linearVelocityY[index] = 0.0f;
+				m_BodyData.angularVelocity[index] = 0.0f;
+				m_BodyData.ClearForces(index);
+
+				//The broadphase and the cached transform won't be updated while the body is asleep, make sure they have the final position
+				Collider* collider = aBody->GetCollider();
+				collider->UpdateTransform(aBody->GetPosition(), aBody->GetAngle());
+				if (aBody->m_ProxyId != NULL_PROXY)
+				{
+					m_BroadPhase->MoveProxy(aBody->m_ProxyId, collider->GetAABB(), Vector2(0.0f, 0.0f));
+				}
+
+				m_BodyData.awakeCount--;
+				SwapBodies(index, m_BodyData.awakeCount);
+			}
+		}
+
+		void World::SwapBodies(unsigned int aIndexA, unsigned int aIndexB)
+		{
+			if (aIndexA == aIndexB)
+			{
+				return;
+			}
+
+			m_BodyData.Swap(aIndexA, aIndexB);
+			m_BodyData.body[aIndexA]->m_Index = aIndexA;
+			m_BodyData.body[aIndexB]->m_Index = aIndexB;
+		}
+
+		void World::UpdateSleep()
+		{
+			unsigned int awakeCount = m_BodyData.awakeCount;
+
+			//Every awake body starts in its own island, the contacts join them together
+			m_IslandParents.resize(awakeCount);
+			for (unsigned int i = 0; i < awakeCount; i++)
 			{
-				m_Bodies.at(i)->SyncForces(aTimeStep, m_Gravity);
+				m_IslandParents.at(i) = i;
 			}
 
 			for (unsigned int i = 0; i < m_Contacts.size(); i++)
 			{
-				m_Contacts.at(i).CorrectOverlap();
+				unsigned int islandA = FindIsland(m_Contacts.at(i).GetBodyA()->m_Index);
+				unsigned int islandB = FindIsland(m_Contacts.at(i).GetBodyB()->m_Index);
+				if (islandA != islandB)
+				{
+					m_IslandParents.at(islandB) = islandA;
+				}
 			}
 
-			for (unsigned int i = 0; i < m_Bodies.size(); i++)
+			//An island can only sleep once every body in it has been resting long enough
+			m_IslandSleepTimes.assign(awakeCount, FLT_MAX);
+			for (unsigned int i = 0; i < awakeCount; i++)
 			{
-				m_Bodies.at(i)->SyncVelocities(aTimeStep);
+				unsigned int island = FindIsland(i);
+				m_IslandSleepTimes.at(island) = std::min<float>(m_IslandSleepTimes.at(island), m_BodyData.sleepTime[i]);
 			}
 
-			for (unsigned int i = 0; i < m_Bodies.size(); i++)
+			//Link the bodies of each sleeping island in a ring
+			m_IslandHeads.assign(awakeCount, nullptr);
+			m_IslandTails.assign(awakeCount, nullptr);
+			m_SleepingBodies.clear();
+
+			for (unsigned int i = 0; i < awakeCount; i++)
 			{
-				m_Bodies.at(i)->ClearForces();
+				unsigned int island = FindIsland(i);
+				if (m_IslandSleepTimes.at(island) < BODY_TIME_TO_SLEEP)
+				{
+					continue;
+				}
+
+				Body* body = m_BodyData.body[i];
+				if (m_IslandHeads.at(island) == nullptr)
+				{
+					m_IslandHeads.at(island) = body;
+				}
+				else
+				{
+					m_IslandTails.at(island)->m_NextInIsland = body;
+				}
+				m_IslandTails.at(island) = body;
+				body->m_NextInIsland = m_IslandHeads.at(island);
+
+				m_SleepingBodies.push_back(body);
 			}
+
+			//Lastly move the bodies to the sleeping part of the BodyData, this changes their indices
+			for (unsigned int i = 0; i < m_SleepingBodies.size(); i++)
+			{
+				SetBodyIsAwake(m_SleepingBodies.at(i), false);
+			}
+		}
+
+		unsigned int World::FindIsland(unsigned int aIndex)
+		{
+			while (m_IslandParents.at(aIndex) != aIndex)
+			{
+				m_IslandParents.at(aIndex) = m_IslandParents.at(m_IslandParents.at(aIndex));
+				aIndex = m_IslandParents.at(aIndex);
+			}
+			return aIndex;
 		}
 
 		void World::DebugDraw()
 		{
 #ifdef DEBUG_DRAW
-			for (unsigned int i = 0; i < m_Bodies.size(); i++)
+			for (unsigned int i = 0; i < m_BodyData.GetCount(); i++)
 			{
-				Body* body = m_Bodies.at(i);
+				Body* body = m_BodyData.body[i];
 				Collider* collider = body->GetCollider();
 
 				if (collider->GetType() == ColliderType_Circle)
@@ -118,165 +489,252 @@ namespace GameDev2D
 					BoxCollider* box = (BoxCollider*)collider;
 					float width = Math::MetersToPixels(box->GetWidth());
 					float height = Math::MetersToPixels(box->GetHeight());
-					Vector2 position = Math::MetersToPixels(body->GetPosition());
-					float angle = Math::RadiansToDegrees(body->GetAngle());
 
-					GameDev2D::DrawRectangle(position.x, position.y, width, height, angle, Color::YellowColor(), false);
+					//Build the AffineMatrix from the collider's cached sine and cosine, the same transform the narrowphase uses
+					const ColliderTransform& transform = box->GetTransform();
+					AffineMatrix transformation(Vector2(transform.cosAngle, transform.sinAngle), Vector2(-transform.sinAngle, transform.cosAngle), Math::MetersToPixels(transform.position));
+
+					Services::GetGraphics()->DrawRectangle(transformation, Vector2(width, height), Vector2(0.0f, 0.0f), Color::YellowColor(), false);
 				}
 			}
 #endif
 		}
 
-		Body* World::CreateBody(Collider* aCollider, float aDensity)
+		void World::QueryPoint(Vector2 aPoint, std::vector<Body*>* aBodies)
 		{
-			Body* body = new Body(aCollider, aDensity);
-			m_Bodies.push_back(body);
-			return body;
-		}
+			aBodies->clear();
 
-		void World::SetGravity(Vector2 aGravity)
-		{
-			m_Gravity = aGravity;
-		}
+			if (m_IsBroadPhaseStale == true)
+			{
+				UpdateBroadPhase(0.0);
+			}
 
-		Vector2 World::GetGravity()
-		{
-			return m_Gravity;
-		}
+			//The broadphase narrows it down to the bodies whose bounding boxes contain the point
+			m_BroadPhase->Query(AABB(aPoint, aPoint), &m_QueryProxies);
 
-		void World::SetListener(WorldListener* aListener)
-		{
-			m_Listener = aListener;
+			for (unsigned int i = 0; i < m_QueryProxies.size(); i++)
+			{
+				Body* body = (Body*)m_BroadPhase->GetUserData(m_QueryProxies.at(i));
+				if (body->GetCollider()->TestPoint(body->GetPosition(), aPoint) == true)
+				{
+					aBodies->push_back(body);
+				}
+			}
 		}
 
-
-		bool World::CheckCollision(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		void World::QueryAABB(const AABB& aAABB, std::vector<Body*>* aBodies)
 		{
-			bool result = false;
+			aBodies->clear();
 
-			if (aBodyA == aBodyB)
+			if (m_IsBroadPhaseStale == true)
 			{
-				return result;
+				UpdateBroadPhase(0.0);
 			}
 
-			//Determine the type of collision check to perform
-			if (aBodyA->GetCollider()->GetType() == ColliderType_Circle &&
-				aBodyB->GetCollider()->GetType() == ColliderType_Circle &&
-				aBodyA != aBodyB)
+			m_BroadPhase->Query(aAABB, &m_QueryProxies);
+
+			for (unsigned int i = 0; i < m_QueryProxies.size(); i++)
 			{
-				result = CheckCircleToCircle(aBodyA, aBodyB, aManifold);
+				//The broadphase might store a fattened bounding box, check against the collider's actual bounding box
+				Body* body = (Body*)m_BroadPhase->GetUserData(m_QueryProxies.at(i));
+				if (body->GetCollider()->ComputeAABB(body->GetPosition()).Overlaps(aAABB) == true)
+				{
+					aBodies->push_back(body);
+				}
 			}
-			else if (aBodyA->GetCollider()->GetType() == ColliderType_Circle &&
-				aBodyB->GetCollider()->GetType() == ColliderType_Box)
+		}
+
+		BroadPhaseType World::GetBroadPhaseType()
+		{
+			return m_BroadPhaseType;
+		}
+
+		Body* World::CreateBody(Collider* aCollider, float aDensity)
+		{
+			//Reuse a free slot if there is one, the slot's generation is what invalidates old handles
+			unsigned int slot = 0;
+			if (m_FreeBodySlots.size() > 0)
 			{
-				result = CheckCircleToBox(aBodyA, aBodyB, aManifold);
+				slot = m_FreeBodySlots.back();
+				m_FreeBodySlots.pop_back();
 			}
-			else if (aBodyA->GetCollider()->GetType() == ColliderType_Box &&
-				aBodyB->GetCollider()->GetType() == ColliderType_Circle)
+			else
 			{
-				result = CheckCircleToBox(aBodyB, aBodyA, aManifold);
-
-				aManifold->FlipNormal();
+				slot = (unsigned int)m_BodySlots.size();
+				BodySlot bodySlot;
+				bodySlot.body = nullptr;
+				bodySlot.generation = 0;
+				m_BodySlots.push_back(bodySlot);
 			}
 
-			return result;
+			Body* body = new (m_BodyPool.Allocate()) Body(this, &m_BodyData, aCollider, aDensity);
+			body->m_Handle = BodyHandle(slot, m_BodySlots.at(slot).generation);
+			body->SetIsAwake(true);
+			m_BodySlots.at(slot).body = body;
+			return body;
 		}
 
-		bool World::CheckCircleToCircle(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		void World::DestroyBody(Body* aBody)
 		{
-			//Get the circle colliders
-			CircleCollider* circleColliderA = (CircleCollider*)aBodyA->GetCollider();
-			CircleCollider* circleColliderB = (CircleCollider*)aBodyB->GetCollider();
-
-			if (circleColliderA->GetIsEnabled() == false || circleColliderB->GetIsEnabled() == false)
+			if (aBody == nullptr || aBody->m_IsDestroyPending == true)
 			{
-				return false;
+				return;
 			}
 
-			//Check the distance against the radii for collision
-			float distanceSquared = Math::CalculateDistanceSquared(aBodyA->GetPosition(), aBodyB->GetPosition());
-			float combinedRadii = circleColliderA->GetRadius() + circleColliderB->GetRadius();
-			float radiiSquared = combinedRadii * combinedRadii;
+			//If this assert is hit, the body doesn't belong to the World (or has already been destroyed)
+			assert(GetBody(aBody->m_Handle) == aBody);
 
-			if (distanceSquared > radiiSquared)
+			if (m_IsLocked == true)
 			{
-				return false;
+				aBody->m_IsDestroyPending = true;
+				m_PendingDestroys.push_back(aBody);
+				return;
 			}
 
-			float distance = sqrtf(distanceSquared);
-			float overlap = combinedRadii - distance;
-			Vector2 normal = Vector2(aBodyB->GetPosition() - aBodyA->GetPosition()) / distance;
-			aManifold->SetContact(overlap, normal);
-
-			return true;
+			RemoveBody(aBody);
 		}
 
-		bool World::CheckCircleToBox(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		Body* World::GetBody(BodyHandle aHandle)
 		{
-			CircleCollider* circleCollider = (CircleCollider*)aBodyA->GetCollider();
-			BoxCollider* boxCollider = (BoxCollider*)aBodyB->GetCollider();
-
-			float radius = circleCollider->GetRadius();
-			float radiusSquared = radius * radius;
-			float angle = boxCollider->GetAngle();
-			float c = cosf(angle);
-			float s = sinf(angle);
-			float cx = aBodyA->GetPosition().x;
-			float cy = aBodyA->GetPosition().y;
-			float rx = aBodyB->GetPosition().x;
-			float ry = aBodyB->GetPosition().y;
+			if (aHandle.index >= m_BodySlots.size() || m_BodySlots.at(aHandle.index).generation != aHandle.generation)
+			{
+				return nullptr;
+			}
+			return m_BodySlots.at(aHandle.index).body;
+		}
 
-			float circleX = c* (cx - rx) - s* (cy - ry);
-			float circleY = s* (cx - rx) + c* (cy - ry);
-			Vector2 circleCenter = Vector2(circleX, circleY);
+		void World::EndContactPairs(Body* aBody)
+		{
+			//Collect the body's pairs first, the listener can destroy other bodies from EndContact(), which ends their pairs too
+			std::vector<unsigned long long> endedContactPairs;
+			for (std::unordered_map<unsigned long long, ContactPair>::iterator it = m_ContactPairs.begin(); it != m_ContactPairs.end(); ++it)
+			{
+				if (it->second.handleA == aBody->m_Handle || it->second.handleB == aBody->m_Handle)
+				{
+					endedContactPairs.push_back(it->first);
+				}
+			}
+			std::sort(endedContactPairs.begin(), endedContactPairs.end());
 
-			float maxSeperation = -FLT_MAX;
-			unsigned int faceNormal = 0;
+			//The body can't be destroyed again from inside its own EndContact() calls
+			aBody->m_IsDestroyPending = true;
 
-			for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+			for (unsigned int i = 0; i < endedContactPairs.size(); i++)
 			{
-				Vector2 vertex1 = boxCollider->GetNormalsAtIndex(i);
-				Vector2 vertex2 = circleCenter - boxCollider->GetVerticesAtIndex(i);
-				float seperation = Math::Dot(vertex1, vertex2);
-
-				if (seperation > radius)
+				std::unordered_map<unsigned long long, ContactPair>::iterator ended = m_ContactPairs.find(endedContactPairs.at(i));
+				if (ended == m_ContactPairs.end())
 				{
-					return false;
+					continue;
 				}
-				if (seperation > maxSeperation)
+
+				Body* bodyA = GetBody(ended->second.handleA);
+				Body* bodyB = GetBody(ended->second.handleB);
+				m_ContactPairs.erase(ended);
+
+				if (m_Listener != nullptr && bodyA != nullptr && bodyB != nullptr)
 				{
-					maxSeperation = seperation;
-					faceNormal = i;
+					m_Listener->EndContact(bodyA, bodyB);
 				}
 			}
-			if (maxSeperation < EPSILON)
-			{
-				float overlap = circleCollider->GetRadius();
-				Vector2 faceNormalIV = boxCollider->GetNormalsAtIndex(faceNormal);
-				Vector2 normal = Vector2(c * faceNormalIV.x + s* faceNormalIV.y, -s * faceNormalIV.x + c * faceNormalIV.y) * -1.0f;
-				aManifold->SetContact(overlap, normal);
+		}
+
+		void World::RemoveBody(Body* aBody)
+		{
+			//Let the listener know the body's contacts have ended, while both bodies are still valid
+			EndContactPairs(aBody);
+
+			//Wake the body's island, the bodies resting on it shouldn't stay asleep (this also takes it out of the island's ring)
+			aBody->SetIsAwake(true);
 
-				return true;
+			if (aBody->m_ProxyId != NULL_PROXY)
+			{
+				m_BroadPhase->DestroyProxy(aBody->m_ProxyId);
+				aBody->m_ProxyId = NULL_PROXY;
 			}
-			Vector2 vertex1 = boxCollider->GetVerticesAtIndex(faceNormal);
-			unsigned int index2 = (faceNormal + 1 < BOX_COLLIDER_VERTEX_COUNT) ? faceNormal + 1 : 0;
-			Vector2 vertex2 = boxCollider->GetVerticesAtIndex(index2);
 
-			Vector2 closestPoint = Math::CalculateClosestPoint(circleCenter, radius, vertex1, vertex2);
+			//Swap the body to the end of the awake bodies, then to the end of the BodyData, and remove it
+			m_BodyData.awakeCount--;
+			SwapBodies(aBody->m_Index, m_BodyData.awakeCount);
+			SwapBodies(aBody->m_Index, m_BodyData.GetCount() - 1);
+			m_BodyData.RemoveLast();
+
+			//Invalidate the handles to the body and free its slot
+			BodySlot& slot = m_BodySlots.at(aBody->m_Handle.index);
+			slot.body = nullptr;
+			slot.generation++;
+			m_FreeBodySlots.push_back(aBody->m_Handle.index);
+
+			//The body deletes its collider
+			aBody->~Body();
+			m_BodyPool.Free(aBody);
+		}
+
+		void World::SetGravity(Vector2 aGravity)
+		{
+			m_Gravity = aGravity;
+		}
+
+		Vector2 World::GetGravity()
+		{
+			return m_Gravity;
+		}
+
+		void World::SetListener(WorldListener* aListener)
+		{
+			m_Listener = aListener;
+		}
+
+
+		unsigned int World::GetBodyCount()
+		{
+			return m_BodyData.GetCount();
+		}
+
+		unsigned int World::GetAwakeBodyCount()
+		{
+			return m_BodyData.awakeCount;
+		}
+
+		unsigned int World::GetPairCount()
+		{
+			return (unsigned int)m_Pairs.size();
+		}
+
+		unsigned int World::GetCulledPairCount()
+		{
+			return m_BroadPhase->GetCulledPairCount();
+		}
+
+		unsigned int World::GetContactCount()
+		{
+			return (unsigned int)m_Contacts.size();
+		}
+
+		double World::GetStepTime()
+		{
+			return m_StepTime;
+		}
 
-			float distance = Math::CalculateDistanceSquared(closestPoint, circleCenter);
+		unsigned int World::GetWorkerCount()
+		{
+			return m_ActiveWorkerCount;
+		}
 
-			if (distance <= radiusSquared)
+		bool World::CheckCollision(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+		{
+			if (aBodyA == aBodyB)
 			{
-				float overlap = radius - sqrtf(distance);
-				Vector2 normal = circleCenter - closestPoint;
-				normal = Vector2(c * normal.x + s * normal.y, -s * normal.x + c * normal.y) * -1.0f;
-				normal = Math::Normalize(normal);
-				aManifold->SetContact(overlap, normal);
+				return false;
+			}
 
-				return true;
+			//Look the kernel up in the dispatch table, pairs of types without a kernel can't collide
+			CollisionKernel kernel = GetCollisionKernel(aBodyA->GetCollider()->GetType(), aBodyB->GetCollider()->GetType());
+			if (kernel == nullptr)
+			{
+				return false;
 			}
-			return false;
+
+			return kernel(aBodyA, aBodyB, aManifold);
 		}
 	}
 }
\ No newline at end of file
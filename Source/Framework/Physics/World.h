@@ -2,26 +2,48 @@
 #define __GameDev2D__World__
 
 #include <vector>
+#include <unordered_map>
 #include "WorldListener.h"
 #include "../Math/Vector2.h"
 #include "Manifold.h"
+#include "BroadPhase.h"
+#include "BodyData.h"
+#include "Body.h"
+#include "ObjectPool.h"
 
 namespace GameDev2D
 {
 	namespace Physics
 	{
+		//Local constants
+		const BroadPhaseType WORLD_DEFAULT_BROAD_PHASE = BroadPhaseType_SpatialHash;
+		const unsigned int WORLD_MIN_PAIRS_PER_WORKER = 128;
+
 		//Forward declarations
 		class Body;
 		class Collider;
+		class WorkerPool;
 
 		class World
 		{
 		public:
+			//Returns the World instance, if it hasn't been created yet it will use the default broadphase
 			static World* GetInstance();
 
+			//Creates the World instance with the supplied broadphase, must be called before the first GetInstance() call
+			static World* CreateInstance(BroadPhaseType broadPhaseType);
+
 			void Step(double timeStep);
+			//Creates a body, the World owns the body and the collider, use DestroyBody() to delete them
 			Body* CreateBody(Collider* collider, float density);
 
+			//Destroys a body and its collider, if the World is in the middle of a step the body is destroyed at the end of it.
+			//The listener's EndContact() is called for the bodies it was touching, before it's destroyed
+			void DestroyBody(Body* body);
+
+			//Returns the body for a handle, or nullptr if the body has been destroyed
+			Body* GetBody(BodyHandle handle);
+
 			void SetGravity(Vector2 gravity);
 			Vector2 GetGravity();
 
@@ -29,21 +51,129 @@ namespace GameDev2D
 
 			void DebugDraw();
 
+			//Fills the bodies vector with every enabled body whose collider contains the point (in meters)
+			void QueryPoint(Vector2 point, std::vector<Body*>* bodies);
+
+			//Fills the bodies vector with every enabled body whose bounding box overlaps the bounding box (in meters)
+			void QueryAABB(const AABB& aabb, std::vector<Body*>* bodies);
+
+			//Returns the type of broadphase the World was created with
+			BroadPhaseType GetBroadPhaseType();
+
+			//Returns the number of bodies in the world
+			unsigned int GetBodyCount();
+
+			//Returns the number of bodies that are awake
+			unsigned int GetAwakeBodyCount();
+
+			//Returns the number of overlapping pairs the broadphase found during the last step
+			unsigned int GetPairCount();
+
+			//Returns the number of overlapping pairs the collision filters culled before the narrowphase during the last step
+			unsigned int GetCulledPairCount();
+
+			//Returns the number of contacts found during the last step
+			unsigned int GetContactCount();
+
+			//Returns how long the last step took (in milliseconds)
+			double GetStepTime();
+
+			//Returns the number of threads the narrowphase used during the last step
+			unsigned int GetWorkerCount();
+
 		private:
-			World();
+			//Bodies need to let the World know when they wake up or go to sleep
+			friend class Body;
+
+			World(BroadPhaseType broadPhaseType);
 			~World();
 
-			//Private collision methods
+			//Removes a body from the broadphase and the BodyData, then destroys it and frees its slot
+			void RemoveBody(Body* body);
+
+			//Moves a body between the awake and sleeping bodies, waking a body wakes its whole island
+			void SetBodyIsAwake(Body* body, bool isAwake);
+
+			//Swaps the state of two bodies in the BodyData and updates their handles
+			void SwapBodies(unsigned int indexA, unsigned int indexB);
+
+			//Builds islands of awake bodies connected by contacts, islands that have been resting long enough go to sleep
+			void UpdateSleep();
+			unsigned int FindIsland(unsigned int index);
+
+			//Updates the broadphase proxies for every body
+			void UpdateBroadPhase(double timeStep);
+
+			//Runs the narrowphase on one worker's share of the pairs, the contacts go in that worker's buffer
+			void NarrowPhase(unsigned int workerIndex);
+
+			//Looks the contact up in the contact pair cache and calls BeginContact() or PersistContact()
+			void UpdateContactPair(Body* bodyA, Body* bodyB);
+
+			//Calls EndContact() for the cached pairs that weren't touching this step and removes them from the cache
+			void EndContactPairs();
+
+			//Calls EndContact() for the cached pairs the body is part of and removes them from the cache, called before the body is removed
+			void EndContactPairs(Body* body);
+
+			//Returns the contact pair cache key for a pair of bodies, it's the same regardless of the order of the bodies
+			unsigned long long GetContactPairKey(Body* bodyA, Body* bodyB);
+
+			//Runs the narrowphase kernel for the pair's collider types
 			bool CheckCollision(Body* bodyA, Body* bodyB, Manifold* manifold);
-			bool CheckCircleToCircle(Body* bodyA, Body* bodyB, Manifold* manifold);
-			bool CheckCircleToBox(Body* bodyA, Body* bodyB, Manifold* manifold);
+
+			struct BodySlot
+			{
+				Body* body;
+				unsigned int generation;
+			};
+
+			struct ContactPair
+			{
+				ContactPair() :
+					handleA(),
+					handleB(),
+					stepCount(0)
+				{
+				}
+
+				BodyHandle handleA;
+				BodyHandle handleB;
+				unsigned int stepCount;	//The last step the bodies were touching, zero for a pair that was just added
+			};
 
 			Vector2 m_Gravity;
-			std::vector<Body*> m_Bodies;
+			BodyData m_BodyData;
+			ObjectPool m_BodyPool;
+			std::vector<BodySlot> m_BodySlots;
+			std::vector<unsigned int> m_FreeBodySlots;
+			std::vector<Body*> m_PendingDestroys;
+			bool m_IsLocked;
 
             vector<Manifold> m_Contacts;
+			std::unordered_map<unsigned long long, ContactPair> m_ContactPairs;
+			std::vector<unsigned long long> m_EndedContactPairs;
+			unsigned int m_StepCount;
+
+			BroadPhaseType m_BroadPhaseType;
+			BroadPhase* m_BroadPhase;
+			std::vector<ProxyPair> m_Pairs;
+			std::vector<int> m_QueryProxies;
+			std::vector<int> m_AwakeProxies;
+			bool m_IsBroadPhaseStale;
+
+			WorkerPool* m_WorkerPool;
+			std::vector<std::vector<Manifold>> m_WorkerContacts;
+			unsigned int m_ActiveWorkerCount;
+
+			std::vector<unsigned int> m_IslandParents;
+			std::vector<float> m_IslandSleepTimes;
+			std::vector<Body*> m_IslandHeads;
+			std::vector<Body*> m_IslandTails;
+			std::vector<Body*> m_SleepingBodies;
 
 			WorldListener* m_Listener;
+			double m_StepTime;
 
 			static World* s_Instance;
 		};
@@ -8,13 +8,29 @@ namespace GameDev2D
 		//Forward declarations
 		class Body;
 
+		//The World keeps track of which pairs of bodies are touching from one step to the next, so the listener
+		//is told once when two bodies start touching, every step they stay touching and once when they stop.
+		//Bodies can be destroyed from any of the callbacks, they are destroyed at the end of the step
 		class WorldListener
 		{
 		public:
-			virtual bool CollisionCallBack(Body* bodyA, Body* bodyB) = 0;
+			virtual ~WorldListener() {}
+
+			//Called the first step two bodies are touching
+			virtual void BeginContact(Body* bodyA, Body* bodyB) {}
+
+			//Called every step after the first that two bodies are still touching
+			virtual void PersistContact(Body* bodyA, Body* bodyB) {}
+
+			//Called the first step two bodies are no longer touching, or when one of the bodies is destroyed while they're touching
+			virtual void EndContact(Body* bodyA, Body* bodyB) {}
+
+			//Called every step two bodies are touching, after BeginContact() or PersistContact(). Return false
+			//to let the bodies overlap, the overlap won't be corrected for this step
+			virtual bool CollisionCallBack(Body* bodyA, Body* bodyB) { return true; }
 		};
 	}
 }
 
 
-#endif
\ No newline at end of file
+#endif
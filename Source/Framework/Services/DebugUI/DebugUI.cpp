@@ -25,6 +25,43 @@ namespace GameDev2D
 #if DEBUG_DRAW_ALLOCATED_TEXTURE_MEMORY
         WatchUnsignedLongLong(std::bind(&Graphics::GetAllocatedTextureMemory, Services::GetGraphics()), true);
 #endif
+
+#if DEBUG_DRAW_UNIFORM_UPLOADS
+        WatchUnsignedInt(std::bind(&Graphics::GetUniformUploadCount, Services::GetGraphics()));
+        WatchUnsignedInt(std::bind(&Graphics::GetSkippedUniformUploadCount, Services::GetGraphics()));
+#endif
+
+#if DEBUG_DRAW_UPLOADED_BYTES
+        WatchUnsignedLongLong(std::bind(&Graphics::GetUploadedByteCount, Services::GetGraphics()), true);
+        WatchUnsignedInt(std::bind(&Graphics::GetBufferWrapCount, Services::GetGraphics()));
+#endif
+
+#if DEBUG_DRAW_CULLED_DRAWABLES
+        WatchUnsignedInt(std::bind(&Graphics::GetSubmittedDrawableCount, Services::GetGraphics()));
+        WatchUnsignedInt(std::bind(&Graphics::GetCulledDrawableCount, Services::GetGraphics()));
+#endif
+
+        //The physics watches look the World up when they're drawn, so they don't create it before the game picks its broadphase
+#if DEBUG_DRAW_PHYSICS_BODY_COUNT
+        WatchUnsignedInt([]() { return Physics::World::GetInstance()->GetBodyCount(); });
+#endif
+
+#if DEBUG_DRAW_PHYSICS_AWAKE_BODY_COUNT
+        WatchUnsignedInt([]() { return Physics::World::GetInstance()->GetAwakeBodyCount(); });
+#endif
+
+#if DEBUG_DRAW_PHYSICS_PAIR_COUNT
+        WatchUnsignedInt([]() { return Physics::World::GetInstance()->GetPairCount(); });
+#endif
+
+#if DEBUG_DRAW_PHYSICS_CULLED_PAIR_COUNT
+        WatchUnsignedInt([]() { return Physics::World::GetInstance()->GetCulledPairCount(); });
+#endif
+
+#if DEBUG_DRAW_PHYSICS_STEP_TIME
+        WatchDouble([]() { return Physics::World::GetInstance()->GetStepTime(); });
+#endif
+
 #if DEBUG ||_DEBUG
         //Add an event listener callback for the Update event
         Services::GetApplication()->AddEventListener(this, DRAW_EVENT);
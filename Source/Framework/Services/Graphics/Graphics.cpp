@@ -5,39 +5,70 @@
 #include "../../Events/UpdateEvent.h"
 #include "../../Graphics/Camera.h"
 #include "../../Graphics/Font.h"
+#include "../../Graphics/FontLayoutCache.h"
+#include "../../Graphics/PrimitiveBatch.h"
+#include "../../Graphics/Sprite.h"
 #include "../../Graphics/SpriteBatch.h"
 #include "../../Graphics/Texture.h"
-#include "../../Utils/Text/Text.h"
 #include "../../Windows/Application.h"
 #include "../../Windows/OpenGL/OpenGLExtensions.h"
 #include "../../Windows/OpenGL/glext.h"
 #include "../../Windows/OpenGL/wglext.h"
 #include <GameDev2D.h>
+#include <string.h>
 
 
 namespace GameDev2D
 {
-    Graphics::Graphics() : EventHandler(),
+    Graphics::Graphics(GraphicsBackend aBackend) : EventHandler(),
+        m_Backend(aBackend),
+        m_CommandList(nullptr),
         m_TexturedVertexData(nullptr),
-        m_PolygonVertexData(nullptr),
-        m_SpriteBatch(nullptr),
+        m_TexturedShader(nullptr),
+        m_TexturedAnchorUniform(SHADER_INVALID_UNIFORM),
+        m_TexturedSizeUniform(SHADER_INVALID_UNIFORM),
+        m_TexturedColorUniform(SHADER_INVALID_UNIFORM),
+        m_TexturedTextureUniform(SHADER_INVALID_UNIFORM),
+        m_TexturedModelUniform(SHADER_INVALID_UNIFORM),
+        m_TexturedViewUniform(SHADER_INVALID_UNIFORM),
+        m_TexturedProjectionUniform(SHADER_INVALID_UNIFORM),
+        m_FontLayoutCache(nullptr),
+        m_FrameSpriteBatch(nullptr),
+        m_FramePrimitiveBatch(nullptr),
         m_Camera(nullptr),
         m_ClearColor(Color::WhiteColor()),
         m_BoundShaderProgram(0),
-        m_BoundTextureId(0),
+        m_BoundTextureId(),
+        m_ActiveTextureUnit(0),
         m_BoundFrameBufferId(0),
         m_BoundVertexArray(0),
         m_BoundDataBuffer(0),
-        m_Stats(Graphics::Stats())
-    {
+        m_Stats(Graphics::Stats()),
+        m_FrameStats(Graphics::Stats()),
+        m_IsDrawingSprites(false),
+        m_IsAddingSprite(false),
+        m_IsDrawingPrimitives(false),
+        m_IsAddingPrimitive(false),
+        m_IsCullingEnabled(true)
+    {
+        //The headless backend records the graphics commands instead of calling OpenGL
+        if (m_Backend == GraphicsBackend_Headless)
+        {
+            m_CommandList = new GraphicsCommandList();
+        }
+
         //Create the Camera object
         m_Camera = new Camera();
 
         //Set the clear color
         SetClearColor(BACKGROUND_CLEAR_COLOR);
 
-        //Add an event listener callback for the Update event, used to update the Camera
-        Services::GetApplication()->AddEventListener(this, UPDATE_EVENT);
+        //Add an event listener callback for the Update event, used to update the Camera. There's no
+        //Application when the Graphics service is created on its own, for headless tests and benchmarks
+        if (Services::GetApplication() != nullptr)
+        {
+            Services::GetApplication()->AddEventListener(this, UPDATE_EVENT);
+        }
     }
     
     Graphics::~Graphics()
@@ -48,10 +79,22 @@ namespace GameDev2D
             m_TexturedVertexData = nullptr;
         }
 
-        if (m_SpriteBatch != nullptr)
+        if (m_FontLayoutCache != nullptr)
+        {
+            delete m_FontLayoutCache;
+            m_FontLayoutCache = nullptr;
+        }
+
+        if (m_FrameSpriteBatch != nullptr)
         {
-            delete m_SpriteBatch;
-            m_SpriteBatch = nullptr;
+            delete m_FrameSpriteBatch;
+            m_FrameSpriteBatch = nullptr;
+        }
+
+        if (m_FramePrimitiveBatch != nullptr)
+        {
+            delete m_FramePrimitiveBatch;
+            m_FramePrimitiveBatch = nullptr;
         }
 
         if (m_Camera != nullptr)
@@ -60,8 +103,17 @@ namespace GameDev2D
             m_Camera = nullptr;
         }
 
+        if (m_CommandList != nullptr)
+        {
+            delete m_CommandList;
+            m_CommandList = nullptr;
+        }
+
         //Remove the event listener callback for the Update event
-        Services::GetApplication()->RemoveEventListener(this, UPDATE_EVENT);
+        if (Services::GetApplication() != nullptr)
+        {
+            Services::GetApplication()->RemoveEventListener(this, UPDATE_EVENT);
+        }
     }
 
     void Graphics::HandleEvent(Event* aEvent)
@@ -82,8 +134,23 @@ namespace GameDev2D
         }
     }
 
+    GraphicsBackend Graphics::GetBackend()
+    {
+        return m_Backend;
+    }
+
+    GraphicsCommandList* Graphics::GetCommandList()
+    {
+        return m_CommandList;
+    }
+
     unsigned int Graphics::GetApiVersion()
     {
+        if (m_CommandList != nullptr)
+        {
+            return GRAPHICS_COMMAND_LIST_API_VERSION;
+        }
+
         float version;
         sscanf((char *)glGetString(GL_VERSION), "%f", &version);
         return (unsigned int)(100 * version);
@@ -91,6 +158,11 @@ namespace GameDev2D
 
     unsigned int Graphics::GetShadingLanguageVersion()
     {
+        if (m_CommandList != nullptr)
+        {
+            return GRAPHICS_COMMAND_LIST_API_VERSION;
+        }
+
         float version;
         sscanf((char *)glGetString(GL_SHADING_LANGUAGE_VERSION), "%f", &version);
         return (unsigned int)(100 * version);
@@ -98,26 +170,45 @@ namespace GameDev2D
     
     void Graphics::Clear()
     {
-        glClear(GL_COLOR_BUFFER_BIT);
+        //Draw any sprites and shapes waiting to be drawn before they get cleared
+        FlushBatches();
+
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_Clear);
+        }
+        else
+        {
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
     }
 
     void Graphics::DrawTexture(Texture* aTexture, Vector2 aPosition, float aAngle, float aAlpha)
     {
         //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
         Color color = Color::WhiteColor(aAlpha);
-        Matrix transformation = Matrix::Make(aPosition, aAngle);
+        AffineMatrix transformation = AffineMatrix::Make(aPosition, aAngle);
 
         //If the textured VertexData object hasn't been created yet, then, well... Create it!
         if (m_TexturedVertexData == nullptr)
         {
+            //Look up the shader and its uniform handles once, they're used every time a texture is drawn
+            m_TexturedShader = Services::GetResourceManager()->GetShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
+            m_TexturedAnchorUniform = m_TexturedShader->GetUniformHandle("uniform_anchor");
+            m_TexturedSizeUniform = m_TexturedShader->GetUniformHandle("uniform_size");
+            m_TexturedColorUniform = m_TexturedShader->GetUniformHandle("uniform_color");
+            m_TexturedTextureUniform = m_TexturedShader->GetUniformHandle("uniform_texture");
+            m_TexturedModelUniform = m_TexturedShader->GetUniformHandle("uniform_model");
+            m_TexturedViewUniform = m_TexturedShader->GetUniformHandle("uniform_view");
+            m_TexturedProjectionUniform = m_TexturedShader->GetUniformHandle("uniform_projection");
+
             //Initialize the Graphics's textured vertex VertexBufferDescriptor, it describes
             //how the individual 'vertices' will be stored in the DataBuffer
             VertexBufferDescriptor descriptor;
             descriptor.size = 4;
             descriptor.capacity = 4;
             descriptor.usage = BufferUsage_StaticDraw;
-            descriptor.attributeIndex = { shader->GetAttributeLocation("in_vertices"), shader->GetAttributeLocation("in_uv") };
+            descriptor.attributeIndex = { m_TexturedShader->GetAttributeLocation("in_vertices"), m_TexturedShader->GetAttributeLocation("in_uv") };
             descriptor.attributeSize = { 2, 2 };
 
             //Initialize the vertices
@@ -156,16 +247,16 @@ namespace GameDev2D
         m_TexturedVertexData->PrepareForDraw();
 
         //Setup the shader uniforms
-        shader->SetUniformVector2("uniform_anchor", Vector2(0.0f, 0.0f));
-        shader->SetUniformVector2("uniform_size", Vector2((float)aTexture->GetWidth(), (float)aTexture->GetHeight()));
-        shader->SetUniformFloat("uniform_color", color.r, color.g, color.b, color.a);
-        shader->SetUniformInt("uniform_texture", 0);
-        shader->SetUniformMatrix("uniform_model", transformation);
-        shader->SetUniformMatrix("uniform_view", GetViewMatrix());
-        shader->SetUniformMatrix("uniform_projection", GetProjectionMatrix());
+        m_TexturedShader->SetUniformVector2(m_TexturedAnchorUniform, Vector2(0.0f, 0.0f));
+        m_TexturedShader->SetUniformVector2(m_TexturedSizeUniform, Vector2((float)aTexture->GetWidth(), (float)aTexture->GetHeight()));
+        m_TexturedShader->SetUniformFloat(m_TexturedColorUniform, color.r, color.g, color.b, color.a);
+        m_TexturedShader->SetUniformInt(m_TexturedTextureUniform, 0);
+        m_TexturedShader->SetUniformMatrix(m_TexturedModelUniform, transformation);
+        m_TexturedShader->SetUniformMatrix(m_TexturedViewUniform, GetViewMatrix());
+        m_TexturedShader->SetUniformMatrix(m_TexturedProjectionUniform, GetProjectionMatrix());
 
         //Validate the shader, return if it fails
-        if (shader->Validate() == false)
+        if (m_TexturedShader->Validate() == false)
         {
             return;
         }
@@ -200,247 +291,214 @@ namespace GameDev2D
             return;
         }
 
-        //If the SpriteBatch hasn't been created, create it
-        if (m_SpriteBatch == nullptr)
+        //If the FontLayoutCache hasn't been created, create it
+        if (m_FontLayoutCache == nullptr)
         {
-            m_SpriteBatch = new SpriteBatch();
+            m_FontLayoutCache = new FontLayoutCache();
         }
 
-        //calculate the baseline and origin for the label
-        unsigned int baseline = aFont->GetLineHeight() - aFont->GetBaseLine();
-        unsigned int numberOfLines = Text::NumberOfLines(aText);
-        Vector2 origin(aPosition.x, aPosition.y + baseline + (aFont->GetLineHeight() * (numberOfLines - 1)));
-
-        //
-        m_SpriteBatch->Begin();
-
-        //Cycle through the characters in the text label
-        for (unsigned int i = 0; i < aText.length(); i++)
-        {
-            //Did we reach a new line?
-            if (aText.at(i) == '\n')
-            {
-                origin.x = aPosition.x;
-                origin.y -= aFont->GetLineHeight();
-                continue;
-            }
+        //Get the text's glyph quads, they are only laid out the first frame the text is drawn
+        const std::vector<SpriteVertex>& vertices = m_FontLayoutCache->GetVertices(aFont, aText, aPosition, aColor);
 
-            //
-            Rect characterRect = aFont->GetTextureRectForCharacter(aText.at(i));
-
-            //Calculate the character position based on the x and y bearing
-            Vector2 charPosition = origin;
-            charPosition.x += aFont->GetBearingXForCharacter(aText.at(i));
-            charPosition.y += aFont->GetBearingYForCharacter(aText.at(i)) - characterRect.size.y;
-
-            //
-            m_SpriteBatch->Draw(aFont->GetTexture(), charPosition, 0.0f, Vector2(1.0f, 1.0f), aColor, Vector2(0.0f, 0.0f), characterRect);
-
-            //Increment the origin
-            origin.x += aFont->GetAdvanceXForCharacter(aText.at(i));
-        }
-
-        m_SpriteBatch->End();
+        //Add all the characters to the frame's SpriteBatch as one block
+        DrawSpriteVertices(aFont->GetTexture(), vertices.data(), (unsigned int)(vertices.size() / SPRITE_BATCH_VERTICES_PER_SPRITE));
     }
 
-    void Graphics::DrawRectangle(Vector2 aPosition, Vector2 aSize, float aAngle, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    void Graphics::DrawSprite(Sprite* aSprite)
     {
-        //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
-        Matrix transformation = Matrix::Make(aPosition, aAngle);
-
-        //If the textured VertexData object hasn't been created yet, then, well... Create it!
-        if (m_PolygonVertexData == nullptr)
+        //Is the Sprite on-screen?
+        if (IsVisible(aSprite) == false)
         {
-            //Initialize the Graphics's textured vertex VertexBufferDescriptor, it describes
-            //how the individual 'vertices' will be stored in the DataBuffer
-            VertexBufferDescriptor descriptor;
-            descriptor.size = 6;
-            descriptor.capacity = 36; //Max vertices the circle can have
-            descriptor.usage = BufferUsage_DynamicDraw;
-            descriptor.attributeIndex = { shader->GetAttributeLocation("in_vertices"), shader->GetAttributeLocation("in_color") };
-            descriptor.attributeSize = { 2, 4 };
-
-            //Create the textured vertex DataBuffer
-            m_PolygonVertexData = new VertexData();
-            m_PolygonVertexData->CreateBuffer(descriptor);
+            return;
         }
 
-        //Clear the existing vertices and add the new vertices to the vertex buffer
-        m_PolygonVertexData->GetVertexBuffer()->ClearVertices();
-        m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 0.0f, 0.0f, aColor.r, aColor.g, aColor.b, aColor.a });
-        m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { aSize.x, 0.0f, aColor.r, aColor.g, aColor.b, aColor.a });
-        m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { aSize.x, aSize.y, aColor.r, aColor.g, aColor.b, aColor.a });
-        m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { 0.0f, aSize.y, aColor.r, aColor.g, aColor.b, aColor.a });
+        //The SpriteBatch flushes itself when the texture slots run out, that flush mustn't End() the SpriteBatch
+        BeginSprites();
+        m_IsAddingSprite = true;
+        m_FrameSpriteBatch->Draw(aSprite);
+        m_IsAddingSprite = false;
+    }
 
-        //Prepate the textured VertexBuffer for Drawing
-        m_PolygonVertexData->PrepareForDraw();
+    void Graphics::DrawSpriteVertices(Texture* aTexture, const SpriteVertex* aVertices, unsigned int aSpriteCount)
+    {
+        //Add the block of sprites to the frame's SpriteBatch, it shares the texture slots with the Sprites around it
+        BeginSprites();
+        m_IsAddingSprite = true;
+        m_FrameSpriteBatch->Draw(aTexture, aVertices, aSpriteCount);
+        m_IsAddingSprite = false;
+    }
 
-        //Setup the shader uniforms
-        shader->SetUniformVector2("uniform_anchor", aAnchor);
-        shader->SetUniformVector2("uniform_size", aSize);
-        shader->SetUniformMatrix("uniform_model", transformation);
-        shader->SetUniformMatrix("uniform_view", GetViewMatrix());
-        shader->SetUniformMatrix("uniform_projection", GetProjectionMatrix());
+    void Graphics::EndFrame()
+    {
+        //Draw any sprites and shapes still waiting in the frame's batches
+        FlushBatches();
 
-        //Validate the shader, return if it fails
-        if (shader->Validate() == false)
+        //Remove the cached text layouts that weren't drawn this frame
+        if (m_FontLayoutCache != nullptr)
         {
-            return;
+            m_FontLayoutCache->EndFrame();
         }
 
-        //Enable blending if the texture has an alpha channel
-        if (aColor.a != 1.0f)
-        {
-            EnableBlending(BlendingMode());
-        }
-
-        //Draw the texture
-        DrawArrays(aIsFilled == true ? RenderMode_TriangleFan : RenderMode_LineLoop, 0, m_PolygonVertexData->GetVertexBuffer()->GetCount());
+        //Keep the frame's stats and reset the per frame counters
+        m_FrameStats = m_Stats;
+        m_Stats.uniformUploads = 0;
+        m_Stats.skippedUniformUploads = 0;
+        m_Stats.uploadedBytes = 0;
+        m_Stats.bufferWraps = 0;
+        m_Stats.submittedDrawables = 0;
+        m_Stats.culledDrawables = 0;
+    }
 
-        //Disable blending, if we did in fact have it enabled
-        if (aColor.a != 1.0f)
+    void Graphics::FlushSprites()
+    {
+        if (m_IsDrawingSprites == true && m_IsAddingSprite == false)
         {
-            DisableBlending();
+            //Reset the flag first, drawing the SpriteBatch calls back into this method through VertexData::PrepareForDraw()
+            m_IsDrawingSprites = false;
+            m_FrameSpriteBatch->End();
         }
     }
 
-    void Graphics::DrawCircle(Vector2 aPosition, float aRadius, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    void Graphics::FlushPrimitives()
     {
-        //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
-        Matrix transformation = Matrix::MakeTranslation(aPosition);
-
-        //If the textured VertexData object hasn't been created yet, then, well... Create it!
-        if (m_PolygonVertexData == nullptr)
+        if (m_IsDrawingPrimitives == true && m_IsAddingPrimitive == false)
         {
-            //Initialize the Graphics's textured vertex VertexBufferDescriptor, it describes
-            //how the individual 'vertices' will be stored in the DataBuffer
-            VertexBufferDescriptor descriptor;
-            descriptor.size = 6;
-            descriptor.capacity = 36; //Max vertices the circle can have
-            descriptor.usage = BufferUsage_DynamicDraw;
-            descriptor.attributeIndex = { shader->GetAttributeLocation("in_vertices"), shader->GetAttributeLocation("in_color") };
-            descriptor.attributeSize = { 2, 4 };
-
-            //Create the textured vertex DataBuffer
-            m_PolygonVertexData = new VertexData();
-            m_PolygonVertexData->CreateBuffer(descriptor);
+            //Reset the flag first, drawing the PrimitiveBatch calls back into this method through VertexData::PrepareForDraw()
+            m_IsDrawingPrimitives = false;
+            m_FramePrimitiveBatch->End();
         }
+    }
 
-        //Clear the existing vertices
-        m_PolygonVertexData->GetVertexBuffer()->ClearVertices();
+    void Graphics::FlushBatches()
+    {
+        //Only one of the batches can have anything waiting, each one is flushed before the other begins
+        FlushSprites();
+        FlushPrimitives();
+    }
 
-        //And add the new vertices to the vertex buffer for the circle
-        for (float i = 0.0f; i < 359.99f; i += 10.0f)
+    void Graphics::BeginSprites()
+    {
+        //If the frame's SpriteBatch hasn't been created, create it
+        if (m_FrameSpriteBatch == nullptr)
         {
-            float x = aRadius - (cosf(((float)M_PI * i / 180.0f)) * aRadius);
-            float y = aRadius - (sinf(((float)M_PI * i / 180.0f)) * aRadius);
-            m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { x, y, aColor.r, aColor.g, aColor.b, aColor.a });
+            m_FrameSpriteBatch = new SpriteBatch(true);
         }
 
-        //Prepate the textured VertexBuffer for Drawing
-        m_PolygonVertexData->PrepareForDraw();
+        //Begin the SpriteBatch, if it was flushed since the last Sprite was drawn
+        if (m_IsDrawingSprites == false)
+        {
+            //Draw any shapes waiting in the frame's PrimitiveBatch first, so the draw order is kept
+            FlushPrimitives();
 
-        //Setup the shader uniforms
-        shader->SetUniformVector2("uniform_anchor", aAnchor);
-        shader->SetUniformVector2("uniform_size", Vector2(aRadius * 2.0f, aRadius * 2.0f));
-        shader->SetUniformMatrix("uniform_model", transformation);
-        shader->SetUniformMatrix("uniform_view", GetViewMatrix());
-        shader->SetUniformMatrix("uniform_projection", GetProjectionMatrix());
+            m_FrameSpriteBatch->Begin();
+            m_IsDrawingSprites = true;
+        }
+    }
 
-        //Validate the shader, return if it fails
-        if (shader->Validate() == false)
+    void Graphics::BeginPrimitives()
+    {
+        //If the frame's PrimitiveBatch hasn't been created, create it
+        if (m_FramePrimitiveBatch == nullptr)
         {
-            return;
+            m_FramePrimitiveBatch = new PrimitiveBatch();
         }
 
-        //Enable blending if the texture has an alpha channel
-        if (aColor.a != 1.0f)
+        //Begin the PrimitiveBatch, if it was flushed since the last shape was drawn
+        if (m_IsDrawingPrimitives == false)
         {
-            EnableBlending(BlendingMode());
+            //Draw any sprites waiting in the frame's SpriteBatch first, so the draw order is kept
+            FlushSprites();
+
+            m_FramePrimitiveBatch->Begin();
+            m_IsDrawingPrimitives = true;
         }
+    }
 
-        //Draw the texture
-        DrawArrays(aIsFilled == true ? RenderMode_TriangleFan : RenderMode_LineLoop, 0, m_PolygonVertexData->GetVertexBuffer()->GetCount());
+    void Graphics::DrawRectangle(Vector2 aPosition, Vector2 aSize, float aAngle, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    {
+        //Add the Rectangle to the frame's PrimitiveBatch
+        BeginPrimitives();
+        m_IsAddingPrimitive = true;
+        m_FramePrimitiveBatch->DrawRectangle(aPosition, aSize, aAngle, aAnchor, aColor, aIsFilled);
+        m_IsAddingPrimitive = false;
+    }
 
-        //Disable blending, if we did in fact have it enabled
-        if (aColor.a != 1.0f)
-        {
-            DisableBlending();
-        }
+    void Graphics::DrawRectangle(const AffineMatrix& aTransformation, Vector2 aSize, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    {
+        //Add the Rectangle to the frame's PrimitiveBatch
+        BeginPrimitives();
+        m_IsAddingPrimitive = true;
+        m_FramePrimitiveBatch->DrawRectangle(aTransformation, aSize, aAnchor, aColor, aIsFilled);
+        m_IsAddingPrimitive = false;
+    }
+
+    void Graphics::DrawCircle(Vector2 aPosition, float aRadius, Vector2 aAnchor, Color aColor, bool aIsFilled)
+    {
+        //Add the Circle to the frame's PrimitiveBatch
+        BeginPrimitives();
+        m_IsAddingPrimitive = true;
+        m_FramePrimitiveBatch->DrawCircle(aPosition, aRadius, aAnchor, aColor, aIsFilled);
+        m_IsAddingPrimitive = false;
     }
 
     void Graphics::DrawLine(Vector2 aStartPoint, Vector2 aEndPoint, Color aColor)
     {
-        //Initialize the local variables used in this method
-        Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+        //Add the Line to the frame's PrimitiveBatch
+        BeginPrimitives();
+        m_IsAddingPrimitive = true;
+        m_FramePrimitiveBatch->DrawLine(aStartPoint, aEndPoint, aColor);
+        m_IsAddingPrimitive = false;
+    }
 
-        //If the textured VertexData object hasn't been created yet, then, well... Create it!
-        if (m_PolygonVertexData == nullptr)
+    void Graphics::DrawArrays(RenderMode aRenderMode, int aFirst, int aCount)
+    {
+        if (m_CommandList != nullptr)
         {
-            //Initialize the Graphics's textured vertex VertexBufferDescriptor, it describes
-            //how the individual 'vertices' will be stored in the DataBuffer
-            VertexBufferDescriptor descriptor;
-            descriptor.size = 6;
-            descriptor.capacity = 36; //Max vertices the circle can have
-            descriptor.usage = BufferUsage_DynamicDraw;
-            descriptor.attributeIndex = { shader->GetAttributeLocation("in_vertices"), shader->GetAttributeLocation("in_color") };
-            descriptor.attributeSize = { 2, 4 };
-
-            //Create the textured vertex DataBuffer
-            m_PolygonVertexData = new VertexData();
-            m_PolygonVertexData->CreateBuffer(descriptor);
+            m_CommandList->Record(GraphicsCommandType_DrawArrays, 0, aRenderMode, aFirst, aCount);
+            return;
         }
 
-        //Clear the existing vertices
-        m_PolygonVertexData->GetVertexBuffer()->ClearVertices();
-        m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { aStartPoint.x, aStartPoint.y, aColor.r, aColor.g, aColor.b, aColor.a });
-        m_PolygonVertexData->GetVertexBuffer()->AddVertex(std::vector<float>() = { aEndPoint.x, aEndPoint.y, aColor.r, aColor.g, aColor.b, aColor.a });
-
-        //Prepate the textured VertexBuffer for Drawing
-        m_PolygonVertexData->PrepareForDraw();
-
-        //Setup the shader uniforms
-        shader->SetUniformVector2("uniform_anchor", Vector2(0.0f, 0.0f));
-        shader->SetUniformVector2("uniform_size", aEndPoint - aStartPoint);
-        shader->SetUniformMatrix("uniform_model", Matrix::Identity());
-        shader->SetUniformMatrix("uniform_view", GetViewMatrix());
-        shader->SetUniformMatrix("uniform_projection", GetProjectionMatrix());
+        unsigned int renderMode = GetOpenGLRenderMode(aRenderMode);
+        glDrawArrays(renderMode, aFirst, aCount);
+    }
 
-        //Validate the shader, return if it fails
-        if (shader->Validate() == false)
+    void Graphics::DrawElements(RenderMode aRenderMode, int aCount, GraphicType aType, const void* aIndices)
+    {
+        if (m_CommandList != nullptr)
         {
+            m_CommandList->Record(GraphicsCommandType_DrawElements, 0, aRenderMode, aCount, aType, (int)(size_t)aIndices);
             return;
         }
 
-        //Enable blending if the texture has an alpha channel
-        if (aColor.a != 1.0f)
-        {
-            EnableBlending(BlendingMode());
-        }
+        unsigned int renderMode = GetOpenGLRenderMode(aRenderMode);
+        unsigned int type = GetOpenGLGraphicType(aType);
+        glDrawElements(renderMode, aCount, type, aIndices);
+    }
 
-        //Draw the texture
-        DrawArrays(RenderMode_Lines, 0, m_PolygonVertexData->GetVertexBuffer()->GetCount());
+    void Graphics::DrawElementsInstanced(RenderMode aRenderMode, int aCount, GraphicType aType, const void* aIndices, int aInstanceCount)
+    {
+        //If this assert is hit, the OpenGL context doesn't support instancing, check IsInstancingSupported() first
+        assert(IsInstancingSupported() == true);
 
-        //Disable blending, if we did in fact have it enabled
-        if (aColor.a != 1.0f)
+        if (m_CommandList != nullptr)
         {
-            DisableBlending();
+            m_CommandList->Record(GraphicsCommandType_DrawElementsInstanced, 0, aRenderMode, aCount, aType, aInstanceCount);
+            return;
         }
-    }
 
-    void Graphics::DrawArrays(RenderMode aRenderMode, int aFirst, int aCount)
-    {
         unsigned int renderMode = GetOpenGLRenderMode(aRenderMode);
-        glDrawArrays(renderMode, aFirst, aCount);
+        unsigned int type = GetOpenGLGraphicType(aType);
+        glDrawElementsInstanced(renderMode, aCount, type, aIndices, aInstanceCount);
     }
 
-    void Graphics::DrawElements(RenderMode aRenderMode, int aCount, GraphicType aType, const void* aIndices)
+    bool Graphics::IsInstancingSupported()
     {
-        unsigned int renderMode = GetOpenGLRenderMode(aRenderMode);
-        unsigned int type = GetOpenGLGraphicType(aType);
-        glDrawElements(renderMode, aCount, type, aIndices);
+        if (m_CommandList != nullptr)
+        {
+            return true;
+        }
+
+        return glDrawElementsInstanced != nullptr && glVertexAttribDivisor != nullptr;
     }
 
     Matrix Graphics::GetProjectionMatrix()
@@ -448,7 +506,7 @@ namespace GameDev2D
         return m_Camera->GetProjectionMatrix();
     }
 
-    Matrix Graphics::GetViewMatrix()
+    AffineMatrix Graphics::GetViewMatrix()
     {
         return m_Camera->GetViewMatrix();
     }
@@ -457,16 +515,54 @@ namespace GameDev2D
     {
         return m_Camera;
     }
+
+    bool Graphics::IsVisible(Drawable* aDrawable)
+    {
+        //Everything is visible if culling is disabled OR the Camera's viewport hasn't been set yet (when running headless)
+        Viewport viewport = m_Camera->GetViewport();
+        if (m_IsCullingEnabled == false || viewport.width == 0 || viewport.height == 0)
+        {
+            m_Stats.submittedDrawables++;
+            return true;
+        }
+
+        //Test the Drawable's world bounds against what the Camera can see
+        if (aDrawable->GetWorldBounds().Overlaps(m_Camera->GetVisibleBounds()) == false)
+        {
+            m_Stats.culledDrawables++;
+            return false;
+        }
+
+        m_Stats.submittedDrawables++;
+        return true;
+    }
+
+    void Graphics::SetCullingEnabled(bool aIsCullingEnabled)
+    {
+        m_IsCullingEnabled = aIsCullingEnabled;
+    }
+
+    bool Graphics::IsCullingEnabled()
+    {
+        return m_IsCullingEnabled;
+    }
     
     void Graphics::EnableBlending(BlendingMode aBlendingMode)
     {
-        //Determine the source and destination blending settings
-        GLenum source = GetOpenGLBlendingFactor(aBlendingMode.source);
-        GLenum destination = GetOpenGLBlendingFactor(aBlendingMode.destination);
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_EnableBlending, 0, aBlendingMode.source, aBlendingMode.destination);
+        }
+        else
+        {
+            //Determine the source and destination blending settings
+            GLenum source = GetOpenGLBlendingFactor(aBlendingMode.source);
+            GLenum destination = GetOpenGLBlendingFactor(aBlendingMode.destination);
 
-        //Enable blending
-        glBlendFunc(source, destination);
-        glEnable(GL_BLEND);
+            //Enable blending
+            glBlendFunc(source, destination);
+            glEnable(GL_BLEND);
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Blending enabled");
@@ -475,7 +571,14 @@ namespace GameDev2D
     void Graphics::DisableBlending()
     {
         //Disable blending
-        glDisable(GL_BLEND);
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_DisableBlending);
+        }
+        else
+        {
+            glDisable(GL_BLEND);
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Blending disabled");
@@ -485,7 +588,15 @@ namespace GameDev2D
     {
         //Set the OpenGL clear color
         m_ClearColor = aClearColor;
-        glClearColor(m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a);
+        if (m_CommandList != nullptr)
+        {
+            float clearColor[] = { m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a };
+            m_CommandList->Record(GraphicsCommandType_SetClearColor, 0, clearColor, sizeof(clearColor));
+        }
+        else
+        {
+            glClearColor(m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a);
+        }
 
         //Log the Graphic's event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Set clear color: (%f, %f, %f, %f)", m_ClearColor.r, m_ClearColor.g, m_ClearColor.b, m_ClearColor.a);
@@ -498,8 +609,18 @@ namespace GameDev2D
 
     void Graphics::SetViewport(const Viewport& aViewport)
     {
+        //Draw any sprites and shapes waiting to be drawn with the old viewport
+        FlushBatches();
+
         //Set the OpenGL viewport size
-        glViewport(aViewport.x, aViewport.y, aViewport.width, aViewport.height);
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_SetViewport, 0, aViewport.x, aViewport.y, aViewport.width, aViewport.height);
+        }
+        else
+        {
+            glViewport(aViewport.x, aViewport.y, aViewport.width, aViewport.height);
+        }
 
         //Log the Graphic's event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Set viewport: (%u, %u, %u, %u)", aViewport.x, aViewport.y, aViewport.width, aViewport.height);
@@ -507,10 +628,20 @@ namespace GameDev2D
 
     void Graphics::PushScissorClip(float aX, float aY, float aWidth, float aHeight)
     {
+        //Draw any sprites and shapes waiting to be drawn with the old scissor clip
+        FlushBatches();
+
         //If this is the first scissor clip, enable scissor clipping
         if (m_ScissorStack.size() == 0)
         {
-            glEnable(GL_SCISSOR_TEST);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_EnableScissor);
+            }
+            else
+            {
+                glEnable(GL_SCISSOR_TEST);
+            }
         }
 
         //Push the scissor clip onto the scissor stack
@@ -525,6 +656,9 @@ namespace GameDev2D
 
     void Graphics::PopScissorClip()
     {
+        //Draw any sprites and shapes waiting to be drawn with the old scissor clip
+        FlushBatches();
+
         //Pop back the scissor stack
         m_ScissorStack.pop_back();
 
@@ -543,17 +677,39 @@ namespace GameDev2D
             //Set the front scissor rect
             Vector2 position = m_ScissorStack.back().origin;
             Vector2 size = m_ScissorStack.back().size;
-            glScissor((int)position.x, (int)position.y, (int)size.x, (int)size.y);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_SetScissor, 0, (int)position.x, (int)position.y, (int)size.x, (int)size.y);
+            }
+            else
+            {
+                glScissor((int)position.x, (int)position.y, (int)size.x, (int)size.y);
+            }
         }
         else
         {
             //Disable the scissor test
-            glDisable(GL_SCISSOR_TEST);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_DisableScissor);
+            }
+            else
+            {
+                glDisable(GL_SCISSOR_TEST);
+            }
         }
     }
     
     void Graphics::BindTexture(Texture* aTexture)
     {
+        BindTexture(aTexture, 0);
+    }
+
+    void Graphics::BindTexture(Texture* aTexture, unsigned int aUnit)
+    {
+        //If this assert is hit, the texture unit is greater than the number of units tracked
+        assert(aUnit < GRAPHICS_TEXTURE_UNIT_COUNT);
+
         //Determine the Texture id to bind, if the pointer is null, it 
         //means we need to unbind (glBindTexture(0)) the active texture
         unsigned int id = 0;
@@ -562,29 +718,61 @@ namespace GameDev2D
             id = aTexture->GetId();
         }
 
+        //Make the texture unit active, even if the texture is already bound, the texture
+        //calls that follow (wrap, data, etc) act on the active unit
+        if (aUnit != m_ActiveTextureUnit)
+        {
+            m_ActiveTextureUnit = aUnit;
+            if (m_CommandList == nullptr)
+            {
+                glActiveTexture(GL_TEXTURE0 + m_ActiveTextureUnit);
+            }
+        }
+
         //Is the texture already bound?
-        if (id != m_BoundTextureId)
+        if (id != m_BoundTextureId[aUnit])
         {
             //Bind the texture id
-            m_BoundTextureId = id;
-            glBindTexture(GL_TEXTURE_2D, m_BoundTextureId);
+            m_BoundTextureId[aUnit] = id;
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_BindTexture, id, aUnit);
+            }
+            else
+            {
+                glBindTexture(GL_TEXTURE_2D, id);
+            }
 
             //Log the Graphics event
-            Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Bind texture: %u", m_BoundTextureId);
+            Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Bind texture: %u, unit: %u", id, aUnit);
         }
     }
 
-
     unsigned int Graphics::GetBoundTextureId()
     {
-        return m_BoundTextureId;
+        return GetBoundTextureId(0);
+    }
+
+    unsigned int Graphics::GetBoundTextureId(unsigned int aUnit)
+    {
+        //If this assert is hit, the texture unit is greater than the number of units tracked
+        assert(aUnit < GRAPHICS_TEXTURE_UNIT_COUNT);
+        return m_BoundTextureId[aUnit];
     }
 
     unsigned int Graphics::GenerateTexture()
     {
         //Generate a texture
         unsigned int id = 0;
-        glGenTextures(1, &id);
+        if (m_CommandList != nullptr)
+        {
+            id = m_CommandList->GenerateId();
+            m_CommandList->Record(GraphicsCommandType_GenerateTexture, id);
+        }
+        else
+        {
+            glGenTextures(1, &id);
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Generate texture: %u", id);
@@ -598,10 +786,16 @@ namespace GameDev2D
         //The Texture can't be null
         assert(aTexture != nullptr);
 
-        //If the texture we are about to delete is bound, we need to unbind it
-        if (aTexture->GetId() == GetBoundTextureId())
+        //Draw any sprites waiting to be drawn, they could be using the texture
+        FlushSprites();
+
+        //If the texture we are about to delete is bound to any texture unit, we need to unbind it
+        for (unsigned int i = 0; i < GRAPHICS_TEXTURE_UNIT_COUNT; i++)
         {
-            Services::GetGraphics()->BindTexture(nullptr);
+            if (aTexture->GetId() == GetBoundTextureId(i))
+            {
+                BindTexture(nullptr, i);
+            }
         }
 
         //Get the pixel size, width and height
@@ -614,7 +808,14 @@ namespace GameDev2D
 
         //Delete the texture
         unsigned int id = aTexture->GetId();
-        glDeleteTextures(1, &id);
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_DeleteTexture, id);
+        }
+        else
+        {
+            glDeleteTextures(1, &id);
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Delete texture: %u", aTexture->GetId());
@@ -647,6 +848,13 @@ namespace GameDev2D
             //Bind the texture by its id
             BindTexture(aTexture);
 
+            //The image data isn't recorded, only its size and layout
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_SetTextureData, aTexture->GetId(), aImageData.width, aImageData.height, aImageData.format.layout);
+                return;
+            }
+
             //Set the texture's filter settings
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -665,6 +873,12 @@ namespace GameDev2D
         //Bind the texture by its id
         BindTexture(aTexture);
 
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_SetTextureWrap, aTexture->GetId(), aWrap.s, aWrap.t);
+            return;
+        }
+
         //Get the OpenGL wrap mode
         int wrapModeS = GetOpenGLWrapMode(aWrap.s);
         int wrapModeT = GetOpenGLWrapMode(aWrap.t);
@@ -683,8 +897,18 @@ namespace GameDev2D
     {
         if (aFrameBuffer != m_BoundFrameBufferId)
         {
+            //Draw any sprites and shapes waiting to be drawn into the old framebuffer
+            FlushBatches();
+
             m_BoundFrameBufferId = aFrameBuffer;
-            glBindFramebuffer(GL_FRAMEBUFFER, m_BoundFrameBufferId);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_BindFrameBuffer, m_BoundFrameBufferId);
+            }
+            else
+            {
+                glBindFramebuffer(GL_FRAMEBUFFER, m_BoundFrameBufferId);
+            }
 
             //Log the Graphics event
             Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Bind framebuffer: %u", m_BoundFrameBufferId);
@@ -694,7 +918,15 @@ namespace GameDev2D
     void Graphics::GenerateFrameBuffer(unsigned int* aFrameBuffer)
     {
         //Generate the framebuffer
-        glGenFramebuffers(1, aFrameBuffer);
+        if (m_CommandList != nullptr)
+        {
+            *aFrameBuffer = m_CommandList->GenerateId();
+            m_CommandList->Record(GraphicsCommandType_GenerateFrameBuffer, *aFrameBuffer);
+        }
+        else
+        {
+            glGenFramebuffers(1, aFrameBuffer);
+        }
 
         //Log the graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Generate framebuffer: %u", *aFrameBuffer);
@@ -703,7 +935,14 @@ namespace GameDev2D
     void Graphics::DeleteFrameBuffer(unsigned int* aFrameBuffer)
     {
         //Delete the framebuffer
-        glDeleteFramebuffers(1, aFrameBuffer);
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_DeleteFrameBuffer, *aFrameBuffer);
+        }
+        else
+        {
+            glDeleteFramebuffers(1, aFrameBuffer);
+        }
 
         //Log the graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Delete framebuffer: %u", *aFrameBuffer);
@@ -720,17 +959,29 @@ namespace GameDev2D
         //Bind the framebuffer
         BindFrameBuffer(aFrameBuffer);
 
-        //If the texture id is bound, unbind it
-        if (aTextureId == GetBoundTextureId())
+        //If the texture id is bound to any texture unit, unbind it
+        for (unsigned int i = 0; i < GRAPHICS_TEXTURE_UNIT_COUNT; i++)
         {
-            Services::GetGraphics()->BindTexture(nullptr);
+            if (aTextureId == GetBoundTextureId(i))
+            {
+                BindTexture(nullptr, i);
+            }
         }
 
-        //Set the framebuffer storage to that of the texture
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, aTextureId, 0);
+        //Set the framebuffer storage to that of the texture, a recorded framebuffer is always complete
+        bool isComplete = true;
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_SetFrameBufferStorage, aFrameBuffer, aTextureId);
+        }
+        else
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, aTextureId, 0);
+            isComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        }
 
         //Check for errors, if any are found; log an error
-        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        if (isComplete == false)
         {
             Log::Error(this, "Graphics", false, Log::Verbosity_Graphics, "Failed to set framebuffer storage: %u", aFrameBuffer);
         }
@@ -748,12 +999,22 @@ namespace GameDev2D
         //Bind the framebuffer
         BindFrameBuffer(aFrameBuffer);
 
-        //Get the OpenGL texture format
-        unsigned int layout = GetOpenGLPixelLayout(aFormat.layout);
-        unsigned int size = GetOpenGLPixelSize(aFormat.size);
+        if (m_CommandList != nullptr)
+        {
+            //There are no pixels to read back, the buffer is zeroed
+            unsigned int pixelSize = aFormat.layout == PixelFormat::RGB ? 3 : 4;
+            memset(aBuffer, 0, aWidth * aHeight * pixelSize);
+            m_CommandList->Record(GraphicsCommandType_ReadPixels, aFrameBuffer, aWidth, aHeight, aFormat.layout);
+        }
+        else
+        {
+            //Get the OpenGL texture format
+            unsigned int layout = GetOpenGLPixelLayout(aFormat.layout);
+            unsigned int size = GetOpenGLPixelSize(aFormat.size);
 
-        //Read the data into the buffer
-        glReadPixels(0, 0, aWidth, aHeight, layout, size, aBuffer);
+            //Read the data into the buffer
+            glReadPixels(0, 0, aWidth, aHeight, layout, size, aBuffer);
+        }
 
         //Unbind the framebuffer
         BindFrameBuffer(0);
@@ -766,7 +1027,14 @@ namespace GameDev2D
         {
             //Bind the vertex array
             m_BoundVertexArray = aVertexArray;
-            glBindVertexArray(m_BoundVertexArray);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_BindVertexArray, m_BoundVertexArray);
+            }
+            else
+            {
+                glBindVertexArray(m_BoundVertexArray);
+            }
 
             //Log the Graphics event
             Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Bind vertex array: %u", m_BoundVertexArray);
@@ -781,7 +1049,15 @@ namespace GameDev2D
     void Graphics::GenerateVertexArray(unsigned int* aVertexArray)
     {
         //Generate a new vertex array
-        glGenVertexArrays(1, aVertexArray);
+        if (m_CommandList != nullptr)
+        {
+            *aVertexArray = m_CommandList->GenerateId();
+            m_CommandList->Record(GraphicsCommandType_GenerateVertexArray, *aVertexArray);
+        }
+        else
+        {
+            glGenVertexArrays(1, aVertexArray);
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Generate vertex array: %u", *aVertexArray);
@@ -792,7 +1068,14 @@ namespace GameDev2D
         if (*aVertexArray != 0)
         {
             //Delete the vertex array
-            glDeleteVertexArrays(1, aVertexArray);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_DeleteVertexArray, *aVertexArray);
+            }
+            else
+            {
+                glDeleteVertexArrays(1, aVertexArray);
+            }
             
             //Log the Graphics event
             Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Delete vertex array: %u", *aVertexArray);
@@ -807,12 +1090,16 @@ namespace GameDev2D
         //Is the  buffer already bound?
         if (aDataBuffer != m_BoundDataBuffer)
         {
-            //Get the OpenGL buffer type
-            GLenum bufferType = GetOpenGLBufferType(aBufferType);
-
             //Bind the  buffer
             m_BoundDataBuffer = aDataBuffer;
-            glBindBuffer(bufferType, aDataBuffer);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_BindDataBuffer, aDataBuffer, aBufferType);
+            }
+            else
+            {
+                glBindBuffer(GetOpenGLBufferType(aBufferType), aDataBuffer);
+            }
 
             //Log the Graphics event
             Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Bind data buffer: %u", m_BoundDataBuffer);
@@ -827,7 +1114,15 @@ namespace GameDev2D
     void Graphics::GenerateDataBuffer(unsigned int* aDataBuffer)
     {
         //Generate the buffer
-        glGenBuffers(1, aDataBuffer);
+        if (m_CommandList != nullptr)
+        {
+            *aDataBuffer = m_CommandList->GenerateId();
+            m_CommandList->Record(GraphicsCommandType_GenerateDataBuffer, *aDataBuffer);
+        }
+        else
+        {
+            glGenBuffers(1, aDataBuffer);
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Generate buffer: %u", *aDataBuffer);
@@ -838,7 +1133,14 @@ namespace GameDev2D
         if (*aDataBuffer != 0)
         {
             //Delete the vertex buffer
-            glDeleteBuffers(1, aDataBuffer);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_DeleteDataBuffer, *aDataBuffer);
+            }
+            else
+            {
+                glDeleteBuffers(1, aDataBuffer);
+            }
 
             //Log the Graphics event
             Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Delete buffer: %u", *aDataBuffer);
@@ -853,6 +1155,18 @@ namespace GameDev2D
         //Bind the vertex buffer
         BindDataBuffer(aBufferType, aDataBuffer);
 
+        //Keep track of how many bytes are uploaded, a buffer can be initialized without any data
+        if (aData != nullptr)
+        {
+            m_Stats.uploadedBytes += aSize;
+        }
+
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_InitializeDataBuffer, aDataBuffer, aData, (unsigned int)aSize, aBufferType, aUsage);
+            return;
+        }
+
         //Get the OpenGL usage constant
         GLenum usage = GetOpenGLBufferUsage(aUsage);
 
@@ -863,34 +1177,80 @@ namespace GameDev2D
         glBufferData(bufferType, (GLsizeiptr)aSize, aData, usage);
     }
 
-    void Graphics::UpdateDataBuffer(unsigned int aDataBuffer, BufferType aBufferType, long long aOffset, long long aSize, const void* aData)
+    void Graphics::UpdateDataBuffer(unsigned int aDataBuffer, BufferType aBufferType, long long aOffset, long long aSize, const void* aData, bool aIsUnsynchronized)
     {
         //Bind the data buffer
         BindDataBuffer(aBufferType, aDataBuffer);
 
+        //Keep track of how many bytes are uploaded
+        m_Stats.uploadedBytes += aSize;
+
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_UpdateDataBuffer, aDataBuffer, aData, (unsigned int)aSize, aBufferType, (int)aOffset, aIsUnsynchronized == true ? 1 : 0);
+            return;
+        }
+
         //Get the OpenGL buffer type
         GLenum bufferType = GetOpenGLBufferType(aBufferType);
 
+        //Map the range without waiting for the GPU, if mapping fails fall back to glBufferSubData()
+        if (aIsUnsynchronized == true && glMapBufferRange != nullptr && glUnmapBuffer != nullptr)
+        {
+            void* destination = glMapBufferRange(bufferType, (GLintptr)aOffset, (GLsizeiptr)aSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+            if (destination != nullptr)
+            {
+                memcpy(destination, aData, (size_t)aSize);
+                glUnmapBuffer(bufferType);
+                return;
+            }
+        }
+
         //Set the vertex buffer data
         glBufferSubData(bufferType, (GLintptr)aOffset, (GLsizeiptr)aSize, aData);
     }
 
-    void Graphics::SetVertexAttributePointer(unsigned int aVertexBuffer, int aAttributeIndex, int aSize, int aStride, const void * aOffset)
+    void Graphics::SetVertexAttributePointer(unsigned int aVertexBuffer, int aAttributeIndex, int aSize, int aStride, const void * aOffset, GraphicType aType, unsigned int aDivisor)
     {
         //Bind the vertex buffer
         BindDataBuffer(BufferType_Vertex, aVertexBuffer);
 
+        if (m_CommandList != nullptr)
+        {
+            unsigned int offsetAndDivisor[] = { (unsigned int)(size_t)aOffset, aDivisor };
+            m_CommandList->Record(GraphicsCommandType_SetVertexAttribute, aVertexBuffer, offsetAndDivisor, sizeof(offsetAndDivisor), aAttributeIndex, aSize, aStride, aType);
+            return;
+        }
+
         //Enable the vertex attribute array
         glEnableVertexAttribArray(aAttributeIndex);
 
-        //Set the shader's attribute for the uv coordinates
-        glVertexAttribPointer(aAttributeIndex, aSize, GL_FLOAT, GL_FALSE, aStride, aOffset);
+        //Set the shader's attribute for the uv coordinates, integer types are normalized
+        GLboolean normalized = aType == GraphicType_Float || aType == GraphicType_Double || aType == GraphicType_HalfFloat ? GL_FALSE : GL_TRUE;
+        glVertexAttribPointer(aAttributeIndex, aSize, GetOpenGLGraphicType(aType), normalized, aStride, aOffset);
+
+        //Set how often the attribute advances, only instanced attributes need it set
+        if (aDivisor != 0)
+        {
+            //If this assert is hit, the OpenGL context doesn't support instancing, check IsInstancingSupported() first
+            assert(IsInstancingSupported() == true);
+            glVertexAttribDivisor(aAttributeIndex, aDivisor);
+        }
     }
 
     unsigned int Graphics::CreateShaderProgram()
     {
         //Create the shader program
-        unsigned int program = glCreateProgram();
+        unsigned int program = 0;
+        if (m_CommandList != nullptr)
+        {
+            program = m_CommandList->GenerateId();
+            m_CommandList->Record(GraphicsCommandType_CreateShaderProgram, program);
+        }
+        else
+        {
+            program = glCreateProgram();
+        }
 
         //Log the Graphics event
         Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Create shader program: %u", program);
@@ -904,7 +1264,14 @@ namespace GameDev2D
         if (*aProgram != 0)
         {
             //Delete the shader program
-            glDeleteProgram(*aProgram);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_DeleteShaderProgram, *aProgram);
+            }
+            else
+            {
+                glDeleteProgram(*aProgram);
+            }
 
             //Log the Graphics event
             Log::Message(this, "Graphics", Log::Verbosity_Graphics, "Delete shader program: %u", *aProgram);
@@ -916,6 +1283,13 @@ namespace GameDev2D
 
     unsigned int Graphics::CreateShader(ShaderType aShaderType)
     {
+        if (m_CommandList != nullptr)
+        {
+            unsigned int shader = m_CommandList->GenerateId();
+            m_CommandList->Record(GraphicsCommandType_CreateShader, shader, aShaderType);
+            return shader;
+        }
+
         //Get the OpenGL shader type
         GLenum shaderType = GetOpenGLShaderType(aShaderType);
 
@@ -930,7 +1304,14 @@ namespace GameDev2D
     {
         if (*aShader != 0)
         {
-            glDeleteShader(*aShader);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_DeleteShader, *aShader);
+            }
+            else
+            {
+                glDeleteShader(*aShader);
+            }
             *aShader = 0;
         }
     }
@@ -940,6 +1321,13 @@ namespace GameDev2D
         //If this assert was hit, the shader hasn't been created yet
         assert(aShader != 0);
 
+        //Recorded shaders always compile
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_CompileShader, aShader, aSource.c_str(), (unsigned int)aSource.length());
+            return true;
+        }
+
         //Get the GLSL version
         unsigned int version = GetShadingLanguageVersion();
 
@@ -977,16 +1365,35 @@ namespace GameDev2D
 
     void Graphics::AttachShader(unsigned int aProgram, unsigned int aShader)
     {
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_AttachShader, aProgram, aShader);
+            return;
+        }
+
         glAttachShader(aProgram, aShader);
     }
 
     void Graphics::DetachShader(unsigned int aProgram, unsigned int aShader)
     {
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_DetachShader, aProgram, aShader);
+            return;
+        }
+
         glDetachShader(aProgram, aShader);
     }
 
     bool Graphics::LinkShaderProgram(unsigned int aProgram)
     {
+        //Recorded shader programs always link
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_LinkShaderProgram, aProgram);
+            return true;
+        }
+
         //Link the shader program
         glLinkProgram(aProgram);
 
@@ -1000,6 +1407,13 @@ namespace GameDev2D
 
     bool Graphics::ValidateShaderProgram(unsigned int aProgram)
     {
+        //Recorded shader programs are always valid
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_ValidateShaderProgram, aProgram);
+            return true;
+        }
+
         //Validate the shader program
         glValidateProgram(aProgram);
 
@@ -1016,83 +1430,188 @@ namespace GameDev2D
         if (aProgram != m_BoundShaderProgram)
         {
             m_BoundShaderProgram = aProgram;
-            glUseProgram(m_BoundShaderProgram);
+            if (m_CommandList != nullptr)
+            {
+                m_CommandList->Record(GraphicsCommandType_UseShaderProgram, m_BoundShaderProgram);
+            }
+            else
+            {
+                glUseProgram(m_BoundShaderProgram);
+            }
         }
     }
 
     int Graphics::GetUniformLocation(unsigned int aProgram, const string& aUniform)
     {
+        if (m_CommandList != nullptr)
+        {
+            return m_CommandList->GetLocation(aProgram, aUniform);
+        }
+
         return glGetUniformLocation(aProgram, aUniform.c_str());
     }
 
     int Graphics::GetAttributeLocation(unsigned int aProgram, const string& aAttribute)
     {
+        if (m_CommandList != nullptr)
+        {
+            return m_CommandList->GetLocation(aProgram, aAttribute);
+        }
+
         return glGetAttribLocation(aProgram, aAttribute.c_str());
     }
 
     void Graphics::SetUniformFloat(unsigned int aProgram, int aLocation, float aValue)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            float values[] = { aValue };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 1, 0);
+            return;
+        }
+
         glUniform1f(aLocation, aValue);
     }
 
     void Graphics::SetUniformFloat(unsigned int aProgram, int aLocation, float aValue1, float aValue2)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            float values[] = { aValue1, aValue2 };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 2, 0);
+            return;
+        }
+
         glUniform2f(aLocation, aValue1, aValue2);
     }
 
     void Graphics::SetUniformFloat(unsigned int aProgram, int aLocation, float aValue1, float aValue2, float aValue3)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            float values[] = { aValue1, aValue2, aValue3 };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 3, 0);
+            return;
+        }
+
         glUniform3f(aLocation, aValue1, aValue2, aValue3);
     }
 
     void Graphics::SetUniformFloat(unsigned int aProgram, int aLocation, float aValue1, float aValue2, float aValue3, float aValue4)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            float values[] = { aValue1, aValue2, aValue3, aValue4 };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 4, 0);
+            return;
+        }
+
         glUniform4f(aLocation, aValue1, aValue2, aValue3, aValue4);
     }
 
     void Graphics::SetUniformInt(unsigned int aProgram, int aLocation, int aValue)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            int values[] = { aValue };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 1, 1);
+            return;
+        }
+
         glUniform1i(aLocation, aValue);
     }
 
     void Graphics::SetUniformInt(unsigned int aProgram, int aLocation, int aValue1, int aValue2)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            int values[] = { aValue1, aValue2 };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 2, 1);
+            return;
+        }
+
         glUniform2i(aLocation, aValue1, aValue2);
     }
 
     void Graphics::SetUniformInt(unsigned int aProgram, int aLocation, int aValue1, int aValue2, int aValue3)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            int values[] = { aValue1, aValue2, aValue3 };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 3, 1);
+            return;
+        }
+
         glUniform3i(aLocation, aValue1, aValue2, aValue3);
     }
 
     void Graphics::SetUniformInt(unsigned int aProgram, int aLocation, int aValue1, int aValue2, int aValue3, int aValue4)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            int values[] = { aValue1, aValue2, aValue3, aValue4 };
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, values, sizeof(values), aLocation, 4, 1);
+            return;
+        }
+
         glUniform4i(aLocation, aValue1, aValue2, aValue3, aValue4);
     }
 
     void Graphics::SetUniformVector2(unsigned int aProgram, int aLocation, const Vector2& aValue)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, &aValue.data[0], 2 * sizeof(float), aLocation, 2, 0);
+            return;
+        }
+
         glUniform2fv(aLocation, 1, &aValue.data[0]);
     }
 
     void Graphics::SetUniformMatrix(unsigned int aProgram, int aLocation, const Matrix& aValue)
     {
         UseShaderProgram(aProgram);
+        m_Stats.uniformUploads++;
+        if (m_CommandList != nullptr)
+        {
+            m_CommandList->Record(GraphicsCommandType_SetUniform, aProgram, &aValue.m[0][0], sizeof(aValue.m), aLocation, MATRIX_NUM_COLUMNS * MATRIX_NUM_ROWS, 0);
+            return;
+        }
+
         glUniformMatrix4fv(aLocation, 1, 0, &aValue.m[0][0]);
     }
 
+    void Graphics::AddSkippedUniformUpload()
+    {
+        m_Stats.skippedUniformUploads++;
+    }
+
+    void Graphics::AddBufferWrap()
+    {
+        m_Stats.bufferWraps++;
+    }
+
     unsigned int Graphics::GetOpenGLGraphicType(GraphicType aType)
     {
-        unsigned int types[] = { GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT, GL_INT, GL_UNSIGNED_INT, GL_FLOAT, GL_DOUBLE };
+        unsigned int types[] = { GL_BYTE, GL_UNSIGNED_BYTE, GL_SHORT, GL_UNSIGNED_SHORT, GL_INT, GL_UNSIGNED_INT, GL_FLOAT, GL_DOUBLE, GL_HALF_FLOAT };
         return types[aType];
     }
 
@@ -1148,4 +1667,34 @@ namespace GameDev2D
     {
         return m_Stats.textureMemory;
     }
+
+    unsigned int Graphics::GetUniformUploadCount()
+    {
+        return m_FrameStats.uniformUploads;
+    }
+
+    unsigned int Graphics::GetSkippedUniformUploadCount()
+    {
+        return m_FrameStats.skippedUniformUploads;
+    }
+
+    unsigned long long Graphics::GetUploadedByteCount()
+    {
+        return m_FrameStats.uploadedBytes;
+    }
+
+    unsigned int Graphics::GetBufferWrapCount()
+    {
+        return m_FrameStats.bufferWraps;
+    }
+
+    unsigned int Graphics::GetSubmittedDrawableCount()
+    {
+        return m_FrameStats.submittedDrawables;
+    }
+
+    unsigned int Graphics::GetCulledDrawableCount()
+    {
+        return m_FrameStats.culledDrawables;
+    }
 }
@@ -7,26 +7,42 @@
 #include "../../Graphics/RenderTarget.h"
 #include "../../Graphics/Shader.h"
 #include "../../Graphics/VertexData.h"
+#include "../../Math/AffineMatrix.h"
 #include "../../Math/Matrix.h"
+#include "GraphicsCommandList.h"
 
 
 namespace GameDev2D
 {
+    //Local constants
+    const unsigned int GRAPHICS_TEXTURE_UNIT_COUNT = 8;     //Number of texture units tracked, OpenGL 3.x guarantees at least 16 for fragment shaders
+
     //Forward declarations
     class Camera;
+    class Drawable;
     class Font;
+    class FontLayoutCache;
+    class PrimitiveBatch;
+    class Sprite;
     class SpriteBatch;
+    struct SpriteVertex;
 
     //
     class Graphics : public EventHandler
     {
     public:
-        Graphics();
+        Graphics(GraphicsBackend backend = GraphicsBackend_OpenGL);
         ~Graphics();
         
         //The HandleEvent is used to notify the Graphics class of various GameDev2D events
         void HandleEvent(Event* event);
 
+        //Returns the backend the Graphics service is rendering with
+        GraphicsBackend GetBackend();
+
+        //Returns the recorded graphics commands when running headless, returns null for the OpenGL backend
+        GraphicsCommandList* GetCommandList();
+
         //Returns the OpenGL API version
         unsigned int GetApiVersion();
 
@@ -42,13 +58,41 @@ namespace GameDev2D
         //Draws a string using a supplied Font to the screen at the supplied position and color
         void DrawFont(Font* font, const std::string& text, Vector2 position, Color color);
 
-        //Draw a Rectangle to the screen at the supplied position and size, the Color can be set, and can be filled in
+        //Adds a Sprite to the frame's SpriteBatch, consecutive sprites that share a texture and blending mode
+        //are drawn with a single draw call. Sprite::Draw() calls this method
+        void DrawSprite(Sprite* sprite);
+
+        //Adds a block of sprites whose vertices were built ahead of time (see PackSpriteVertices) to the frame's SpriteBatch,
+        //all sampling from the same Texture. DrawFont() and Label::Draw() call this method, so text is batched with the sprites
+        void DrawSpriteVertices(Texture* texture, const SpriteVertex* vertices, unsigned int spriteCount);
+
+        //Called by the Application once the frame has been drawn, draws any sprites and shapes still waiting in
+        //the frame's batches and resets the per frame stats
+        void EndFrame();
+
+        //Draws the sprites waiting in the frame's SpriteBatch. It's called before shapes are added to the frame's
+        //PrimitiveBatch and through FlushBatches() so the draw order is kept
+        void FlushSprites();
+
+        //Draws the shapes waiting in the frame's PrimitiveBatch. It's called before sprites are added to the
+        //frame's SpriteBatch and through FlushBatches() so the draw order is kept
+        void FlushPrimitives();
+
+        //Draws the sprites and shapes waiting in the frame's batches. It's called whenever anything else is about
+        //to be drawn (through VertexData::PrepareForDraw()) so the draw order is kept, and at the end of the frame
+        void FlushBatches();
+
+        //Adds a Rectangle to the frame's PrimitiveBatch at the supplied position and size, the Color can be set, and can
+        //be filled in. Filled shapes and outlines are drawn in order, sharing one draw call
         void DrawRectangle(Vector2 position, Vector2 size, float angle, Vector2 anchor, Color color, bool isFilled);
 
-        //Draw a Circle to the screen at the supplied position and radius, the Color can be set, and can be filled in
+        //Adds a Rectangle to the frame's PrimitiveBatch, transformed by the AffineMatrix instead of a position and angle
+        void DrawRectangle(const AffineMatrix& transformation, Vector2 size, Vector2 anchor, Color color, bool isFilled);
+
+        //Adds a Circle to the frame's PrimitiveBatch at the supplied position and radius, the Color can be set, and can be filled in
         void DrawCircle(Vector2 position, float radius, Vector2 anchor, Color color, bool isFilled);
 
-        //Draw a Line to the screen at the supplied endpoints, the Color can be set
+        //Adds a Line to the frame's PrimitiveBatch at the supplied endpoints, the Color can be set
         void DrawLine(Vector2 startPoint, Vector2 endPoint, Color color);
 
         //Call the OpenGL DrawArrays function
@@ -57,13 +101,29 @@ namespace GameDev2D
         //Call the OpenGL DrawElements function
         void DrawElements(RenderMode aRenderMode, int aCount, GraphicType aType, const void* aIndices);
 
+        //Call the OpenGL DrawElementsInstanced function, the indices are drawn once for each instance
+        void DrawElementsInstanced(RenderMode renderMode, int count, GraphicType type, const void* indices, int instanceCount);
+
+        //Returns true if the OpenGL context supports instanced drawing and vertex attribute divisors
+        bool IsInstancingSupported();
+
         //Returns the active camera's projection and view matrices
         Matrix GetProjectionMatrix();
-        Matrix GetViewMatrix();
+        AffineMatrix GetViewMatrix();
 
         //Returns the Camera
         Camera* GetCamera();
 
+        //Returns true if the Drawable's world bounds overlap the Camera's visible bounds. Sprites, Labels and Polygons
+        //call this before they emit any vertices, the result is counted in the submitted and culled drawable stats
+        bool IsVisible(Drawable* drawable);
+
+        //Enables or disables culling, when it's disabled IsVisible() always returns true. Culling is enabled by default
+        void SetCullingEnabled(bool isCullingEnabled);
+
+        //Returns wether culling is enabled
+        bool IsCullingEnabled();
+
         //Sets the OpenGL viewport
         void SetViewport(const Viewport& viewport);
 
@@ -87,12 +147,18 @@ namespace GameDev2D
         //there is no value, OpenGL scissor is disabled
         void ResetScissorClip();
 
-        //Bind the open gl texture id associated with the Texture object
+        //Bind the open gl texture id associated with the Texture object, to texture unit zero
         void BindTexture(Texture* texture);
 
-        //Returns the currently bound texture id
+        //Bind the open gl texture id associated with the Texture object to a texture unit, the unit is made active
+        void BindTexture(Texture* texture, unsigned int unit);
+
+        //Returns the texture id bound to texture unit zero
         unsigned int GetBoundTextureId();
 
+        //Returns the texture id bound to a texture unit
+        unsigned int GetBoundTextureId(unsigned int unit);
+
         //Generates an OpenGL Texture id and returns it
         unsigned int GenerateTexture();
 
@@ -151,10 +217,14 @@ namespace GameDev2D
         void InitializeDataBuffer(unsigned int dataBuffer, BufferType bufferType, long long size, const void* data, BufferUsage usage);
 
         //
-        void UpdateDataBuffer(unsigned int dataBuffer, BufferType bufferType, long long offset, long long size, const void* data);
+        //Unsynchronized updates don't wait for draws still using the buffer, only use them to write to a range of
+        //the buffer no pending draw reads from, such as the unused part of a ring buffer
+        void UpdateDataBuffer(unsigned int dataBuffer, BufferType bufferType, long long offset, long long size, const void* data, bool isUnsynchronized = false);
 
         //
-        void SetVertexAttributePointer(unsigned int vertexBuffer, int attributeIndex, int size, int stride, const void * offset);
+        //Integer attribute types are normalized to the 0.0f - 1.0f range, a divisor of zero advances the attribute
+        //every vertex, a divisor of one advances it every instance
+        void SetVertexAttributePointer(unsigned int vertexBuffer, int attributeIndex, int size, int stride, const void * offset, GraphicType type = GraphicType_Float, unsigned int divisor = 0);
 
         //
         unsigned int CreateShaderProgram();
@@ -210,6 +280,12 @@ namespace GameDev2D
         //
         void SetUniformMatrix(unsigned int program, int location, const Matrix& value);
 
+        //Called by a Shader when setting a uniform is skipped because the uniform already had the value
+        void AddSkippedUniformUpload();
+
+        //Called by a VertexBuffer when its ring buffer is full and has to be orphaned
+        void AddBufferWrap();
+
         //Converts the GraphicType data type into the OpenGL constant
         unsigned int GetOpenGLGraphicType(GraphicType aType);
        
@@ -241,30 +317,84 @@ namespace GameDev2D
         struct Stats
         {
             Stats() :
-                textureMemory(0)
+                textureMemory(0),
+                uniformUploads(0),
+                skippedUniformUploads(0),
+                uploadedBytes(0),
+                bufferWraps(0),
+                submittedDrawables(0),
+                culledDrawables(0)
             {
             }
 
             unsigned long long textureMemory;
+            unsigned int uniformUploads;            //Per frame
+            unsigned int skippedUniformUploads;     //Per frame
+            unsigned long long uploadedBytes;       //Per frame
+            unsigned int bufferWraps;               //Per frame
+            unsigned int submittedDrawables;        //Per frame
+            unsigned int culledDrawables;           //Per frame
         };
 
         //Returns the Graphics stats
         unsigned long long GetAllocatedTextureMemory();
 
+        //Returns the number of uniform values uploaded last frame
+        unsigned int GetUniformUploadCount();
+
+        //Returns the number of uniform uploads skipped last frame, because the uniform already had the value
+        unsigned int GetSkippedUniformUploadCount();
+
+        //Returns the number of bytes uploaded to vertex, instance and index buffers last frame
+        unsigned long long GetUploadedByteCount();
+
+        //Returns the number of times a VertexBuffer's ring buffer was full and had to be orphaned last frame
+        unsigned int GetBufferWrapCount();
+
+        //Returns the number of Drawables that were visible and submitted for drawing last frame
+        unsigned int GetSubmittedDrawableCount();
+
+        //Returns the number of Drawables that were outside of the Camera's view and skipped last frame
+        unsigned int GetCulledDrawableCount();
+
     private:
+        //Creates and begins the frame's SpriteBatch, if it isn't already drawing
+        void BeginSprites();
+
+        //Creates and begins the frame's PrimitiveBatch, if it isn't already drawing
+        void BeginPrimitives();
+
         //Member variables
+        GraphicsBackend m_Backend;
+        GraphicsCommandList* m_CommandList;
         VertexData* m_TexturedVertexData;
-        VertexData* m_PolygonVertexData;
-        SpriteBatch* m_SpriteBatch;  //Used for Text rendering
+        Shader* m_TexturedShader;
+        UniformHandle m_TexturedAnchorUniform;
+        UniformHandle m_TexturedSizeUniform;
+        UniformHandle m_TexturedColorUniform;
+        UniformHandle m_TexturedTextureUniform;
+        UniformHandle m_TexturedModelUniform;
+        UniformHandle m_TexturedViewUniform;
+        UniformHandle m_TexturedProjectionUniform;
+        FontLayoutCache* m_FontLayoutCache;  //Caches the glyph quads for Text rendering
+        SpriteBatch* m_FrameSpriteBatch;  //Used for Sprite rendering
+        PrimitiveBatch* m_FramePrimitiveBatch;  //Used for Rectangle, Circle and Line rendering
         Camera* m_Camera;
         Color m_ClearColor;
         unsigned int m_BoundShaderProgram;
-        unsigned int m_BoundTextureId;
+        unsigned int m_BoundTextureId[GRAPHICS_TEXTURE_UNIT_COUNT];
+        unsigned int m_ActiveTextureUnit;
         unsigned int m_BoundFrameBufferId;
         unsigned int m_BoundVertexArray;
         unsigned int m_BoundDataBuffer;
         vector<Rect> m_ScissorStack; 
         Stats m_Stats;
+        Stats m_FrameStats;
+        bool m_IsDrawingSprites;
+        bool m_IsAddingSprite;
+        bool m_IsDrawingPrimitives;
+        bool m_IsAddingPrimitive;
+        bool m_IsCullingEnabled;
     };
 }
 
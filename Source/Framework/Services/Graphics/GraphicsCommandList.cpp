@@ -0,0 +1,126 @@
+#include "GraphicsCommandList.h"
+#include <assert.h>
+#include <string.h>
+
+
+namespace GameDev2D
+{
+    GraphicsCommandList::GraphicsCommandList() :
+        m_Commands(),
+        m_Data(),
+        m_Locations(),
+        m_LocationCounts(),
+        m_UploadedBytes(0),
+        m_NextId(1)
+    {
+        memset(m_Counts, 0, sizeof(m_Counts));
+    }
+
+    GraphicsCommandList::~GraphicsCommandList()
+    {
+    }
+
+    unsigned int GraphicsCommandList::Record(GraphicsCommandType aType, unsigned int aId, int aArgument1, int aArgument2, int aArgument3, int aArgument4)
+    {
+        return Record(aType, aId, nullptr, 0, aArgument1, aArgument2, aArgument3, aArgument4);
+    }
+
+    unsigned int GraphicsCommandList::Record(GraphicsCommandType aType, unsigned int aId, const void* aData, unsigned int aSize, int aArgument1, int aArgument2, int aArgument3, int aArgument4)
+    {
+        //If this assert is hit, the command type is invalid
+        assert(aType < GraphicsCommandType_Count);
+
+        GraphicsCommand command;
+        command.type = aType;
+        command.id = aId;
+        command.arguments[0] = aArgument1;
+        command.arguments[1] = aArgument2;
+        command.arguments[2] = aArgument3;
+        command.arguments[3] = aArgument4;
+        command.dataOffset = (unsigned int)m_Data.size();
+        command.dataSize = 0;
+
+        //Copy the command's data, buffers can be initialized without any data
+        if (aData != nullptr && aSize > 0)
+        {
+            m_Data.insert(m_Data.end(), (const unsigned char*)aData, (const unsigned char*)aData + aSize);
+            command.dataSize = aSize;
+        }
+
+        //Keep track of how many bytes have been uploaded to data buffers
+        if (aType == GraphicsCommandType_InitializeDataBuffer || aType == GraphicsCommandType_UpdateDataBuffer)
+        {
+            m_UploadedBytes += command.dataSize;
+        }
+
+        m_Counts[aType]++;
+        m_Commands.push_back(command);
+        return (unsigned int)m_Commands.size() - 1;
+    }
+
+    unsigned int GraphicsCommandList::GetCount()
+    {
+        return (unsigned int)m_Commands.size();
+    }
+
+    unsigned int GraphicsCommandList::GetCount(GraphicsCommandType aType)
+    {
+        //If this assert is hit, the command type is invalid
+        assert(aType < GraphicsCommandType_Count);
+
+        return m_Counts[aType];
+    }
+
+    const GraphicsCommand& GraphicsCommandList::GetCommand(unsigned int aIndex)
+    {
+        //If this assert is hit, the index is out of bounds
+        assert(aIndex < m_Commands.size());
+
+        return m_Commands[aIndex];
+    }
+
+    const void* GraphicsCommandList::GetData(const GraphicsCommand& aCommand)
+    {
+        if (aCommand.dataSize == 0)
+        {
+            return nullptr;
+        }
+
+        return &m_Data[aCommand.dataOffset];
+    }
+
+    unsigned long long GraphicsCommandList::GetUploadedBytes()
+    {
+        return m_UploadedBytes;
+    }
+
+    void GraphicsCommandList::Clear()
+    {
+        //The vectors keep their capacity, so recording doesn't allocate once it has warmed up
+        m_Commands.clear();
+        m_Data.clear();
+        memset(m_Counts, 0, sizeof(m_Counts));
+        m_UploadedBytes = 0;
+    }
+
+    unsigned int GraphicsCommandList::GenerateId()
+    {
+        //Zero is never used, OpenGL treats it as 'no object'
+        return m_NextId++;
+    }
+
+    int GraphicsCommandList::GetLocation(unsigned int aProgram, const std::string& aName)
+    {
+        std::pair<unsigned int, std::string> key(aProgram, aName);
+        std::map<std::pair<unsigned int, std::string>, int>::iterator location = m_Locations.find(key);
+        if (location != m_Locations.end())
+        {
+            return location->second;
+        }
+
+        //Hand out the program's locations in the order they are asked for
+        int newLocation = m_LocationCounts[aProgram]++;
+        m_Locations[key] = newLocation;
+        return newLocation;
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef __GameDev2D__GraphicsCommandList__
+#define __GameDev2D__GraphicsCommandList__
+
+#include "../../Graphics/GraphicTypes.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int GRAPHICS_COMMAND_ARGUMENT_COUNT = 4;
+    const unsigned int GRAPHICS_COMMAND_LIST_API_VERSION = 330;     //The version the headless backend reports for OpenGL and GLSL
+
+    //The commands recorded by the headless Graphics backend. The id is the object the command acts on
+    //and the arguments used by each command are listed beside it, unlisted arguments are zero
+    enum GraphicsCommandType
+    {
+        GraphicsCommandType_Clear = 0,
+        GraphicsCommandType_SetClearColor,              //Data: 4 floats (RGBA)
+        GraphicsCommandType_SetViewport,                //Arguments: x, y, width, height
+        GraphicsCommandType_EnableBlending,             //Arguments: source BlendingFactor, destination BlendingFactor
+        GraphicsCommandType_DisableBlending,
+        GraphicsCommandType_EnableScissor,
+        GraphicsCommandType_SetScissor,                 //Arguments: x, y, width, height
+        GraphicsCommandType_DisableScissor,
+        GraphicsCommandType_BindTexture,                //Id: texture, Arguments: texture unit
+        GraphicsCommandType_GenerateTexture,            //Id: texture
+        GraphicsCommandType_DeleteTexture,              //Id: texture
+        GraphicsCommandType_SetTextureData,             //Id: texture, Arguments: width, height, PixelLayout
+        GraphicsCommandType_SetTextureWrap,             //Id: texture, Arguments: s WrapMode, t WrapMode
+        GraphicsCommandType_BindFrameBuffer,            //Id: framebuffer
+        GraphicsCommandType_GenerateFrameBuffer,        //Id: framebuffer
+        GraphicsCommandType_DeleteFrameBuffer,          //Id: framebuffer
+        GraphicsCommandType_SetFrameBufferStorage,      //Id: framebuffer, Arguments: texture
+        GraphicsCommandType_ReadPixels,                 //Id: framebuffer, Arguments: width, height, PixelLayout
+        GraphicsCommandType_BindVertexArray,            //Id: vertex array
+        GraphicsCommandType_GenerateVertexArray,        //Id: vertex array
+        GraphicsCommandType_DeleteVertexArray,          //Id: vertex array
+        GraphicsCommandType_BindDataBuffer,             //Id: buffer, Arguments: BufferType
+        GraphicsCommandType_GenerateDataBuffer,         //Id: buffer
+        GraphicsCommandType_DeleteDataBuffer,           //Id: buffer
+        GraphicsCommandType_InitializeDataBuffer,       //Id: buffer, Arguments: BufferType, BufferUsage, Data: the buffer's contents (if any)
+        GraphicsCommandType_UpdateDataBuffer,           //Id: buffer, Arguments: BufferType, offset, 1 if unsynchronized, Data: the uploaded bytes
+        GraphicsCommandType_SetVertexAttribute,         //Id: buffer, Arguments: attribute index, size, stride, GraphicType, Data: offset and divisor
+        GraphicsCommandType_CreateShaderProgram,        //Id: program
+        GraphicsCommandType_DeleteShaderProgram,        //Id: program
+        GraphicsCommandType_CreateShader,               //Id: shader, Arguments: ShaderType
+        GraphicsCommandType_DeleteShader,               //Id: shader
+        GraphicsCommandType_CompileShader,              //Id: shader, Data: the shader's source
+        GraphicsCommandType_AttachShader,               //Id: program, Arguments: shader
+        GraphicsCommandType_DetachShader,               //Id: program, Arguments: shader
+        GraphicsCommandType_LinkShaderProgram,          //Id: program
+        GraphicsCommandType_ValidateShaderProgram,      //Id: program
+        GraphicsCommandType_UseShaderProgram,           //Id: program
+        GraphicsCommandType_SetUniform,                 //Id: program, Arguments: location, value count, 1 if the values are ints, Data: the values
+        GraphicsCommandType_DrawArrays,                 //Arguments: RenderMode, first, count
+        GraphicsCommandType_DrawElements,               //Arguments: RenderMode, count, GraphicType, index offset
+        GraphicsCommandType_DrawElementsInstanced,      //Arguments: RenderMode, count, GraphicType, instance count
+        GraphicsCommandType_Count
+    };
+
+    //A single recorded command, any data it carries (buffer uploads, uniform values, shader source) is stored in
+    //the GraphicsCommandList, use GraphicsCommandList::GetData() to access it
+    struct GraphicsCommand
+    {
+        GraphicsCommandType type;
+        unsigned int id;
+        int arguments[GRAPHICS_COMMAND_ARGUMENT_COUNT];
+        unsigned int dataOffset;
+        unsigned int dataSize;
+    };
+
+    //The GraphicsCommandList records every bind, buffer upload, uniform set and draw made through the Graphics service,
+    //instead of calling OpenGL. It lets the rendering code run without a GPU, so render paths can be inspected in tests
+    //and benchmarked headless. It also hands out the object ids and shader locations OpenGL would have
+    class GraphicsCommandList
+    {
+    public:
+        GraphicsCommandList();
+        ~GraphicsCommandList();
+
+        //Records a command, returns the index of the command
+        unsigned int Record(GraphicsCommandType type, unsigned int id = 0, int argument1 = 0, int argument2 = 0, int argument3 = 0, int argument4 = 0);
+
+        //Records a command and copies its data, returns the index of the command
+        unsigned int Record(GraphicsCommandType type, unsigned int id, const void* data, unsigned int size, int argument1 = 0, int argument2 = 0, int argument3 = 0, int argument4 = 0);
+
+        //Returns the number of recorded commands
+        unsigned int GetCount();
+
+        //Returns the number of recorded commands of a type
+        unsigned int GetCount(GraphicsCommandType type);
+
+        //Returns a recorded command
+        const GraphicsCommand& GetCommand(unsigned int index);
+
+        //Returns the data of a recorded command, returns null if the command has no data
+        const void* GetData(const GraphicsCommand& command);
+
+        //Returns the total number of bytes uploaded to data buffers
+        unsigned long long GetUploadedBytes();
+
+        //Clears the recorded commands, the generated ids and locations are kept
+        void Clear();
+
+        //Returns a new, unique object id, the same way glGen*() would
+        unsigned int GenerateId();
+
+        //Returns the location of a uniform or attribute in a program, the same name always gets the same location
+        int GetLocation(unsigned int program, const std::string& name);
+
+    private:
+        //Member variables
+        std::vector<GraphicsCommand> m_Commands;
+        std::vector<unsigned char> m_Data;
+        std::map<std::pair<unsigned int, std::string>, int> m_Locations;
+        std::map<unsigned int, int> m_LocationCounts;
+        unsigned int m_Counts[GraphicsCommandType_Count];
+        unsigned long long m_UploadedBytes;
+        unsigned int m_NextId;
+    };
+}
+
+#endif
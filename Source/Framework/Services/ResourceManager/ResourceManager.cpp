@@ -4,6 +4,7 @@
 #include "../../Graphics/Font.h"
 #include "../../Graphics/Shader.h"
 #include "../../Graphics/SpriteAtlas.h"
+#include "../../Graphics/SpriteBatch.h"
 #include "../../IO/File.h"
 #include "../../Utils/Png/Png.h"
 #include "../../Utils/TrueType/TrueType.h"
@@ -75,10 +76,14 @@ namespace GameDev2D
         attributes.push_back("in_vertices");
         attributes.push_back("in_uv");
         attributes.push_back("in_color");
+        attributes.push_back("in_textureSlot");
 
-        //Re-initialize the uniforms for the SpriteBatch shader
+        //Re-initialize the uniforms for the SpriteBatch shader, there's one sampler per texture slot
         uniforms.clear();
-        uniforms.push_back("uniform_texture");
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            uniforms.push_back("uniform_textures[" + std::to_string(i) + "]");
+        }
         uniforms.push_back("uniform_model");
         uniforms.push_back("uniform_view");
         uniforms.push_back("uniform_projection");
@@ -87,6 +92,29 @@ namespace GameDev2D
         ShaderInfo spriteBatchPassthrough = ShaderInfo("passThrough-spriteBatch", "passThrough-spriteBatch", attributes, uniforms);
         LoadShader(&spriteBatchPassthrough, PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
 
+        //Re-initialize the attributes for the instanced SpriteBatch shader
+        attributes.clear();
+        attributes.push_back("in_corner");
+        attributes.push_back("in_transformX");
+        attributes.push_back("in_transformY");
+        attributes.push_back("in_uvRect");
+        attributes.push_back("in_anchor");
+        attributes.push_back("in_color");
+        attributes.push_back("in_textureSlot");
+
+        //Re-initialize the uniforms for the instanced SpriteBatch shader, it has the same texture slots as the SpriteBatch shader
+        uniforms.clear();
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+        {
+            uniforms.push_back("uniform_textures[" + std::to_string(i) + "]");
+        }
+        uniforms.push_back("uniform_view");
+        uniforms.push_back("uniform_projection");
+
+        //Load the instanced sprite pass through shader
+        ShaderInfo spriteInstancedPassthrough = ShaderInfo("passThrough-spriteInstanced", "passThrough-spriteInstanced", attributes, uniforms);
+        LoadShader(&spriteInstancedPassthrough, PASSTHROUGH_SPRITEINSTANCED_SHADER_KEY);
+
         //Add an event listener callback for the Update event
         Services::GetApplication()->AddEventListener(this, UPDATE_EVENT);
     }
@@ -125,6 +153,7 @@ namespace GameDev2D
         UnloadShader(PASSTHROUGH_POLYGON_SHADER_KEY);
         UnloadShader(PASSTHROUGH_TEXTURE_SHADER_KEY);
         UnloadShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
+        UnloadShader(PASSTHROUGH_SPRITEINSTANCED_SHADER_KEY);
 
         //Check how many Textures remain loaded
         unsigned int texturesLeft = m_TextureMap.Count();
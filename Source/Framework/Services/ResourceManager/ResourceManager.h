@@ -17,6 +17,7 @@ const unsigned int MAX_AUDIO_CHANNELS = 32;
 const std::string PASSTHROUGH_POLYGON_SHADER_KEY = "PolygonPassthrough";
 const std::string PASSTHROUGH_TEXTURE_SHADER_KEY = "TexturePassthrough";
 const std::string PASSTHROUGH_SPRITEBATCH_SHADER_KEY = "SpriteBatchPassthrough";
+const std::string PASSTHROUGH_SPRITEINSTANCED_SHADER_KEY = "SpriteInstancedPassthrough";
 
 
 //Font constants
@@ -11,10 +11,10 @@ namespace GameDev2D
     InputManager* Services::s_InputManager = nullptr;
     DebugUI* Services::s_DebugUI = nullptr;
     
-    void Services::Init(Application* aApplication)
+    void Services::Init(Application* aApplication, GraphicsBackend aGraphicsBackend)
     {
         s_Application = aApplication;
-        s_Graphics = new Graphics();
+        s_Graphics = new Graphics(aGraphicsBackend);
         s_ResourceManager = new ResourceManager();
         s_InputManager = new InputManager();
         s_DebugUI = new DebugUI();
@@ -17,8 +17,8 @@ namespace GameDev2D
     class Services
     {
     public:
-        //Initializes the default game services
-        static void Init(Application* application);
+        //Initializes the default game services, the Graphics service renders with the backend
+        static void Init(Application* application, GraphicsBackend graphicsBackend = GraphicsBackend_OpenGL);
 
         //Cleans up the default game services
         static void Cleanup();
@@ -2,18 +2,19 @@
 #include "../Services/Services.h"
 #include "../Debug/Log.h"
 #include "../Events/UpdateEvent.h"
+#include <GameDev2D.h>
 
 
 namespace GameDev2D
 {
-    Application::Application(const char* aWindowTitle, int aFrameRate, unsigned int aWidth, unsigned int aHeight, bool aFullscreen) : 
+    Application::Application(const char* aWindowTitle, int aFrameRate, unsigned int aWidth, unsigned int aHeight, bool aFullscreen, GraphicsBackend aGraphicsBackend) : 
         m_GameWindow(nullptr),
         m_GameLoop(nullptr),
         m_IsSuspended(false),
         m_IsRunning(true)
     {
         //Create the Game window
-        m_GameWindow = new GameWindow();
+        m_GameWindow = new GameWindow(aGraphicsBackend);
 
         //Create the GameLoop
         m_GameLoop = new GameLoop(this);
@@ -23,7 +24,7 @@ namespace GameDev2D
         AddEventListener(m_GameLoop, RESUME_EVENT);
 
         //Set the application and load the default services
-        Services::Init(this);
+        Services::Init(this, aGraphicsBackend);
 
         //Initialize the GameWindow
         m_GameWindow->SetTitle(aWindowTitle);
@@ -132,6 +133,9 @@ namespace GameDev2D
         //Dispatch a Draw event
         DispatchEvent(Event(DRAW_EVENT));
 
+        //Let the Graphics service know the frame has been drawn
+        Services::GetGraphics()->EndFrame();
+
         //If the application isn't suspended, flush the opengl buffer
         if(m_IsSuspended == false)
         {
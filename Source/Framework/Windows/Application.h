@@ -22,7 +22,8 @@ namespace GameDev2D
     {
     public:
         //The constructor takes in the Window the application is in, the window title and the target frame rate.
-        Application(const char* windowTitle, int frameRate, unsigned int width, unsigned int height, bool fullscreen);
+        //The GraphicsBackend is chosen at startup, the headless backend runs without a window or a GPU
+        Application(const char* windowTitle, int frameRate, unsigned int width, unsigned int height, bool fullscreen, GraphicsBackend graphicsBackend = GraphicsBackend_OpenGL);
         ~Application();
         
         //
@@ -12,10 +12,11 @@
 
 namespace GameDev2D
 {
-    GameWindow::GameWindow() :
+    GameWindow::GameWindow(GraphicsBackend aGraphicsBackend) :
         m_WindowHandle(nullptr),
         m_DeviceContext(nullptr),
         m_OpenGLContext(nullptr),
+        m_GraphicsBackend(aGraphicsBackend),
         m_Width(0),
         m_Height(0),
         m_IsMouseCursorVisible(true),
@@ -23,6 +24,12 @@ namespace GameDev2D
         m_IsVerticalSyncEnabled(false),
         m_LastGamePadDetection(0.0)
     {
+        //The headless backend records its graphics commands, it doesn't need a window, a device context or an OpenGL context
+        if (m_GraphicsBackend == GraphicsBackend_Headless)
+        {
+            return;
+        }
+
         //Get the current hardware instance
         HINSTANCE currentInstance = GetModuleHandle(NULL);
 
@@ -102,8 +109,12 @@ namespace GameDev2D
 
     GameWindow::~GameWindow()
     {
-        wglMakeCurrent(NULL, NULL);
-        wglDeleteContext(m_OpenGLContext);
+        if (m_OpenGLContext != nullptr)
+        {
+            wglMakeCurrent(NULL, NULL);
+            wglDeleteContext(m_OpenGLContext);
+            m_OpenGLContext = nullptr;
+        }
     }
 
     unsigned int GameWindow::GetWidth()
@@ -118,7 +129,11 @@ namespace GameDev2D
 
     void GameWindow::SetTitle(const std::string& aTitle)
     {
-        SetWindowTextA(m_WindowHandle, aTitle.c_str());
+        //The headless backend doesn't have a window
+        if (m_WindowHandle != nullptr)
+        {
+            SetWindowTextA(m_WindowHandle, aTitle.c_str());
+        }
     }
 
     bool GameWindow::IsMouseCursorVisible()
@@ -140,6 +155,11 @@ namespace GameDev2D
 
     void GameWindow::SetMouseCursorPosition(int aX, int aY)
     {
+        if (m_WindowHandle == nullptr)
+        {
+            return;
+        }
+
         POINT point;
         point.x = aX;
         point.y = aY;
@@ -175,8 +195,8 @@ namespace GameDev2D
         //Set the vertical sync flag
         m_IsVerticalSyncEnabled = aIsEnabled;
 
-        //Ensure the v-sync function actually exists
-        if (wglSwapIntervalEXT != nullptr)
+        //Ensure there's an OpenGL context and the v-sync function actually exists
+        if (m_OpenGLContext != nullptr && wglSwapIntervalEXT != nullptr)
         {
             if (m_IsVerticalSyncEnabled)
             {
@@ -295,6 +315,14 @@ namespace GameDev2D
 
     void GameWindow::ApplyVideoModeChanges(VideoModeInfo* aVideoModeInfo)
     {
+        //There's no headless window, the display settings are left alone and only the size is kept
+        if (m_GraphicsBackend == GraphicsBackend_Headless)
+        {
+            m_IsFullScreen = false;
+            HandleResize(aVideoModeInfo->width, aVideoModeInfo->height);
+            return;
+        }
+
         //Will we need to dispatch a fullscreen event
         bool dispatchFullscreenEvent = m_IsFullScreen != aVideoModeInfo->fullscreen;
 
@@ -384,7 +412,11 @@ namespace GameDev2D
 
     void GameWindow::SwapDrawBuffer()
     {
-        SwapBuffers(m_DeviceContext);
+        //There's nothing to present without an OpenGL context
+        if (m_OpenGLContext != nullptr)
+        {
+            SwapBuffers(m_DeviceContext);
+        }
     }
 
     void GameWindow::HandleResize(unsigned int aWidth, unsigned int aHeight)
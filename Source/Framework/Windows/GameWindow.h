@@ -1,6 +1,7 @@
 #ifndef GAME_WINDOW_H
 #define GAME_WINDOW_H
 
+#include "../Graphics/GraphicTypes.h"
 #include <string>
 #include <Windows.h>
 
@@ -26,11 +27,12 @@ namespace GameDev2D
         NativeDialogYesNo
     };
 
-    //The GameWindow handle window creation, event handling and OpenGL context creation
+    //The GameWindow handle window creation, event handling and OpenGL context creation. With the headless
+    //GraphicsBackend no window OR OpenGL context is created, so it runs without a GPU
     class GameWindow
     {
     public:
-        GameWindow();
+        GameWindow(GraphicsBackend graphicsBackend = GraphicsBackend_OpenGL);
         ~GameWindow();
 
         //Returns the Window's current width and height
@@ -96,6 +98,7 @@ namespace GameDev2D
         HWND m_WindowHandle;
         HDC m_DeviceContext;
         HGLRC m_OpenGLContext;
+        GraphicsBackend m_GraphicsBackend;
         unsigned int m_Width;
         unsigned int m_Height;
         bool m_IsMouseCursorVisible;
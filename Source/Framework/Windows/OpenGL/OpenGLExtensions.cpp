@@ -58,6 +58,8 @@ PFNGLGENBUFFERSPROC                 glGenBuffers = 0;
 PFNGLBINDBUFFERPROC                 glBindBuffer = 0;
 PFNGLBUFFERDATAPROC                 glBufferData = 0;
 PFNGLBUFFERSUBDATAPROC              glBufferSubData = 0;
+PFNGLMAPBUFFERRANGEPROC             glMapBufferRange = 0;
+PFNGLUNMAPBUFFERPROC                glUnmapBuffer = 0;
 PFNGLDELETEBUFFERSPROC              glDeleteBuffers = 0;
 
 PFNGLBLENDFUNCSEPARATEPROC          glBlendFuncSeparate = 0;
@@ -74,6 +76,9 @@ PFNGLBINDVERTEXARRAYPROC            glBindVertexArray = 0;
 PFNGLGENVERTEXARRAYSPROC            glGenVertexArrays = 0;
 PFNGLDELETEVERTEXARRAYSPROC         glDeleteVertexArrays = 0;
 
+PFNGLVERTEXATTRIBDIVISORPROC        glVertexAttribDivisor = 0;
+PFNGLDRAWELEMENTSINSTANCEDPROC      glDrawElementsInstanced = 0;
+
 PFNGLFRAMEBUFFERRENDERBUFFERPROC    glFramebufferRenderbuffer = 0;
 PFNGLBINDRENDERBUFFERPROC           glBindRenderbuffer = 0;
 PFNGLGENRENDERBUFFERSPROC           glGenRenderbuffers = 0;
@@ -143,6 +148,8 @@ void InitOpenGLExtensions()
     glBindBuffer                    = (PFNGLBINDBUFFERPROC)                 wglGetProcAddress( "glBindBuffer" );
     glBufferData                    = (PFNGLBUFFERDATAPROC)                 wglGetProcAddress( "glBufferData" );
     glBufferSubData                 = (PFNGLBUFFERSUBDATAPROC)              wglGetProcAddress("glBufferSubData");
+    glMapBufferRange                = (PFNGLMAPBUFFERRANGEPROC)             wglGetProcAddress( "glMapBufferRange" );
+    glUnmapBuffer                   = (PFNGLUNMAPBUFFERPROC)                wglGetProcAddress( "glUnmapBuffer" );
     glDeleteBuffers                 = (PFNGLDELETEBUFFERSPROC)              wglGetProcAddress( "glDeleteBuffers" );
 
     glBlendFuncSeparate             = (PFNGLBLENDFUNCSEPARATEPROC)          wglGetProcAddress( "glBlendFuncSeparate" );
@@ -173,6 +180,14 @@ void InitOpenGLExtensions()
     glGenVertexArrays               = (PFNGLGENVERTEXARRAYSPROC)            wglGetProcAddress( "glGenVertexArrays" );
     glDeleteVertexArrays            = (PFNGLDELETEVERTEXARRAYSPROC)         wglGetProcAddress( "glDeleteVertexArrays" );
 
+    glVertexAttribDivisor           = (PFNGLVERTEXATTRIBDIVISORPROC)        wglGetProcAddress( "glVertexAttribDivisor" );
+    if( glVertexAttribDivisor == 0 )
+        glVertexAttribDivisor       = (PFNGLVERTEXATTRIBDIVISORPROC)        wglGetProcAddress( "glVertexAttribDivisorARB" );
+
+    glDrawElementsInstanced         = (PFNGLDRAWELEMENTSINSTANCEDPROC)      wglGetProcAddress( "glDrawElementsInstanced" );
+    if( glDrawElementsInstanced == 0 )
+        glDrawElementsInstanced     = (PFNGLDRAWELEMENTSINSTANCEDPROC)      wglGetProcAddress( "glDrawElementsInstancedARB" );
+
     glFramebufferRenderbuffer       = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)    wglGetProcAddress( "glFramebufferRenderbuffer" );
     if( glFramebufferRenderbuffer == 0 )
         glFramebufferRenderbuffer   = (PFNGLFRAMEBUFFERRENDERBUFFERPROC)    wglGetProcAddress( "glFramebufferRenderbufferEXT" );
@@ -64,6 +64,8 @@ extern PFNGLGENBUFFERSPROC                  glGenBuffers;
 extern PFNGLBINDBUFFERPROC                  glBindBuffer;
 extern PFNGLBUFFERDATAPROC                  glBufferData;
 extern PFNGLBUFFERSUBDATAPROC               glBufferSubData;
+extern PFNGLMAPBUFFERRANGEPROC              glMapBufferRange;
+extern PFNGLUNMAPBUFFERPROC                 glUnmapBuffer;
 extern PFNGLDELETEBUFFERSPROC               glDeleteBuffers;
 
 extern PFNGLBLENDFUNCSEPARATEPROC           glBlendFuncSeparate;
@@ -81,6 +83,9 @@ extern PFNGLBINDVERTEXARRAYPROC             glBindVertexArray;
 extern PFNGLGENVERTEXARRAYSPROC             glGenVertexArrays;
 extern PFNGLDELETEVERTEXARRAYSPROC          glDeleteVertexArrays;
 
+extern PFNGLVERTEXATTRIBDIVISORPROC         glVertexAttribDivisor;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC       glDrawElementsInstanced;
+
 extern PFNGLFRAMEBUFFERRENDERBUFFERPROC     glFramebufferRenderbuffer;
 extern PFNGLBINDRENDERBUFFERPROC            glBindRenderbuffer;
 extern PFNGLGENRENDERBUFFERSPROC            glGenRenderbuffers;
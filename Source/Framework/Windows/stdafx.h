@@ -81,6 +81,7 @@
 #include "../Input/Keyboard.h"
 #include "../Input/Mouse.h"
 #include "../IO/File.h"
+#include "../Math/AffineMatrix.h"
 #include "../Math/Math.h"
 #include "../Math/Matrix.h"
 #include "../Math/Rotation.h"
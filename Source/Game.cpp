@@ -1,11 +1,14 @@
 #include "Game.h"
 #include <time.h>
+#include <algorithm>
 
 
 namespace GameDev2D
 {
     Game::Game()
     {
+        //The tanks, barrels and shells are all small and similar in size, which the spatial hash handles best
+        Physics::World::CreateInstance(Physics::BroadPhaseType_SpatialHash);
         Physics::World::GetInstance()->SetListener(this);
 
         LoadTexture("SpriteAtlas");
@@ -48,6 +51,10 @@ namespace GameDev2D
         m_Background->SetPosition(Vector2(GetScreenWidth() / 2, GetScreenHeight() / 2));
         m_Background->SetAnchor(Vector2(0.5f, 0.5f));
 
+        //The background never moves, bake it into a StaticLayer so it isn't re-packed every frame
+        m_BackgroundLayer = new StaticLayer(1);
+        m_BackgroundLayer->Add(m_Background);
+
 
         for (int i = 0; i < 3; i++)
         {
@@ -67,8 +74,8 @@ namespace GameDev2D
         unsigned int GreenDet;
         do
         {
-            BlueDet = RandomRange(0, 47);
-            GreenDet = RandomRange(0, 47);
+            BlueDet = RandomRange(0, BarrelCount - 1);
+            GreenDet = RandomRange(0, BarrelCount - 1);
         } while (BlueDet == GreenDet);
 
         for (int i = 0; i < 8; i++)
@@ -108,6 +115,8 @@ namespace GameDev2D
         }
 
         delete m_Winner;
+        delete m_BackgroundLayer;
+        delete m_Background;
 
         for (int i = 0; i < SHELL_POOL_SIZE; i++)
         {
@@ -167,7 +176,7 @@ namespace GameDev2D
 
     void Game::Draw()
     {
-        m_Background->Draw();
+        m_BackgroundLayer->Draw();
 
 
         DrawRectangle(40, 50, 40, m_BlueTank->GetTimer() * 45, 0, Color::AntiqueWhiteColor(), true);
@@ -202,9 +211,15 @@ namespace GameDev2D
 
     void Game::HandleRightMouseClick(float mouseX, float mouseY)
     {
-        for (int i = 0; i < 48; i++)
+        //Only the barrels under the mouse explode, the World finds them instead of checking every barrel
+        std::vector<Physics::Body*> bodies;
+        Physics::World::GetInstance()->QueryPoint(Math::PixelsToMeters(Vector2(mouseX, mouseY)), &bodies);
+        for (unsigned int i = 0; i < bodies.size(); i++)
         {
-            m_Barrel[i]->Explosions();
+            if (bodies[i]->GetObject1() == Body_Barrel)
+            {
+                ((Barrel*)bodies[i]->GetUserData())->Explosions();
+            }
         }
     }
     void Game::HandleKeyPress(Keyboard::Key key)
@@ -247,67 +262,64 @@ namespace GameDev2D
         }
     }
 
-    bool Game::CollisionCallBack(Physics::Body* aBodyA, Physics::Body* aBodyB)
+    void Game::BeginContact(Physics::Body* aBodyA, Physics::Body* aBodyB)
     {
-        if ((aBodyA->GetObject1() == Body_Shell && aBodyB->GetObject1() == Body_Barrel) ||
-            (aBodyA->GetObject1() == Body_Barrel && aBodyB->GetObject1() == Body_Shell))
+        //Order the bodies by type, so each pair of types only has to be handled one way around
+        if (aBodyA->GetObject1() > aBodyB->GetObject1())
         {
-            for (int i = 0; i < BarrelCount; i++)
-            {
+            std::swap(aBodyA, aBodyB);
+        }
 
-                if (aBodyA == m_Barrel[i]->GetPhysicsBody() || aBodyB == m_Barrel[i]->GetPhysicsBody())
-                {
-                    for (int j = 0; j < 10; j++)
-                    {
-                        if (aBodyA == m_Shells[j]->GetPhysicsBody() || aBodyB == m_Shells[j]->GetPhysicsBody())
-                        {
-                            m_Shells[j]->Disable();
-                        }
-                        m_Barrel[i]->Explosions();
-                    }
+        //The bodies' user data is the game object that owns them
+        if (aBodyA->GetObject1() == Body_Barrel && aBodyB->GetObject1() == Body_Shell)
+        {
+            Barrel* barrel = (Barrel*)aBodyA->GetUserData();
+            Shell* shell = (Shell*)aBodyB->GetUserData();
+            shell->Disable();
+            barrel->Explosions();
+        }
 
-                }
-            }
+        DetonatorContact(aBodyA, aBodyB);
+    }
+
+    void Game::PersistContact(Physics::Body* aBodyA, Physics::Body* aBodyB)
+    {
+        //A barrel becomes a detonator when it's shot, a tank that was already touching it doesn't get another BeginContact() call
+        if (aBodyA->GetObject1() > aBodyB->GetObject1())
+        {
+            std::swap(aBodyA, aBodyB);
         }
-        if ((aBodyA->GetObject1() == Body_Tank && aBodyB->GetObject1() == Body_Green) ||
-            aBodyA->GetObject1() == Body_Green && aBodyB->GetObject1() == Body_Tank)
+
+        DetonatorContact(aBodyA, aBodyB);
+    }
+
+    void Game::DetonatorContact(Physics::Body* aBodyA, Physics::Body* aBodyB)
+    {
+        if (aBodyA->GetObject1() == Body_Tank && aBodyB->GetObject1() == Body_Green)
         {
-            if (aBodyA == m_BlueTank->GetPhysicsBody() || aBodyB == m_BlueTank->GetPhysicsBody())
+            if ((Tank*)aBodyA->GetUserData() == m_BlueTank)
             {
                 m_GreenTank->DestroyTank();
                 m_Winner->SetColor(Color::BlueColor());
                 m_Winner->SetText("BLUE WINS!");
                 m_Winner->SetPosition(Vector2(GetScreenHeight() / 2, GetScreenWidth() / 2));
-                for (int i = 0; i < BarrelCount; i++)
-                {
-                    if (aBodyA == m_Barrel[i]->GetPhysicsBody() || aBodyB == m_Barrel[i]->GetPhysicsBody())
-                    {
-                        m_Barrel[i]->RemoveDetonator();
-                    }
-                }
+                ((Barrel*)aBodyB->GetUserData())->RemoveDetonator();
             }
         }
 
-        if ((aBodyA->GetObject1() == Body_Tank && aBodyB->GetObject1() == Body_Blue) ||
-            aBodyA->GetObject1() == Body_Blue && aBodyB->GetObject1() == Body_Tank)
+        if (aBodyA->GetObject1() == Body_Tank && aBodyB->GetObject1() == Body_Blue)
         {
-            if (aBodyA == m_GreenTank->GetPhysicsBody() || aBodyB == m_GreenTank->GetPhysicsBody())
+            if ((Tank*)aBodyA->GetUserData() == m_GreenTank)
             {
                 m_Winner->SetColor(Color::GreenColor());
                 m_Winner->SetText("GREEN WINS!");
                 m_Winner->SetPosition(Vector2(GetScreenHeight() / 2, GetScreenWidth() / 2));
                 m_BlueTank->DestroyTank();
-                for (int i = 0; i < BarrelCount; i++)
-                {
-                    if (aBodyA == m_Barrel[i]->GetPhysicsBody() || aBodyB == m_Barrel[i]->GetPhysicsBody())
-                    {
-                        m_Barrel[i]->RemoveDetonator();
-                    }
-                }
+                ((Barrel*)aBodyB->GetUserData())->RemoveDetonator();
             }
         }
-        return true;
     }
+
     unsigned int Game::RandomRange(unsigned int min, unsigned int max)
     {
         unsigned int output = min + (rand() % (max - min + 1));
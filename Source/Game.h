@@ -45,8 +45,14 @@ namespace GameDev2D
         //Private methods
         void UpdateTank(Tank* tank, double delta);
 
-        //Collision callback, called whenever collision occurs
-        bool CollisionCallBack(Physics::Body* bodyA, Physics::Body* bodyB);
+        //Contact callback, called once when two bodies start touching
+        void BeginContact(Physics::Body* bodyA, Physics::Body* bodyB);
+
+        //Contact callback, called every step after the first that two bodies are still touching
+        void PersistContact(Physics::Body* bodyA, Physics::Body* bodyB);
+
+        //Handles a tank touching a detonator barrel, the bodies are ordered by type
+        void DetonatorContact(Physics::Body* bodyA, Physics::Body* bodyB);
 
         //Member variable should go here
         Tank* m_BlueTank;
@@ -67,5 +73,6 @@ namespace GameDev2D
         int m_GreenCount;
 
         Sprite* m_Background;
+        StaticLayer* m_BackgroundLayer;
 	};
 }
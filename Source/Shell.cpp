@@ -28,12 +28,16 @@ namespace GameDev2D
 		m_PhysicsBody = Physics::World::GetInstance()->CreateBody(collider, density);
 		m_PhysicsBody->SetLinearDamping(Vector2(0.2f, 0.2));
 		m_PhysicsBody->SetAngularDamping(1.0f);
+        m_PhysicsBody->SetUserData(this);
         m_PhysicsBody->SetObject(Body_Shell);
+        m_PhysicsBody->GetCollider()->SetCategoryBits(COLLISION_CATEGORY_SHELL);
+        m_PhysicsBody->GetCollider()->SetMaskBits(COLLISION_CATEGORY_TANK | COLLISION_CATEGORY_BARREL);
 	}
 
 	Shell::~Shell()
 	{
 		m_Sprite = nullptr;
+		Physics::World::GetInstance()->DestroyBody(m_PhysicsBody);
 		m_PhysicsBody = nullptr;
 	}
 
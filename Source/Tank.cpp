@@ -78,14 +78,17 @@ namespace GameDev2D
 		m_PhysicsBody->SetInertia(47.6998405f);
 		m_PhysicsBody->SetLinearDamping(Vector2(1.5f, 1.5f));
 		m_PhysicsBody->SetAngularDamping(1.5f);
+		m_PhysicsBody->SetUserData(this);
 		m_PhysicsBody->SetObject(Body_Tank);
+		m_PhysicsBody->GetCollider()->SetCategoryBits(COLLISION_CATEGORY_TANK);
 	}
 
 	Tank::~Tank()
 	{
         delete m_Turret;
 		delete m_Body;
-        delete m_PhysicsBody;
+        Physics::World::GetInstance()->DestroyBody(m_PhysicsBody);
+        m_PhysicsBody = nullptr;
         delete m_Shell;
 	}
 
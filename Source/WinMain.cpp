@@ -17,8 +17,8 @@ GameDev2D::Game* game = nullptr;
 //Entry point to the application
 int WINAPI WinMain(HINSTANCE aCurrentInstance, HINSTANCE aPreviousInstance, LPSTR aCommandLine, int aCommandShow)
 {
-    //Run GameDev2D, pass in the Init, Shutdown, Update and Draw methods
-    GameDev2D::Run(Init, Shutdown, Update, Draw);
+    //Run GameDev2D, pass in the Init, Shutdown, Update and Draw methods and the GraphicsBackend requested on the command line
+    GameDev2D::Run(Init, Shutdown, Update, Draw, GameDev2D::GetGraphicsBackend(aCommandLine));
     return 0;
 }
 
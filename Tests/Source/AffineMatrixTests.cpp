@@ -0,0 +1,115 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include <math.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const float AFFINE_MATRIX_TEST_EPSILON = 0.001f;
+const unsigned int AFFINE_MATRIX_TEST_MAX_COUNT = 9;     //Odd and even counts, the odd ones leave a vector for the scalar loop
+
+//A translation, angle and scale to build both matrices from
+struct AffineMatrixTestTransform
+{
+    Vector2 translation;
+    float angle;
+    Vector2 scale;
+};
+
+//Translation only, rotation only, and rotation with a uniform, non-uniform and mirrored scale
+const AffineMatrixTestTransform AFFINE_MATRIX_TEST_TRANSFORMS[] =
+{
+    { Vector2(12.0f, -7.0f), 0.0f, Vector2(1.0f, 1.0f) },
+    { Vector2(0.0f, 0.0f), 90.0f, Vector2(1.0f, 1.0f) },
+    { Vector2(-30.0f, 45.0f), 30.0f, Vector2(2.0f, 2.0f) },
+    { Vector2(100.0f, 250.0f), 135.0f, Vector2(3.0f, 0.5f) },
+    { Vector2(5.0f, 5.0f), -60.0f, Vector2(-1.5f, 2.5f) },
+};
+
+//Returns true if the vectors are the same, within the epsilon
+static bool IsSameVector(Vector2 aA, Vector2 aB)
+{
+    return fabsf(aA.x - aB.x) < AFFINE_MATRIX_TEST_EPSILON && fabsf(aA.y - aB.y) < AFFINE_MATRIX_TEST_EPSILON;
+}
+
+//Returns true if the AffineMatrix holds the same 2D transformation as the 4x4 Matrix
+static bool IsSameMatrix(const AffineMatrix& aAffineMatrix, const Matrix& aMatrix)
+{
+    return IsSameVector(Vector2(aAffineMatrix.m[0][0], aAffineMatrix.m[0][1]), Vector2(aMatrix.m[0][0], aMatrix.m[0][1])) &&
+           IsSameVector(Vector2(aAffineMatrix.m[1][0], aAffineMatrix.m[1][1]), Vector2(aMatrix.m[1][0], aMatrix.m[1][1])) &&
+           IsSameVector(Vector2(aAffineMatrix.m[2][0], aAffineMatrix.m[2][1]), Vector2(aMatrix.m[3][0], aMatrix.m[3][1]));
+}
+
+//Returns the vectors to transform, they aren't on the axes so the rotation and scale both show up
+static std::vector<Vector2> GetAffineMatrixTestVectors(unsigned int aCount)
+{
+    std::vector<Vector2> vectors;
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        vectors.push_back(Vector2((float)i * 3.0f - 10.0f, 4.0f - (float)i * 1.5f));
+    }
+    return vectors;
+}
+
+void TestAffineMatrixTransform()
+{
+    for (unsigned int i = 0; i < sizeof(AFFINE_MATRIX_TEST_TRANSFORMS) / sizeof(AFFINE_MATRIX_TEST_TRANSFORMS[0]); i++)
+    {
+        const AffineMatrixTestTransform& transform = AFFINE_MATRIX_TEST_TRANSFORMS[i];
+        AffineMatrix affineMatrix = AffineMatrix::Make(transform.translation, transform.angle, transform.scale);
+        Matrix matrix = Matrix::Make(transform.translation, transform.angle, transform.scale);
+        TEST_CHECK(IsSameMatrix(affineMatrix, matrix) == true);
+
+        //Every count up to the maximum, the SSE loop does two at a time and the scalar loop does the last odd one
+        for (unsigned int count = 1; count <= AFFINE_MATRIX_TEST_MAX_COUNT; count++)
+        {
+            std::vector<Vector2> source = GetAffineMatrixTestVectors(count);
+            std::vector<Vector2> destination(count, Vector2(0.0f, 0.0f));
+            affineMatrix.Transform(source.data(), destination.data(), count);
+
+            //The arrays can be the same
+            std::vector<Vector2> inPlace = source;
+            affineMatrix.Transform(inPlace.data(), inPlace.data(), count);
+
+            bool isCorrect = true;
+            for (unsigned int j = 0; j < count; j++)
+            {
+                Vector2 expected = matrix * source[j];
+                isCorrect = isCorrect && IsSameVector(destination[j], expected) == true && IsSameVector(inPlace[j], expected) == true;
+                isCorrect = isCorrect && IsSameVector(affineMatrix * source[j], expected) == true;
+            }
+            TEST_CHECK(isCorrect == true);
+        }
+    }
+}
+
+void TestAffineMatrixInverse()
+{
+    for (unsigned int i = 0; i < sizeof(AFFINE_MATRIX_TEST_TRANSFORMS) / sizeof(AFFINE_MATRIX_TEST_TRANSFORMS[0]); i++)
+    {
+        const AffineMatrixTestTransform& transform = AFFINE_MATRIX_TEST_TRANSFORMS[i];
+        AffineMatrix affineMatrix = AffineMatrix::Make(transform.translation, transform.angle, transform.scale);
+        Matrix matrix = Matrix::Make(transform.translation, transform.angle, transform.scale);
+
+        //The inverse matches the 4x4 Matrix's inverse
+        AffineMatrix inverse = affineMatrix.GetInverse();
+        TEST_CHECK(IsSameMatrix(inverse, matrix.GetInverse()) == true);
+
+        //It undoes the transformation, both ways round
+        std::vector<Vector2> vectors = GetAffineMatrixTestVectors(AFFINE_MATRIX_TEST_MAX_COUNT);
+        bool isCorrect = true;
+        for (unsigned int j = 0; j < vectors.size(); j++)
+        {
+            isCorrect = isCorrect && IsSameVector(inverse * (affineMatrix * vectors[j]), vectors[j]) == true;
+            isCorrect = isCorrect && IsSameVector((affineMatrix * inverse) * vectors[j], vectors[j]) == true;
+        }
+        TEST_CHECK(isCorrect == true);
+    }
+
+    //A matrix without an inverse returns a zero matrix, like the 4x4 Matrix
+    AffineMatrix singular = AffineMatrix::Make(Vector2(1.0f, 2.0f), 45.0f, Vector2(0.0f, 1.0f));
+    TEST_CHECK(IsSameMatrix(singular.GetInverse(), Matrix::Make(Vector2(1.0f, 2.0f), 45.0f, Vector2(0.0f, 1.0f)).GetInverse()) == true);
+    TEST_CHECK(IsSameVector(singular.GetInverse() * Vector2(3.0f, 4.0f), Vector2(0.0f, 0.0f)) == true);
+}
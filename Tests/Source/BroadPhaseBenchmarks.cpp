@@ -0,0 +1,84 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Physics/DynamicTree.h"
+#include "Physics/SpatialHash.h"
+#include <chrono>
+#include <math.h>
+#include <string>
+#include <vector>
+
+
+using namespace GameDev2D;
+using namespace GameDev2D::Physics;
+
+//Local constants
+const unsigned int BROAD_PHASE_BENCHMARK_STEPS = 100;
+const unsigned int BROAD_PHASE_BENCHMARK_BODY_COUNTS[] = { 1000, 4000, 16000 };
+const float BROAD_PHASE_BENCHMARK_BODY_SIZE = 1.0f;           //In meters
+const float BROAD_PHASE_BENCHMARK_AREA_PER_BODY = 16.0f;      //In square meters
+const float BROAD_PHASE_BENCHMARK_TIME_STEP = 1.0f / 60.0f;
+
+//Returns a pseudo random number between zero and one, the sequence is the same every run so the results can be compared
+static float GetBroadPhaseBenchmarkRandom(unsigned int* aSeed)
+{
+    *aSeed = *aSeed * 1664525u + 1013904223u;
+    return (float)(*aSeed >> 8) / (float)(1 << 24);
+}
+
+//Moves the bodies for the steps and computes their pairs each step, the way World::Step() uses its broadphase.
+//Reports the time per step and the number of pairs in the last step. The DynamicTree reports more pairs, its pairs
+//are the pairs of fat bounding boxes, the extra pairs are rejected by the narrowphase
+static void BenchmarkBroadPhase(const std::string& aName, BroadPhase* aBroadPhase, unsigned int aBodyCount)
+{
+    //Spread the bodies over a square world, each one moves at up to 10 meters per second
+    float worldSize = sqrtf(aBodyCount * BROAD_PHASE_BENCHMARK_AREA_PER_BODY);
+    Vector2 bodySize = Vector2(BROAD_PHASE_BENCHMARK_BODY_SIZE, BROAD_PHASE_BENCHMARK_BODY_SIZE);
+    std::vector<Vector2> positions;
+    std::vector<Vector2> velocities;
+    std::vector<int> proxyIds;
+    unsigned int seed = aBodyCount;
+    for (unsigned int i = 0; i < aBodyCount; i++)
+    {
+        positions.push_back(Vector2(GetBroadPhaseBenchmarkRandom(&seed) * worldSize, GetBroadPhaseBenchmarkRandom(&seed) * worldSize));
+        velocities.push_back(Vector2(GetBroadPhaseBenchmarkRandom(&seed) * 20.0f - 10.0f, GetBroadPhaseBenchmarkRandom(&seed) * 20.0f - 10.0f));
+        proxyIds.push_back(aBroadPhase->CreateProxy(AABB(positions.back(), positions.back() + bodySize), nullptr));
+    }
+
+    std::vector<ProxyPair> pairs;
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (unsigned int step = 0; step < BROAD_PHASE_BENCHMARK_STEPS; step++)
+    {
+        //Move the bodies, they wrap around the edges of the world
+        for (unsigned int i = 0; i < aBodyCount; i++)
+        {
+            Vector2 displacement = velocities[i] * BROAD_PHASE_BENCHMARK_TIME_STEP;
+            positions[i] += displacement;
+            positions[i].x = fmodf(positions[i].x + worldSize, worldSize);
+            positions[i].y = fmodf(positions[i].y + worldSize, worldSize);
+            aBroadPhase->MoveProxy(proxyIds[i], AABB(positions[i], positions[i] + bodySize), displacement);
+        }
+
+        aBroadPhase->ComputePairs(proxyIds, &pairs);
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+
+    std::string name = aName + ", " + std::to_string(aBodyCount) + " bodies";
+    Test::Report(name, duration.count() / BROAD_PHASE_BENCHMARK_STEPS, "ms/step");
+    Test::Report(name + " pairs", (double)pairs.size(), "");
+}
+
+void BenchmarkBroadPhases()
+{
+    for (unsigned int i = 0; i < sizeof(BROAD_PHASE_BENCHMARK_BODY_COUNTS) / sizeof(BROAD_PHASE_BENCHMARK_BODY_COUNTS[0]); i++)
+    {
+        unsigned int bodyCount = BROAD_PHASE_BENCHMARK_BODY_COUNTS[i];
+
+        //The spatial hash also reports its cell count, it stays bounded by the bodies, not the ground they've covered
+        SpatialHash spatialHash(SPATIAL_HASH_DEFAULT_CELL_SIZE);
+        BenchmarkBroadPhase("SpatialHash", &spatialHash, bodyCount);
+        Test::Report("SpatialHash, " + std::to_string(bodyCount) + " bodies cells", (double)spatialHash.GetCellCount(), "");
+
+        DynamicTree dynamicTree(DYNAMIC_TREE_AABB_MARGIN);
+        BenchmarkBroadPhase("DynamicTree", &dynamicTree, bodyCount);
+    }
+}
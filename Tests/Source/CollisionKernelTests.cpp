@@ -0,0 +1,114 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Physics/CollisionKernels.h"
+#include <math.h>
+
+
+using namespace GameDev2D;
+using namespace GameDev2D::Physics;
+
+//Local constants
+const float COLLISION_KERNEL_TEST_EPSILON = 0.001f;
+const float COLLISION_KERNEL_TEST_ANGLE = 30.0f;      //In degrees, counter-clockwise. Not a multiple of 90, so rotating the wrong way round gives a different box
+const float COLLISION_KERNEL_TEST_RADIUS = 0.5f;
+const float COLLISION_KERNEL_TEST_BOX_WIDTH = 2.0f;
+const float COLLISION_KERNEL_TEST_BOX_HEIGHT = 1.0f;
+
+//Rotates a vector counter-clockwise, worked out here rather than with the ColliderTransform so the test pins its convention
+static Vector2 RotateCollisionKernelTestVector(Vector2 aVector, float aDegrees)
+{
+    float c = cosf(Math::DegreesToRadians(aDegrees));
+    float s = sinf(Math::DegreesToRadians(aDegrees));
+    return Vector2(c * aVector.x - s * aVector.y, s * aVector.x + c * aVector.y);
+}
+
+//Creates a body and caches its collider's transform, the way the World does at the start of a step
+static Body* CreateCollisionKernelTestBody(Collider* aCollider, Vector2 aPosition, float aDegrees)
+{
+    Body* body = World::GetInstance()->CreateBody(aCollider, 1.0f);
+    body->SetPosition(aPosition);
+    body->SetAngle(Math::DegreesToRadians(aDegrees));
+    aCollider->UpdateTransform(aPosition, Math::DegreesToRadians(aDegrees));
+    return body;
+}
+
+//Runs the kernel for the bodies' collider types, returns true if they're touching with the expected normal and overlap
+static bool IsCollisionKernelContact(Body* aBodyA, Body* aBodyB, Vector2 aNormal, float aOverlap)
+{
+    CollisionKernel kernel = GetCollisionKernel(aBodyA->GetCollider()->GetType(), aBodyB->GetCollider()->GetType());
+    Manifold manifold(aBodyA, aBodyB);
+    if (kernel == nullptr || kernel(aBodyA, aBodyB, &manifold) == false)
+    {
+        return false;
+    }
+
+    Vector2 normal = manifold.GetNormal();
+    return fabsf(normal.x - aNormal.x) < COLLISION_KERNEL_TEST_EPSILON && fabsf(normal.y - aNormal.y) < COLLISION_KERNEL_TEST_EPSILON &&
+           fabsf(manifold.GetOverlap() - aOverlap) < COLLISION_KERNEL_TEST_EPSILON;
+}
+
+void TestCollisionKernelCircleBox()
+{
+    World* world = World::GetInstance();
+    Vector2 boxPosition = Vector2(3.0f, -2.0f);
+    Body* box = CreateCollisionKernelTestBody(new BoxCollider(COLLISION_KERNEL_TEST_BOX_WIDTH, COLLISION_KERNEL_TEST_BOX_HEIGHT), boxPosition, COLLISION_KERNEL_TEST_ANGLE);
+
+    //A circle just above the rotated box's top face, the normal is the face's normal, pointing from the circle into the box
+    float depth = 0.2f;
+    Vector2 up = RotateCollisionKernelTestVector(Vector2(0.0f, 1.0f), COLLISION_KERNEL_TEST_ANGLE);
+    Vector2 position = boxPosition + up * (COLLISION_KERNEL_TEST_BOX_HEIGHT * 0.5f + COLLISION_KERNEL_TEST_RADIUS - depth);
+    Body* circle = CreateCollisionKernelTestBody(new CircleCollider(COLLISION_KERNEL_TEST_RADIUS), position, 0.0f);
+    TEST_CHECK(IsCollisionKernelContact(circle, box, up * -1.0f, depth) == true);
+
+    //The other way round the normal is flipped, it still points from body A to body B
+    TEST_CHECK(IsCollisionKernelContact(box, circle, up, depth) == true);
+    world->DestroyBody(circle);
+
+    //A circle off the box's top right corner, the normal points from the circle's center at the corner
+    Vector2 corner = boxPosition + RotateCollisionKernelTestVector(Vector2(COLLISION_KERNEL_TEST_BOX_WIDTH * 0.5f, COLLISION_KERNEL_TEST_BOX_HEIGHT * 0.5f), COLLISION_KERNEL_TEST_ANGLE);
+    Vector2 diagonal = RotateCollisionKernelTestVector(Math::Normalize(Vector2(1.0f, 1.0f)), COLLISION_KERNEL_TEST_ANGLE);
+    position = corner + diagonal * (COLLISION_KERNEL_TEST_RADIUS - depth);
+    circle = CreateCollisionKernelTestBody(new CircleCollider(COLLISION_KERNEL_TEST_RADIUS), position, 0.0f);
+    TEST_CHECK(IsCollisionKernelContact(circle, box, diagonal * -1.0f, depth) == true);
+    world->DestroyBody(circle);
+
+    //A small circle that would be inside the box's right end if the box was rotated the other way round
+    Vector2 mirrored = RotateCollisionKernelTestVector(Vector2(0.0f, 1.0f), -COLLISION_KERNEL_TEST_ANGLE);
+    position = boxPosition + RotateCollisionKernelTestVector(Vector2(COLLISION_KERNEL_TEST_BOX_WIDTH * 0.5f, 0.0f), -COLLISION_KERNEL_TEST_ANGLE) + mirrored * 0.45f;
+    circle = CreateCollisionKernelTestBody(new CircleCollider(COLLISION_KERNEL_TEST_RADIUS * 0.25f), position, 0.0f);
+    TEST_CHECK(IsCollisionKernelContact(circle, box, Vector2(0.0f, 0.0f), 0.0f) == false);
+    world->DestroyBody(circle);
+
+    world->DestroyBody(box);
+}
+
+void TestCollisionKernelBoxBox()
+{
+    World* world = World::GetInstance();
+
+    //A small box resting on the rotated box's top face, its corners are pushed into the face
+    float depth = 0.1f;
+    float size = 0.4f;
+    Vector2 boxPosition = Vector2(-1.0f, 4.0f);
+    Body* boxA = CreateCollisionKernelTestBody(new BoxCollider(COLLISION_KERNEL_TEST_BOX_WIDTH, COLLISION_KERNEL_TEST_BOX_HEIGHT), boxPosition, COLLISION_KERNEL_TEST_ANGLE);
+    Vector2 up = RotateCollisionKernelTestVector(Vector2(0.0f, 1.0f), COLLISION_KERNEL_TEST_ANGLE);
+    Body* boxB = CreateCollisionKernelTestBody(new BoxCollider(size, size), boxPosition + up * (COLLISION_KERNEL_TEST_BOX_HEIGHT * 0.5f + size * 0.5f - depth), COLLISION_KERNEL_TEST_ANGLE);
+    TEST_CHECK(IsCollisionKernelContact(boxA, boxB, up, depth) == true);
+    TEST_CHECK(IsCollisionKernelContact(boxB, boxA, up * -1.0f, depth) == true);
+    world->DestroyBody(boxB);
+
+    //A box rotated 45 degrees whose corner pokes into the side of an axis aligned box, box A's face is the axis of least penetration
+    world->DestroyBody(boxA);
+    float halfDiagonal = sqrtf(2.0f) * 0.5f;
+    boxA = CreateCollisionKernelTestBody(new BoxCollider(2.0f, 2.0f), boxPosition, 0.0f);
+    boxB = CreateCollisionKernelTestBody(new BoxCollider(size, size), boxPosition + Vector2(1.0f + size * halfDiagonal - depth, 0.0f), 45.0f);
+    TEST_CHECK(IsCollisionKernelContact(boxA, boxB, Vector2(1.0f, 0.0f), depth) == true);
+
+    //Separated along box A's face normal, the rotated corner doesn't reach it
+    world->DestroyBody(boxB);
+    boxB = CreateCollisionKernelTestBody(new BoxCollider(size, size), boxPosition + Vector2(1.0f + size * halfDiagonal + depth, 0.0f), 45.0f);
+    TEST_CHECK(IsCollisionKernelContact(boxA, boxB, Vector2(0.0f, 0.0f), 0.0f) == false);
+
+    world->DestroyBody(boxA);
+    world->DestroyBody(boxB);
+}
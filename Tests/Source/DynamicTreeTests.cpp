@@ -0,0 +1,164 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Physics/DynamicTree.h"
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+using namespace GameDev2D::Physics;
+
+//Local constants
+const unsigned int DYNAMIC_TREE_TEST_PROXY_COUNT = 200;
+const unsigned int DYNAMIC_TREE_TEST_STEPS = 100;
+const float DYNAMIC_TREE_TEST_SIZE = 0.8f;
+const float DYNAMIC_TREE_TEST_WORLD_SIZE = 30.0f;
+
+//Returns a small bounding box at a position
+static AABB GetDynamicTreeTestAABB(Vector2 aPosition)
+{
+    return AABB(aPosition, aPosition + Vector2(DYNAMIC_TREE_TEST_SIZE, DYNAMIC_TREE_TEST_SIZE));
+}
+
+//Returns true if the proxy is in the vector
+static bool IsQueried(const std::vector<int>& aProxies, int aProxyId)
+{
+    return std::find(aProxies.begin(), aProxies.end(), aProxyId) != aProxies.end();
+}
+
+void TestDynamicTreeProxies()
+{
+    DynamicTree dynamicTree;
+    int userData = 0;
+
+    //Insert: the proxy's fat bounding box holds its bounding box, and the proxy can be found there
+    Vector2 position = Vector2(1.0f, 1.0f);
+    int proxyId = dynamicTree.CreateProxy(GetDynamicTreeTestAABB(position), &userData);
+    TEST_CHECK(dynamicTree.GetProxyCount() == 1 && dynamicTree.GetHeight() == 0);
+    TEST_CHECK(dynamicTree.GetUserData(proxyId) == &userData);
+    TEST_CHECK(dynamicTree.GetAABB(proxyId).Contains(GetDynamicTreeTestAABB(position)) == true);
+
+    std::vector<int> proxies;
+    dynamicTree.Query(GetDynamicTreeTestAABB(position), &proxies);
+    TEST_CHECK(proxies.size() == 1 && proxies.front() == proxyId);
+
+    //Move: a move that stays inside the fat bounding box doesn't touch the tree
+    AABB fatAABB = dynamicTree.GetAABB(proxyId);
+    Vector2 displacement = Vector2(DYNAMIC_TREE_AABB_MARGIN * 0.5f, 0.0f);
+    position += displacement;
+    dynamicTree.MoveProxy(proxyId, GetDynamicTreeTestAABB(position), displacement);
+    TEST_CHECK(dynamicTree.GetAABB(proxyId).lowerBound == fatAABB.lowerBound && dynamicTree.GetAABB(proxyId).upperBound == fatAABB.upperBound);
+
+    //A move that leaves it re-inserts the proxy, it's found where it is now and not where it was
+    Vector2 oldPosition = position;
+    displacement = Vector2(10.0f, 5.0f);
+    position += displacement;
+    dynamicTree.MoveProxy(proxyId, GetDynamicTreeTestAABB(position), displacement);
+    TEST_CHECK(dynamicTree.GetAABB(proxyId).Contains(GetDynamicTreeTestAABB(position)) == true);
+    dynamicTree.Query(GetDynamicTreeTestAABB(position), &proxies);
+    TEST_CHECK(proxies.size() == 1 && proxies.front() == proxyId);
+    dynamicTree.Query(GetDynamicTreeTestAABB(oldPosition), &proxies);
+    TEST_CHECK(proxies.size() == 0);
+
+    //Remove: the proxy can't be found and its id is reused by the next proxy
+    int otherId = dynamicTree.CreateProxy(GetDynamicTreeTestAABB(oldPosition), nullptr);
+    TEST_CHECK(dynamicTree.GetProxyCount() == 2 && dynamicTree.GetHeight() == 1);
+    dynamicTree.DestroyProxy(proxyId);
+    TEST_CHECK(dynamicTree.GetProxyCount() == 1 && dynamicTree.GetHeight() == 0);
+    dynamicTree.Query(GetDynamicTreeTestAABB(position), &proxies);
+    TEST_CHECK(proxies.size() == 0);
+    dynamicTree.Query(GetDynamicTreeTestAABB(oldPosition), &proxies);
+    TEST_CHECK(proxies.size() == 1 && proxies.front() == otherId);
+    TEST_CHECK(dynamicTree.CreateProxy(GetDynamicTreeTestAABB(position), nullptr) == proxyId);
+}
+
+void TestDynamicTreeQuery()
+{
+    DynamicTree dynamicTree;
+
+    //Create the proxies, they are spread over the world and move in different directions
+    std::vector<Vector2> positions;
+    std::vector<Vector2> displacements;
+    std::vector<int> proxyIds;
+    for (unsigned int i = 0; i < DYNAMIC_TREE_TEST_PROXY_COUNT; i++)
+    {
+        positions.push_back(Vector2(fmodf(i * 7.31f, DYNAMIC_TREE_TEST_WORLD_SIZE), fmodf(i * 3.17f, DYNAMIC_TREE_TEST_WORLD_SIZE)));
+        displacements.push_back(Vector2((float)((int)(i % 7) - 3) * 0.11f, (float)((int)(i % 5) - 2) * 0.13f));
+        proxyIds.push_back(dynamicTree.CreateProxy(GetDynamicTreeTestAABB(positions.back()), nullptr));
+    }
+
+    //The tree stays balanced, a leaf is never much deeper than log2 of the proxy count
+    TEST_CHECK(dynamicTree.GetHeight() <= 2 * (int)ceilf(log2f((float)DYNAMIC_TREE_TEST_PROXY_COUNT)));
+
+    std::vector<int> proxies;
+    std::vector<int> expectedProxies;
+    std::vector<ProxyPair> pairs;
+    std::vector<ProxyPair> expectedPairs;
+    for (unsigned int step = 0; step < DYNAMIC_TREE_TEST_STEPS; step++)
+    {
+        //Move the proxies, they wrap around the edges of the world
+        for (unsigned int i = 0; i < proxyIds.size(); i++)
+        {
+            positions[i] += displacements[i];
+            positions[i].x = fmodf(positions[i].x + DYNAMIC_TREE_TEST_WORLD_SIZE, DYNAMIC_TREE_TEST_WORLD_SIZE);
+            positions[i].y = fmodf(positions[i].y + DYNAMIC_TREE_TEST_WORLD_SIZE, DYNAMIC_TREE_TEST_WORLD_SIZE);
+            dynamicTree.MoveProxy(proxyIds[i], GetDynamicTreeTestAABB(positions[i]), displacements[i]);
+        }
+
+        //Query a region that moves across the world, the tree must find every fat bounding box it overlaps, found the slow way
+        Vector2 corner = Vector2(fmodf(step * 0.7f, DYNAMIC_TREE_TEST_WORLD_SIZE), fmodf(step * 0.3f, DYNAMIC_TREE_TEST_WORLD_SIZE));
+        AABB region = AABB(corner, corner + Vector2(5.0f, 5.0f));
+        expectedProxies.clear();
+        bool isMissing = false;
+        for (unsigned int i = 0; i < proxyIds.size(); i++)
+        {
+            if (dynamicTree.GetAABB(proxyIds[i]).Overlaps(region) == true)
+            {
+                expectedProxies.push_back(proxyIds[i]);
+            }
+            isMissing = isMissing || dynamicTree.GetAABB(proxyIds[i]).Contains(GetDynamicTreeTestAABB(positions[i])) == false;
+        }
+        dynamicTree.Query(region, &proxies);
+        std::sort(proxies.begin(), proxies.end());
+        if (TEST_CHECK(isMissing == false && proxies == expectedProxies) == false)
+        {
+            break;
+        }
+
+        //Every pair of overlapping fat bounding boxes, found the slow way
+        expectedPairs.clear();
+        for (unsigned int i = 0; i < proxyIds.size(); i++)
+        {
+            for (unsigned int j = i + 1; j < proxyIds.size(); j++)
+            {
+                if (dynamicTree.GetAABB(proxyIds[i]).Overlaps(dynamicTree.GetAABB(proxyIds[j])) == true)
+                {
+                    expectedPairs.push_back(ProxyPair(std::min<int>(proxyIds[i], proxyIds[j]), std::max<int>(proxyIds[i], proxyIds[j])));
+                }
+            }
+        }
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+
+        //The tree must find the same pairs, each one once
+        dynamicTree.ComputePairs(proxyIds, &pairs);
+        bool isSame = pairs.size() == expectedPairs.size();
+        for (unsigned int i = 0; i < pairs.size() && isSame == true; i++)
+        {
+            isSame = pairs[i].proxyA == expectedPairs[i].proxyA && pairs[i].proxyB == expectedPairs[i].proxyB;
+        }
+        if (TEST_CHECK(isSame == true) == false)
+        {
+            break;
+        }
+    }
+
+    //Removing every proxy empties the tree
+    for (unsigned int i = 0; i < proxyIds.size(); i++)
+    {
+        dynamicTree.DestroyProxy(proxyIds[i]);
+    }
+    TEST_CHECK(dynamicTree.GetProxyCount() == 0);
+    dynamicTree.Query(AABB(Vector2(0.0f, 0.0f), Vector2(DYNAMIC_TREE_TEST_WORLD_SIZE, DYNAMIC_TREE_TEST_WORLD_SIZE)), &proxies);
+    TEST_CHECK(proxies.size() == 0);
+}
@@ -0,0 +1,166 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/FontLayoutCache.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <math.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const float FONT_LAYOUT_TEST_EPSILON = 0.001f;
+const unsigned int FONT_LAYOUT_TEST_SMALL_FONT_SIZE = 16;
+
+//Returns true if each vertex in the second array is the vertex in the first array moved by the offset
+static bool IsTranslated(const std::vector<SpriteVertex>& aVertices, const std::vector<SpriteVertex>& aTranslated, Vector2 aOffset)
+{
+    if (aVertices.size() == 0 || aVertices.size() != aTranslated.size())
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < aVertices.size(); i++)
+    {
+        if (fabsf(aTranslated[i].x - aVertices[i].x - aOffset.x) > FONT_LAYOUT_TEST_EPSILON || fabsf(aTranslated[i].y - aVertices[i].y - aOffset.y) > FONT_LAYOUT_TEST_EPSILON)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Draws the Label, ends the frame and returns the sprite vertices that were uploaded
+static std::vector<SpriteVertex> DrawLabelFrame(Label* aLabel)
+{
+    GraphicsCommandList* commandList = Services::GetGraphics()->GetCommandList();
+    commandList->Clear();
+    aLabel->Draw();
+    Services::GetGraphics()->EndFrame();
+
+    std::vector<SpriteVertex> vertices;
+    for (unsigned int i = 0; i < commandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = commandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_UpdateDataBuffer && command.dataSize > 0)
+        {
+            const SpriteVertex* data = (const SpriteVertex*)commandList->GetData(command);
+            vertices.insert(vertices.end(), data, data + command.dataSize / sizeof(SpriteVertex));
+        }
+    }
+    commandList->Clear();
+    return vertices;
+}
+
+void TestFontLayoutCache()
+{
+    Font* font = Services::GetResourceManager()->GetDefaultFont();
+    if (TEST_CHECK(font != nullptr) == false)
+    {
+        return;
+    }
+
+    //The first time the text is drawn it's laid out, the next time it's a hit
+    FontLayoutCache cache;
+    std::vector<SpriteVertex> vertices = cache.GetVertices(font, "Score", Vector2(10.0f, 20.0f), Color::WhiteColor());
+    TEST_CHECK(vertices.size() == 5 * SPRITE_BATCH_VERTICES_PER_SPRITE);
+    TEST_CHECK(cache.GetMissCount() == 1 && cache.GetHitCount() == 0);
+    cache.GetVertices(font, "Score", Vector2(10.0f, 20.0f), Color::WhiteColor());
+    TEST_CHECK(cache.GetMissCount() == 1 && cache.GetHitCount() == 1);
+
+    //A new position is still a hit, the cached quads are re-translated
+    const std::vector<SpriteVertex>& moved = cache.GetVertices(font, "Score", Vector2(15.0f, 12.0f), Color::WhiteColor());
+    TEST_CHECK(cache.GetMissCount() == 1 && cache.GetHitCount() == 2);
+    TEST_CHECK(IsTranslated(vertices, moved, Vector2(5.0f, -8.0f)) == true);
+
+    //The text and the color are part of the key, a different one is a miss
+    cache.GetVertices(font, "Lives", Vector2(10.0f, 20.0f), Color::WhiteColor());
+    cache.GetVertices(font, "Score", Vector2(10.0f, 20.0f), Color::RedColor());
+    TEST_CHECK(cache.GetMissCount() == 3 && cache.GetHitCount() == 2);
+    TEST_CHECK(cache.GetCount() == 3);
+
+    //EndFrame() keeps the entries used this frame
+    cache.EndFrame();
+    TEST_CHECK(cache.GetCount() == 3);
+
+    //Only one of them is used the next frame, the others are dropped
+    cache.GetVertices(font, "Score", Vector2(10.0f, 20.0f), Color::WhiteColor());
+    cache.EndFrame();
+    TEST_CHECK(cache.GetCount() == 1);
+
+    //A frame without any text drops the last one, drawing it again lays it out again
+    cache.EndFrame();
+    TEST_CHECK(cache.GetCount() == 0);
+    cache.GetVertices(font, "Score", Vector2(10.0f, 20.0f), Color::WhiteColor());
+    TEST_CHECK(cache.GetMissCount() == 4 && cache.GetHitCount() == 3);
+}
+
+void TestLabelLayout()
+{
+    Graphics* graphics = Services::GetGraphics();
+    GraphicsCommandList* commandList = graphics->GetCommandList();
+    Font* font = Services::GetResourceManager()->GetDefaultFont();
+    Services::GetResourceManager()->LoadFont("OpenSans-CondBold", "ttf", FONT_LAYOUT_TEST_SMALL_FONT_SIZE);
+    Font* smallFont = Services::GetResourceManager()->GetFont("OpenSans-CondBold", "ttf", FONT_LAYOUT_TEST_SMALL_FONT_SIZE);
+    if (TEST_CHECK(commandList != nullptr && font != nullptr && smallFont != nullptr && smallFont != font) == false)
+    {
+        return;
+    }
+
+    //The layout is built the first time the Label is drawn, drawing it again doesn't rebuild it
+    Label label(font);
+    label.SetText("Score");
+    label.SetPosition(Vector2(100.0f, 100.0f));
+    std::vector<SpriteVertex> vertices = DrawLabelFrame(&label);
+    TEST_CHECK(vertices.size() == 5 * SPRITE_BATCH_VERTICES_PER_SPRITE);
+    TEST_CHECK(label.GetLayoutVersion() == 1);
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 1);
+
+    //Moving the Label re-translates the quads without rebuilding them
+    label.SetPosition(Vector2(130.0f, 90.0f));
+    TEST_CHECK(IsTranslated(vertices, DrawLabelFrame(&label), Vector2(30.0f, -10.0f)) == true);
+    TEST_CHECK(label.GetLayoutVersion() == 1);
+
+    //Setting the same values again doesn't rebuild the layout
+    label.SetText("Score");
+    label.SetFont(font);
+    label.SetCharacterSpacing(0.0f);
+    label.SetJustification(Label::JustifyLeft);
+    label.SetAnchor(label.GetAnchor());
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 1);
+
+    //Each of these changes rebuilds the layout once
+    label.SetText("Lives");
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 2);
+
+    label.SetFont(smallFont);
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 3);
+
+    label.SetCharacterSpacing(2.0f);
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 4);
+
+    label.SetJustification(Label::JustifyRight);
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 5);
+
+    label.SetAnchor(Vector2(0.5f, 0.5f));
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 6);
+    DrawLabelFrame(&label);
+    TEST_CHECK(label.GetLayoutVersion() == 6);
+
+    //The Label goes through the frame's SpriteBatch, a Sprite drawn before it shares its draw call
+    Sprite sprite(Services::GetResourceManager()->GetDefaultTexture());
+    sprite.SetPosition(Vector2(200.0f, 200.0f));
+    commandList->Clear();
+    sprite.Draw();
+    label.Draw();
+    graphics->EndFrame();
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawElements) == 1);
+    commandList->Clear();
+}
@@ -0,0 +1,195 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/PrimitiveBatch.h"
+#include "Graphics/SpriteBatch.h"
+#include "Graphics/VertexFormat.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const unsigned int HEADLESS_TEST_SPRITE_COUNT = 64;
+const unsigned int HEADLESS_TEST_BAR_COUNT = 16;
+
+//Draws the sprites and ends the frame, the sprites are laid out in a grid in the middle of the screen
+static void DrawSpriteFrame(std::vector<Sprite*>& aSprites)
+{
+    for (unsigned int i = 0; i < aSprites.size(); i++)
+    {
+        aSprites[i]->SetPosition(Vector2(100.0f + (float)(i % 8) * 64.0f, 100.0f + (float)(i / 8) * 64.0f));
+        aSprites[i]->Draw();
+    }
+    Services::GetGraphics()->EndFrame();
+}
+
+void TestHeadlessBackend()
+{
+    //The Application was created with the headless backend, the Graphics service must be recording its commands
+    Graphics* graphics = Services::GetGraphics();
+    TEST_CHECK(graphics->GetBackend() == GraphicsBackend_Headless);
+    TEST_CHECK(graphics->GetCommandList() != nullptr);
+
+    //The default shaders are loaded through the command list
+    TEST_CHECK(Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY) != nullptr);
+    TEST_CHECK(Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY) != nullptr);
+}
+
+void TestHeadlessSpriteFrame()
+{
+    Graphics* graphics = Services::GetGraphics();
+    GraphicsCommandList* commandList = graphics->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    //Create the sprites, they all share the default (RGBA) texture
+    Texture* texture = Services::GetResourceManager()->GetDefaultTexture();
+    std::vector<Sprite*> sprites;
+    for (unsigned int i = 0; i < HEADLESS_TEST_SPRITE_COUNT; i++)
+    {
+        sprites.push_back(new Sprite(texture));
+    }
+
+    //Draw a frame first, so the frame's SpriteBatch and its buffers are created
+    DrawSpriteFrame(sprites);
+    commandList->Clear();
+
+    //Draw the frame that is checked
+    DrawSpriteFrame(sprites);
+
+    //The sprites share a texture, they are drawn with a single draw call
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawElements) == 1);
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawArrays) == 0);
+
+    //Only the sprites' vertices are uploaded, four 20 byte vertices per sprite
+    TEST_CHECK(commandList->GetUploadedBytes() == HEADLESS_TEST_SPRITE_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex));
+
+    //The texture has an alpha channel, blending is enabled for the draw call and disabled after it
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_EnableBlending) == 1);
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DisableBlending) == 1);
+
+    //Check the draw call itself, two triangles (six indices) per sprite
+    for (unsigned int i = 0; i < commandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = commandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_DrawElements)
+        {
+            TEST_CHECK(command.arguments[0] == RenderMode_Triangles);
+            TEST_CHECK(command.arguments[1] == (int)(HEADLESS_TEST_SPRITE_COUNT * 6));
+            TEST_CHECK(command.arguments[2] == GraphicType_UnsignedShort);
+        }
+    }
+
+    //Delete the sprites
+    for (unsigned int i = 0; i < sprites.size(); i++)
+    {
+        delete sprites[i];
+    }
+    commandList->Clear();
+}
+
+void TestHeadlessDrawOrder()
+{
+    Graphics* graphics = Services::GetGraphics();
+    GraphicsCommandList* commandList = graphics->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    //Draw a sprite, a rectangle over it and a sprite over the rectangle
+    Sprite sprite(Services::GetResourceManager()->GetDefaultTexture());
+    sprite.SetPosition(Vector2(200.0f, 200.0f));
+    commandList->Clear();
+    sprite.Draw();
+    graphics->DrawRectangle(Vector2(200.0f, 200.0f), Vector2(64.0f, 64.0f), 0.0f, Vector2(0.0f, 0.0f), Color::RedColor(), true);
+    sprite.Draw();
+    graphics->EndFrame();
+
+    //The batches flush each other, so the draw calls are recorded in the order they were submitted
+    std::vector<GraphicsCommandType> draws;
+    for (unsigned int i = 0; i < commandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = commandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_DrawElements || command.type == GraphicsCommandType_DrawArrays)
+        {
+            draws.push_back(command.type);
+        }
+    }
+
+    if (TEST_CHECK(draws.size() == 3) == true)
+    {
+        TEST_CHECK(draws[0] == GraphicsCommandType_DrawElements);
+        TEST_CHECK(draws[1] == GraphicsCommandType_DrawArrays);
+        TEST_CHECK(draws[2] == GraphicsCommandType_DrawElements);
+    }
+    commandList->Clear();
+}
+
+void TestHeadlessPrimitiveFrame()
+{
+    Graphics* graphics = Services::GetGraphics();
+    GraphicsCommandList* commandList = graphics->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    //Draw a frame first, so the frame's PrimitiveBatch and its buffer are created
+    graphics->DrawRectangle(Vector2(0.0f, 0.0f), Vector2(8.0f, 8.0f), 0.0f, Vector2(0.0f, 0.0f), Color::RedColor(), true);
+    graphics->EndFrame();
+    commandList->Clear();
+
+    //Draw health bars the way the HUD does, a filled bar followed by its outline
+    Color fillColor = Color::GreenColor();
+    Color outlineColor = Color::WhiteColor();
+    for (unsigned int i = 0; i < HEADLESS_TEST_BAR_COUNT; i++)
+    {
+        Vector2 position = Vector2(20.0f, 20.0f + (float)i * 12.0f);
+        graphics->DrawRectangle(position, Vector2(100.0f, 8.0f), 0.0f, Vector2(0.0f, 0.0f), fillColor, true);
+        graphics->DrawRectangle(position, Vector2(100.0f, 8.0f), 0.0f, Vector2(0.0f, 0.0f), outlineColor, false);
+    }
+    graphics->EndFrame();
+
+    //The fills and outlines share one triangle stream, so the whole frame is a single draw call
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawArrays) == 1);
+
+    //A filled rectangle is 6 vertices and an outline is 4 lines of 6 vertices
+    const unsigned int verticesPerBar = 6 + 4 * PRIMITIVE_BATCH_LINE_VERTICES;
+    TEST_CHECK(commandList->GetUploadedBytes() == HEADLESS_TEST_BAR_COUNT * verticesPerBar * sizeof(PrimitiveVertex));
+
+    //Gather the uploaded vertices, the fills and outlines must be in the order they were drawn
+    std::vector<PrimitiveVertex> vertices;
+    for (unsigned int i = 0; i < commandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = commandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_DrawArrays)
+        {
+            TEST_CHECK(command.arguments[0] == RenderMode_Triangles);
+            TEST_CHECK(command.arguments[2] == (int)(HEADLESS_TEST_BAR_COUNT * verticesPerBar));
+        }
+        else if (command.type == GraphicsCommandType_UpdateDataBuffer && command.dataSize > 0)
+        {
+            const PrimitiveVertex* data = (const PrimitiveVertex*)commandList->GetData(command);
+            vertices.insert(vertices.end(), data, data + command.dataSize / sizeof(PrimitiveVertex));
+        }
+    }
+
+    if (TEST_CHECK(vertices.size() == HEADLESS_TEST_BAR_COUNT * verticesPerBar) == true)
+    {
+        unsigned int fill = PackColor(fillColor);
+        unsigned int outline = PackColor(outlineColor);
+        for (unsigned int i = 0; i < vertices.size(); i++)
+        {
+            bool isFill = (i % verticesPerBar) < 6;
+            if (TEST_CHECK(vertices[i].color == (isFill == true ? fill : outline)) == false)
+            {
+                break;
+            }
+        }
+    }
+    commandList->Clear();
+}
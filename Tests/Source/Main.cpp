@@ -0,0 +1,91 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include <string.h>
+
+
+//Test function prototypes
+void TestHeadlessBackend();
+void TestHeadlessSpriteFrame();
+void TestHeadlessDrawOrder();
+void TestHeadlessPrimitiveFrame();
+void TestSpriteInstanceSize();
+void TestSpriteInstancePacking();
+void TestSpatialHashCells();
+void TestSpatialHashPairs();
+void TestDynamicTreeProxies();
+void TestDynamicTreeQuery();
+void TestWorldContactDestroy();
+void TestCollisionKernelCircleBox();
+void TestCollisionKernelBoxBox();
+void TestTransformableHierarchy();
+void TestSpriteBatchTextureSlots();
+void TestSpriteBatchSortOrder();
+void TestVertexDataRingBuffer();
+void TestAffineMatrixTransform();
+void TestAffineMatrixInverse();
+void TestFontLayoutCache();
+void TestLabelLayout();
+void TestStaticLayerTextureSlots();
+void TestStaticLayerDirtySprite();
+
+//Benchmark function prototypes
+void BenchmarkSpriteEmission();
+void BenchmarkSpriteBatchModes();
+void BenchmarkSpriteVertexFormats();
+void BenchmarkPrimitiveVertexFormats();
+void BenchmarkBroadPhases();
+void BenchmarkWorldStep();
+
+//Entry point to the tests
+int main(int aArgumentCount, char* aArguments[])
+{
+    //Create a headless Application, it loads the default services without a visible window OR a GPU
+    GameDev2D::Application application(WINDOW_TITLE, TARGET_FPS, WINDOW_WIDTH, WINDOW_HEIGHT, false, GameDev2D::GraphicsBackend_Headless);
+    application.Init([]() {}, []() {}, [](double) {}, []() {});
+
+    //Run the tests
+    unsigned int failed = 0;
+    failed += GameDev2D::Test::Run("Headless backend", TestHeadlessBackend) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("Headless sprite frame", TestHeadlessSpriteFrame) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("Headless draw order", TestHeadlessDrawOrder) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("Headless primitive frame", TestHeadlessPrimitiveFrame) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("SpriteInstance size", TestSpriteInstanceSize) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("SpriteInstance packing", TestSpriteInstancePacking) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("SpatialHash cells", TestSpatialHashCells) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("SpatialHash pairs", TestSpatialHashPairs) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("DynamicTree proxies", TestDynamicTreeProxies) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("DynamicTree query", TestDynamicTreeQuery) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("World contact destroy", TestWorldContactDestroy) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("CollisionKernel circle box", TestCollisionKernelCircleBox) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("CollisionKernel box box", TestCollisionKernelBoxBox) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("Transformable hierarchy", TestTransformableHierarchy) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("SpriteBatch texture slots", TestSpriteBatchTextureSlots) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("SpriteBatch sort order", TestSpriteBatchSortOrder) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("VertexData ring buffer", TestVertexDataRingBuffer) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("AffineMatrix transform", TestAffineMatrixTransform) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("AffineMatrix inverse", TestAffineMatrixInverse) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("FontLayoutCache", TestFontLayoutCache) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("Label layout", TestLabelLayout) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("StaticLayer texture slots", TestStaticLayerTextureSlots) == false ? 1 : 0;
+    failed += GameDev2D::Test::Run("StaticLayer dirty sprite", TestStaticLayerDirtySprite) == false ? 1 : 0;
+
+    printf("%u test(s) failed\n", failed);
+
+    //Run the benchmarks, only when they are asked for with the -benchmark argument, they are CPU side measurements
+    //made with the headless backend, nothing reaches a GPU
+    for (int i = 1; i < aArgumentCount; i++)
+    {
+        if (strcmp(aArguments[i], "-benchmark") == 0)
+        {
+            GameDev2D::Test::Benchmark("Sprite vertex emission", BenchmarkSpriteEmission);
+            GameDev2D::Test::Benchmark("SpriteBatch modes", BenchmarkSpriteBatchModes);
+            GameDev2D::Test::Benchmark("Sprite vertex formats", BenchmarkSpriteVertexFormats);
+            GameDev2D::Test::Benchmark("Primitive vertex formats", BenchmarkPrimitiveVertexFormats);
+            GameDev2D::Test::Benchmark("Broadphases", BenchmarkBroadPhases);
+            GameDev2D::Test::Benchmark("World step", BenchmarkWorldStep);
+            break;
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}
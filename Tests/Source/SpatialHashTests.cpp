@@ -0,0 +1,115 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Physics/SpatialHash.h"
+#include <algorithm>
+#include <math.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+using namespace GameDev2D::Physics;
+
+//Local constants
+const unsigned int SPATIAL_HASH_TEST_PROXY_COUNT = 200;
+const unsigned int SPATIAL_HASH_TEST_STEPS = 100;
+const float SPATIAL_HASH_TEST_CELL_SIZE = 1.0f;
+const float SPATIAL_HASH_TEST_WORLD_SIZE = 30.0f;
+
+//Returns a bounding box the size of a cell at a position, it never straddles more than a 2x2 block of cells
+static AABB GetSpatialHashTestAABB(Vector2 aPosition)
+{
+    return AABB(aPosition, aPosition + Vector2(SPATIAL_HASH_TEST_CELL_SIZE * 0.8f, SPATIAL_HASH_TEST_CELL_SIZE * 0.8f));
+}
+
+void TestSpatialHashCells()
+{
+    SpatialHash spatialHash(SPATIAL_HASH_TEST_CELL_SIZE);
+
+    //Move a proxy a long way across the grid, the cells it leaves behind must be erased
+    Vector2 position = Vector2(0.1f, 0.1f);
+    Vector2 displacement = Vector2(0.3f, 0.2f);
+    int proxyId = spatialHash.CreateProxy(GetSpatialHashTestAABB(position), nullptr);
+    for (unsigned int i = 0; i < SPATIAL_HASH_TEST_STEPS * 10; i++)
+    {
+        position += displacement;
+        spatialHash.MoveProxy(proxyId, GetSpatialHashTestAABB(position), displacement);
+
+        //The proxy never touches more than a 2x2 block of cells
+        if (TEST_CHECK(spatialHash.GetCellCount() <= 4) == false)
+        {
+            break;
+        }
+    }
+
+    //The proxy can still be found where it ended up
+    std::vector<int> proxies;
+    spatialHash.Query(GetSpatialHashTestAABB(position), &proxies);
+    TEST_CHECK(proxies.size() == 1 && proxies.front() == proxyId);
+
+    //Destroying the last proxy leaves no cells behind
+    spatialHash.DestroyProxy(proxyId);
+    TEST_CHECK(spatialHash.GetCellCount() == 0);
+}
+
+void TestSpatialHashPairs()
+{
+    SpatialHash spatialHash(SPATIAL_HASH_TEST_CELL_SIZE);
+
+    //Create the proxies, they are spread over the world and move in different directions
+    std::vector<Vector2> positions;
+    std::vector<Vector2> displacements;
+    std::vector<int> proxyIds;
+    for (unsigned int i = 0; i < SPATIAL_HASH_TEST_PROXY_COUNT; i++)
+    {
+        positions.push_back(Vector2(fmodf(i * 7.31f, SPATIAL_HASH_TEST_WORLD_SIZE), fmodf(i * 3.17f, SPATIAL_HASH_TEST_WORLD_SIZE)));
+        displacements.push_back(Vector2((float)((int)(i % 7) - 3) * 0.11f, (float)((int)(i % 5) - 2) * 0.13f));
+        proxyIds.push_back(spatialHash.CreateProxy(GetSpatialHashTestAABB(positions.back()), nullptr));
+    }
+
+    std::vector<ProxyPair> pairs;
+    std::vector<ProxyPair> expectedPairs;
+    for (unsigned int step = 0; step < SPATIAL_HASH_TEST_STEPS; step++)
+    {
+        //Move the proxies, they wrap around the edges of the world
+        for (unsigned int i = 0; i < proxyIds.size(); i++)
+        {
+            positions[i] += displacements[i];
+            positions[i].x = fmodf(positions[i].x + SPATIAL_HASH_TEST_WORLD_SIZE, SPATIAL_HASH_TEST_WORLD_SIZE);
+            positions[i].y = fmodf(positions[i].y + SPATIAL_HASH_TEST_WORLD_SIZE, SPATIAL_HASH_TEST_WORLD_SIZE);
+            spatialHash.MoveProxy(proxyIds[i], GetSpatialHashTestAABB(positions[i]), displacements[i]);
+        }
+
+        //Every overlapping pair, found the slow way
+        expectedPairs.clear();
+        for (unsigned int i = 0; i < proxyIds.size(); i++)
+        {
+            for (unsigned int j = i + 1; j < proxyIds.size(); j++)
+            {
+                if (GetSpatialHashTestAABB(positions[i]).Overlaps(GetSpatialHashTestAABB(positions[j])) == true)
+                {
+                    expectedPairs.push_back(ProxyPair(std::min<int>(proxyIds[i], proxyIds[j]), std::max<int>(proxyIds[i], proxyIds[j])));
+                }
+            }
+        }
+        std::sort(expectedPairs.begin(), expectedPairs.end());
+
+        //The spatial hash must find the same pairs, each one once
+        spatialHash.ComputePairs(proxyIds, &pairs);
+        bool isSame = pairs.size() == expectedPairs.size();
+        for (unsigned int i = 0; i < pairs.size() && isSame == true; i++)
+        {
+            isSame = pairs[i].proxyA == expectedPairs[i].proxyA && pairs[i].proxyB == expectedPairs[i].proxyB;
+        }
+        if (TEST_CHECK(isSame == true) == false)
+        {
+            break;
+        }
+    }
+
+    //Destroying every proxy leaves no cells behind
+    for (unsigned int i = 0; i < proxyIds.size(); i++)
+    {
+        spatialHash.DestroyProxy(proxyIds[i]);
+    }
+    TEST_CHECK(spatialHash.GetCellCount() == 0);
+}
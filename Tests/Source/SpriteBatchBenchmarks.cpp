@@ -0,0 +1,153 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/SpriteBatch.h"
+#include "Graphics/VertexData.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <chrono>
+#include <string.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const unsigned int SPRITE_BENCHMARK_SPRITE_COUNT = 100000;
+const unsigned int SPRITE_BENCHMARK_ITERATIONS = 5;
+const unsigned int SPRITE_BENCHMARK_TEXTURE_COUNT = 12;     //More textures than the SpriteBatch has texture slots
+const unsigned int SPRITE_BENCHMARK_TEXTURE_SIZE = 64;
+
+//Returns the transformation of a sprite, the sprites are spread over the screen at different angles
+static AffineMatrix GetBenchmarkTransformation(unsigned int aIndex)
+{
+    return AffineMatrix::Make(Vector2((float)(aIndex % WINDOW_WIDTH), (float)(aIndex % WINDOW_HEIGHT)), (float)(aIndex % 360));
+}
+
+//Returns the number of milliseconds since the start time
+static double GetElapsedMilliseconds(std::chrono::high_resolution_clock::time_point aStart)
+{
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - aStart;
+    return duration.count();
+}
+
+void BenchmarkSpriteEmission()
+{
+    //Create a vertex buffer the size of the SpriteBatch's, nothing is drawn from it, it's cleared
+    //whenever it's full, the way the SpriteBatch clears it after a flush
+    VertexBufferDescriptor descriptor;
+    descriptor.size = sizeof(SpriteVertex) / sizeof(float);
+    descriptor.capacity = SPRITE_BATCH_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE;
+    descriptor.usage = BufferUsage_DynamicDraw;
+    descriptor.attributeIndex = { 0, 1, 2, 3 };
+    descriptor.attributeSize = { 2, 2, 4, 1 };
+    descriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedShort, GraphicType_UnsignedByte, GraphicType_UnsignedByte };
+
+    VertexData vertexData;
+    VertexBuffer* vertexBuffer = vertexData.CreateBuffer(descriptor);
+
+    Vector2 textureSize = Vector2((float)SPRITE_BENCHMARK_TEXTURE_SIZE, (float)SPRITE_BENCHMARK_TEXTURE_SIZE);
+    Rect sourceFrame = Rect(Vector2(0.0f, 0.0f), textureSize);
+    Color color = Color::WhiteColor();
+    Vector2 anchor = Vector2(0.5f, 0.5f);
+
+    //The vector path is the way SpriteBatch::Draw() used to add its vertices, one std::vector<float> per vertex,
+    //the emit path packs the vertices straight into the vertex buffer
+    double vectorTime = 0.0;
+    double emitTime = 0.0;
+    for (unsigned int iteration = 0; iteration < SPRITE_BENCHMARK_ITERATIONS; iteration++)
+    {
+        vertexBuffer->ClearVertices();
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        for (unsigned int i = 0; i < SPRITE_BENCHMARK_SPRITE_COUNT; i++)
+        {
+            if (vertexBuffer->GetCount() + SPRITE_BATCH_VERTICES_PER_SPRITE > vertexBuffer->GetCapacity())
+            {
+                vertexBuffer->ClearVertices();
+            }
+
+            SpriteVertex vertices[SPRITE_BATCH_VERTICES_PER_SPRITE];
+            PackSpriteVertices(vertices, textureSize, GetBenchmarkTransformation(i), color, anchor, sourceFrame);
+            for (unsigned int j = 0; j < SPRITE_BATCH_VERTICES_PER_SPRITE; j++)
+            {
+                std::vector<float> vertex(descriptor.size);
+                memcpy(vertex.data(), &vertices[j], sizeof(SpriteVertex));
+                vertexBuffer->AddVertex(vertex);
+            }
+        }
+        double time = GetElapsedMilliseconds(start);
+        vectorTime = iteration == 0 ? time : std::min<double>(vectorTime, time);
+
+        vertexBuffer->ClearVertices();
+        start = std::chrono::high_resolution_clock::now();
+        for (unsigned int i = 0; i < SPRITE_BENCHMARK_SPRITE_COUNT; i++)
+        {
+            if (vertexBuffer->GetCount() + SPRITE_BATCH_VERTICES_PER_SPRITE > vertexBuffer->GetCapacity())
+            {
+                vertexBuffer->ClearVertices();
+            }
+
+            SpriteVertex* vertices = vertexBuffer->Emit<SpriteVertex>(SPRITE_BATCH_VERTICES_PER_SPRITE);
+            PackSpriteVertices(vertices, textureSize, GetBenchmarkTransformation(i), color, anchor, sourceFrame);
+        }
+        time = GetElapsedMilliseconds(start);
+        emitTime = iteration == 0 ? time : std::min<double>(emitTime, time);
+    }
+
+    //Report the best iteration of each path
+    Test::Report("Vertex emission, std::vector per vertex", SPRITE_BENCHMARK_SPRITE_COUNT / vectorTime, "sprites/ms");
+    Test::Report("Vertex emission, Emit<SpriteVertex>()", SPRITE_BENCHMARK_SPRITE_COUNT / emitTime, "sprites/ms");
+}
+
+void BenchmarkSpriteBatchModes()
+{
+    GraphicsCommandList* commandList = Services::GetGraphics()->GetCommandList();
+
+    //Create the textures, they are opaque so blending never splits a batch
+    std::vector<unsigned char> pixels(SPRITE_BENCHMARK_TEXTURE_SIZE * SPRITE_BENCHMARK_TEXTURE_SIZE * 3, 255);
+    std::vector<Texture*> textures;
+    for (unsigned int i = 0; i < SPRITE_BENCHMARK_TEXTURE_COUNT; i++)
+    {
+        ImageData imageData = ImageData(PixelFormat(PixelFormat::RGB, PixelFormat::UnsignedByte), SPRITE_BENCHMARK_TEXTURE_SIZE, SPRITE_BENCHMARK_TEXTURE_SIZE, pixels.data());
+        textures.push_back(new Texture(imageData));
+    }
+
+    //The sprites cycle through the textures, the worst case for immediate mode, it runs out of texture slots
+    //every eight sprites. Deferred mode sorts them by texture. The time includes recording the headless commands
+    SpriteBatchMode modes[] = { SpriteBatchMode_Immediate, SpriteBatchMode_Deferred, SpriteBatchMode_Instanced };
+    const char* names[] = { "immediate", "deferred", "instanced" };
+    SpriteBatch spriteBatch;
+    for (unsigned int mode = 0; mode < 3; mode++)
+    {
+        double bestTime = 0.0;
+        unsigned int drawCalls = 0;
+        for (unsigned int iteration = 0; iteration < SPRITE_BENCHMARK_ITERATIONS; iteration++)
+        {
+            if (commandList != nullptr)
+            {
+                commandList->Clear();
+            }
+
+            spriteBatch.Begin(modes[mode]);
+            for (unsigned int i = 0; i < SPRITE_BENCHMARK_SPRITE_COUNT; i++)
+            {
+                spriteBatch.Draw(textures[i % SPRITE_BENCHMARK_TEXTURE_COUNT], GetBenchmarkTransformation(i));
+            }
+            spriteBatch.End();
+
+            bestTime = iteration == 0 ? spriteBatch.GetDrawTime() : std::min<double>(bestTime, spriteBatch.GetDrawTime());
+            drawCalls = spriteBatch.GetDrawCallCount();
+        }
+
+        Test::Report(std::string("SpriteBatch, ") + names[mode], spriteBatch.GetSpriteCount() / bestTime, "sprites/ms");
+        Test::Report(std::string("SpriteBatch, ") + names[mode] + " draw calls", drawCalls, "");
+    }
+
+    //Delete the textures
+    if (commandList != nullptr)
+    {
+        commandList->Clear();
+    }
+    for (unsigned int i = 0; i < textures.size(); i++)
+    {
+        delete textures[i];
+    }
+}
@@ -0,0 +1,266 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/SpriteBatch.h"
+#include "Graphics/SpriteInstance.h"
+#include "Graphics/VertexFormat.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <algorithm>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const unsigned int SPRITE_BATCH_TEST_TEXTURE_SIZE = 3;      //The uvs of a one texel source frame are thirds, they use all 16 bits
+const unsigned int SPRITE_BATCH_TEST_SPRITE_COUNT = SPRITE_BATCH_TEXTURE_SLOTS * 4;
+const unsigned int SPRITE_BATCH_SORT_TEST_SPRITE_COUNT = 60;
+const unsigned int SPRITE_BATCH_SORT_TEST_LAYERS = 3;
+const unsigned int SPRITE_BATCH_SORT_TEST_TEXTURES = 3;
+
+//A sprite drawn by the deferred sort test, its submission index is packed into its color so it can be found in the uploaded vertices
+struct SpriteBatchSortTestSprite
+{
+    unsigned int index;
+    unsigned short layer;
+    Texture* texture;
+    BlendingMode blendingMode;
+};
+
+//Creates opaque textures, one per texture slot
+static std::vector<Texture*> CreateSpriteBatchTestTextures(unsigned int aCount)
+{
+    std::vector<unsigned char> pixels(SPRITE_BATCH_TEST_TEXTURE_SIZE * SPRITE_BATCH_TEST_TEXTURE_SIZE * 3, 255);
+    std::vector<Texture*> textures;
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        ImageData imageData = ImageData(PixelFormat(PixelFormat::RGB, PixelFormat::UnsignedByte), SPRITE_BATCH_TEST_TEXTURE_SIZE, SPRITE_BATCH_TEST_TEXTURE_SIZE, pixels.data());
+        textures.push_back(new Texture(imageData));
+    }
+    return textures;
+}
+
+//Deletes the textures
+static void DeleteSpriteBatchTestTextures(std::vector<Texture*>& aTextures)
+{
+    for (unsigned int i = 0; i < aTextures.size(); i++)
+    {
+        delete aTextures[i];
+    }
+    aTextures.clear();
+}
+
+//Returns the bytes uploaded by the UpdateDataBuffer commands, in the order they were recorded
+static std::vector<unsigned char> GetUploadedData(GraphicsCommandList* aCommandList)
+{
+    std::vector<unsigned char> data;
+    for (unsigned int i = 0; i < aCommandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = aCommandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_UpdateDataBuffer && command.dataSize > 0)
+        {
+            const unsigned char* bytes = (const unsigned char*)aCommandList->GetData(command);
+            data.insert(data.end(), bytes, bytes + command.dataSize);
+        }
+    }
+    return data;
+}
+
+//Returns true if the attribute was pointed at the offset, with one unsigned byte component
+static bool IsTextureSlotAttribute(GraphicsCommandList* aCommandList, int aAttributeIndex, unsigned int aOffset)
+{
+    for (unsigned int i = 0; i < aCommandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = aCommandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_SetVertexAttribute && command.arguments[0] == aAttributeIndex)
+        {
+            const unsigned int* offsetAndDivisor = (const unsigned int*)aCommandList->GetData(command);
+            return command.arguments[1] == 1 && command.arguments[3] == GraphicType_UnsignedByte && offsetAndDivisor[0] == aOffset;
+        }
+    }
+    return false;
+}
+
+//Draws the sprites, each sprite samples one texel of the next texture, so they cycle through every texture slot
+static void DrawSpriteBatchTestSprites(SpriteBatch* aSpriteBatch, SpriteBatchMode aMode, std::vector<Texture*>& aTextures)
+{
+    aSpriteBatch->Begin(aMode);
+    for (unsigned int i = 0; i < SPRITE_BATCH_TEST_SPRITE_COUNT; i++)
+    {
+        Rect sourceFrame = Rect(Vector2((float)(i % SPRITE_BATCH_TEST_TEXTURE_SIZE), 1.0f), Vector2(1.0f, 1.0f));
+        aSpriteBatch->Draw(aTextures[i % aTextures.size()], AffineMatrix::Make(Vector2((float)i * 4.0f, 100.0f), 0.0f), Color::WhiteColor(), Vector2(0.0f, 0.0f), sourceFrame);
+    }
+    aSpriteBatch->End();
+}
+
+void TestSpriteBatchTextureSlots()
+{
+    GraphicsCommandList* commandList = Services::GetGraphics()->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    //The expected uvs of each sprite's one texel source frame, the full 16 bits are kept
+    const float textureSize = (float)SPRITE_BATCH_TEST_TEXTURE_SIZE;
+    std::vector<Texture*> textures = CreateSpriteBatchTestTextures(SPRITE_BATCH_TEXTURE_SLOTS);
+    SpriteBatch spriteBatch;
+
+    //Immediate mode: every texture fits in a slot, so the sprites are a single draw call and each vertex carries its slot
+    Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
+    commandList->Clear();
+    DrawSpriteBatchTestSprites(&spriteBatch, SpriteBatchMode_Immediate, textures);
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawElements) == 1);
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_BindTexture) == SPRITE_BATCH_TEXTURE_SLOTS);
+    TEST_CHECK(IsTextureSlotAttribute(commandList, shader->GetAttributeLocation("in_textureSlot"), 16) == true);
+
+    std::vector<unsigned char> data = GetUploadedData(commandList);
+    if (TEST_CHECK(data.size() == SPRITE_BATCH_TEST_SPRITE_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex)) == true)
+    {
+        const SpriteVertex* vertices = (const SpriteVertex*)data.data();
+        for (unsigned int i = 0; i < SPRITE_BATCH_TEST_SPRITE_COUNT; i++)
+        {
+            //The vertex order is top left, top right, bottom right, bottom left
+            float u1 = (float)(i % SPRITE_BATCH_TEST_TEXTURE_SIZE) / textureSize;
+            float u2 = (float)(i % SPRITE_BATCH_TEST_TEXTURE_SIZE + 1) / textureSize;
+            const SpriteVertex* sprite = &vertices[i * SPRITE_BATCH_VERTICES_PER_SPRITE];
+            bool isCorrect = sprite[0].u == PackUnsignedNormalized(u1) && sprite[1].u == PackUnsignedNormalized(u2) &&
+                             sprite[0].v == PackUnsignedNormalized(1.0f - 1.0f / textureSize) && sprite[2].v == PackUnsignedNormalized(1.0f - 2.0f / textureSize);
+            for (unsigned int j = 0; j < SPRITE_BATCH_VERTICES_PER_SPRITE; j++)
+            {
+                isCorrect = isCorrect && sprite[j].GetTextureSlot() == i % SPRITE_BATCH_TEXTURE_SLOTS;
+            }
+            if (TEST_CHECK(isCorrect == true) == false)
+            {
+                break;
+            }
+        }
+    }
+
+    //Instanced mode: the sprites share the texture slots too, switching textures no longer flushes. The
+    //textures are still bound from the first frame, the Graphics service doesn't bind them again
+    if (Services::GetGraphics()->IsInstancingSupported() == true)
+    {
+        Shader* instanceShader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEINSTANCED_SHADER_KEY);
+        DrawSpriteBatchTestSprites(&spriteBatch, SpriteBatchMode_Instanced, textures);
+        commandList->Clear();
+        DrawSpriteBatchTestSprites(&spriteBatch, SpriteBatchMode_Instanced, textures);
+        TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawElementsInstanced) == 1);
+        TEST_CHECK(spriteBatch.GetDrawCallCount() == 1);
+        TEST_CHECK(IsTextureSlotAttribute(commandList, instanceShader->GetAttributeLocation("in_textureSlot"), 44) == true);
+
+        data = GetUploadedData(commandList);
+        if (TEST_CHECK(data.size() == SPRITE_BATCH_TEST_SPRITE_COUNT * sizeof(SpriteInstance)) == true)
+        {
+            const SpriteInstance* instances = (const SpriteInstance*)data.data();
+            for (unsigned int i = 0; i < SPRITE_BATCH_TEST_SPRITE_COUNT; i++)
+            {
+                float u1 = (float)(i % SPRITE_BATCH_TEST_TEXTURE_SIZE) / textureSize;
+                bool isCorrect = instances[i].textureSlot == i % SPRITE_BATCH_TEXTURE_SLOTS && instances[i].uvRect[0] == PackUnsignedNormalized(u1);
+                if (TEST_CHECK(isCorrect == true) == false)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    //One texture more than there are slots: the extra texture flushes, in both modes
+    std::vector<Texture*> moreTextures = CreateSpriteBatchTestTextures(SPRITE_BATCH_TEXTURE_SLOTS + 1);
+    DrawSpriteBatchTestSprites(&spriteBatch, SpriteBatchMode_Immediate, moreTextures);
+    TEST_CHECK(spriteBatch.GetDrawCallCount() > 1);
+    DrawSpriteBatchTestSprites(&spriteBatch, SpriteBatchMode_Instanced, moreTextures);
+    TEST_CHECK(spriteBatch.GetDrawCallCount() > 1);
+
+    commandList->Clear();
+    DeleteSpriteBatchTestTextures(moreTextures);
+    DeleteSpriteBatchTestTextures(textures);
+}
+
+//Returns true if the first sprite is drawn before the second one, by layer, then texture and blending mode, then submission
+//order. Every sprite in the SpriteBatch shares its Shader, so the shader part of the sort key is the same for all of them
+static bool IsSortedBefore(const SpriteBatchSortTestSprite& aA, const SpriteBatchSortTestSprite& aB)
+{
+    if (aA.layer != aB.layer)
+    {
+        return aA.layer < aB.layer;
+    }
+    if (aA.texture->GetId() != aB.texture->GetId())
+    {
+        return aA.texture->GetId() < aB.texture->GetId();
+    }
+    if (aA.blendingMode.source != aB.blendingMode.source)
+    {
+        return aA.blendingMode.source < aB.blendingMode.source;
+    }
+    return aA.blendingMode.destination < aB.blendingMode.destination;
+}
+
+void TestSpriteBatchSortOrder()
+{
+    GraphicsCommandList* commandList = Services::GetGraphics()->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    //Submit the sprites out of order, with few layers, textures and blending modes so there are plenty of equal keys
+    std::vector<Texture*> textures = CreateSpriteBatchTestTextures(SPRITE_BATCH_SORT_TEST_TEXTURES);
+    BlendingMode blendingModes[] = { BlendingMode(), BlendingMode(BlendingFactor_SourceAlpha, BlendingFactor_One) };
+    std::vector<SpriteBatchSortTestSprite> sprites;
+    unsigned int seed = 7;
+    for (unsigned int i = 0; i < SPRITE_BATCH_SORT_TEST_SPRITE_COUNT; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        SpriteBatchSortTestSprite sprite;
+        sprite.index = i;
+        sprite.layer = (unsigned short)((seed >> 8) % SPRITE_BATCH_SORT_TEST_LAYERS);
+        sprite.texture = textures[(seed >> 16) % SPRITE_BATCH_SORT_TEST_TEXTURES];
+        sprite.blendingMode = blendingModes[(seed >> 24) % 2];
+        sprites.push_back(sprite);
+    }
+
+    SpriteBatch spriteBatch;
+    commandList->Clear();
+    spriteBatch.Begin(SpriteBatchMode_Deferred);
+    for (unsigned int i = 0; i < sprites.size(); i++)
+    {
+        Color color = Color((float)i / 255.0f, 0.0f, 0.0f, 1.0f);
+        spriteBatch.SetLayer(sprites[i].layer);
+        spriteBatch.SetBlendingMode(sprites[i].blendingMode);
+        spriteBatch.Draw(sprites[i].texture, AffineMatrix::Make(Vector2((float)i, 100.0f), 0.0f), color, Vector2(0.0f, 0.0f));
+    }
+    spriteBatch.End();
+
+    //The expected order is a stable sort of the submission order, a draw call is made each time the blending mode changes
+    std::vector<SpriteBatchSortTestSprite> expected = sprites;
+    std::stable_sort(expected.begin(), expected.end(), IsSortedBefore);
+    unsigned int expectedDrawCalls = 1;
+    for (unsigned int i = 1; i < expected.size(); i++)
+    {
+        if (expected[i].blendingMode != expected[i - 1].blendingMode)
+        {
+            expectedDrawCalls++;
+        }
+    }
+    TEST_CHECK(spriteBatch.GetSpriteCount() == SPRITE_BATCH_SORT_TEST_SPRITE_COUNT);
+    TEST_CHECK(spriteBatch.GetDrawCallCount() == expectedDrawCalls);
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DrawElements) == expectedDrawCalls);
+
+    //Find each sprite in the uploaded vertices by its color, they must be in the expected order
+    std::vector<unsigned char> data = GetUploadedData(commandList);
+    if (TEST_CHECK(data.size() == SPRITE_BATCH_SORT_TEST_SPRITE_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex)) == true)
+    {
+        const SpriteVertex* vertices = (const SpriteVertex*)data.data();
+        for (unsigned int i = 0; i < expected.size(); i++)
+        {
+            unsigned int color = PackColor(Color((float)expected[i].index / 255.0f, 0.0f, 0.0f, 1.0f));
+            if (TEST_CHECK(vertices[i * SPRITE_BATCH_VERTICES_PER_SPRITE].color == color) == false)
+            {
+                break;
+            }
+        }
+    }
+
+    commandList->Clear();
+    DeleteSpriteBatchTestTextures(textures);
+}
@@ -0,0 +1,134 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/SpriteBatch.h"
+#include "Graphics/SpriteInstance.h"
+#include <math.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//The sprites packed by the tests, each one is position, angle, scale, anchor, source frame and color
+struct SpriteInstanceTestCase
+{
+    Vector2 position;
+    float angle;
+    Vector2 scale;
+    Vector2 anchor;
+    Rect sourceFrame;
+    Color color;
+};
+
+//Local constants
+const Vector2 SPRITE_INSTANCE_TEST_TEXTURE_SIZE = Vector2(256.0f, 128.0f);
+const float SPRITE_INSTANCE_TEST_UV_TOLERANCE = 0.5f / 65535.0f + 0.000001f;
+const float SPRITE_INSTANCE_TEST_POSITION_TOLERANCE = 0.001f;
+const float SPRITE_INSTANCE_TEST_ANGLE_TOLERANCE = 0.001f;
+
+//Returns the test cases, they cover the full texture, sub frames, rotations in every quadrant and anchors
+static std::vector<SpriteInstanceTestCase> GetSpriteInstanceTestCases()
+{
+    std::vector<SpriteInstanceTestCase> testCases;
+    testCases.push_back({ Vector2(0.0f, 0.0f), 0.0f, Vector2(1.0f, 1.0f), Vector2(0.0f, 0.0f), Rect(Vector2(0.0f, 0.0f), SPRITE_INSTANCE_TEST_TEXTURE_SIZE), Color::WhiteColor() });
+    testCases.push_back({ Vector2(512.0f, 384.0f), 45.0f, Vector2(1.0f, 1.0f), Vector2(0.5f, 0.5f), Rect(Vector2(32.0f, 16.0f), Vector2(64.0f, 48.0f)), Color(0.25f, 0.5f, 0.75f, 1.0f) });
+    testCases.push_back({ Vector2(-100.0f, 250.5f), 135.0f, Vector2(2.0f, 0.5f), Vector2(1.0f, 0.0f), Rect(Vector2(0.0f, 64.0f), Vector2(128.0f, 64.0f)), Color(1.0f, 0.0f, 0.0f, 0.5f) });
+    testCases.push_back({ Vector2(1000.25f, -20.0f), -100.0f, Vector2(3.0f, 3.0f), Vector2(0.25f, 0.75f), Rect(Vector2(255.0f, 127.0f), Vector2(1.0f, 1.0f)), Color(0.0f, 1.0f, 0.0f, 0.0f) });
+    testCases.push_back({ Vector2(64.0f, 64.0f), 270.0f, Vector2(0.25f, 4.0f), Vector2(0.0f, 1.0f), Rect(Vector2(100.0f, 0.0f), Vector2(156.0f, 128.0f)), Color(-0.5f, 1.5f, 0.333f, 0.999f) });
+    return testCases;
+}
+
+//Returns the normalized unsigned short as a float
+static float UnpackUnsignedNormalized(unsigned short aValue)
+{
+    return (float)aValue / 65535.0f;
+}
+
+//Returns the color component the way PackColor() rounds and clamps it
+static unsigned int ExpectedColorComponent(float aComponent)
+{
+    float clamped = aComponent < 0.0f ? 0.0f : (aComponent > 1.0f ? 1.0f : aComponent);
+    return (unsigned int)(clamped * 255.0f + 0.5f);
+}
+
+//Returns true if the two values are within the tolerance, it's relative for large values
+static bool IsClose(float aA, float aB, float aTolerance)
+{
+    float scale = fabsf(aB) > 1.0f ? fabsf(aB) : 1.0f;
+    return fabsf(aA - aB) <= aTolerance * scale;
+}
+
+void TestSpriteInstanceSize()
+{
+    //The instance buffer's stride and the instanced shader's attributes depend on this layout
+    TEST_CHECK(sizeof(SpriteInstance) == 48);
+    TEST_CHECK(sizeof(SpriteInstance) < SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex));
+}
+
+void TestSpriteInstancePacking()
+{
+    std::vector<SpriteInstanceTestCase> testCases = GetSpriteInstanceTestCases();
+    for (unsigned int i = 0; i < testCases.size(); i++)
+    {
+        const SpriteInstanceTestCase& testCase = testCases[i];
+        AffineMatrix transformation = AffineMatrix::Make(testCase.position, testCase.angle, testCase.scale);
+
+        SpriteInstance instance;
+        PackSpriteInstance(&instance, SPRITE_INSTANCE_TEST_TEXTURE_SIZE, transformation, testCase.color, testCase.anchor, testCase.sourceFrame, (unsigned char)i);
+
+        //Texture slot: stored as is, in its own byte
+        TEST_CHECK(instance.textureSlot == i);
+
+        //Position: the translation is stored as is, and the anchor point of the quad lands on it
+        TEST_CHECK(instance.transformX[2] == testCase.position.x);
+        TEST_CHECK(instance.transformY[2] == testCase.position.y);
+        TEST_CHECK(instance.anchor[0] == testCase.anchor.x);
+        TEST_CHECK(instance.anchor[1] == testCase.anchor.y);
+
+        //Rotation: the transform's first column points along the sprite's angle
+        float angle = Math::RadiansToDegrees(atan2f(instance.transformY[0], instance.transformX[0]));
+        float angleDifference = fmodf(angle - testCase.angle + 720.0f, 360.0f);
+        TEST_CHECK(angleDifference < SPRITE_INSTANCE_TEST_ANGLE_TOLERANCE || angleDifference > 360.0f - SPRITE_INSTANCE_TEST_ANGLE_TOLERANCE);
+
+        //Expected uvs, the same way the SpriteBatch builds them for its vertices
+        Vector2 size = testCase.sourceFrame.size;
+        float u1 = 0.0f;
+        float v1 = 0.0f;
+        float u2 = 1.0f;
+        float v2 = 1.0f;
+        if (SPRITE_INSTANCE_TEST_TEXTURE_SIZE != size)
+        {
+            u1 = testCase.sourceFrame.origin.x / SPRITE_INSTANCE_TEST_TEXTURE_SIZE.x;
+            v1 = 1.0f - ((testCase.sourceFrame.origin.y + size.y) / SPRITE_INSTANCE_TEST_TEXTURE_SIZE.y);
+            u2 = (testCase.sourceFrame.origin.x + size.x) / SPRITE_INSTANCE_TEST_TEXTURE_SIZE.x;
+            v2 = 1.0f - (testCase.sourceFrame.origin.y / SPRITE_INSTANCE_TEST_TEXTURE_SIZE.y);
+        }
+
+        //UV: the uv rect unpacks to the source frame's uvs
+        TEST_CHECK(fabsf(UnpackUnsignedNormalized(instance.uvRect[0]) - u1) <= SPRITE_INSTANCE_TEST_UV_TOLERANCE);
+        TEST_CHECK(fabsf(UnpackUnsignedNormalized(instance.uvRect[1]) - v1) <= SPRITE_INSTANCE_TEST_UV_TOLERANCE);
+        TEST_CHECK(fabsf(UnpackUnsignedNormalized(instance.uvRect[2]) - u2) <= SPRITE_INSTANCE_TEST_UV_TOLERANCE);
+        TEST_CHECK(fabsf(UnpackUnsignedNormalized(instance.uvRect[3]) - v2) <= SPRITE_INSTANCE_TEST_UV_TOLERANCE);
+
+        //Color: one byte per component, red first in memory, clamped and rounded
+        const unsigned char* color = (const unsigned char*)&instance.color;
+        TEST_CHECK(color[0] == ExpectedColorComponent(testCase.color.r));
+        TEST_CHECK(color[1] == ExpectedColorComponent(testCase.color.g));
+        TEST_CHECK(color[2] == ExpectedColorComponent(testCase.color.b));
+        TEST_CHECK(color[3] == ExpectedColorComponent(testCase.color.a));
+
+        //The quad: expand the unit quad the way the instanced vertex shader does, and compare each corner
+        //with the corner the SpriteBatch would build, transformation * (corner * size - anchor * size)
+        Vector2 corners[4] = { Vector2(0.0f, 0.0f), Vector2(1.0f, 0.0f), Vector2(0.0f, 1.0f), Vector2(1.0f, 1.0f) };
+        for (unsigned int j = 0; j < 4; j++)
+        {
+            float x = corners[j].x - instance.anchor[0];
+            float y = corners[j].y - instance.anchor[1];
+            Vector2 corner = Vector2(instance.transformX[0] * x + instance.transformX[1] * y + instance.transformX[2],
+                                     instance.transformY[0] * x + instance.transformY[1] * y + instance.transformY[2]);
+
+            Vector2 expected = transformation * Vector2((corners[j].x - testCase.anchor.x) * size.x, (corners[j].y - testCase.anchor.y) * size.y);
+            TEST_CHECK(IsClose(corner.x, expected.x, SPRITE_INSTANCE_TEST_POSITION_TOLERANCE));
+            TEST_CHECK(IsClose(corner.y, expected.y, SPRITE_INSTANCE_TEST_POSITION_TOLERANCE));
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/StaticLayer.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <math.h>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const unsigned int STATIC_LAYER_TEST_TEXTURE_SIZE = 16;
+const unsigned int STATIC_LAYER_TEST_SPRITE_COUNT = 8;
+const float STATIC_LAYER_TEST_BOUNDS_SIZE = 256.0f;
+
+//Creates opaque textures and a Sprite for each one, the Sprites are laid out in a row
+static void CreateStaticLayerTestSprites(unsigned int aCount, std::vector<Texture*>& aTextures, std::vector<Sprite*>& aSprites)
+{
+    std::vector<unsigned char> pixels(STATIC_LAYER_TEST_TEXTURE_SIZE * STATIC_LAYER_TEST_TEXTURE_SIZE * 3, 255);
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        ImageData imageData = ImageData(PixelFormat(PixelFormat::RGB, PixelFormat::UnsignedByte), STATIC_LAYER_TEST_TEXTURE_SIZE, STATIC_LAYER_TEST_TEXTURE_SIZE, pixels.data());
+        aTextures.push_back(new Texture(imageData));
+        aSprites.push_back(new Sprite(aTextures.back()));
+        aSprites.back()->SetPosition(Vector2((float)i * 32.0f + 8.0f, 8.0f));
+    }
+}
+
+//Deletes the Sprites and their textures
+static void DeleteStaticLayerTestSprites(std::vector<Texture*>& aTextures, std::vector<Sprite*>& aSprites)
+{
+    for (unsigned int i = 0; i < aSprites.size(); i++)
+    {
+        delete aSprites[i];
+        delete aTextures[i];
+    }
+    aSprites.clear();
+    aTextures.clear();
+}
+
+//Returns the UpdateDataBuffer commands' offset and size, there must be exactly one
+static bool GetSingleUpload(GraphicsCommandList* aCommandList, int* aOffset, unsigned int* aSize)
+{
+    unsigned int uploads = 0;
+    for (unsigned int i = 0; i < aCommandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = aCommandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_UpdateDataBuffer)
+        {
+            *aOffset = command.arguments[1];
+            *aSize = command.dataSize;
+            uploads++;
+        }
+    }
+    return uploads == 1;
+}
+
+//Returns the last scissor rect that was set, its arguments are x, y, width and height
+static bool GetLastScissor(GraphicsCommandList* aCommandList, int aScissor[4])
+{
+    bool isFound = false;
+    for (unsigned int i = 0; i < aCommandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = aCommandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_SetScissor)
+        {
+            for (unsigned int j = 0; j < 4; j++)
+            {
+                aScissor[j] = command.arguments[j];
+            }
+            isFound = true;
+        }
+    }
+    return isFound;
+}
+
+void TestStaticLayerTextureSlots()
+{
+    std::vector<Texture*> textures;
+    std::vector<Sprite*> sprites;
+    CreateStaticLayerTestSprites(SPRITE_BATCH_TEXTURE_SLOTS + 1, textures, sprites);
+
+    //Every slot is taken, a Sprite with another Texture doesn't fit
+    StaticLayer layer;
+    for (unsigned int i = 0; i < SPRITE_BATCH_TEXTURE_SLOTS; i++)
+    {
+        TEST_CHECK(layer.Add(sprites[i]) == true);
+    }
+    TEST_CHECK(layer.GetTextureCount() == SPRITE_BATCH_TEXTURE_SLOTS);
+    TEST_CHECK(layer.Add(sprites[SPRITE_BATCH_TEXTURE_SLOTS]) == false);
+
+    //A second Sprite sharing a Texture keeps its slot taken when the first one is removed
+    Sprite sharing(textures[0]);
+    TEST_CHECK(layer.Add(&sharing) == true);
+    layer.Remove(sprites[0]);
+    TEST_CHECK(layer.GetTextureCount() == SPRITE_BATCH_TEXTURE_SLOTS);
+    TEST_CHECK(layer.Add(sprites[SPRITE_BATCH_TEXTURE_SLOTS]) == false);
+
+    //Removing the last Sprite using the Texture frees its slot for another Texture
+    layer.Remove(&sharing);
+    TEST_CHECK(layer.GetTextureCount() == SPRITE_BATCH_TEXTURE_SLOTS - 1);
+    TEST_CHECK(layer.Add(sprites[SPRITE_BATCH_TEXTURE_SLOTS]) == true);
+    TEST_CHECK(layer.GetTextureCount() == SPRITE_BATCH_TEXTURE_SLOTS);
+
+    //Changing a Sprite's Texture moves it to the new Texture's slot when it's rebuilt, the old one is freed
+    sprites[1]->SetTexture(textures[0]);
+    layer.MarkDirty(sprites[1]);
+    layer.Draw();
+    Services::GetGraphics()->EndFrame();
+    TEST_CHECK(layer.GetTextureCount() == SPRITE_BATCH_TEXTURE_SLOTS);
+    TEST_CHECK(layer.Add(sprites[0]) == true);
+    TEST_CHECK(layer.GetTextureCount() == SPRITE_BATCH_TEXTURE_SLOTS);
+
+    layer.Clear();
+    TEST_CHECK(layer.GetTextureCount() == 0);
+    Services::GetGraphics()->GetCommandList()->Clear();
+    DeleteStaticLayerTestSprites(textures, sprites);
+}
+
+void TestStaticLayerDirtySprite()
+{
+    Graphics* graphics = Services::GetGraphics();
+    GraphicsCommandList* commandList = graphics->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    std::vector<Texture*> textures;
+    std::vector<Sprite*> sprites;
+    CreateStaticLayerTestSprites(STATIC_LAYER_TEST_SPRITE_COUNT, textures, sprites);
+    const unsigned int spriteBytes = SPRITE_BATCH_VERTICES_PER_SPRITE * sizeof(SpriteVertex);
+    const unsigned int dirtyIndex = 3;
+
+    //Vertex buffer mode: the first draw uploads every Sprite, after that only the dirty Sprite is uploaded, in place
+    StaticLayer layer;
+    for (unsigned int i = 0; i < sprites.size(); i++)
+    {
+        layer.Add(sprites[i]);
+    }
+    commandList->Clear();
+    layer.Draw();
+    TEST_CHECK(commandList->GetUploadedBytes() == STATIC_LAYER_TEST_SPRITE_COUNT * spriteBytes);
+
+    commandList->Clear();
+    layer.Draw();
+    TEST_CHECK(commandList->GetUploadedBytes() == 0);
+
+    sprites[dirtyIndex]->SetPosition(sprites[dirtyIndex]->GetPosition() + Vector2(4.0f, 10.0f));
+    layer.MarkDirty(sprites[dirtyIndex]);
+    commandList->Clear();
+    layer.Draw();
+    int offset = 0;
+    unsigned int size = 0;
+    TEST_CHECK(commandList->GetUploadedBytes() == spriteBytes);
+    TEST_CHECK(GetSingleUpload(commandList, &offset, &size) == true);
+    TEST_CHECK(offset == (int)(dirtyIndex * spriteBytes) && size == spriteBytes);
+    graphics->EndFrame();
+    layer.Clear();
+
+    //RenderTarget mode: only the region the dirty Sprite covered before and covers now is redrawn
+    Rect bounds = Rect(Vector2(0.0f, 0.0f), Vector2(STATIC_LAYER_TEST_BOUNDS_SIZE, STATIC_LAYER_TEST_BOUNDS_SIZE));
+    StaticLayer renderLayer(bounds);
+    for (unsigned int i = 0; i < sprites.size(); i++)
+    {
+        renderLayer.Add(sprites[i]);
+    }
+    renderLayer.Draw();
+    graphics->EndFrame();
+
+    Rect before = sprites[dirtyIndex]->GetWorldBounds();
+    sprites[dirtyIndex]->SetPosition(sprites[dirtyIndex]->GetPosition() + Vector2(4.5f, 10.0f));
+    Rect after = sprites[dirtyIndex]->GetWorldBounds();
+    renderLayer.MarkDirty(sprites[dirtyIndex]);
+    commandList->Clear();
+    renderLayer.Draw();
+
+    //The layer's vertices are uploaded before the RenderTarget's Sprite is added to the frame's SpriteBatch
+    TEST_CHECK(commandList->GetUploadedBytes() == spriteBytes);
+    TEST_CHECK(GetSingleUpload(commandList, &offset, &size) == true);
+    TEST_CHECK(offset == (int)(dirtyIndex * spriteBytes) && size == spriteBytes);
+
+    //The scissor is the union of both bounds, relative to the layer's bounds and rounded out to whole pixels
+    int scissor[4] = {};
+    float left = floorf(fminf(before.origin.x, after.origin.x) - bounds.origin.x);
+    float bottom = floorf(fminf(before.origin.y, after.origin.y) - bounds.origin.y);
+    float right = ceilf(fmaxf(before.origin.x + before.size.x, after.origin.x + after.size.x) - bounds.origin.x);
+    float top = ceilf(fmaxf(before.origin.y + before.size.y, after.origin.y + after.size.y) - bounds.origin.y);
+    if (TEST_CHECK(GetLastScissor(commandList, scissor) == true) == true)
+    {
+        TEST_CHECK(scissor[0] == (int)left && scissor[1] == (int)bottom);
+        TEST_CHECK(scissor[2] == (int)(right - left) && scissor[3] == (int)(top - bottom));
+    }
+    TEST_CHECK(commandList->GetCount(GraphicsCommandType_DisableScissor) == 1);
+
+    graphics->EndFrame();
+    renderLayer.Clear();
+    commandList->Clear();
+    DeleteStaticLayerTestSprites(textures, sprites);
+}
@@ -0,0 +1,44 @@
+#include "Test.h"
+#include <stdio.h>
+
+
+namespace GameDev2D
+{
+    namespace Test
+    {
+        //The number of failed checks in the test being run
+        static unsigned int s_FailedChecks = 0;
+
+        bool Run(const std::string& aName, std::function<void()> aTest)
+        {
+            //Reset the failed checks and run the test
+            s_FailedChecks = 0;
+            aTest();
+
+            //Print the result of the test
+            printf("[%s] %s\n", s_FailedChecks == 0 ? "PASSED" : "FAILED", aName.c_str());
+            return s_FailedChecks == 0;
+        }
+
+        bool Check(bool aCondition, const char* aExpression, const char* aFile, int aLine)
+        {
+            if (aCondition == false)
+            {
+                printf("    %s(%i): check failed: %s\n", aFile, aLine, aExpression);
+                s_FailedChecks++;
+            }
+            return aCondition;
+        }
+
+        void Benchmark(const std::string& aName, std::function<void()> aBenchmark)
+        {
+            printf("[BENCHMARK] %s\n", aName.c_str());
+            aBenchmark();
+        }
+
+        void Report(const std::string& aName, double aValue, const std::string& aUnits)
+        {
+            printf("    %-48s %12.2f %s\n", aName.c_str(), aValue, aUnits.c_str());
+        }
+    }
+}
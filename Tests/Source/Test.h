@@ -0,0 +1,34 @@
+#ifndef __GameDev2D__Test__
+#define __GameDev2D__Test__
+
+#include <functional>
+#include <string>
+
+
+//Checks a condition inside a test, a failed condition is printed along with its file and line
+#define TEST_CHECK(condition) GameDev2D::Test::Check((condition), #condition, __FILE__, __LINE__)
+
+
+namespace GameDev2D
+{
+    //The Test functions are used by the GameDev2DTests console application, each test is a function that
+    //checks its conditions with TEST_CHECK(). The tests run against a headless Application, it doesn't create a
+    //window and the Graphics service records its commands in a GraphicsCommandList instead of calling OpenGL.
+    //The project still builds the whole framework, so it's Windows only and links opengl32
+    namespace Test
+    {
+        //Runs a test and prints whether it passed, returns true if none of its checks failed
+        bool Run(const std::string& name, std::function<void()> test);
+
+        //Records the result of a check, returns the condition so a test can stop early if it fails
+        bool Check(bool condition, const char* expression, const char* file, int line);
+
+        //Runs a benchmark and prints its name, the benchmark prints its own results with Report()
+        void Benchmark(const std::string& name, std::function<void()> benchmark);
+
+        //Prints a benchmark result, the value is printed along with its units
+        void Report(const std::string& name, double value, const std::string& units);
+    }
+}
+
+#endif
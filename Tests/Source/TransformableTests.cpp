@@ -0,0 +1,75 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include <math.h>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const float TRANSFORMABLE_TEST_EPSILON = 0.001f;
+
+//Returns true if the world matrix moves the origin to the expected position
+static bool IsWorldPosition(Transformable* aTransformable, Vector2 aExpected)
+{
+    Vector2 position = aTransformable->GetTransformMatrix() * Vector2(0.0f, 0.0f);
+    return fabsf(position.x - aExpected.x) < TRANSFORMABLE_TEST_EPSILON && fabsf(position.y - aExpected.y) < TRANSFORMABLE_TEST_EPSILON;
+}
+
+void TestTransformableHierarchy()
+{
+    Transformable parent;
+    Transformable child;
+    Transformable grandchild;
+    Transformable sibling;
+    child.AttachTo(&parent);
+    grandchild.AttachTo(&child);
+    sibling.AttachTo(&parent);
+
+    parent.SetPosition(Vector2(100.0f, 0.0f));
+    child.SetPosition(Vector2(10.0f, 0.0f));
+    grandchild.SetPosition(Vector2(1.0f, 0.0f));
+    TEST_CHECK(IsWorldPosition(&grandchild, Vector2(111.0f, 0.0f)) == true);
+
+    //Nothing has changed, the matrices stay cached, their versions don't change
+    unsigned int parentVersion = parent.GetTransformVersion();
+    unsigned int childVersion = child.GetTransformVersion();
+    unsigned int grandchildVersion = grandchild.GetTransformVersion();
+    for (unsigned int i = 0; i < 10; i++)
+    {
+        grandchild.GetTransformMatrix();
+    }
+    TEST_CHECK(parent.GetTransformVersion() == parentVersion);
+    TEST_CHECK(child.GetTransformVersion() == childVersion);
+    TEST_CHECK(grandchild.GetTransformVersion() == grandchildVersion);
+
+    //Moving a sibling doesn't touch the child's branch
+    sibling.SetPosition(Vector2(0.0f, 50.0f));
+    TEST_CHECK(grandchild.GetTransformVersion() == grandchildVersion);
+    TEST_CHECK(IsWorldPosition(&sibling, Vector2(100.0f, 50.0f)) == true);
+
+    //Moving the parent rebuilds the world matrices below it, each once
+    parent.SetPosition(Vector2(200.0f, 0.0f));
+    TEST_CHECK(IsWorldPosition(&grandchild, Vector2(211.0f, 0.0f)) == true);
+    TEST_CHECK(grandchild.GetTransformVersion() == grandchildVersion + 1);
+    TEST_CHECK(child.GetTransformVersion() == childVersion + 1);
+    TEST_CHECK(IsWorldPosition(&child, Vector2(210.0f, 0.0f)) == true);
+    TEST_CHECK(child.GetTransformVersion() == childVersion + 1);
+
+    //Rotating and scaling the parent carries the children with it
+    parent.SetAngle(90.0f);
+    parent.SetScale(Vector2(2.0f, 2.0f));
+    TEST_CHECK(IsWorldPosition(&grandchild, Vector2(200.0f, 22.0f)) == true);
+
+    //Detaching the child makes its world matrix its local matrix again
+    child.AttachTo(nullptr);
+    TEST_CHECK(IsWorldPosition(&grandchild, Vector2(11.0f, 0.0f)) == true);
+
+    //A deleted parent detaches its children, they don't keep pointing at it
+    Transformable* temporary = new Transformable();
+    temporary->SetPosition(Vector2(5.0f, 5.0f));
+    child.AttachTo(temporary);
+    TEST_CHECK(IsWorldPosition(&child, Vector2(15.0f, 5.0f)) == true);
+    delete temporary;
+    TEST_CHECK(child.GetParent() == nullptr);
+    TEST_CHECK(IsWorldPosition(&child, Vector2(10.0f, 0.0f)) == true);
+}
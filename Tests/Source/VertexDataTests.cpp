@@ -0,0 +1,116 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/VertexData.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const unsigned int VERTEX_DATA_TEST_CAPACITY = 4;
+const unsigned int VERTEX_DATA_TEST_VERTICES_PER_UPLOAD = 3;
+const unsigned int VERTEX_DATA_TEST_RING_CAPACITY = VERTEX_DATA_TEST_CAPACITY * VERTEX_BUFFER_RING_SIZE;
+const unsigned int VERTEX_DATA_TEST_UPLOADS_BEFORE_WRAP = VERTEX_DATA_TEST_RING_CAPACITY / VERTEX_DATA_TEST_VERTICES_PER_UPLOAD;
+
+//Two float attributes, eight bytes per vertex
+struct VertexDataTestVertex
+{
+    float a;
+    float b;
+};
+
+//Returns true if the command list holds one upload, at the base vertex, and the attributes point at the base vertex
+static bool IsUploadedAtBaseVertex(GraphicsCommandList* aCommandList, unsigned int aBaseVertex)
+{
+    const unsigned int stride = sizeof(VertexDataTestVertex);
+    unsigned int uploads = 0;
+    unsigned int attributes = 0;
+    bool isCorrect = true;
+    for (unsigned int i = 0; i < aCommandList->GetCount(); i++)
+    {
+        const GraphicsCommand& command = aCommandList->GetCommand(i);
+        if (command.type == GraphicsCommandType_UpdateDataBuffer)
+        {
+            isCorrect = isCorrect && command.arguments[1] == (int)(aBaseVertex * stride) && command.dataSize == VERTEX_DATA_TEST_VERTICES_PER_UPLOAD * stride;
+            uploads++;
+        }
+        else if (command.type == GraphicsCommandType_SetVertexAttribute)
+        {
+            //The second attribute follows the first one's float
+            const unsigned int* offsetAndDivisor = (const unsigned int*)aCommandList->GetData(command);
+            unsigned int expected = aBaseVertex * stride + command.arguments[0] * sizeof(float);
+            isCorrect = isCorrect && command.arguments[2] == (int)stride && offsetAndDivisor[0] == expected;
+            attributes++;
+        }
+    }
+    return isCorrect == true && uploads == 1 && attributes == 2;
+}
+
+void TestVertexDataRingBuffer()
+{
+    Graphics* graphics = Services::GetGraphics();
+    GraphicsCommandList* commandList = graphics->GetCommandList();
+    if (TEST_CHECK(commandList != nullptr) == false)
+    {
+        return;
+    }
+
+    //A ring buffer holds VERTEX_BUFFER_RING_SIZE full buffers, its storage is allocated once when it's created
+    VertexBufferDescriptor descriptor;
+    descriptor.attributeIndex = { 0, 1 };
+    descriptor.attributeSize = { 1, 1 };
+    descriptor.size = 2;
+    descriptor.capacity = VERTEX_DATA_TEST_CAPACITY;
+    descriptor.isRingBuffer = true;
+
+    VertexData vertexData;
+    VertexBuffer* vertexBuffer = vertexData.CreateBuffer(descriptor);
+    TEST_CHECK(vertexBuffer->IsRingBuffer() == true);
+
+    //Start from a clean frame, so the frame's stats only count this test's wraps
+    graphics->EndFrame();
+    commandList->Clear();
+
+    //Each upload goes after the last one, until the next one doesn't fit in the ring
+    for (unsigned int i = 0; i <= VERTEX_DATA_TEST_UPLOADS_BEFORE_WRAP; i++)
+    {
+        vertexBuffer->ClearVertices();
+        VertexDataTestVertex* vertices = vertexBuffer->Emit<VertexDataTestVertex>(VERTEX_DATA_TEST_VERTICES_PER_UPLOAD);
+        for (unsigned int j = 0; j < VERTEX_DATA_TEST_VERTICES_PER_UPLOAD; j++)
+        {
+            vertices[j].a = (float)i;
+            vertices[j].b = (float)j;
+        }
+
+        vertexData.PrepareForDraw();
+        vertexData.EndDraw();
+
+        //The uploads before the wrap don't orphan the storage, the one after it does, exactly once
+        bool isWrap = i == VERTEX_DATA_TEST_UPLOADS_BEFORE_WRAP;
+        unsigned int baseVertex = isWrap == true ? 0 : i * VERTEX_DATA_TEST_VERTICES_PER_UPLOAD;
+        TEST_CHECK(commandList->GetCount(GraphicsCommandType_InitializeDataBuffer) == (isWrap == true ? 1 : 0));
+        TEST_CHECK(vertexBuffer->GetBaseVertex() == baseVertex);
+        TEST_CHECK(IsUploadedAtBaseVertex(commandList, baseVertex) == true);
+
+        //The orphaned storage is re-initialized empty, at the ring's full size
+        if (isWrap == true)
+        {
+            for (unsigned int j = 0; j < commandList->GetCount(); j++)
+            {
+                const GraphicsCommand& command = commandList->GetCommand(j);
+                if (command.type == GraphicsCommandType_InitializeDataBuffer)
+                {
+                    TEST_CHECK(command.dataSize == 0);
+                    TEST_CHECK(command.arguments[1] == BufferUsage_DynamicDraw);
+                }
+            }
+        }
+        commandList->Clear();
+    }
+
+    //The frame's stats counted the wrap
+    graphics->EndFrame();
+    TEST_CHECK(graphics->GetBufferWrapCount() == 1);
+    commandList->Clear();
+}
@@ -0,0 +1,224 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Graphics/PrimitiveBatch.h"
+#include "Graphics/SpriteBatch.h"
+#include "Graphics/VertexData.h"
+#include "Graphics/VertexFormat.h"
+#include "Services/Graphics/GraphicsCommandList.h"
+#include <chrono>
+#include <functional>
+#include <vector>
+
+
+using namespace GameDev2D;
+
+//The vertex layouts used before the vertex formats were packed, every attribute is a float
+struct FloatSpriteVertex
+{
+    float x, y;
+    float u, v;
+    float r, g, b, a;
+};
+
+struct FloatPrimitiveVertex
+{
+    float x, y;
+    float r, g, b, a;
+};
+
+//Local constants
+const unsigned int VERTEX_FORMAT_BENCHMARK_FRAMES = 200;
+const unsigned int VERTEX_FORMAT_BENCHMARK_BATCHES = 10;                //Draw calls per frame, each one draws SPRITE_BATCH_COUNT sprites or triangles
+const unsigned int VERTEX_FORMAT_BENCHMARK_TRIANGLES = SPRITE_BATCH_COUNT;
+const Vector2 VERTEX_FORMAT_BENCHMARK_SPRITE_SIZE = Vector2(64.0f, 64.0f);
+
+//Returns the transformation of a sprite or triangle, they are spread over the screen at different angles
+static AffineMatrix GetVertexFormatTransformation(unsigned int aIndex)
+{
+    return AffineMatrix::Make(Vector2((float)(aIndex % WINDOW_WIDTH), (float)(aIndex % WINDOW_HEIGHT)), (float)(aIndex % 360));
+}
+
+//Returns the color of a sprite or triangle
+static Color GetVertexFormatColor(unsigned int aIndex)
+{
+    return Color((float)(aIndex % 256) / 255.0f, 0.5f, 1.0f, 1.0f);
+}
+
+//Uploads and draws the frames, the pack function fills one batch's vertices. Reports the bytes uploaded and the time per frame
+static void BenchmarkUploads(const std::string& aName, VertexData* aVertexData, std::function<void(VertexBuffer*, unsigned int)> aPack, std::function<void()> aDraw)
+{
+    //The uploaded bytes are counted by the headless backend's command list
+    GraphicsCommandList* commandList = Services::GetGraphics()->GetCommandList();
+    if (commandList == nullptr)
+    {
+        return;
+    }
+    VertexBuffer* vertexBuffer = aVertexData->GetVertexBuffer();
+
+    //Upload a batch first, so the static index buffer's upload isn't counted
+    aPack(vertexBuffer, 0);
+    aVertexData->PrepareForDraw();
+    aVertexData->EndDraw();
+    commandList->Clear();
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (unsigned int frame = 0; frame < VERTEX_FORMAT_BENCHMARK_FRAMES; frame++)
+    {
+        for (unsigned int batch = 0; batch < VERTEX_FORMAT_BENCHMARK_BATCHES; batch++)
+        {
+            vertexBuffer->ClearVertices();
+            aPack(vertexBuffer, batch);
+
+            aVertexData->PrepareForDraw();
+            aDraw();
+            aVertexData->EndDraw();
+        }
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+
+    Test::Report(aName + ", upload", (double)commandList->GetUploadedBytes() / VERTEX_FORMAT_BENCHMARK_FRAMES, "bytes/frame");
+    Test::Report(aName + ", upload and draw", duration.count() / VERTEX_FORMAT_BENCHMARK_FRAMES, "ms/frame");
+    commandList->Clear();
+}
+
+//Creates the static index buffer the sprite benchmarks draw with, the same indices the SpriteBatch uses
+static void CreateSpriteIndexBuffer(VertexData* aVertexData)
+{
+    IndexBufferDescriptor indexDescriptor;
+    indexDescriptor.size = 6;
+    indexDescriptor.capacity = SPRITE_BATCH_COUNT;
+    indexDescriptor.usage = BufferUsage_StaticDraw;
+
+    std::vector<unsigned short> indices;
+    for (unsigned int i = 0; i < SPRITE_BATCH_COUNT; i++)
+    {
+        indices.push_back(i * 4 + 1);
+        indices.push_back(i * 4 + 2);
+        indices.push_back(i * 4 + 0);
+        indices.push_back(i * 4 + 0);
+        indices.push_back(i * 4 + 2);
+        indices.push_back(i * 4 + 3);
+    }
+    aVertexData->CreateBuffer(indexDescriptor, &indices);
+}
+
+void BenchmarkSpriteVertexFormats()
+{
+    Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_SPRITEBATCH_SHADER_KEY);
+    Vector2 anchor = Vector2(0.5f, 0.5f);
+    Rect sourceFrame = Rect(Vector2(0.0f, 0.0f), VERTEX_FORMAT_BENCHMARK_SPRITE_SIZE);
+    std::function<void()> draw = []() { Services::GetGraphics()->DrawElements(RenderMode_Triangles, SPRITE_BATCH_COUNT * 6, GraphicType_UnsignedShort, 0); };
+
+    //The packed SpriteVertex, 20 bytes: float position, unsigned short uvs, a packed color and the texture slot
+    VertexBufferDescriptor packedDescriptor;
+    packedDescriptor.size = sizeof(SpriteVertex) / sizeof(float);
+    packedDescriptor.capacity = SPRITE_BATCH_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE;
+    packedDescriptor.attributeIndex = { shader->GetAttributeLocation("in_vertices"), shader->GetAttributeLocation("in_uv"), shader->GetAttributeLocation("in_color"), shader->GetAttributeLocation("in_textureSlot") };
+    packedDescriptor.attributeSize = { 2, 2, 4, 1 };
+    packedDescriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedShort, GraphicType_UnsignedByte, GraphicType_UnsignedByte };
+
+    VertexData packedVertexData;
+    packedVertexData.CreateBuffer(packedDescriptor);
+    CreateSpriteIndexBuffer(&packedVertexData);
+
+    BenchmarkUploads("SpriteVertex, 20 bytes", &packedVertexData,
+        [&](VertexBuffer* aVertexBuffer, unsigned int aBatch)
+        {
+            for (unsigned int i = 0; i < SPRITE_BATCH_COUNT; i++)
+            {
+                unsigned int index = aBatch * SPRITE_BATCH_COUNT + i;
+                SpriteVertex* vertices = aVertexBuffer->Emit<SpriteVertex>(SPRITE_BATCH_VERTICES_PER_SPRITE);
+                PackSpriteVertices(vertices, VERTEX_FORMAT_BENCHMARK_SPRITE_SIZE, GetVertexFormatTransformation(index), GetVertexFormatColor(index), anchor, sourceFrame);
+            }
+        }, draw);
+
+    //The float layout, 32 bytes: float position, uvs and color
+    VertexBufferDescriptor floatDescriptor;
+    floatDescriptor.size = sizeof(FloatSpriteVertex) / sizeof(float);
+    floatDescriptor.capacity = SPRITE_BATCH_COUNT * SPRITE_BATCH_VERTICES_PER_SPRITE;
+    floatDescriptor.attributeIndex = { packedDescriptor.attributeIndex[0], packedDescriptor.attributeIndex[1], packedDescriptor.attributeIndex[2] };
+    floatDescriptor.attributeSize = { 2, 2, 4 };
+
+    VertexData floatVertexData;
+    floatVertexData.CreateBuffer(floatDescriptor);
+    CreateSpriteIndexBuffer(&floatVertexData);
+
+    BenchmarkUploads("Float sprite vertex, 32 bytes", &floatVertexData,
+        [&](VertexBuffer* aVertexBuffer, unsigned int aBatch)
+        {
+            Vector2 corners[SPRITE_BATCH_VERTICES_PER_SPRITE] = { Vector2(0.0f, 0.0f), Vector2(0.0f, 1.0f), Vector2(1.0f, 1.0f), Vector2(1.0f, 0.0f) };
+            for (unsigned int i = 0; i < SPRITE_BATCH_COUNT; i++)
+            {
+                unsigned int index = aBatch * SPRITE_BATCH_COUNT + i;
+                AffineMatrix transformation = GetVertexFormatTransformation(index);
+                Color color = GetVertexFormatColor(index);
+                FloatSpriteVertex* vertices = aVertexBuffer->Emit<FloatSpriteVertex>(SPRITE_BATCH_VERTICES_PER_SPRITE);
+                for (unsigned int j = 0; j < SPRITE_BATCH_VERTICES_PER_SPRITE; j++)
+                {
+                    Vector2 position = transformation * Vector2((corners[j].x - anchor.x) * VERTEX_FORMAT_BENCHMARK_SPRITE_SIZE.x, (corners[j].y - anchor.y) * VERTEX_FORMAT_BENCHMARK_SPRITE_SIZE.y);
+                    vertices[j] = { position.x, position.y, corners[j].x, corners[j].y, color.r, color.g, color.b, color.a };
+                }
+            }
+        }, draw);
+}
+
+void BenchmarkPrimitiveVertexFormats()
+{
+    Shader* shader = Services::GetResourceManager()->GetShader(PASSTHROUGH_POLYGON_SHADER_KEY);
+    Vector2 corners[3] = { Vector2(-16.0f, -16.0f), Vector2(16.0f, -16.0f), Vector2(0.0f, 16.0f) };
+    std::function<void()> draw = []() { Services::GetGraphics()->DrawArrays(RenderMode_Triangles, 0, VERTEX_FORMAT_BENCHMARK_TRIANGLES * 3); };
+
+    //The packed PrimitiveVertex, 12 bytes: float position and a packed color
+    VertexBufferDescriptor packedDescriptor;
+    packedDescriptor.size = sizeof(PrimitiveVertex) / sizeof(float);
+    packedDescriptor.capacity = VERTEX_FORMAT_BENCHMARK_TRIANGLES * 3;
+    packedDescriptor.attributeIndex = { shader->GetAttributeLocation("in_vertices"), shader->GetAttributeLocation("in_color") };
+    packedDescriptor.attributeSize = { 2, 4 };
+    packedDescriptor.attributeType = { GraphicType_Float, GraphicType_UnsignedByte };
+
+    VertexData packedVertexData;
+    packedVertexData.CreateBuffer(packedDescriptor);
+
+    BenchmarkUploads("PrimitiveVertex, 12 bytes", &packedVertexData,
+        [&](VertexBuffer* aVertexBuffer, unsigned int aBatch)
+        {
+            for (unsigned int i = 0; i < VERTEX_FORMAT_BENCHMARK_TRIANGLES; i++)
+            {
+                unsigned int index = aBatch * VERTEX_FORMAT_BENCHMARK_TRIANGLES + i;
+                AffineMatrix transformation = GetVertexFormatTransformation(index);
+                unsigned int color = PackColor(GetVertexFormatColor(index));
+                PrimitiveVertex* vertices = aVertexBuffer->Emit<PrimitiveVertex>(3);
+                for (unsigned int j = 0; j < 3; j++)
+                {
+                    vertices[j] = PrimitiveVertex(transformation * corners[j], color);
+                }
+            }
+        }, draw);
+
+    //The float layout, 24 bytes: float position and color
+    VertexBufferDescriptor floatDescriptor;
+    floatDescriptor.size = sizeof(FloatPrimitiveVertex) / sizeof(float);
+    floatDescriptor.capacity = VERTEX_FORMAT_BENCHMARK_TRIANGLES * 3;
+    floatDescriptor.attributeIndex = packedDescriptor.attributeIndex;
+    floatDescriptor.attributeSize = { 2, 4 };
+
+    VertexData floatVertexData;
+    floatVertexData.CreateBuffer(floatDescriptor);
+
+    BenchmarkUploads("Float primitive vertex, 24 bytes", &floatVertexData,
+        [&](VertexBuffer* aVertexBuffer, unsigned int aBatch)
+        {
+            for (unsigned int i = 0; i < VERTEX_FORMAT_BENCHMARK_TRIANGLES; i++)
+            {
+                unsigned int index = aBatch * VERTEX_FORMAT_BENCHMARK_TRIANGLES + i;
+                AffineMatrix transformation = GetVertexFormatTransformation(index);
+                Color color = GetVertexFormatColor(index);
+                FloatPrimitiveVertex* vertices = aVertexBuffer->Emit<FloatPrimitiveVertex>(3);
+                for (unsigned int j = 0; j < 3; j++)
+                {
+                    Vector2 position = transformation * corners[j];
+                    vertices[j] = { position.x, position.y, color.r, color.g, color.b, color.a };
+                }
+            }
+        }, draw);
+}
@@ -0,0 +1,134 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Physics/CollisionKernels.h"
+#include <chrono>
+#include <math.h>
+#include <string>
+#include <vector>
+
+
+using namespace GameDev2D;
+using namespace GameDev2D::Physics;
+
+//Local constants
+const unsigned int WORLD_BENCHMARK_STEPS = 100;
+const unsigned int WORLD_BENCHMARK_BRUTE_FORCE_STEPS = 10;        //The brute force steps are slow, fewer of them are enough
+const unsigned int WORLD_BENCHMARK_BODY_COUNTS[] = { 250, 1000, 4000 };
+const float WORLD_BENCHMARK_BODY_SIZE = 1.0f;                     //In meters
+const float WORLD_BENCHMARK_AREA_PER_BODY = 16.0f;                //In square meters
+const float WORLD_BENCHMARK_TIME_STEP = 1.0f / 60.0f;
+
+//Returns a pseudo random number between zero and one, the sequence is the same every run so the results can be compared
+static float GetWorldBenchmarkRandom(unsigned int* aSeed)
+{
+    *aSeed = *aSeed * 1664525u + 1013904223u;
+    return (float)(*aSeed >> 8) / (float)(1 << 24);
+}
+
+//Creates the bodies in the World, half circles and half boxes, spread over a square area and moving at up to 10 meters per second
+static void CreateWorldBenchmarkBodies(unsigned int aBodyCount, std::vector<Body*>& aBodies)
+{
+    float worldSize = sqrtf(aBodyCount * WORLD_BENCHMARK_AREA_PER_BODY);
+    unsigned int seed = aBodyCount;
+    for (unsigned int i = 0; i < aBodyCount; i++)
+    {
+        Collider* collider = nullptr;
+        if (i % 2 == 0)
+        {
+            collider = new CircleCollider(WORLD_BENCHMARK_BODY_SIZE * 0.5f);
+        }
+        else
+        {
+            collider = new BoxCollider(WORLD_BENCHMARK_BODY_SIZE, WORLD_BENCHMARK_BODY_SIZE);
+        }
+
+        Body* body = World::GetInstance()->CreateBody(collider, 1.0f);
+        body->SetPosition(Vector2(GetWorldBenchmarkRandom(&seed) * worldSize, GetWorldBenchmarkRandom(&seed) * worldSize));
+        body->SetLinearVelocity(Vector2(GetWorldBenchmarkRandom(&seed) * 20.0f - 10.0f, GetWorldBenchmarkRandom(&seed) * 20.0f - 10.0f));
+        aBodies.push_back(body);
+    }
+}
+
+//The O(n^2) baseline, every pair of bodies goes through the bounding box test and the narrowphase, the way the World
+//did before it had a broadphase. Only the collision detection is timed, so it's a lower bound for a brute force step
+static void BenchmarkBruteForce(const std::string& aName, std::vector<Body*>& aBodies)
+{
+    unsigned int pairCount = 0;
+    unsigned int contactCount = 0;
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (unsigned int step = 0; step < WORLD_BENCHMARK_BRUTE_FORCE_STEPS; step++)
+    {
+        pairCount = 0;
+        contactCount = 0;
+        for (unsigned int i = 0; i < aBodies.size(); i++)
+        {
+            aBodies[i]->GetCollider()->UpdateTransform(aBodies[i]->GetPosition(), aBodies[i]->GetAngle());
+        }
+
+        for (unsigned int i = 0; i < aBodies.size(); i++)
+        {
+            for (unsigned int j = i + 1; j < aBodies.size(); j++)
+            {
+                Collider* colliderA = aBodies[i]->GetCollider();
+                Collider* colliderB = aBodies[j]->GetCollider();
+                if (colliderA->GetAABB().Overlaps(colliderB->GetAABB()) == false)
+                {
+                    continue;
+                }
+                pairCount++;
+
+                CollisionKernel kernel = GetCollisionKernel(colliderA->GetType(), colliderB->GetType());
+                Manifold manifold(aBodies[i], aBodies[j]);
+                if (kernel != nullptr && kernel(aBodies[i], aBodies[j], &manifold) == true)
+                {
+                    contactCount++;
+                }
+            }
+        }
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+
+    Test::Report(aName, duration.count() / WORLD_BENCHMARK_BRUTE_FORCE_STEPS, "ms/step");
+    Test::Report(aName + " pairs", (double)pairCount, "");
+    Test::Report(aName + " contacts", (double)contactCount, "");
+}
+
+void BenchmarkWorldStep()
+{
+    //The World is shared with the tests, put its gravity back and don't leave any bodies behind
+    World* world = World::GetInstance();
+    Vector2 gravity = world->GetGravity();
+    world->SetGravity(Vector2(0.0f, 0.0f));
+
+    for (unsigned int i = 0; i < sizeof(WORLD_BENCHMARK_BODY_COUNTS) / sizeof(WORLD_BENCHMARK_BODY_COUNTS[0]); i++)
+    {
+        unsigned int bodyCount = WORLD_BENCHMARK_BODY_COUNTS[i];
+        std::vector<Body*> bodies;
+        CreateWorldBenchmarkBodies(bodyCount, bodies);
+
+        //The first step creates the proxies, it isn't timed
+        world->Step(WORLD_BENCHMARK_TIME_STEP);
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        for (unsigned int step = 0; step < WORLD_BENCHMARK_STEPS; step++)
+        {
+            world->Step(WORLD_BENCHMARK_TIME_STEP);
+        }
+        std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+
+        std::string name = "World::Step, " + std::to_string(bodyCount) + " bodies";
+        Test::Report(name, duration.count() / WORLD_BENCHMARK_STEPS, "ms/step");
+        Test::Report(name + " pairs", (double)world->GetPairCount(), "");
+        Test::Report(name + " contacts", (double)world->GetContactCount(), "");
+
+        //The baseline runs on the bodies where the World left them
+        BenchmarkBruteForce("Brute force, " + std::to_string(bodyCount) + " bodies", bodies);
+
+        for (unsigned int j = 0; j < bodies.size(); j++)
+        {
+            world->DestroyBody(bodies[j]);
+        }
+    }
+
+    world->SetGravity(gravity);
+}
@@ -0,0 +1,124 @@
+#include <GameDev2D.h>
+#include "Test.h"
+#include "Physics/Body.h"
+#include "Physics/CircleCollider.h"
+#include "Physics/World.h"
+#include "Physics/WorldListener.h"
+#include <vector>
+
+
+using namespace GameDev2D;
+using namespace GameDev2D::Physics;
+
+//Local constants
+const float WORLD_CONTACT_TEST_RADIUS = 1.0f;             //In meters
+const double WORLD_CONTACT_TEST_TIME_STEP = 1.0 / 60.0;
+
+//Records the listener calls, it can destroy a body from PersistContact() to test a destroy in the middle of a step
+class WorldContactTestListener : public WorldListener
+{
+public:
+    WorldContactTestListener() :
+        beginCount(0),
+        persistCount(0),
+        destroyOnPersist(nullptr)
+    {
+    }
+
+    void BeginContact(Body* aBodyA, Body* aBodyB)
+    {
+        beginCount++;
+    }
+
+    void PersistContact(Body* aBodyA, Body* aBodyB)
+    {
+        persistCount++;
+        if (destroyOnPersist != nullptr && (aBodyA == destroyOnPersist || aBodyB == destroyOnPersist))
+        {
+            World::GetInstance()->DestroyBody(destroyOnPersist);
+            destroyOnPersist = nullptr;
+        }
+    }
+
+    void EndContact(Body* aBodyA, Body* aBodyB)
+    {
+        //The bodies must still be valid when EndContact() is called
+        TEST_CHECK(World::GetInstance()->GetBody(aBodyA->GetHandle()) == aBodyA);
+        TEST_CHECK(World::GetInstance()->GetBody(aBodyB->GetHandle()) == aBodyB);
+        endedBodies.push_back(aBodyA);
+        endedBodies.push_back(aBodyB);
+    }
+
+    unsigned int beginCount;
+    unsigned int persistCount;
+    std::vector<Body*> endedBodies;
+    Body* destroyOnPersist;
+};
+
+//Creates a sensor body, sensors report their contacts but aren't pushed apart, so the bodies keep touching
+static Body* CreateWorldContactTestBody(Vector2 aPosition)
+{
+    CircleCollider* collider = new CircleCollider(WORLD_CONTACT_TEST_RADIUS);
+    collider->SetIsSensor(true);
+    Body* body = World::GetInstance()->CreateBody(collider, 1.0f);
+    body->SetPosition(aPosition);
+    return body;
+}
+
+//Returns true if the listener's last EndContact() call was for the two bodies, in either order
+static bool DidEndContact(const WorldContactTestListener& aListener, Body* aBodyA, Body* aBodyB)
+{
+    if (aListener.endedBodies.size() < 2)
+    {
+        return false;
+    }
+
+    Body* endedA = aListener.endedBodies.at(aListener.endedBodies.size() - 2);
+    Body* endedB = aListener.endedBodies.back();
+    return (endedA == aBodyA && endedB == aBodyB) || (endedA == aBodyB && endedB == aBodyA);
+}
+
+void TestWorldContactDestroy()
+{
+    World* world = World::GetInstance();
+    Vector2 gravity = world->GetGravity();
+    world->SetGravity(Vector2(0.0f, 0.0f));
+
+    WorldContactTestListener listener;
+    world->SetListener(&listener);
+
+    //Two overlapping bodies begin, then persist their contact
+    Body* bodyA = CreateWorldContactTestBody(Vector2(0.0f, 0.0f));
+    Body* bodyB = CreateWorldContactTestBody(Vector2(WORLD_CONTACT_TEST_RADIUS, 0.0f));
+    world->Step(WORLD_CONTACT_TEST_TIME_STEP);
+    TEST_CHECK(listener.beginCount == 1);
+    world->Step(WORLD_CONTACT_TEST_TIME_STEP);
+    TEST_CHECK(listener.persistCount == 1);
+
+    //Destroying a body between steps ends its contact before the body is gone
+    world->DestroyBody(bodyB);
+    TEST_CHECK(listener.endedBodies.size() == 2);
+    TEST_CHECK(DidEndContact(listener, bodyA, bodyB) == true);
+
+    //The next step doesn't end the contact a second time
+    world->Step(WORLD_CONTACT_TEST_TIME_STEP);
+    TEST_CHECK(listener.endedBodies.size() == 2);
+
+    //Destroying a body from the listener, in the middle of a step, ends its contact once the step is done
+    Body* bodyC = CreateWorldContactTestBody(Vector2(0.0f, WORLD_CONTACT_TEST_RADIUS));
+    world->Step(WORLD_CONTACT_TEST_TIME_STEP);
+    TEST_CHECK(listener.beginCount == 2);
+    listener.destroyOnPersist = bodyC;
+    world->Step(WORLD_CONTACT_TEST_TIME_STEP);
+    TEST_CHECK(listener.endedBodies.size() == 4);
+    TEST_CHECK(DidEndContact(listener, bodyA, bodyC) == true);
+
+    world->Step(WORLD_CONTACT_TEST_TIME_STEP);
+    TEST_CHECK(listener.endedBodies.size() == 4);
+
+    //Clean up, the last body isn't touching anything
+    world->DestroyBody(bodyA);
+    TEST_CHECK(listener.endedBodies.size() == 4);
+    world->SetListener(nullptr);
+    world->SetGravity(gravity);
+}